@@ -0,0 +1,585 @@
+/* FAudio - XAudio Reimplementation for FNA
+ *
+ * Copyright (c) 2011-2018 Ethan Lee, Luigi Auriemma, and the MonoGame Team
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from
+ * the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software in a
+ * product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ * Ethan "flibitijibibo" Lee <flibitijibibo@flibitijibibo.com>
+ *
+ */
+
+/* Engine benchmarks
+ *
+ * Builds synthetic voice graphs and times how long the engine takes to render
+ * each quantum, with no device involved (see HeadlessEXT and RenderEXT).
+ * Results are written as JSON, so they can be compared between builds.
+ *
+ * Usage: faudio_benchmark [-o results.json] [-n quanta] [-g group]
+ */
+
+#include <FAudio.h>
+#include <FAudioFX.h>
+#include <FAPO.h>
+#include <SDL.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef FAUDIO_VERSION_STRING
+#define FAUDIO_VERSION_STRING "unknown"
+#endif
+
+#define OUTPUT_RATE 48000
+#define OUTPUT_CHANNELS 2
+#define BUFFER_SECONDS 1
+#define WARMUP_QUANTA 16
+#define MAX_SUBMIXES 8
+
+/* Source Formats */
+
+typedef enum BenchFormat
+{
+	FORMAT_PCM8,
+	FORMAT_PCM16,
+	FORMAT_PCM24,
+	FORMAT_FLOAT32,
+	FORMAT_MSADPCM
+} BenchFormat;
+
+static const char *formatNames[] =
+{
+	"pcm8",
+	"pcm16",
+	"pcm24",
+	"float32",
+	"msadpcm"
+};
+
+/* Effect Chains */
+
+typedef enum BenchEffects
+{
+	EFFECTS_NONE,
+	EFFECTS_REVERB,
+	EFFECTS_VOLUMEMETER,
+	EFFECTS_REVERB_VOLUMEMETER
+} BenchEffects;
+
+static const char *effectNames[] =
+{
+	"none",
+	"reverb",
+	"volumemeter",
+	"reverb+volumemeter"
+};
+
+/* Scenarios */
+
+typedef struct BenchScenario
+{
+	const char *group;
+	uint32_t voices;
+	BenchFormat format;
+	uint16_t channels;
+	uint32_t sampleRate;
+	uint32_t submixes;
+	BenchEffects effects;
+} BenchScenario;
+
+typedef struct BenchResult
+{
+	double mean;
+	double median;
+	double p99;
+	double min;
+} BenchResult;
+
+/* Deterministic, so every run decodes the same data */
+static uint32_t randState = 1;
+static uint32_t BenchRandom()
+{
+	randState = randState * 1103515245 + 12345;
+	return randState >> 8;
+}
+
+static uint8_t* CreateBuffer(
+	BenchFormat format,
+	uint16_t channels,
+	uint32_t sampleRate,
+	FAudioADPCMWaveFormat *fmt,
+	uint32_t *bytes
+) {
+	uint8_t *data;
+	uint32_t frames, samples, i, block, blocks;
+
+	SDL_memset(fmt, '\0', sizeof(FAudioADPCMWaveFormat));
+	fmt->wfx.nChannels = channels;
+	fmt->wfx.nSamplesPerSec = sampleRate;
+	frames = sampleRate * BUFFER_SECONDS;
+	samples = frames * channels;
+
+	if (format == FORMAT_MSADPCM)
+	{
+		/* 512 bytes per channel per block, like most XACT wavebanks */
+		fmt->wfx.wFormatTag = FAUDIO_FORMAT_MSADPCM;
+		fmt->wfx.wBitsPerSample = 4;
+		fmt->wfx.nBlockAlign = 512 * channels;
+		fmt->wfx.cbSize = 4;
+		fmt->wSamplesPerBlock = (512 - 6) * 2;
+		blocks = (frames + fmt->wSamplesPerBlock - 1) / fmt->wSamplesPerBlock;
+		fmt->wfx.nAvgBytesPerSec = (
+			sampleRate / fmt->wSamplesPerBlock *
+			fmt->wfx.nBlockAlign
+		);
+		*bytes = blocks * fmt->wfx.nBlockAlign;
+		data = (uint8_t*) SDL_malloc(*bytes);
+
+		/* Random nibbles decode to noise, as long as each block header
+		 * has a valid predictor and a sane starting delta.
+		 */
+		for (i = 0; i < *bytes; i += 1)
+		{
+			data[i] = (uint8_t) BenchRandom();
+		}
+		for (block = 0; block < blocks; block += 1)
+		{
+			uint8_t *header = data + (block * fmt->wfx.nBlockAlign);
+			for (i = 0; i < channels; i += 1)
+			{
+				header[i] = (uint8_t) (BenchRandom() % 7);
+				header[channels + (i * 2)] = 64;
+				header[channels + (i * 2) + 1] = 0;
+			}
+		}
+		return data;
+	}
+
+	if (format == FORMAT_FLOAT32)
+	{
+		fmt->wfx.wFormatTag = FAUDIO_FORMAT_IEEE_FLOAT;
+		fmt->wfx.wBitsPerSample = 32;
+	}
+	else
+	{
+		fmt->wfx.wFormatTag = FAUDIO_FORMAT_PCM;
+		fmt->wfx.wBitsPerSample = (
+			(format == FORMAT_PCM8) ? 8 :
+			(format == FORMAT_PCM16) ? 16 :
+			24
+		);
+	}
+	fmt->wfx.nBlockAlign = channels * (fmt->wfx.wBitsPerSample / 8);
+	fmt->wfx.nAvgBytesPerSec = sampleRate * fmt->wfx.nBlockAlign;
+	*bytes = frames * fmt->wfx.nBlockAlign;
+	data = (uint8_t*) SDL_malloc(*bytes);
+
+	if (format == FORMAT_FLOAT32)
+	{
+		float *dst = (float*) data;
+		for (i = 0; i < samples; i += 1)
+		{
+			dst[i] = ((BenchRandom() & 0xFFFF) / 32768.0f) - 1.0f;
+		}
+	}
+	else
+	{
+		/* Any bytes are valid integer PCM */
+		for (i = 0; i < *bytes; i += 1)
+		{
+			data[i] = (uint8_t) BenchRandom();
+		}
+	}
+	return data;
+}
+
+static void CreateEffectChain(
+	BenchEffects effects,
+	FAudioEffectDescriptor *desc,
+	FAudioEffectChain *chain
+) {
+	chain->EffectCount = 0;
+	chain->pEffectDescriptors = desc;
+	if (effects == EFFECTS_REVERB || effects == EFFECTS_REVERB_VOLUMEMETER)
+	{
+		FAudioCreateReverb(&desc[chain->EffectCount].pEffect, 0);
+		desc[chain->EffectCount].InitialState = 1;
+		desc[chain->EffectCount].OutputChannels = OUTPUT_CHANNELS;
+		chain->EffectCount += 1;
+	}
+	if (effects == EFFECTS_VOLUMEMETER || effects == EFFECTS_REVERB_VOLUMEMETER)
+	{
+		FAudioCreateVolumeMeter(&desc[chain->EffectCount].pEffect, 0);
+		desc[chain->EffectCount].InitialState = 1;
+		desc[chain->EffectCount].OutputChannels = OUTPUT_CHANNELS;
+		chain->EffectCount += 1;
+	}
+}
+
+static int CompareDoubles(const void *a, const void *b)
+{
+	const double x = *(const double*) a;
+	const double y = *(const double*) b;
+	return (x > y) - (x < y);
+}
+
+static int RunScenario(
+	const BenchScenario *scenario,
+	uint32_t quanta,
+	uint32_t *quantumFrames,
+	BenchResult *result
+) {
+	FAudio *audio;
+	FAudioMasteringVoice *master;
+	FAudioSubmixVoice *submixes[MAX_SUBMIXES];
+	FAudioSourceVoice **sources;
+	FAudioADPCMWaveFormat fmt;
+	FAudioBuffer buffer;
+	FAudioSendDescriptor send;
+	FAudioVoiceSends sends;
+	FAudioEffectDescriptor desc[2];
+	FAudioEffectChain chain;
+	float *output;
+	double *times;
+	uint64_t start;
+	double toNS;
+	uint8_t *data;
+	uint32_t bytes, i;
+
+	if (FAudioCreate(&audio, 0, FAUDIO_DEFAULT_PROCESSOR) != 0)
+	{
+		return 0;
+	}
+	FAudio_SetHeadlessModeEXT(audio, FAUDIO_HEADLESS_MANUAL_EXT, NULL);
+	if (FAudio_CreateMasteringVoice(
+		audio,
+		&master,
+		OUTPUT_CHANNELS,
+		OUTPUT_RATE,
+		0,
+		0,
+		NULL
+	) != 0) {
+		FAudio_Release(audio);
+		return 0;
+	}
+	FAudio_GetQuantumSizeEXT(audio, quantumFrames);
+
+	/* The effects go on whatever feeds the master: the first submix in
+	 * the chain, or the master itself when there are no submixes. Each
+	 * submix sends to the one before it, so it needs an earlier stage.
+	 */
+	CreateEffectChain(scenario->effects, desc, &chain);
+	if (scenario->submixes == 0 && chain.EffectCount > 0)
+	{
+		FAudioVoice_SetEffectChain(master, &chain);
+	}
+	for (i = 0; i < scenario->submixes; i += 1)
+	{
+		FAudioSubmixVoice *target = (i == 0) ? master : submixes[i - 1];
+		send.Flags = 0;
+		send.pOutputVoice = target;
+		sends.SendCount = 1;
+		sends.pSends = &send;
+		FAudio_CreateSubmixVoice(
+			audio,
+			&submixes[i],
+			OUTPUT_CHANNELS,
+			OUTPUT_RATE,
+			0,
+			scenario->submixes - 1 - i,
+			&sends,
+			(i == 0 && chain.EffectCount > 0) ? &chain : NULL
+		);
+	}
+	for (i = 0; i < chain.EffectCount; i += 1)
+	{
+		desc[i].pEffect->Release(desc[i].pEffect);
+	}
+
+	/* Every source plays the same looping buffer */
+	data = CreateBuffer(
+		scenario->format,
+		scenario->channels,
+		scenario->sampleRate,
+		&fmt,
+		&bytes
+	);
+	SDL_memset(&buffer, '\0', sizeof(buffer));
+	buffer.AudioBytes = bytes;
+	buffer.pAudioData = data;
+	buffer.LoopCount = FAUDIO_LOOP_INFINITE;
+
+	send.Flags = 0;
+	send.pOutputVoice = (scenario->submixes > 0) ?
+		submixes[scenario->submixes - 1] :
+		master;
+	sends.SendCount = 1;
+	sends.pSends = &send;
+	sources = (FAudioSourceVoice**) SDL_malloc(
+		sizeof(FAudioSourceVoice*) * scenario->voices
+	);
+	for (i = 0; i < scenario->voices; i += 1)
+	{
+		FAudio_CreateSourceVoice(
+			audio,
+			&sources[i],
+			&fmt.wfx,
+			0,
+			FAUDIO_DEFAULT_FREQ_RATIO,
+			NULL,
+			&sends,
+			NULL
+		);
+		FAudioSourceVoice_SubmitSourceBuffer(sources[i], &buffer, NULL);
+		FAudioSourceVoice_Start(sources[i], 0, 0);
+	}
+
+	/* Warm up the caches, then time each quantum on its own */
+	output = (float*) SDL_malloc(
+		sizeof(float) * (*quantumFrames) * OUTPUT_CHANNELS
+	);
+	for (i = 0; i < WARMUP_QUANTA; i += 1)
+	{
+		FAudio_RenderEXT(
+			audio,
+			output,
+			*quantumFrames,
+			FAUDIO_RENDER_FLOAT32_EXT
+		);
+	}
+	times = (double*) SDL_malloc(sizeof(double) * quanta);
+	toNS = 1000000000.0 / (double) SDL_GetPerformanceFrequency();
+	result->mean = 0.0;
+	for (i = 0; i < quanta; i += 1)
+	{
+		start = SDL_GetPerformanceCounter();
+		FAudio_RenderEXT(
+			audio,
+			output,
+			*quantumFrames,
+			FAUDIO_RENDER_FLOAT32_EXT
+		);
+		times[i] = (SDL_GetPerformanceCounter() - start) * toNS;
+		result->mean += times[i];
+	}
+	result->mean /= quanta;
+	SDL_qsort(times, quanta, sizeof(double), CompareDoubles);
+	result->median = times[quanta / 2];
+	result->p99 = times[(quanta * 99) / 100];
+	result->min = times[0];
+
+	/* Clean up. Submixes have to go from the sources up. */
+	for (i = 0; i < scenario->voices; i += 1)
+	{
+		FAudioVoice_DestroyVoice(sources[i]);
+	}
+	for (i = scenario->submixes; i > 0; i -= 1)
+	{
+		FAudioVoice_DestroyVoice(submixes[i - 1]);
+	}
+	FAudioVoice_DestroyVoice(master);
+	FAudio_Release(audio);
+	SDL_free(times);
+	SDL_free(output);
+	SDL_free(sources);
+	SDL_free(data);
+	return 1;
+}
+
+/* The default suite. Each group varies one thing from the same baseline:
+ * 64 stereo PCM16 voices at 44100Hz, straight into the master.
+ */
+
+static BenchScenario scenarios[128];
+static uint32_t scenarioCount = 0;
+
+static void AddScenario(
+	const char *group,
+	uint32_t voices,
+	BenchFormat format,
+	uint16_t channels,
+	uint32_t sampleRate,
+	uint32_t submixes,
+	BenchEffects effects
+) {
+	BenchScenario *s = &scenarios[scenarioCount++];
+	s->group = group;
+	s->voices = voices;
+	s->format = format;
+	s->channels = channels;
+	s->sampleRate = sampleRate;
+	s->submixes = submixes;
+	s->effects = effects;
+}
+
+static void BuildScenarios()
+{
+	static const uint32_t voiceCounts[] = { 1, 4, 16, 64, 256 };
+	static const uint16_t channelCounts[] = { 1, 2, 4, 6, 8 };
+	static const uint32_t sampleRates[] = { 22050, 24000, 32000, 44100, 48000, 96000 };
+	static const uint32_t submixDepths[] = { 0, 1, 2, 4, 8 };
+	uint32_t i, format;
+
+	#define COUNT(x) (sizeof(x) / sizeof(x[0]))
+	for (i = 0; i < COUNT(voiceCounts); i += 1)
+	{
+		AddScenario("scaling", voiceCounts[i], FORMAT_PCM16, 2, 44100, 0, EFFECTS_NONE);
+	}
+	for (format = FORMAT_PCM8; format <= FORMAT_MSADPCM; format += 1)
+	{
+		/* Native rate and resampled, mono and stereo */
+		AddScenario("formats", 64, (BenchFormat) format, 1, 48000, 0, EFFECTS_NONE);
+		AddScenario("formats", 64, (BenchFormat) format, 2, 48000, 0, EFFECTS_NONE);
+		AddScenario("formats", 64, (BenchFormat) format, 1, 44100, 0, EFFECTS_NONE);
+		AddScenario("formats", 64, (BenchFormat) format, 2, 44100, 0, EFFECTS_NONE);
+	}
+	for (i = 0; i < COUNT(channelCounts); i += 1)
+	{
+		AddScenario("channels", 64, FORMAT_PCM16, channelCounts[i], 44100, 0, EFFECTS_NONE);
+	}
+	for (i = 0; i < COUNT(sampleRates); i += 1)
+	{
+		AddScenario("resampling", 64, FORMAT_PCM16, 2, sampleRates[i], 0, EFFECTS_NONE);
+	}
+	for (i = 0; i < COUNT(submixDepths); i += 1)
+	{
+		AddScenario("submixes", 64, FORMAT_PCM16, 2, 44100, submixDepths[i], EFFECTS_NONE);
+	}
+	for (i = EFFECTS_NONE; i <= EFFECTS_REVERB_VOLUMEMETER; i += 1)
+	{
+		AddScenario("effects", 64, FORMAT_PCM16, 2, 44100, 1, (BenchEffects) i);
+	}
+	#undef COUNT
+}
+
+int main(int argc, char **argv)
+{
+	const char *outputPath = NULL;
+	const char *onlyGroup = NULL;
+	const char *simd;
+	uint32_t quanta = 500;
+	uint32_t quantumFrames = 0;
+	uint32_t i, written;
+	BenchResult result;
+	FILE *out;
+
+	for (i = 1; i < (uint32_t) argc; i += 1)
+	{
+		if (SDL_strcmp(argv[i], "-o") == 0 && i + 1 < (uint32_t) argc)
+		{
+			outputPath = argv[++i];
+		}
+		else if (SDL_strcmp(argv[i], "-n") == 0 && i + 1 < (uint32_t) argc)
+		{
+			quanta = SDL_atoi(argv[++i]);
+		}
+		else if (SDL_strcmp(argv[i], "-g") == 0 && i + 1 < (uint32_t) argc)
+		{
+			onlyGroup = argv[++i];
+		}
+		else
+		{
+			fprintf(
+				stderr,
+				"Usage: %s [-o results.json] [-n quanta] [-g group]\n",
+				argv[0]
+			);
+			return 1;
+		}
+	}
+	if (quanta == 0)
+	{
+		quanta = 1;
+	}
+
+	out = (outputPath != NULL) ? fopen(outputPath, "w") : stdout;
+	if (out == NULL)
+	{
+		fprintf(stderr, "Could not open %s\n", outputPath);
+		return 1;
+	}
+
+	/* FAUDIO_SIMD caps the SIMD tier, so record it with the results */
+	simd = SDL_getenv("FAUDIO_SIMD");
+
+	BuildScenarios();
+	fprintf(out, "{\n");
+	fprintf(out, "\t\"version\": \"%s\",\n", FAUDIO_VERSION_STRING);
+	fprintf(out, "\t\"simd\": \"%s\",\n", (simd != NULL) ? simd : "auto");
+	fprintf(out, "\t\"output_rate\": %d,\n", OUTPUT_RATE);
+	fprintf(out, "\t\"output_channels\": %d,\n", OUTPUT_CHANNELS);
+	fprintf(out, "\t\"quanta\": %u,\n", quanta);
+	fprintf(out, "\t\"results\": [");
+	written = 0;
+	for (i = 0; i < scenarioCount; i += 1)
+	{
+		const BenchScenario *s = &scenarios[i];
+		if (onlyGroup != NULL && SDL_strcmp(onlyGroup, s->group) != 0)
+		{
+			continue;
+		}
+		if (!RunScenario(s, quanta, &quantumFrames, &result))
+		{
+			fprintf(stderr, "Could not create an engine, stopping\n");
+			break;
+		}
+		fprintf(out, "%s\n\t\t{\n", (written > 0) ? "," : "");
+		fprintf(out, "\t\t\t\"group\": \"%s\",\n", s->group);
+		fprintf(out, "\t\t\t\"voices\": %u,\n", s->voices);
+		fprintf(out, "\t\t\t\"format\": \"%s\",\n", formatNames[s->format]);
+		fprintf(out, "\t\t\t\"channels\": %u,\n", s->channels);
+		fprintf(out, "\t\t\t\"sample_rate\": %u,\n", s->sampleRate);
+		fprintf(out, "\t\t\t\"submixes\": %u,\n", s->submixes);
+		fprintf(out, "\t\t\t\"effects\": \"%s\",\n", effectNames[s->effects]);
+		fprintf(out, "\t\t\t\"quantum_frames\": %u,\n", quantumFrames);
+		fprintf(out, "\t\t\t\"ns_per_quantum_mean\": %.0f,\n", result.mean);
+		fprintf(out, "\t\t\t\"ns_per_quantum_median\": %.0f,\n", result.median);
+		fprintf(out, "\t\t\t\"ns_per_quantum_p99\": %.0f,\n", result.p99);
+		fprintf(out, "\t\t\t\"ns_per_quantum_min\": %.0f,\n", result.min);
+		fprintf(out, "\t\t\t\"ns_per_voice\": %.1f,\n", result.median / s->voices);
+		fprintf(
+			out,
+			"\t\t\t\"realtime_factor\": %.1f\n",
+			(quantumFrames * 1000000000.0 / OUTPUT_RATE) / result.median
+		);
+		fprintf(out, "\t\t}");
+		written += 1;
+
+		/* Progress goes to stderr, so stdout stays valid JSON */
+		fprintf(
+			stderr,
+			"%s: %u %s %uch %uHz, %u submixes, %s: %.0f ns\n",
+			s->group,
+			s->voices,
+			formatNames[s->format],
+			s->channels,
+			s->sampleRate,
+			s->submixes,
+			effectNames[s->effects],
+			result.median
+		);
+	}
+	fprintf(out, "\n\t]\n}\n");
+	if (out != stdout)
+	{
+		fclose(out);
+	}
+	return 0;
+}
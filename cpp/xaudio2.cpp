@@ -1324,7 +1324,7 @@ public:
 
 	COM_METHOD(HRESULT) CommitChanges(UINT32 OperationSet)
 	{
-		return FAudio_CommitChanges(faudio);
+		return FAudio_CommitOperationSet(faudio, OperationSet);
 	}
 
 	COM_METHOD(void) GetPerformanceData(XAUDIO2_PERFORMANCE_DATA *pPerfData)
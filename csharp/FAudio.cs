@@ -400,6 +400,12 @@ public static class FAudio
 		IntPtr audio /* FAudio* */
 	);
 
+	[DllImport(nativeLibName, CallingConvention = CallingConvention.Cdecl)]
+	public static extern uint FAudio_CommitOperationSet(
+		IntPtr audio, /* FAudio* */
+		uint OperationSet
+	);
+
 	[DllImport(nativeLibName, CallingConvention = CallingConvention.Cdecl)]
 	public static extern uint FAudio_CommitChanges(
 		IntPtr audio /* FAudio* */
@@ -501,8 +501,19 @@ FAUDIOAPI uint32_t FAudio_StartEngine(FAudio *audio);
 
 FAUDIOAPI void FAudio_StopEngine(FAudio *audio);
 
+/* Applies every call made with OperationSet at the start of the next update.
+ * FAUDIO_COMMIT_ALL applies every queued call, which is what
+ * FAudio_CommitChanges does.
+ */
+FAUDIOAPI uint32_t FAudio_CommitOperationSet(FAudio *audio, uint32_t OperationSet);
+
 FAUDIOAPI uint32_t FAudio_CommitChanges(FAudio *audio);
 
+/* The "cycles" are ticks of SDL_GetPerformanceCounter, not CPU cycles, and
+ * cover what happened since the previous call. A glitch is an update that took
+ * longer to render than it takes to play. MemoryUsageInBytes counts the
+ * engine's own voices and caches, not effects or client buffers.
+ */
 FAUDIOAPI void FAudio_GetPerformanceData(
 	FAudio *audio,
 	FAudioPerformanceData *pPerfData
@@ -790,6 +801,166 @@ FAUDIOAPI void FAudio_SetEngineProcedureEXT(
 	void *user
 );
 
+/* FAudio Mix Threads API
+ * See "extensions/MixThreadsEXT.txt" for more information.
+ */
+
+FAUDIOAPI uint32_t FAudio_SetMixThreadCountEXT(
+	FAudio *audio,
+	uint32_t threadCount
+);
+FAUDIOAPI void FAudio_GetMixThreadCountEXT(
+	FAudio *audio,
+	uint32_t *pThreadCount
+);
+
+/* FAudio Source Voice Pool API
+ * See "extensions/SourceVoicePoolEXT.txt" for more information.
+ */
+
+typedef struct FAudioSourceVoicePoolStatisticsEXT
+{
+	uint32_t PoolSize;	/* Voices owned by the pool, idle or not */
+	uint32_t VoicesInUse;	/* Voices currently handed out */
+	uint32_t HighWaterMark;	/* Most voices handed out at once */
+	uint32_t Hits;		/* Creations served by an idle voice */
+	uint32_t Misses;	/* Creations that found the pool empty */
+} FAudioSourceVoicePoolStatisticsEXT;
+
+FAUDIOAPI uint32_t FAudio_CreateSourceVoicePoolEXT(
+	FAudio *audio,
+	const FAudioWaveFormatEx *pSourceFormat,
+	uint32_t Flags,
+	float MaxFrequencyRatio,
+	uint32_t VoiceCount
+);
+FAUDIOAPI uint32_t FAudio_GetSourceVoicePoolStatisticsEXT(
+	FAudio *audio,
+	const FAudioWaveFormatEx *pSourceFormat,
+	uint32_t Flags,
+	float MaxFrequencyRatio,
+	FAudioSourceVoicePoolStatisticsEXT *pStatistics
+);
+
+/* FAudio Resampler Quality API
+ * See "extensions/ResamplerQualityEXT.txt" for more information.
+ */
+
+#define FAUDIO_RESAMPLER_QUALITY_LINEAR	0
+#define FAUDIO_RESAMPLER_QUALITY_SINC	1
+
+FAUDIOAPI uint32_t FAudio_SetResamplerQualityEXT(
+	FAudio *audio,
+	uint32_t Quality
+);
+FAUDIOAPI void FAudio_GetResamplerQualityEXT(
+	FAudio *audio,
+	uint32_t *pQuality
+);
+FAUDIOAPI uint32_t FAudioSourceVoice_SetResamplerQualityEXT(
+	FAudioSourceVoice *voice,
+	uint32_t Quality
+);
+FAUDIOAPI void FAudioSourceVoice_GetResamplerQualityEXT(
+	FAudioSourceVoice *voice,
+	uint32_t *pQuality
+);
+
+/* FAudio Decode Statistics API
+ * See "extensions/DecodeStatisticsEXT.txt" for more information.
+ */
+
+typedef struct FAudioDecodeStatisticsEXT
+{
+	uint32_t MSADPCMBlocksDecoded;		/* Blocks decoded in the last update */
+	uint32_t MSADPCMBlocksReused;		/* Block reads served by a voice's cache */
+	uint64_t TotalMSADPCMBlocksDecoded;	/* Since the engine was created */
+	uint32_t PCMCacheHits;			/* Buffers found in the PCM cache */
+	uint32_t PCMCacheMisses;		/* Buffers that had to be decoded */
+	uint32_t PCMCacheEvictions;		/* Entries dropped to fit the budget */
+	uint32_t PCMCacheEntries;		/* Buffers in the PCM cache right now */
+	uint32_t PCMCacheBytes;			/* Memory used by those buffers */
+} FAudioDecodeStatisticsEXT;
+
+FAUDIOAPI void FAudio_GetDecodeStatisticsEXT(
+	FAudio *audio,
+	FAudioDecodeStatisticsEXT *pStatistics
+);
+
+/* FAudio PCM Cache API
+ * See "extensions/PCMCacheEXT.txt" for more information.
+ */
+
+#define FAUDIO_BUFFER_CACHEABLE_EXT	0x00010000
+
+FAUDIOAPI uint32_t FAudio_SetPCMCacheBudgetEXT(
+	FAudio *audio,
+	uint32_t BudgetBytes
+);
+
+FAUDIOAPI void FAudio_GetPCMCacheBudgetEXT(
+	FAudio *audio,
+	uint32_t *pBudgetBytes
+);
+
+FAUDIOAPI void FAudio_InvalidatePCMCacheEXT(
+	FAudio *audio,
+	const void *pData,
+	uint32_t DataBytes
+);
+
+/* FAudio Quantum Size API
+ * See "extensions/QuantumSizeEXT.txt" for more information.
+ */
+
+#define FAUDIO_MIN_QUANTUM_FRAMES	16
+#define FAUDIO_MAX_QUANTUM_FRAMES	32768
+
+FAUDIOAPI uint32_t FAudio_SetQuantumSizeEXT(
+	FAudio *audio,
+	uint32_t QuantumFrames
+);
+
+FAUDIOAPI void FAudio_GetQuantumSizeEXT(
+	FAudio *audio,
+	uint32_t *pQuantumFrames
+);
+
+/* FAudio Headless API
+ * See "extensions/HeadlessEXT.txt" for more information.
+ */
+
+#define FAUDIO_HEADLESS_NONE_EXT	0	/* Output to an audio device */
+#define FAUDIO_HEADLESS_NULL_EXT	1	/* Render and throw the output away */
+#define FAUDIO_HEADLESS_WAV_EXT		2	/* Render to a float32 WAV file */
+#define FAUDIO_HEADLESS_RAW_EXT		3	/* Render to a raw float32 file */
+#define FAUDIO_HEADLESS_MANUAL_EXT	4	/* Only render with FAudio_RenderEXT */
+
+FAUDIOAPI uint32_t FAudio_SetHeadlessModeEXT(
+	FAudio *audio,
+	uint32_t Mode,
+	const char *pPath
+);
+
+FAUDIOAPI void FAudio_GetHeadlessModeEXT(
+	FAudio *audio,
+	uint32_t *pMode
+);
+
+/* FAudio Render API
+ * See "extensions/RenderEXT.txt" for more information.
+ */
+
+#define FAUDIO_RENDER_FLOAT32_EXT	0
+#define FAUDIO_RENDER_INT16_EXT		1
+#define FAUDIO_RENDER_INT16_DITHER_EXT	2
+
+FAUDIOAPI uint32_t FAudio_RenderEXT(
+	FAudio *audio,
+	void *pBuffer,
+	uint32_t Frames,
+	uint32_t Format
+);
 
 /* FAudio I/O API */
 
@@ -1271,6 +1271,18 @@ uint32_t FACTWaveBank_Destroy(FACTWaveBank *pWaveBank)
 		}
 	}
 
+	/* The client is free to release the memory after this. Every entry
+	 * lives in the wave data segment, so one call covers all of them.
+	 */
+	if (!pWaveBank->streaming)
+	{
+		FAudio_InvalidatePCMCacheEXT(
+			pWaveBank->parentEngine->audio,
+			FAudio_memptr(pWaveBank->io, pWaveBank->waveDataOffset),
+			pWaveBank->waveDataLength
+		);
+	}
+
 	if (pWaveBank->parentEngine != NULL)
 	{
 		/* Remove this WaveBank from the Engine list */
@@ -1585,7 +1597,8 @@ uint32_t FACTWaveBank_Prepare(
 	{
 		(*ppWave)->streamCache = NULL;
 
-		buffer.Flags = FAUDIO_END_OF_STREAM;
+		/* In-memory banks are immutable until they're destroyed */
+		buffer.Flags = FAUDIO_END_OF_STREAM | FAUDIO_BUFFER_CACHEABLE_EXT;
 		buffer.AudioBytes = entry->PlayRegion.dwLength;
 		buffer.pAudioData = FAudio_memptr(
 			pWaveBank->io,
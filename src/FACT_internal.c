@@ -2882,6 +2882,10 @@ uint32_t FACT_INTERNAL_ParseWaveBank(
 	/* FIXME: How much do we care about this? */
 	FAudio_assert(wb->streaming == isStreaming);
 	wb->streaming = isStreaming;
+	wb->waveDataOffset =
+		header.Segments[FACT_WAVEBANK_SEGIDX_ENTRYWAVEDATA].dwOffset;
+	wb->waveDataLength =
+		header.Segments[FACT_WAVEBANK_SEGIDX_ENTRYWAVEDATA].dwLength;
 
 	/* WaveBank Entry Metadata */
 	SEEKSET(header.Segments[FACT_WAVEBANK_SEGIDX_ENTRYMETADATA].dwOffset)
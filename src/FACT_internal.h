@@ -461,6 +461,10 @@ struct FACTWaveBank
 	/* I/O information */
 	uint16_t streaming;
 	void* io;
+
+	/* Where every entry's wave data lives, relative to io */
+	uint32_t waveDataOffset;
+	uint32_t waveDataLength;
 };
 
 struct FACTWave
@@ -114,9 +114,18 @@ uint32_t FAudioCOMConstructWithCustomAllocatorEXT(
 	LOG_MUTEX_CREATE((*ppFAudio), (*ppFAudio)->submixLock)
 	(*ppFAudio)->callbackLock = FAudio_PlatformCreateMutex();
 	LOG_MUTEX_CREATE((*ppFAudio), (*ppFAudio)->callbackLock)
+	(*ppFAudio)->operationLock = FAudio_PlatformCreateMutex();
+	LOG_MUTEX_CREATE((*ppFAudio), (*ppFAudio)->operationLock)
+	(*ppFAudio)->voicePoolLock = FAudio_PlatformCreateMutex();
+	LOG_MUTEX_CREATE((*ppFAudio), (*ppFAudio)->voicePoolLock)
+	(*ppFAudio)->pcmCacheLock = FAudio_PlatformCreateMutex();
+	LOG_MUTEX_CREATE((*ppFAudio), (*ppFAudio)->pcmCacheLock)
 	(*ppFAudio)->pMalloc = customMalloc;
 	(*ppFAudio)->pFree = customFree;
 	(*ppFAudio)->pRealloc = customRealloc;
+	(*ppFAudio)->mixDone = FAudio_PlatformCreateSemaphore(0);
+	(*ppFAudio)->perfQueryTime = FAudio_timecounter();
+	FAudio_INTERNAL_SetMixWorkerCount(*ppFAudio, 1);
 	(*ppFAudio)->refcount = 1;
 	return 0;
 }
@@ -138,15 +147,36 @@ uint32_t FAudio_Release(FAudio *audio)
 	if (audio->refcount == 0)
 	{
 		FAudio_StopEngine(audio);
-		audio->pFree(audio->decodeCache);
-		audio->pFree(audio->resampleCache);
-		audio->pFree(audio->effectChainCache);
+		FAudio_OPERATIONSET_ClearAll(audio);
+		FAudio_VOICEPOOL_DestroyAll(audio);
+		FAudio_INTERNAL_SetMixWorkerCount(audio, 0);
+		FAudio_PlatformDestroySemaphore(audio->mixDone);
+		FAudio_INTERNAL_FreeRenderPlan(audio);
+		if (audio->sincTable != NULL)
+		{
+			audio->pFree(audio->sincTable);
+		}
+		FAudio_INTERNAL_FreePCMCache(audio);
+		if (audio->headlessPath != NULL)
+		{
+			audio->pFree(audio->headlessPath);
+		}
+		if (audio->renderCache != NULL)
+		{
+			audio->pFree(audio->renderCache);
+		}
 		LOG_MUTEX_DESTROY(audio, audio->sourceLock)
 		FAudio_PlatformDestroyMutex(audio->sourceLock);
 		LOG_MUTEX_DESTROY(audio, audio->submixLock)
 		FAudio_PlatformDestroyMutex(audio->submixLock);
 		LOG_MUTEX_DESTROY(audio, audio->callbackLock)
 		FAudio_PlatformDestroyMutex(audio->callbackLock);
+		LOG_MUTEX_DESTROY(audio, audio->operationLock)
+		FAudio_PlatformDestroyMutex(audio->operationLock);
+		LOG_MUTEX_DESTROY(audio, audio->voicePoolLock)
+		FAudio_PlatformDestroyMutex(audio->voicePoolLock);
+		LOG_MUTEX_DESTROY(audio, audio->pcmCacheLock)
+		FAudio_PlatformDestroyMutex(audio->pcmCacheLock);
 		audio->pFree(audio);
 		FAudio_PlatformRelease();
 	}
@@ -181,15 +211,75 @@ uint32_t FAudio_Initialize(
 	uint32_t Flags,
 	FAudioProcessor XAudio2Processor
 ) {
+	const char *env, *path;
+
 	LOG_API_ENTER(audio)
 	FAudio_assert(Flags == 0);
 	FAudio_assert(XAudio2Processor == FAUDIO_DEFAULT_PROCESSOR);
 
-	/* FIXME: This is lazy... */
-	audio->decodeCache = (float*) audio->pMalloc(sizeof(float));
-	audio->resampleCache = (float*) audio->pMalloc(sizeof(float));
-	audio->decodeSamples = 1;
-	audio->resampleSamples = 1;
+	/* Parallel mixing is opt-in, see MixThreadsEXT */
+	env = FAudio_getenv("FAUDIO_MIX_THREADS");
+	if (env != NULL && FAudio_atoi(env) > 0)
+	{
+		FAudio_SetMixThreadCountEXT(audio, FAudio_atoi(env));
+	}
+
+	/* So is the sinc resampler, see ResamplerQualityEXT */
+	env = FAudio_getenv("FAUDIO_RESAMPLER");
+	if (env != NULL && FAudio_strcmp(env, "sinc") == 0)
+	{
+		FAudio_SetResamplerQualityEXT(
+			audio,
+			FAUDIO_RESAMPLER_QUALITY_SINC
+		);
+	}
+
+	/* The quantum follows the device unless asked otherwise. Values
+	 * outside of the allowed range are rejected, leaving the default.
+	 */
+	env = FAudio_getenv("FAUDIO_QUANTUM_FRAMES");
+	if (env != NULL && FAudio_atoi(env) > 0)
+	{
+		FAudio_SetQuantumSizeEXT(audio, FAudio_atoi(env));
+	}
+
+	/* Build agents and offline renders may not want a device at all */
+	env = FAudio_getenv("FAUDIO_HEADLESS");
+	if (env != NULL)
+	{
+		path = FAudio_getenv("FAUDIO_HEADLESS_PATH");
+		if (FAudio_strcmp(env, "null") == 0)
+		{
+			FAudio_SetHeadlessModeEXT(
+				audio,
+				FAUDIO_HEADLESS_NULL_EXT,
+				NULL
+			);
+		}
+		else if (FAudio_strcmp(env, "wav") == 0)
+		{
+			FAudio_SetHeadlessModeEXT(
+				audio,
+				FAUDIO_HEADLESS_WAV_EXT,
+				(path != NULL) ? path : "FAudio.wav"
+			);
+		}
+		else if (FAudio_strcmp(env, "raw") == 0)
+		{
+			FAudio_SetHeadlessModeEXT(
+				audio,
+				FAUDIO_HEADLESS_RAW_EXT,
+				(path != NULL) ? path : "FAudio.raw"
+			);
+		}
+	}
+
+	/* And sharing decoded buffers, see PCMCacheEXT */
+	env = FAudio_getenv("FAUDIO_PCM_CACHE_KB");
+	if (env != NULL && FAudio_atoi(env) > 0)
+	{
+		FAudio_SetPCMCacheBudgetEXT(audio, FAudio_atoi(env) * 1024);
+	}
 
 	FAudio_StartEngine(audio);
 	LOG_API_EXIT(audio)
@@ -236,10 +326,29 @@ uint32_t FAudio_CreateSourceVoice(
 	const FAudioEffectChain *pEffectChain
 ) {
 	uint32_t i;
+	FAudioSourceVoicePool *pool = NULL;
 
 	LOG_API_ENTER(audio)
 	LOG_FORMAT(audio, pSourceFormat);
 
+	/* Try for a recycled voice first, see SourceVoicePoolEXT */
+	if (	pEffectChain == NULL &&
+		FAudio_VOICEPOOL_Acquire(
+			audio,
+			ppSourceVoice,
+			pSourceFormat,
+			Flags,
+			MaxFrequencyRatio,
+			pCallback,
+			pSendList,
+			&pool
+		)	)
+	{
+		LOG_INFO(audio, "-> %p (pooled)", *ppSourceVoice);
+		LOG_API_EXIT(audio)
+		return 0;
+	}
+
 	*ppSourceVoice = (FAudioSourceVoice*) audio->pMalloc(sizeof(FAudioVoice));
 	FAudio_zero(*ppSourceVoice, sizeof(FAudioSourceVoice));
 	(*ppSourceVoice)->audio = audio;
@@ -314,9 +423,7 @@ uint32_t FAudio_CreateSourceVoice(
 	(*ppSourceVoice)->src.active = 0;
 	(*ppSourceVoice)->src.freqRatio = 1.0f;
 	(*ppSourceVoice)->src.totalSamples = 0;
-	(*ppSourceVoice)->src.bufferList = NULL;
-	(*ppSourceVoice)->src.bufferLock = FAudio_PlatformCreateMutex();
-	LOG_MUTEX_CREATE(audio, (*ppSourceVoice)->src.bufferLock);
+	FAudio_INTERNAL_AllocBufferQueue(*ppSourceVoice);
 
 	if ((*ppSourceVoice)->src.format->wFormatTag == FAUDIO_FORMAT_EXTENSIBLE)
 	{
@@ -392,30 +499,37 @@ uint32_t FAudio_CreateSourceVoice(
 		(*ppSourceVoice)->src.decode = ((*ppSourceVoice)->src.format->nChannels == 2) ?
 			FAudio_INTERNAL_DecodeStereoMSADPCM :
 			FAudio_INTERNAL_DecodeMonoMSADPCM;
+
+		/* Two decoded blocks, (nBlockAlign - 6 * nChannels) * 2 samples each */
+		(*ppSourceVoice)->src.msadpcmCache = (int16_t*) audio->pMalloc(
+			sizeof(int16_t) * 4 * (
+				(*ppSourceVoice)->src.format->nBlockAlign -
+				(6 * (*ppSourceVoice)->src.format->nChannels)
+			)
+		);
 	}
 	else
 	{
 		FAudio_assert(0 && "Unsupported format tag!");
 	}
 
-	if ((*ppSourceVoice)->src.format->nChannels == 1)
-	{
-		(*ppSourceVoice)->src.resample = FAudio_INTERNAL_ResampleMono;
-	}
-	else if ((*ppSourceVoice)->src.format->nChannels == 2)
-	{
-		(*ppSourceVoice)->src.resample = FAudio_INTERNAL_ResampleStereo;
-	}
-	else
+	/* The step isn't known until the first update, which picks again */
+	(*ppSourceVoice)->src.resample = FAudio_INTERNAL_GetResampler(
+		(*ppSourceVoice)->src.resampleStep,
+		(*ppSourceVoice)->src.format->nChannels
+	);
+	if (audio->resamplerQuality != FAUDIO_RESAMPLER_QUALITY_LINEAR)
 	{
-		(*ppSourceVoice)->src.resample = FAudio_INTERNAL_ResampleGeneric;
+		FAudio_INTERNAL_SetResamplerQuality(
+			*ppSourceVoice,
+			audio->resamplerQuality
+		);
 	}
 
 	(*ppSourceVoice)->src.curBufferOffset = 0;
 
-	/* Sends/Effects */
+	/* Effects, which decide the output channel count */
 	FAudioVoice_SetEffectChain(*ppSourceVoice, pEffectChain);
-	FAudioVoice_SetOutputVoices(*ppSourceVoice, pSendList);
 
 	/* Default Levels */
 	(*ppSourceVoice)->volume = 1.0f;
@@ -427,6 +541,9 @@ uint32_t FAudio_CreateSourceVoice(
 		(*ppSourceVoice)->channelVolume[i] = 1.0f;
 	}
 
+	/* Sends, which also set up the mixer's copy of the levels */
+	FAudioVoice_SetOutputVoices(*ppSourceVoice, pSendList);
+
 	/* Filters */
 	if (Flags & FAUDIO_VOICE_USEFILTER)
 	{
@@ -453,6 +570,12 @@ uint32_t FAudio_CreateSourceVoice(
 
 	LOG_INFO(audio, "-> %p", *ppSourceVoice);
 
+	/* The pool was empty, so this voice joins it */
+	if (pool != NULL)
+	{
+		FAudio_VOICEPOOL_AddVoice(pool, *ppSourceVoice);
+	}
+
 	/* Add to list, finally. */
 	LinkedList_PrependEntry(
 		&audio->sources,
@@ -466,6 +589,32 @@ uint32_t FAudio_CreateSourceVoice(
 	return 0;
 }
 
+/* Submixes of one processing stage are mixed at the same time, so a submix may
+ * only send to submixes of a later stage.
+ */
+static uint8_t FAudio_INTERNAL_ValidSubmixSends(
+	uint32_t processingStage,
+	const FAudioVoiceSends *pSendList
+) {
+	uint32_t i;
+	FAudioVoice *out;
+
+	if (pSendList == NULL)
+	{
+		return 1;
+	}
+	for (i = 0; i < pSendList->SendCount; i += 1)
+	{
+		out = pSendList->pSends[i].pOutputVoice;
+		if (	out->type == FAUDIO_VOICE_SUBMIX &&
+			out->mix.processingStage <= processingStage	)
+		{
+			return 0;
+		}
+	}
+	return 1;
+}
+
 uint32_t FAudio_CreateSubmixVoice(
 	FAudio *audio,
 	FAudioSubmixVoice **ppSubmixVoice,
@@ -480,6 +629,17 @@ uint32_t FAudio_CreateSubmixVoice(
 
 	LOG_API_ENTER(audio)
 
+	if (!FAudio_INTERNAL_ValidSubmixSends(ProcessingStage, pSendList))
+	{
+		LOG_ERROR(
+			audio,
+			"%s",
+			"Submix sends must go to a later processing stage"
+		)
+		LOG_API_EXIT(audio)
+		return FAUDIO_E_INVALID_CALL;
+	}
+
 	*ppSubmixVoice = (FAudioSubmixVoice*) audio->pMalloc(sizeof(FAudioVoice));
 	FAudio_zero(*ppSubmixVoice, sizeof(FAudioSubmixVoice));
 	(*ppSubmixVoice)->audio = audio;
@@ -508,17 +668,25 @@ uint32_t FAudio_CreateSubmixVoice(
 		(double) InputSampleRate /
 		(double) audio->master->master.inputSampleRate
 	) * InputChannels;
+	/* The resamplers read one frame past the end of the update. Nothing
+	 * ever writes to the padding, so that frame is always silent.
+	 */
 	(*ppSubmixVoice)->mix.inputCache = (float*) audio->pMalloc(
-		sizeof(float) * (*ppSubmixVoice)->mix.inputSamples
+		sizeof(float) * (
+			(*ppSubmixVoice)->mix.inputSamples +
+			EXTRA_DECODE_PADDING * InputChannels
+		)
 	);
 	FAudio_zero( /* Zero this now, for the first update */
 		(*ppSubmixVoice)->mix.inputCache,
-		sizeof(float) * (*ppSubmixVoice)->mix.inputSamples
+		sizeof(float) * (
+			(*ppSubmixVoice)->mix.inputSamples +
+			EXTRA_DECODE_PADDING * InputChannels
+		)
 	);
 
-	/* Sends/Effects */
+	/* Effects, which decide the output channel count */
 	FAudioVoice_SetEffectChain(*ppSubmixVoice, pEffectChain);
-	FAudioVoice_SetOutputVoices(*ppSubmixVoice, pSendList);
 
 	/* Default Levels */
 	(*ppSubmixVoice)->volume = 1.0f;
@@ -530,6 +698,9 @@ uint32_t FAudio_CreateSubmixVoice(
 		(*ppSubmixVoice)->channelVolume[i] = 1.0f;
 	}
 
+	/* Sends, which also set up the mixer's copy of the levels */
+	FAudioVoice_SetOutputVoices(*ppSubmixVoice, pSendList);
+
 	/* Filters */
 	if (Flags & FAUDIO_VOICE_USEFILTER)
 	{
@@ -542,6 +713,9 @@ uint32_t FAudio_CreateSubmixVoice(
 		);
 	}
 
+	/* Accumulation for mix workers */
+	FAudio_INTERNAL_AllocWorkerCaches(*ppSubmixVoice);
+
 	/* Add to list, finally. */
 	FAudio_INTERNAL_InsertSubmixSorted(
 		&audio->submixes,
@@ -549,6 +723,7 @@ uint32_t FAudio_CreateSubmixVoice(
 		audio->submixLock,
 		audio->pMalloc
 	);
+	FAudio_INTERNAL_InvalidateRenderPlan(audio, FAUDIO_VOICE_SUBMIX);
 	FAudio_AddRef(audio);
 
 	LOG_API_EXIT(audio)
@@ -596,6 +771,10 @@ uint32_t FAudio_CreateMasteringVoice(
 	/* Sends/Effects */
 	FAudio_zero(&(*ppMasteringVoice)->sends, sizeof(FAudioVoiceSends));
 	FAudioVoice_SetEffectChain(*ppMasteringVoice, pEffectChain);
+	FAudio_INTERNAL_AllocParameters(*ppMasteringVoice);
+
+	/* Accumulation for mix workers, filled in lazily */
+	FAudio_INTERNAL_AllocWorkerCaches(*ppMasteringVoice);
 
 	/* Platform Device */
 	audio->master = *ppMasteringVoice;
@@ -674,10 +853,377 @@ void FAudio_SetEngineProcedureEXT(
 	LOG_API_EXIT(audio)
 }
 
+uint32_t FAudio_SetMixThreadCountEXT(FAudio *audio, uint32_t threadCount)
+{
+	LOG_API_ENTER(audio)
+
+	if (threadCount == 0)
+	{
+		LOG_API_EXIT(audio)
+		return FAUDIO_E_INVALID_CALL;
+	}
+	threadCount = FAudio_min(threadCount, MAX_MIX_WORKERS);
+
+	/* The mixer only touches the workers with these held. sourceLock comes
+	 * first, since voice callbacks may call into submixes while holding it.
+	 */
+	FAudio_PlatformLockMutex(audio->sourceLock);
+	LOG_MUTEX_LOCK(audio, audio->sourceLock)
+	FAudio_PlatformLockMutex(audio->submixLock);
+	LOG_MUTEX_LOCK(audio, audio->submixLock)
+	FAudio_INTERNAL_SetMixWorkerCount(audio, threadCount);
+	FAudio_PlatformUnlockMutex(audio->submixLock);
+	LOG_MUTEX_UNLOCK(audio, audio->submixLock)
+	FAudio_PlatformUnlockMutex(audio->sourceLock);
+	LOG_MUTEX_UNLOCK(audio, audio->sourceLock)
+
+	LOG_API_EXIT(audio)
+	return 0;
+}
+
+void FAudio_GetMixThreadCountEXT(FAudio *audio, uint32_t *pThreadCount)
+{
+	LOG_API_ENTER(audio)
+	*pThreadCount = audio->mixWorkerCount;
+	LOG_API_EXIT(audio)
+}
+
+uint32_t FAudio_CreateSourceVoicePoolEXT(
+	FAudio *audio,
+	const FAudioWaveFormatEx *pSourceFormat,
+	uint32_t Flags,
+	float MaxFrequencyRatio,
+	uint32_t VoiceCount
+) {
+	uint32_t result;
+	LOG_API_ENTER(audio)
+	LOG_FORMAT(audio, pSourceFormat);
+	result = FAudio_VOICEPOOL_Create(
+		audio,
+		pSourceFormat,
+		Flags,
+		MaxFrequencyRatio,
+		VoiceCount
+	);
+	LOG_API_EXIT(audio)
+	return result;
+}
+
+uint32_t FAudio_GetSourceVoicePoolStatisticsEXT(
+	FAudio *audio,
+	const FAudioWaveFormatEx *pSourceFormat,
+	uint32_t Flags,
+	float MaxFrequencyRatio,
+	FAudioSourceVoicePoolStatisticsEXT *pStatistics
+) {
+	uint32_t result;
+	LOG_API_ENTER(audio)
+	result = FAudio_VOICEPOOL_GetStatistics(
+		audio,
+		pSourceFormat,
+		Flags,
+		MaxFrequencyRatio,
+		pStatistics
+	);
+	LOG_API_EXIT(audio)
+	return result;
+}
+
+uint32_t FAudio_SetResamplerQualityEXT(FAudio *audio, uint32_t Quality)
+{
+	LOG_API_ENTER(audio)
+	if (Quality > FAUDIO_RESAMPLER_QUALITY_SINC)
+	{
+		LOG_API_EXIT(audio)
+		return FAUDIO_E_INVALID_CALL;
+	}
+	audio->resamplerQuality = Quality;
+	LOG_API_EXIT(audio)
+	return 0;
+}
+
+void FAudio_GetResamplerQualityEXT(FAudio *audio, uint32_t *pQuality)
+{
+	LOG_API_ENTER(audio)
+	*pQuality = audio->resamplerQuality;
+	LOG_API_EXIT(audio)
+}
+
+void FAudio_GetDecodeStatisticsEXT(
+	FAudio *audio,
+	FAudioDecodeStatisticsEXT *pStatistics
+) {
+	LOG_API_ENTER(audio)
+	/* Updated by the mixer under sourceLock */
+	FAudio_PlatformLockMutex(audio->sourceLock);
+	LOG_MUTEX_LOCK(audio, audio->sourceLock)
+	*pStatistics = audio->decodeStats;
+	FAudio_PlatformUnlockMutex(audio->sourceLock);
+	LOG_MUTEX_UNLOCK(audio, audio->sourceLock)
+
+	FAudio_PlatformLockMutex(audio->pcmCacheLock);
+	LOG_MUTEX_LOCK(audio, audio->pcmCacheLock)
+	pStatistics->PCMCacheHits = audio->pcmCacheHits;
+	pStatistics->PCMCacheMisses = audio->pcmCacheMisses;
+	pStatistics->PCMCacheEvictions = audio->pcmCacheEvictions;
+	pStatistics->PCMCacheEntries = audio->pcmCacheEntries;
+	pStatistics->PCMCacheBytes = audio->pcmCacheUsed;
+	FAudio_PlatformUnlockMutex(audio->pcmCacheLock);
+	LOG_MUTEX_UNLOCK(audio, audio->pcmCacheLock)
+	LOG_API_EXIT(audio)
+}
+
+uint32_t FAudio_SetPCMCacheBudgetEXT(FAudio *audio, uint32_t BudgetBytes)
+{
+	LOG_API_ENTER(audio)
+	FAudio_PlatformLockMutex(audio->pcmCacheLock);
+	LOG_MUTEX_LOCK(audio, audio->pcmCacheLock)
+	audio->pcmCacheBudget = BudgetBytes;
+	FAudio_INTERNAL_TrimPCMCache(audio, 0);
+	FAudio_PlatformUnlockMutex(audio->pcmCacheLock);
+	LOG_MUTEX_UNLOCK(audio, audio->pcmCacheLock)
+	LOG_API_EXIT(audio)
+	return 0;
+}
+
+void FAudio_GetPCMCacheBudgetEXT(FAudio *audio, uint32_t *pBudgetBytes)
+{
+	LOG_API_ENTER(audio)
+	FAudio_PlatformLockMutex(audio->pcmCacheLock);
+	LOG_MUTEX_LOCK(audio, audio->pcmCacheLock)
+	*pBudgetBytes = audio->pcmCacheBudget;
+	FAudio_PlatformUnlockMutex(audio->pcmCacheLock);
+	LOG_MUTEX_UNLOCK(audio, audio->pcmCacheLock)
+	LOG_API_EXIT(audio)
+}
+
+void FAudio_InvalidatePCMCacheEXT(
+	FAudio *audio,
+	const void *pData,
+	uint32_t DataBytes
+) {
+	LOG_API_ENTER(audio)
+	FAudio_PlatformLockMutex(audio->pcmCacheLock);
+	LOG_MUTEX_LOCK(audio, audio->pcmCacheLock)
+	FAudio_INTERNAL_InvalidatePCMCache(
+		audio,
+		(const uint8_t*) pData,
+		DataBytes
+	);
+	FAudio_PlatformUnlockMutex(audio->pcmCacheLock);
+	LOG_MUTEX_UNLOCK(audio, audio->pcmCacheLock)
+	LOG_API_EXIT(audio)
+}
+
+uint32_t FAudio_SetQuantumSizeEXT(FAudio *audio, uint32_t QuantumFrames)
+{
+	LOG_API_ENTER(audio)
+
+	/* Everything is sized off of the quantum once the master exists */
+	if (audio->master != NULL)
+	{
+		LOG_ERROR(
+			audio,
+			"%s",
+			"Quantum size must be set before creating the mastering voice"
+		)
+		LOG_API_EXIT(audio)
+		return FAUDIO_E_INVALID_CALL;
+	}
+
+	/* The device buffer size is 16-bit, and the caches grow with this */
+	if (	QuantumFrames != 0 &&
+		(QuantumFrames < FAUDIO_MIN_QUANTUM_FRAMES ||
+		QuantumFrames > FAUDIO_MAX_QUANTUM_FRAMES)	)
+	{
+		LOG_ERROR(
+			audio,
+			"Quantum size %u is out of range",
+			QuantumFrames
+		)
+		LOG_API_EXIT(audio)
+		return FAUDIO_E_INVALID_CALL;
+	}
+	audio->quantumSize = QuantumFrames;
+
+	LOG_API_EXIT(audio)
+	return 0;
+}
+
+void FAudio_GetQuantumSizeEXT(FAudio *audio, uint32_t *pQuantumFrames)
+{
+	LOG_API_ENTER(audio)
+	*pQuantumFrames = (audio->master != NULL) ?
+		audio->updateSize :
+		audio->quantumSize;
+	LOG_API_EXIT(audio)
+}
+
+uint32_t FAudio_SetHeadlessModeEXT(
+	FAudio *audio,
+	uint32_t Mode,
+	const char *pPath
+) {
+	size_t len;
+	LOG_API_ENTER(audio)
+
+	/* The platform picks its output when the master is created */
+	if (audio->master != NULL)
+	{
+		LOG_ERROR(
+			audio,
+			"%s",
+			"Headless mode must be set before creating the mastering voice"
+		)
+		LOG_API_EXIT(audio)
+		return FAUDIO_E_INVALID_CALL;
+	}
+	if (	Mode > FAUDIO_HEADLESS_MANUAL_EXT ||
+		(	(Mode == FAUDIO_HEADLESS_WAV_EXT || Mode == FAUDIO_HEADLESS_RAW_EXT) &&
+			pPath == NULL	)	)
+	{
+		LOG_ERROR(
+			audio,
+			"Invalid headless mode %u",
+			Mode
+		)
+		LOG_API_EXIT(audio)
+		return FAUDIO_E_INVALID_CALL;
+	}
+
+	if (audio->headlessPath != NULL)
+	{
+		audio->pFree(audio->headlessPath);
+		audio->headlessPath = NULL;
+	}
+	if (Mode == FAUDIO_HEADLESS_WAV_EXT || Mode == FAUDIO_HEADLESS_RAW_EXT)
+	{
+		len = FAudio_strlen(pPath) + 1;
+		audio->headlessPath = (char*) audio->pMalloc(len);
+		FAudio_memcpy(audio->headlessPath, pPath, len);
+	}
+	audio->headlessMode = Mode;
+
+	LOG_API_EXIT(audio)
+	return 0;
+}
+
+void FAudio_GetHeadlessModeEXT(FAudio *audio, uint32_t *pMode)
+{
+	LOG_API_ENTER(audio)
+	*pMode = audio->headlessMode;
+	LOG_API_EXIT(audio)
+}
+
+/* Triangular (TPDF) dither, one LSB either way. The generator is a plain
+ * LCG, which is plenty for noise and keeps renders reproducible.
+ */
+static void FAudio_INTERNAL_Dither(
+	float *samples,
+	uint32_t len,
+	uint32_t *seed
+) {
+	uint32_t i, state = *seed;
+	float noise;
+	for (i = 0; i < len; i += 1)
+	{
+		state = state * 1664525 + 1013904223;
+		noise = (float) (state >> 8);
+		state = state * 1664525 + 1013904223;
+		noise -= (float) (state >> 8);
+		samples[i] += noise * (1.0f / 16777216.0f / 32768.0f);
+	}
+	*seed = state;
+}
+
+uint32_t FAudio_RenderEXT(
+	FAudio *audio,
+	void *pBuffer,
+	uint32_t Frames,
+	uint32_t Format
+) {
+	uint32_t channels, samples, chunk;
+	int16_t *output;
+	LOG_API_ENTER(audio)
+
+	if (	audio->master == NULL ||
+		audio->headlessMode != FAUDIO_HEADLESS_MANUAL_EXT ||
+		Format > FAUDIO_RENDER_INT16_DITHER_EXT	)
+	{
+		LOG_ERROR(
+			audio,
+			"%s",
+			"RenderEXT needs a MANUAL mastering voice and a valid format"
+		)
+		LOG_API_EXIT(audio)
+		return FAUDIO_E_INVALID_CALL;
+	}
+	channels = audio->master->outputChannels;
+
+	/* A stopped engine just plays silence, like a device would */
+	if (!audio->active)
+	{
+		FAudio_zero(
+			pBuffer,
+			Frames * channels * ((Format == FAUDIO_RENDER_FLOAT32_EXT) ?
+				sizeof(float) :
+				sizeof(int16_t))
+		);
+		LOG_API_EXIT(audio)
+		return 0;
+	}
+
+	if (Format == FAUDIO_RENDER_FLOAT32_EXT)
+	{
+		FAudio_zero(pBuffer, Frames * channels * sizeof(float));
+		FAudio_INTERNAL_RenderFrames(audio, (float*) pBuffer, Frames);
+		LOG_API_EXIT(audio)
+		return 0;
+	}
+
+	/* Integer output goes through renderCache, one update at a time */
+	samples = audio->updateSize * channels;
+	if (audio->renderCacheSamples < samples)
+	{
+		audio->renderCache = (float*) audio->pRealloc(
+			audio->renderCache,
+			sizeof(float) * samples
+		);
+		audio->renderCacheSamples = samples;
+	}
+	output = (int16_t*) pBuffer;
+	while (Frames > 0)
+	{
+		chunk = FAudio_min(Frames, audio->updateSize);
+		samples = chunk * channels;
+		FAudio_zero(audio->renderCache, samples * sizeof(float));
+		FAudio_INTERNAL_RenderFrames(audio, audio->renderCache, chunk);
+		if (Format == FAUDIO_RENDER_INT16_DITHER_EXT)
+		{
+			FAudio_INTERNAL_Dither(
+				audio->renderCache,
+				samples,
+				&audio->ditherSeed
+			);
+		}
+		FAudio_INTERNAL_Convert_F32_To_S16(
+			audio->renderCache,
+			output,
+			samples
+		);
+		output += samples;
+		Frames -= chunk;
+	}
+
+	LOG_API_EXIT(audio)
+	return 0;
+}
+
 uint32_t FAudio_StartEngine(FAudio *audio)
 {
 	LOG_API_ENTER(audio)
 	audio->active = 1;
+	FAudio_PlatformStartEngine(audio);
 	LOG_API_EXIT(audio)
 	return 0;
 }
@@ -689,25 +1235,85 @@ void FAudio_StopEngine(FAudio *audio)
 	LOG_API_EXIT(audio)
 }
 
+uint32_t FAudio_CommitOperationSet(FAudio *audio, uint32_t OperationSet)
+{
+	LOG_API_ENTER(audio)
+	FAudio_OPERATIONSET_Commit(audio, OperationSet);
+	LOG_API_EXIT(audio)
+	return 0;
+}
+
 uint32_t FAudio_CommitChanges(FAudio *audio)
 {
 	LOG_API_ENTER(audio)
-	FAudio_assert(0 && "Batching is not supported!");
+	FAudio_OPERATIONSET_Commit(audio, FAUDIO_COMMIT_ALL);
 	LOG_API_EXIT(audio)
 	return 0;
 }
 
+/* What a voice holds on to, not counting its effects or the mixer's caches */
+static uint32_t FAudio_INTERNAL_GetVoiceMemory(FAudioVoice *voice)
+{
+	uint32_t bytes = sizeof(FAudioVoice);
+	if (voice->type == FAUDIO_VOICE_SOURCE)
+	{
+		bytes += sizeof(FAudioBufferEntry) * FAUDIO_MAX_QUEUED_BUFFERS;
+		bytes += sizeof(FAudioWaveFormatEx) + voice->src.format->cbSize;
+		if (voice->src.msadpcmCache != NULL)
+		{
+			bytes += sizeof(int16_t) * 4 * (
+				voice->src.format->nBlockAlign -
+				(6 * voice->src.format->nChannels)
+			);
+		}
+		if (voice->src.sincHistory != NULL)
+		{
+			bytes += sizeof(float) * SINC_HISTORY * voice->src.format->nChannels;
+		}
+		return bytes;
+	}
+
+	/* Submixes and the master can be sent to, so they have worker caches */
+	bytes += (sizeof(float*) + sizeof(uint32_t)) * MAX_MIX_WORKERS;
+	if (voice->type == FAUDIO_VOICE_SUBMIX)
+	{
+		bytes += sizeof(float) * voice->mix.inputSamples;
+	}
+	else if (voice->master.effectCache != NULL)
+	{
+		bytes += (
+			sizeof(float) *
+			voice->audio->updateSize *
+			voice->master.inputChannels
+		);
+	}
+	return bytes;
+}
+
 void FAudio_GetPerformanceData(
 	FAudio *audio,
 	FAudioPerformanceData *pPerfData
 ) {
 	LinkedList *list;
 	FAudioSourceVoice *source;
+	uint64_t now;
+	uint32_t memory;
 
 	LOG_API_ENTER(audio)
 
 	FAudio_zero(pPerfData, sizeof(FAudioPerformanceData));
 
+	/* The engine itself, and everything the mixer grew on its own */
+	memory = sizeof(FAudio);
+	memory += sizeof(FAudioMixWorker) * audio->mixWorkerCount;
+	memory += FAudio_PlatformAtomicGet(&audio->mixerCacheBytes);
+	if (audio->sincTable != NULL)
+	{
+		memory += sizeof(float) * SINC_TABLE_SIZE;
+	}
+	memory += sizeof(float) * audio->renderCacheSamples;
+
+	/* Voices, plus the timing the mixer adds up under sourceLock */
 	FAudio_PlatformLockMutex(audio->sourceLock);
 	LOG_MUTEX_LOCK(audio, audio->sourceLock)
 	list = audio->sources;
@@ -719,8 +1325,30 @@ void FAudio_GetPerformanceData(
 		{
 			pPerfData->ActiveSourceVoiceCount += 1;
 		}
+		memory += FAudio_INTERNAL_GetVoiceMemory(source);
 		list = list->next;
 	}
+	memory += sizeof(void*) * audio->plan.sourceCapacity;
+
+	now = FAudio_timecounter();
+	pPerfData->AudioCyclesSinceLastQuery = audio->perfAudioTime;
+	pPerfData->TotalCyclesSinceLastQuery = now - audio->perfQueryTime;
+	pPerfData->MinimumCyclesPerQuantum = (uint32_t) FAudio_min(
+		audio->perfMinQuantum,
+		UINT32_MAX
+	);
+	pPerfData->MaximumCyclesPerQuantum = (uint32_t) FAudio_min(
+		audio->perfMaxQuantum,
+		UINT32_MAX
+	);
+	pPerfData->GlitchesSinceEngineStarted = audio->perfGlitches;
+	pPerfData->ActiveResamplerCount = audio->perfResamplers;
+	pPerfData->ActiveMatrixMixCount = audio->perfMatrixMixes;
+	audio->perfQueryTime = now;
+	audio->perfAudioTime = 0;
+	audio->perfMinQuantum = 0;
+	audio->perfMaxQuantum = 0;
+	audio->perfQuanta = 0;
 	FAudio_PlatformUnlockMutex(audio->sourceLock);
 	LOG_MUTEX_UNLOCK(audio, audio->sourceLock)
 
@@ -730,16 +1358,40 @@ void FAudio_GetPerformanceData(
 	while (list != NULL)
 	{
 		pPerfData->ActiveSubmixVoiceCount += 1;
+		memory += FAudio_INTERNAL_GetVoiceMemory((FAudioVoice*) list->entry);
 		list = list->next;
 	}
+	memory += sizeof(void*) * audio->plan.submixCapacity;
+	memory += sizeof(uint32_t) * audio->plan.stageCapacity;
 	FAudio_PlatformUnlockMutex(audio->submixLock);
 	LOG_MUTEX_UNLOCK(audio, audio->submixLock)
 
+	FAudio_PlatformLockMutex(audio->pcmCacheLock);
+	LOG_MUTEX_LOCK(audio, audio->pcmCacheLock)
+	memory += audio->pcmCacheUsed;
+	FAudio_PlatformUnlockMutex(audio->pcmCacheLock);
+	LOG_MUTEX_UNLOCK(audio, audio->pcmCacheLock)
+
 	if (audio->master != NULL)
 	{
-		/* estimate, should use real latency from platform */
-		pPerfData->CurrentLatencyInSamples = 2 * audio->updateSize;
+		memory += FAudio_INTERNAL_GetVoiceMemory(audio->master);
+		if (audio->quantumCache != NULL)
+		{
+			memory += (
+				sizeof(float) *
+				audio->updateSize *
+				audio->master->outputChannels
+			);
+		}
+
+		/* What the device holds, plus the rest of a partial update */
+		pPerfData->CurrentLatencyInSamples = (
+			audio->platformLatency +
+			audio->updateSize -
+			audio->quantumOffset
+		);
 	}
+	pPerfData->MemoryUsageInBytes = memory;
 
 	LOG_API_EXIT(audio)
 }
@@ -822,6 +1474,17 @@ void FAudio_SetDebugConfiguration(
 
 /* FAudioVoice Interface */
 
+/* Changes to the shape of a voice (its sends, effect chain or sample rate) are
+ * made with the mixer locked out, so the mixer can read them without taking
+ * any of the voice's own locks. Always take this before the voice locks!
+ */
+static inline FAudioMutex FAudio_INTERNAL_GetMixLock(FAudioVoice *voice)
+{
+	return (voice->type == FAUDIO_VOICE_SOURCE) ?
+		voice->audio->sourceLock :
+		voice->audio->submixLock;
+}
+
 void FAudioVoice_GetVoiceDetails(
 	FAudioVoice *voice,
 	FAudioVoiceDetails *pVoiceDetails
@@ -865,6 +1528,7 @@ uint32_t FAudioVoice_SetOutputVoices(
 	uint64_t resampleSanityCheck;
 	FAudioVoiceSends defaultSends;
 	FAudioSendDescriptor defaultSend;
+	FAudioMutex mixLock;
 
 	LOG_API_ENTER(voice->audio)
 
@@ -873,7 +1537,24 @@ uint32_t FAudioVoice_SetOutputVoices(
 		LOG_API_EXIT(voice->audio)
 		return FAUDIO_E_INVALID_CALL;
 	}
+	if (	voice->type == FAUDIO_VOICE_SUBMIX &&
+		!FAudio_INTERNAL_ValidSubmixSends(
+			voice->mix.processingStage,
+			pSendList
+		)	)
+	{
+		LOG_ERROR(
+			voice->audio,
+			"%s",
+			"Submix sends must go to a later processing stage"
+		)
+		LOG_API_EXIT(voice->audio)
+		return FAUDIO_E_INVALID_CALL;
+	}
 
+	mixLock = FAudio_INTERNAL_GetMixLock(voice);
+	FAudio_PlatformLockMutex(mixLock);
+	LOG_MUTEX_LOCK(voice->audio, mixLock)
 	FAudio_PlatformLockMutex(voice->sendLock);
 	LOG_MUTEX_LOCK(voice->audio, voice->sendLock)
 
@@ -929,8 +1610,11 @@ uint32_t FAudioVoice_SetOutputVoices(
 		voice->sendFilter = NULL;
 		voice->sendFilterState = NULL;
 		FAudio_zero(&voice->sends, sizeof(FAudioVoiceSends));
+		FAudio_INTERNAL_AllocParameters(voice);
 		FAudio_PlatformUnlockMutex(voice->sendLock);
 		LOG_MUTEX_UNLOCK(voice->audio, voice->sendLock)
+		FAudio_PlatformUnlockMutex(mixLock);
+		LOG_MUTEX_UNLOCK(voice->audio, mixLock)
 
 		LOG_API_EXIT(voice->audio)
 		return 0;
@@ -980,51 +1664,51 @@ uint32_t FAudioVoice_SetOutputVoices(
 		{
 			if (outChannels == 1)
 			{
-				voice->sendMix[i] = FAudio_INTERNAL_Mix_1in_1out_Scalar;
+				voice->sendMix[i] = FAudio_INTERNAL_Mix_1in_1out;
 			}
 			else if (outChannels == 2)
 			{
-				voice->sendMix[i] = FAudio_INTERNAL_Mix_1in_2out_Scalar;
+				voice->sendMix[i] = FAudio_INTERNAL_Mix_1in_2out;
 			}
 			else if (outChannels == 6)
 			{
-				voice->sendMix[i] = FAudio_INTERNAL_Mix_1in_6out_Scalar;
+				voice->sendMix[i] = FAudio_INTERNAL_Mix_1in_6out;
 			}
 			else if (outChannels == 8)
 			{
-				voice->sendMix[i] = FAudio_INTERNAL_Mix_1in_8out_Scalar;
+				voice->sendMix[i] = FAudio_INTERNAL_Mix_1in_8out;
 			}
 			else
 			{
-				voice->sendMix[i] = FAudio_INTERNAL_Mix_Generic_Scalar;
+				voice->sendMix[i] = FAudio_INTERNAL_Mix_Generic;
 			}
 		}
 		else if (voice->outputChannels == 2)
 		{
 			if (outChannels == 1)
 			{
-				voice->sendMix[i] = FAudio_INTERNAL_Mix_2in_1out_Scalar;
+				voice->sendMix[i] = FAudio_INTERNAL_Mix_2in_1out;
 			}
 			else if (outChannels == 2)
 			{
-				voice->sendMix[i] = FAudio_INTERNAL_Mix_2in_2out_Scalar;
+				voice->sendMix[i] = FAudio_INTERNAL_Mix_2in_2out;
 			}
 			else if (outChannels == 6)
 			{
-				voice->sendMix[i] = FAudio_INTERNAL_Mix_2in_6out_Scalar;
+				voice->sendMix[i] = FAudio_INTERNAL_Mix_2in_6out;
 			}
 			else if (outChannels == 8)
 			{
-				voice->sendMix[i] = FAudio_INTERNAL_Mix_2in_8out_Scalar;
+				voice->sendMix[i] = FAudio_INTERNAL_Mix_2in_8out;
 			}
 			else
 			{
-				voice->sendMix[i] = FAudio_INTERNAL_Mix_Generic_Scalar;
+				voice->sendMix[i] = FAudio_INTERNAL_Mix_Generic;
 			}
 		}
 		else
 		{
-			voice->sendMix[i] = FAudio_INTERNAL_Mix_Generic_Scalar;
+			voice->sendMix[i] = FAudio_INTERNAL_Mix_Generic;
 		}
 
 		if (pSendList->pSends[i].Flags & FAUDIO_SEND_USEFILTER)
@@ -1114,22 +1798,19 @@ uint32_t FAudioVoice_SetOutputVoices(
 			voice->mix.outputSamples -= 1;
 		}
 
-		if (voice->mix.inputChannels == 1)
-		{
-			voice->mix.resample = FAudio_INTERNAL_ResampleMono;
-		}
-		else if (voice->mix.inputChannels == 2)
-		{
-			voice->mix.resample = FAudio_INTERNAL_ResampleStereo;
-		}
-		else
-		{
-			voice->mix.resample = FAudio_INTERNAL_ResampleGeneric;
-		}
+		voice->mix.resample = FAudio_INTERNAL_GetResampler(
+			voice->mix.resampleStep,
+			voice->mix.inputChannels
+		);
 	}
 
+	/* The mixer's copies of the send parameters change shape too */
+	FAudio_INTERNAL_AllocParameters(voice);
+
 	FAudio_PlatformUnlockMutex(voice->sendLock);
 	LOG_MUTEX_UNLOCK(voice->audio, voice->sendLock)
+	FAudio_PlatformUnlockMutex(mixLock);
+	LOG_MUTEX_UNLOCK(voice->audio, mixLock)
 	LOG_API_EXIT(voice->audio)
 	return 0;
 }
@@ -1145,6 +1826,7 @@ uint32_t FAudioVoice_SetEffectChain(
 	FAPORegistrationProperties *pProps;
 	FAudioWaveFormatExtensible srcFmt, dstFmt;
 	FAPOLockForProcessBufferParameters srcLockParams, dstLockParams;
+	FAudioMutex mixLock;
 
 	LOG_API_ENTER(voice->audio)
 
@@ -1185,6 +1867,9 @@ uint32_t FAudioVoice_SetEffectChain(
 		}
 	}
 
+	mixLock = FAudio_INTERNAL_GetMixLock(voice);
+	FAudio_PlatformLockMutex(mixLock);
+	LOG_MUTEX_LOCK(voice->audio, mixLock)
 	FAudio_PlatformLockMutex(voice->effectLock);
 	LOG_MUTEX_LOCK(voice->audio, voice->effectLock)
 
@@ -1249,6 +1934,8 @@ uint32_t FAudioVoice_SetEffectChain(
 				FAudio_assert(0 && "Effect output format not supported");
 				FAudio_PlatformUnlockMutex(voice->effectLock);
 				LOG_MUTEX_UNLOCK(voice->audio, voice->effectLock)
+				FAudio_PlatformUnlockMutex(mixLock);
+				LOG_MUTEX_UNLOCK(voice->audio, mixLock)
 				LOG_API_EXIT(voice->audio)
 				return FAUDIO_E_UNSUPPORTED_FORMAT;
 			}
@@ -1293,6 +1980,8 @@ uint32_t FAudioVoice_SetEffectChain(
 
 	FAudio_PlatformUnlockMutex(voice->effectLock);
 	LOG_MUTEX_UNLOCK(voice->audio, voice->effectLock)
+	FAudio_PlatformUnlockMutex(mixLock);
+	LOG_MUTEX_UNLOCK(voice->audio, mixLock)
 	LOG_API_EXIT(voice->audio)
 	return 0;
 }
@@ -1303,7 +1992,16 @@ uint32_t FAudioVoice_EnableEffect(
 	uint32_t OperationSet
 ) {
 	LOG_API_ENTER(voice->audio)
-	FAudio_assert(OperationSet == FAUDIO_COMMIT_NOW);
+	if (OperationSet != FAUDIO_COMMIT_NOW && voice->audio->active)
+	{
+		FAudio_OPERATIONSET_QueueEnableEffect(
+			voice,
+			EffectIndex,
+			OperationSet
+		);
+		LOG_API_EXIT(voice->audio)
+		return 0;
+	}
 
 	FAudio_PlatformLockMutex(voice->effectLock);
 	LOG_MUTEX_LOCK(voice->audio, voice->effectLock)
@@ -1320,7 +2018,16 @@ uint32_t FAudioVoice_DisableEffect(
 	uint32_t OperationSet
 ) {
 	LOG_API_ENTER(voice->audio)
-	FAudio_assert(OperationSet == FAUDIO_COMMIT_NOW);
+	if (OperationSet != FAUDIO_COMMIT_NOW && voice->audio->active)
+	{
+		FAudio_OPERATIONSET_QueueDisableEffect(
+			voice,
+			EffectIndex,
+			OperationSet
+		);
+		LOG_API_EXIT(voice->audio)
+		return 0;
+	}
 
 	FAudio_PlatformLockMutex(voice->effectLock);
 	LOG_MUTEX_LOCK(voice->audio, voice->effectLock)
@@ -1352,34 +2059,42 @@ uint32_t FAudioVoice_SetEffectParameters(
 	uint32_t ParametersByteSize,
 	uint32_t OperationSet
 ) {
+	FAudioEffectParameterBlock *block;
 	LOG_API_ENTER(voice->audio)
-	FAudio_assert(OperationSet == FAUDIO_COMMIT_NOW);
-
-	if (voice->effects.parameters[EffectIndex] == NULL)
+	if (OperationSet != FAUDIO_COMMIT_NOW && voice->audio->active)
 	{
-		voice->effects.parameters[EffectIndex] = voice->audio->pMalloc(
-			ParametersByteSize
+		FAudio_OPERATIONSET_QueueSetEffectParameters(
+			voice,
+			EffectIndex,
+			pParameters,
+			ParametersByteSize,
+			OperationSet
 		);
-		voice->effects.parameterSizes[EffectIndex] = ParametersByteSize;
+		LOG_API_EXIT(voice->audio)
+		return 0;
 	}
+
+	/* The mixer takes this block over on its next update. If there is
+	 * already one it has not picked up yet, it is stale now.
+	 */
+	block = (FAudioEffectParameterBlock*) voice->audio->pMalloc(
+		sizeof(FAudioEffectParameterBlock) + ParametersByteSize
+	);
+	block->size = ParametersByteSize;
+	FAudio_memcpy(block + 1, pParameters, ParametersByteSize);
+
 	FAudio_PlatformLockMutex(voice->effectLock);
 	LOG_MUTEX_LOCK(voice->audio, voice->effectLock)
-	if (voice->effects.parameterSizes[EffectIndex] < ParametersByteSize)
-	{
-		voice->effects.parameters[EffectIndex] = voice->audio->pRealloc(
-			voice->effects.parameters[EffectIndex],
-			ParametersByteSize
-		);
-		voice->effects.parameterSizes[EffectIndex] = ParametersByteSize;
-	}
-	FAudio_memcpy(
-		voice->effects.parameters[EffectIndex],
-		pParameters,
-		ParametersByteSize
+	block = (FAudioEffectParameterBlock*) FAudio_PlatformAtomicSetPtr(
+		(void**) &voice->effects.parameters[EffectIndex],
+		block
 	);
-	voice->effects.parameterUpdates[EffectIndex] = 1;
 	FAudio_PlatformUnlockMutex(voice->effectLock);
 	LOG_MUTEX_UNLOCK(voice->audio, voice->effectLock)
+	if (block != NULL)
+	{
+		voice->audio->pFree(block);
+	}
 	LOG_API_EXIT(voice->audio)
 	return 0;
 }
@@ -1408,7 +2123,6 @@ uint32_t FAudioVoice_SetFilterParameters(
 	uint32_t OperationSet
 ) {
 	LOG_API_ENTER(voice->audio)
-	FAudio_assert(OperationSet == FAUDIO_COMMIT_NOW);
 
 	/* MSDN: "This method is usable only on source and submix voices and
 	 * has no effect on mastering voices."
@@ -1425,6 +2139,17 @@ uint32_t FAudioVoice_SetFilterParameters(
 		return 0;
 	}
 
+	if (OperationSet != FAUDIO_COMMIT_NOW && voice->audio->active)
+	{
+		FAudio_OPERATIONSET_QueueSetFilterParameters(
+			voice,
+			pParameters,
+			OperationSet
+		);
+		LOG_API_EXIT(voice->audio)
+		return 0;
+	}
+
 	FAudio_PlatformLockMutex(voice->filterLock);
 	LOG_MUTEX_LOCK(voice->audio, voice->filterLock)
 	FAudio_memcpy(
@@ -1434,6 +2159,7 @@ uint32_t FAudioVoice_SetFilterParameters(
 	);
 	FAudio_PlatformUnlockMutex(voice->filterLock);
 	LOG_MUTEX_UNLOCK(voice->audio, voice->filterLock)
+	FAudio_INTERNAL_PublishParameters(voice);
 
 	LOG_API_EXIT(voice->audio)
 	return 0;
@@ -1480,7 +2206,6 @@ uint32_t FAudioVoice_SetOutputFilterParameters(
 ) {
 	uint32_t i;
 	LOG_API_ENTER(voice->audio)
-	FAudio_assert(OperationSet == FAUDIO_COMMIT_NOW);
 
 	/* MSDN: "This method is usable only on source and submix voices and
 	 * has no effect on mastering voices."
@@ -1491,6 +2216,18 @@ uint32_t FAudioVoice_SetOutputFilterParameters(
 		return 0;
 	}
 
+	if (OperationSet != FAUDIO_COMMIT_NOW && voice->audio->active)
+	{
+		FAudio_OPERATIONSET_QueueSetOutputFilterParameters(
+			voice,
+			pDestinationVoice,
+			pParameters,
+			OperationSet
+		);
+		LOG_API_EXIT(voice->audio)
+		return 0;
+	}
+
 	FAudio_PlatformLockMutex(voice->sendLock);
 	LOG_MUTEX_LOCK(voice->audio, voice->sendLock)
 
@@ -1537,6 +2274,7 @@ uint32_t FAudioVoice_SetOutputFilterParameters(
 
 	FAudio_PlatformUnlockMutex(voice->sendLock);
 	LOG_MUTEX_UNLOCK(voice->audio, voice->sendLock)
+	FAudio_INTERNAL_PublishParameters(voice);
 	LOG_API_EXIT(voice->audio)
 	return 0;
 }
@@ -1614,13 +2352,27 @@ uint32_t FAudioVoice_SetVolume(
 	uint32_t OperationSet
 ) {
 	LOG_API_ENTER(voice->audio)
-	FAudio_assert(OperationSet == FAUDIO_COMMIT_NOW);
+	if (OperationSet != FAUDIO_COMMIT_NOW && voice->audio->active)
+	{
+		FAudio_OPERATIONSET_QueueSetVolume(
+			voice,
+			Volume,
+			OperationSet
+		);
+		LOG_API_EXIT(voice->audio)
+		return 0;
+	}
 
+	FAudio_PlatformLockMutex(voice->volumeLock);
+	LOG_MUTEX_LOCK(voice->audio, voice->volumeLock)
 	voice->volume = FAudio_clamp(
 		Volume,
 		-FAUDIO_MAX_VOLUME_LEVEL,
 		FAUDIO_MAX_VOLUME_LEVEL
 	);
+	FAudio_PlatformUnlockMutex(voice->volumeLock);
+	LOG_MUTEX_UNLOCK(voice->audio, voice->volumeLock)
+	FAudio_INTERNAL_PublishParameters(voice);
 	LOG_API_EXIT(voice->audio)
 	return 0;
 }
@@ -1641,7 +2393,6 @@ uint32_t FAudioVoice_SetChannelVolumes(
 	uint32_t OperationSet
 ) {
 	LOG_API_ENTER(voice->audio)
-	FAudio_assert(OperationSet == FAUDIO_COMMIT_NOW);
 
 	if (pVolumes == NULL)
 	{
@@ -1661,6 +2412,18 @@ uint32_t FAudioVoice_SetChannelVolumes(
 		return FAUDIO_E_INVALID_CALL;
 	}
 
+	if (OperationSet != FAUDIO_COMMIT_NOW && voice->audio->active)
+	{
+		FAudio_OPERATIONSET_QueueSetChannelVolumes(
+			voice,
+			Channels,
+			pVolumes,
+			OperationSet
+		);
+		LOG_API_EXIT(voice->audio)
+		return 0;
+	}
+
 	FAudio_PlatformLockMutex(voice->volumeLock);
 	LOG_MUTEX_LOCK(voice->audio, voice->volumeLock)
 	FAudio_memcpy(
@@ -1670,6 +2433,7 @@ uint32_t FAudioVoice_SetChannelVolumes(
 	);
 	FAudio_PlatformUnlockMutex(voice->volumeLock);
 	LOG_MUTEX_UNLOCK(voice->audio, voice->volumeLock)
+	FAudio_INTERNAL_PublishParameters(voice);
 	LOG_API_EXIT(voice->audio)
 	return 0;
 }
@@ -1702,7 +2466,19 @@ uint32_t FAudioVoice_SetOutputMatrix(
 ) {
 	uint32_t i;
 	LOG_API_ENTER(voice->audio)
-	FAudio_assert(OperationSet == FAUDIO_COMMIT_NOW);
+	if (OperationSet != FAUDIO_COMMIT_NOW && voice->audio->active)
+	{
+		FAudio_OPERATIONSET_QueueSetOutputMatrix(
+			voice,
+			pDestinationVoice,
+			SourceChannels,
+			DestinationChannels,
+			pLevelMatrix,
+			OperationSet
+		);
+		LOG_API_EXIT(voice->audio)
+		return 0;
+	}
 
 	FAudio_PlatformLockMutex(voice->sendLock);
 	LOG_MUTEX_LOCK(voice->audio, voice->sendLock)
@@ -1755,6 +2531,7 @@ uint32_t FAudioVoice_SetOutputMatrix(
 
 	FAudio_PlatformUnlockMutex(voice->sendLock);
 	LOG_MUTEX_UNLOCK(voice->audio, voice->sendLock)
+	FAudio_INTERNAL_PublishParameters(voice);
 	LOG_API_EXIT(voice->audio)
 	return 0;
 }
@@ -1829,29 +2606,46 @@ void FAudioVoice_DestroyVoice(FAudioVoice *voice)
 	uint32_t i;
 	LOG_API_ENTER(voice->audio)
 
+	/* Don't let a later commit touch this voice */
+	FAudio_OPERATIONSET_ClearAllForVoice(voice);
+
+	/* Pooled voices go back to their pool instead */
+	if (voice->type == FAUDIO_VOICE_SOURCE && voice->src.pool != NULL)
+	{
+		FAudio_VOICEPOOL_Recycle(voice);
+		LOG_API_EXIT(voice->audio)
+		return;
+	}
+
 	/* TODO: Check for dependencies and fail if still in use */
 	if (voice->type == FAUDIO_VOICE_SOURCE)
 	{
-		FAudioBufferEntry *entry, *next;
-
+		/* The plan may still point at this voice, so it has to be
+		 * invalidated before the mixer gets another look at it
+		 */
+		FAudio_PlatformLockMutex(voice->audio->sourceLock);
+		LOG_MUTEX_LOCK(voice->audio, voice->audio->sourceLock)
 		LinkedList_RemoveEntry(
 			&voice->audio->sources,
 			voice,
 			voice->audio->sourceLock,
 			voice->audio->pFree
 		);
+		FAudio_INTERNAL_InvalidateRenderPlan(voice->audio, voice->type);
+		FAudio_PlatformUnlockMutex(voice->audio->sourceLock);
+		LOG_MUTEX_UNLOCK(voice->audio, voice->audio->sourceLock)
 
-		entry = voice->src.bufferList;
-		while (entry != NULL)
+		voice->audio->pFree(voice->src.bufferQueue);
+		voice->audio->pFree(voice->src.format);
+		if (voice->src.sincHistory != NULL)
 		{
-			next = entry->next;
-			voice->audio->pFree(entry);
-			entry = next;
+			voice->audio->pFree(voice->src.sincHistory);
 		}
-
-		voice->audio->pFree(voice->src.format);
-		LOG_MUTEX_DESTROY(voice->audio, voice->src.bufferLock)
-		FAudio_PlatformDestroyMutex(voice->src.bufferLock);
+		if (voice->src.msadpcmCache != NULL)
+		{
+			voice->audio->pFree(voice->src.msadpcmCache);
+		}
+		FAudio_INTERNAL_ReleasePCMCacheEntry(voice);
 #ifdef HAVE_FFMPEG
 		if (voice->src.ffmpeg)
 		{
@@ -1861,21 +2655,30 @@ void FAudioVoice_DestroyVoice(FAudioVoice *voice)
 	}
 	else if (voice->type == FAUDIO_VOICE_SUBMIX)
 	{
-		/* Remove submix from list */
+		/* Remove submix from list, and from the plan */
+		FAudio_PlatformLockMutex(voice->audio->submixLock);
+		LOG_MUTEX_LOCK(voice->audio, voice->audio->submixLock)
 		LinkedList_RemoveEntry(
 			&voice->audio->submixes,
 			voice,
 			voice->audio->submixLock,
 			voice->audio->pFree
 		);
+		FAudio_INTERNAL_InvalidateRenderPlan(voice->audio, voice->type);
+		FAudio_PlatformUnlockMutex(voice->audio->submixLock);
+		LOG_MUTEX_UNLOCK(voice->audio, voice->audio->submixLock)
 
 		/* Delete submix data */
 		voice->audio->pFree(voice->mix.inputCache);
+		FAudio_INTERNAL_FreeWorkerCaches(voice);
 	}
 	else if (voice->type == FAUDIO_VOICE_MASTER)
 	{
+		/* Idle pooled voices can't outlive the master they send to */
+		FAudio_VOICEPOOL_FreeIdle(voice->audio);
 		FAudio_PlatformQuit(voice->audio);
 		voice->audio->master = NULL;
+		FAudio_INTERNAL_FreeWorkerCaches(voice);
 	}
 
 	if (voice->sendLock != NULL)
@@ -1952,6 +2755,7 @@ void FAudioVoice_DestroyVoice(FAudioVoice *voice)
 		{
 			voice->audio->pFree(voice->channelVolume);
 		}
+		FAudio_INTERNAL_FreeParameters(voice);
 		FAudio_PlatformUnlockMutex(voice->volumeLock);
 		LOG_MUTEX_UNLOCK(voice->audio, voice->volumeLock)
 		LOG_MUTEX_DESTROY(voice->audio, voice->volumeLock)
@@ -1965,17 +2769,62 @@ void FAudioVoice_DestroyVoice(FAudioVoice *voice)
 
 /* FAudioSourceVoice Interface */
 
+/* SubmitSourceBuffer only ever adds to the buffer queue, the mixer is the one
+ * that takes from it. Anything else that changes queued buffers has to keep
+ * the mixer out first, unless it's being called by the mixer itself (i.e. from
+ * one of this voice's callbacks).
+ */
+static inline uint8_t FAudio_INTERNAL_LockBufferQueue(FAudioSourceVoice *voice)
+{
+	if (voice->src.mixThread == FAudio_PlatformGetThreadID())
+	{
+		return 0;
+	}
+	FAudio_PlatformLockMutex(voice->audio->sourceLock);
+	LOG_MUTEX_LOCK(voice->audio, voice->audio->sourceLock)
+	return 1;
+}
+
+static inline void FAudio_INTERNAL_UnlockBufferQueue(
+	FAudioSourceVoice *voice,
+	uint8_t locked
+) {
+	if (locked)
+	{
+		FAudio_PlatformUnlockMutex(voice->audio->sourceLock);
+		LOG_MUTEX_UNLOCK(voice->audio, voice->audio->sourceLock)
+	}
+}
+
 uint32_t FAudioSourceVoice_Start(
 	FAudioSourceVoice *voice,
 	uint32_t Flags,
 	uint32_t OperationSet
 ) {
+	uint8_t wasActive;
 	LOG_API_ENTER(voice->audio)
-	FAudio_assert(OperationSet == FAUDIO_COMMIT_NOW);
 	FAudio_assert(voice->type == FAUDIO_VOICE_SOURCE);
 
+	if (OperationSet != FAUDIO_COMMIT_NOW && voice->audio->active)
+	{
+		FAudio_OPERATIONSET_QueueStart(
+			voice,
+			Flags,
+			OperationSet
+		);
+		LOG_API_EXIT(voice->audio)
+		return 0;
+	}
+
 	FAudio_assert(Flags == 0);
+	wasActive = voice->src.active;
 	voice->src.active = 1;
+
+	/* Voices playing tails are in the plan already */
+	if (!wasActive)
+	{
+		FAudio_INTERNAL_InvalidateRenderPlan(voice->audio, voice->type);
+	}
 	LOG_API_EXIT(voice->audio)
 	return 0;
 }
@@ -1985,10 +2834,22 @@ uint32_t FAudioSourceVoice_Stop(
 	uint32_t Flags,
 	uint32_t OperationSet
 ) {
+	uint8_t wasActive;
 	LOG_API_ENTER(voice->audio)
-	FAudio_assert(OperationSet == FAUDIO_COMMIT_NOW);
 	FAudio_assert(voice->type == FAUDIO_VOICE_SOURCE);
 
+	if (OperationSet != FAUDIO_COMMIT_NOW && voice->audio->active)
+	{
+		FAudio_OPERATIONSET_QueueStop(
+			voice,
+			Flags,
+			OperationSet
+		);
+		LOG_API_EXIT(voice->audio)
+		return 0;
+	}
+
+	wasActive = voice->src.active;
 	if (Flags & FAUDIO_PLAY_TAILS)
 	{
 		voice->src.active = 2;
@@ -1997,6 +2858,12 @@ uint32_t FAudioSourceVoice_Stop(
 	{
 		voice->src.active = 0;
 	}
+
+	/* Stopping with tails keeps the voice in the plan */
+	if (!wasActive != !voice->src.active)
+	{
+		FAudio_INTERNAL_InvalidateRenderPlan(voice->audio, voice->type);
+	}
 	LOG_API_EXIT(voice->audio)
 	return 0;
 }
@@ -2008,7 +2875,7 @@ uint32_t FAudioSourceVoice_SubmitSourceBuffer(
 ) {
 	uint32_t adpcmMask, *adpcmByteCount;
 	uint32_t playBegin, playLength, loopBegin, loopLength;
-	FAudioBufferEntry *entry, *list;
+	FAudioBuffer buffer;
 
 	LOG_API_ENTER(voice->audio)
 	LOG_INFO(
@@ -2114,58 +2981,43 @@ uint32_t FAudioSourceVoice_SubmitSourceBuffer(
 		) * voice->src.format->nBlockAlign;
 	}
 
-	/* Allocate, now that we have valid input */
-	entry = (FAudioBufferEntry*) voice->audio->pMalloc(sizeof(FAudioBufferEntry));
-	FAudio_memcpy(&entry->buffer, pBuffer, sizeof(FAudioBuffer));
-	entry->buffer.PlayBegin = playBegin;
-	entry->buffer.PlayLength = playLength;
-	entry->buffer.LoopBegin = loopBegin;
-	entry->buffer.LoopLength = loopLength;
-	if (pBufferWMA != NULL)
-	{
-		FAudio_memcpy(&entry->bufferWMA, pBufferWMA, sizeof(FAudioBufferWMA));
-	}
-	entry->next = NULL;
+	/* Fill in the final buffer, now that we have valid input */
+	FAudio_memcpy(&buffer, pBuffer, sizeof(FAudioBuffer));
+	buffer.PlayBegin = playBegin;
+	buffer.PlayLength = playLength;
+	buffer.LoopBegin = loopBegin;
+	buffer.LoopLength = loopLength;
 
 	if (	voice->audio->version <= 7 && (
-		entry->buffer.LoopCount > 0 &&
-		entry->buffer.LoopBegin + entry->buffer.LoopLength <= entry->buffer.PlayBegin))
+		buffer.LoopCount > 0 &&
+		buffer.LoopBegin + buffer.LoopLength <= buffer.PlayBegin))
 	{
-		entry->buffer.LoopCount = 0;
+		buffer.LoopCount = 0;
 	}
 
-	/* Submit! */
-	FAudio_PlatformLockMutex(voice->src.bufferLock);
-	LOG_MUTEX_LOCK(voice->audio, voice->src.bufferLock)
-	if (voice->src.bufferList == NULL)
+	/* Decode cacheable buffers now, rather than in the middle of an update */
+	if (buffer.Flags & FAUDIO_BUFFER_CACHEABLE_EXT)
 	{
-		voice->src.bufferList = entry;
-		voice->src.curBufferOffset = entry->buffer.PlayBegin;
-		voice->src.newBuffer = 1;
+		FAudio_INTERNAL_FillPCMCache(voice, &buffer);
 	}
-	else
-	{
-		list = voice->src.bufferList;
-		while (list->next != NULL)
-		{
-			list = list->next;
-		}
-		list->next = entry;
 
-		/* For some bizarre reason we get scenarios where a buffer is freed, only to
-		 * have the allocator give us the exact same address and somehow get a single
-		 * buffer referencing itself. I don't even know.
-		 */
-		FAudio_assert(list != entry);
+	/* Submit! */
+	if (!FAudio_INTERNAL_PushBuffer(voice, &buffer, pBufferWMA))
+	{
+		LOG_ERROR(
+			voice->audio,
+			"%p: too many queued buffers",
+			voice
+		)
+		LOG_API_EXIT(voice->audio)
+		return FAUDIO_E_INVALID_CALL;
 	}
 	LOG_INFO(
 		voice->audio,
 		"%p: appended buffer %p",
 		voice,
-		&entry->buffer
+		pBuffer
 	);
-	FAudio_PlatformUnlockMutex(voice->src.bufferLock);
-	LOG_MUTEX_UNLOCK(voice->audio, voice->src.bufferLock)
 	LOG_API_EXIT(voice->audio)
 	return 0;
 }
@@ -2173,45 +3025,55 @@ uint32_t FAudioSourceVoice_SubmitSourceBuffer(
 uint32_t FAudioSourceVoice_FlushSourceBuffers(
 	FAudioSourceVoice *voice
 ) {
-	FAudioBufferEntry *entry, *next;
+	void *flushed[FAUDIO_MAX_QUEUED_BUFFERS + 1];
+	uint32_t i, flushedCount = 0;
+	FAudioBufferEntry entry;
+	uint8_t locked;
 
 	LOG_API_ENTER(voice->audio)
 	FAudio_assert(voice->type == FAUDIO_VOICE_SOURCE);
 
-	FAudio_PlatformLockMutex(voice->src.bufferLock);
-	LOG_MUTEX_LOCK(voice->audio, voice->src.bufferLock)
+	locked = FAudio_INTERNAL_LockBufferQueue(voice);
 
 	/* If the source is playing, don't flush the active buffer */
-	entry = voice->src.bufferList;
-	if ((voice->src.active == 1) && entry != NULL && !voice->src.newBuffer)
+	if (	!(	voice->src.active == 1 &&
+			voice->src.hasCurBuffer &&
+			!voice->src.newBuffer	)	)
 	{
-		entry = entry->next;
-		voice->src.bufferList->next = NULL;
+		if (voice->src.hasCurBuffer)
+		{
+			flushed[flushedCount++] = voice->src.curBuffer.buffer.pContext;
+			voice->src.hasCurBuffer = 0;
+		}
+		voice->src.curBufferOffset = 0;
+		voice->src.newBuffer = 1;
+		FAudio_PlatformAtomicSetPtr(&voice->src.curBufferContext, NULL);
 	}
-	else
+
+	/* Empty the queue first, so the callbacks see what's left over */
+	while (	flushedCount < FAUDIO_MAX_QUEUED_BUFFERS + 1 &&
+		FAudio_INTERNAL_DequeueBuffer(voice, &entry)	)
 	{
-		voice->src.curBufferOffset = 0;
-		voice->src.bufferList = NULL;
-		voice->src.newBuffer = 0;
+		flushed[flushedCount++] = entry.buffer.pContext;
 	}
+	FAudio_PlatformAtomicAdd(
+		&voice->src.buffersQueued,
+		-((int32_t) flushedCount)
+	);
 
-	/* Go through each buffer, send an event for each one before deleting */
-	while (entry != NULL)
+	/* Go through each buffer, send an event for each one */
+	if (voice->src.callback != NULL && voice->src.callback->OnBufferEnd != NULL)
 	{
-		if (voice->src.callback != NULL && voice->src.callback->OnBufferEnd != NULL)
+		for (i = 0; i < flushedCount; i += 1)
 		{
 			voice->src.callback->OnBufferEnd(
 				voice->src.callback,
-				entry->buffer.pContext
+				flushed[i]
 			);
 		}
-		next = entry->next;
-		voice->audio->pFree(entry);
-		entry = next;
 	}
 
-	FAudio_PlatformUnlockMutex(voice->src.bufferLock);
-	LOG_MUTEX_UNLOCK(voice->audio, voice->src.bufferLock)
+	FAudio_INTERNAL_UnlockBufferQueue(voice, locked);
 	LOG_API_EXIT(voice->audio)
 	return 0;
 }
@@ -2219,22 +3081,26 @@ uint32_t FAudioSourceVoice_FlushSourceBuffers(
 uint32_t FAudioSourceVoice_Discontinuity(
 	FAudioSourceVoice *voice
 ) {
-	FAudioBufferEntry *buf;
+	FAudioBufferEntry *buf, *next;
+	uint32_t i;
+	uint8_t locked;
 
 	LOG_API_ENTER(voice->audio)
 	FAudio_assert(voice->type == FAUDIO_VOICE_SOURCE);
 
-	FAudio_PlatformLockMutex(voice->src.bufferLock);
-	LOG_MUTEX_LOCK(voice->audio, voice->src.bufferLock)
+	locked = FAudio_INTERNAL_LockBufferQueue(voice);
 
-	if (voice->src.bufferList != NULL)
+	buf = FAudio_INTERNAL_PeekBuffer(voice, 0);
+	if (buf != NULL)
 	{
-		for (buf = voice->src.bufferList; buf->next != NULL; buf = buf->next);
+		for (i = 1; (next = FAudio_INTERNAL_PeekBuffer(voice, i)) != NULL; i += 1)
+		{
+			buf = next;
+		}
 		buf->buffer.Flags |= FAUDIO_END_OF_STREAM;
 	}
 
-	FAudio_PlatformUnlockMutex(voice->src.bufferLock);
-	LOG_MUTEX_UNLOCK(voice->audio, voice->src.bufferLock)
+	FAudio_INTERNAL_UnlockBufferQueue(voice, locked);
 	LOG_API_EXIT(voice->audio)
 	return 0;
 }
@@ -2243,20 +3109,31 @@ uint32_t FAudioSourceVoice_ExitLoop(
 	FAudioSourceVoice *voice,
 	uint32_t OperationSet
 ) {
+	FAudioBufferEntry *buf;
+	uint8_t locked;
+
 	LOG_API_ENTER(voice->audio)
-	FAudio_assert(OperationSet == FAUDIO_COMMIT_NOW);
 	FAudio_assert(voice->type == FAUDIO_VOICE_SOURCE);
 
-	FAudio_PlatformLockMutex(voice->src.bufferLock);
-	LOG_MUTEX_LOCK(voice->audio, voice->src.bufferLock)
+	if (OperationSet != FAUDIO_COMMIT_NOW && voice->audio->active)
+	{
+		FAudio_OPERATIONSET_QueueExitLoop(
+			voice,
+			OperationSet
+		);
+		LOG_API_EXIT(voice->audio)
+		return 0;
+	}
+
+	locked = FAudio_INTERNAL_LockBufferQueue(voice);
 
-	if (voice->src.bufferList != NULL)
+	buf = FAudio_INTERNAL_PeekBuffer(voice, 0);
+	if (buf != NULL)
 	{
-		voice->src.bufferList->buffer.LoopCount = 0;
+		buf->buffer.LoopCount = 0;
 	}
 
-	FAudio_PlatformUnlockMutex(voice->src.bufferLock);
-	LOG_MUTEX_UNLOCK(voice->audio, voice->src.bufferLock)
+	FAudio_INTERNAL_UnlockBufferQueue(voice, locked);
 	LOG_API_EXIT(voice->audio)
 	return 0;
 }
@@ -2266,34 +3143,20 @@ void FAudioSourceVoice_GetState(
 	FAudioVoiceState *pVoiceState,
 	uint32_t flags
 ) {
-	FAudioBufferEntry *entry;
-
 	LOG_API_ENTER(voice->audio)
 	FAudio_assert(voice->type == FAUDIO_VOICE_SOURCE);
 
-	FAudio_PlatformLockMutex(voice->src.bufferLock);
-	LOG_MUTEX_LOCK(voice->audio, voice->src.bufferLock)
-
+	/* The mixer keeps these up to date for us, no need to stop it */
 	if (!(flags & FAUDIO_VOICE_NOSAMPLESPLAYED))
 	{
 		pVoiceState->SamplesPlayed = voice->src.totalSamples;
 	}
-
-	pVoiceState->BuffersQueued = 0;
-	pVoiceState->pCurrentBufferContext = NULL;
-	if (voice->src.bufferList != NULL)
-	{
-		entry = voice->src.bufferList;
-		if (!voice->src.newBuffer)
-		{
-			pVoiceState->pCurrentBufferContext = entry->buffer.pContext;
-		}
-		do
-		{
-			pVoiceState->BuffersQueued += 1;
-			entry = entry->next;
-		} while (entry != NULL);
-	}
+	pVoiceState->BuffersQueued = FAudio_PlatformAtomicGet(
+		&voice->src.buffersQueued
+	);
+	pVoiceState->pCurrentBufferContext = FAudio_PlatformAtomicGetPtr(
+		&voice->src.curBufferContext
+	);
 
 	LOG_INFO(
 		voice->audio,
@@ -2301,9 +3164,6 @@ void FAudioSourceVoice_GetState(
 		pVoiceState->pCurrentBufferContext, pVoiceState->BuffersQueued,
 		pVoiceState->SamplesPlayed
 	);
-
-	FAudio_PlatformUnlockMutex(voice->src.bufferLock);
-	LOG_MUTEX_UNLOCK(voice->audio, voice->src.bufferLock)
 	LOG_API_EXIT(voice->audio)
 }
 
@@ -2313,7 +3173,6 @@ uint32_t FAudioSourceVoice_SetFrequencyRatio(
 	uint32_t OperationSet
 ) {
 	LOG_API_ENTER(voice->audio)
-	FAudio_assert(OperationSet == FAUDIO_COMMIT_NOW);
 	FAudio_assert(voice->type == FAUDIO_VOICE_SOURCE);
 
 	if (voice->flags & FAUDIO_VOICE_NOPITCH)
@@ -2322,11 +3181,27 @@ uint32_t FAudioSourceVoice_SetFrequencyRatio(
 		return 0;
 	}
 
+	if (OperationSet != FAUDIO_COMMIT_NOW && voice->audio->active)
+	{
+		FAudio_OPERATIONSET_QueueSetFrequencyRatio(
+			voice,
+			Ratio,
+			OperationSet
+		);
+		LOG_API_EXIT(voice->audio)
+		return 0;
+	}
+
+	FAudio_PlatformLockMutex(voice->volumeLock);
+	LOG_MUTEX_LOCK(voice->audio, voice->volumeLock)
 	voice->src.freqRatio = FAudio_clamp(
 		Ratio,
 		FAUDIO_MIN_FREQ_RATIO,
 		voice->src.maxFreqRatio
 	);
+	FAudio_PlatformUnlockMutex(voice->volumeLock);
+	LOG_MUTEX_UNLOCK(voice->audio, voice->volumeLock)
+	FAudio_INTERNAL_PublishParameters(voice);
 	LOG_API_EXIT(voice->audio)
 	return 0;
 }
@@ -2354,18 +3229,16 @@ uint32_t FAudioSourceVoice_SetSourceSampleRate(
 	FAudio_assert(	NewSourceSampleRate >= FAUDIO_MIN_SAMPLE_RATE &&
 			NewSourceSampleRate <= FAUDIO_MAX_SAMPLE_RATE	);
 
-	FAudio_PlatformLockMutex(voice->src.bufferLock);
-	LOG_MUTEX_LOCK(voice->audio, voice->src.bufferLock)
 	if (	voice->audio->version > 7 &&
-		voice->src.bufferList != NULL	)
+		FAudio_PlatformAtomicGet(&voice->src.buffersQueued) > 0	)
 	{
-		FAudio_PlatformUnlockMutex(voice->src.bufferLock);
-		LOG_MUTEX_UNLOCK(voice->audio, voice->src.bufferLock)
 		LOG_API_EXIT(voice->audio)
 		return FAUDIO_E_INVALID_CALL;
 	}
-	FAudio_PlatformUnlockMutex(voice->src.bufferLock);
-	LOG_MUTEX_UNLOCK(voice->audio, voice->src.bufferLock)
+
+	/* The mixer reads all of this without locking the voice */
+	FAudio_PlatformLockMutex(voice->audio->sourceLock);
+	LOG_MUTEX_LOCK(voice->audio, voice->audio->sourceLock)
 
 	voice->src.format->nSamplesPerSec = NewSourceSampleRate;
 
@@ -2389,6 +3262,8 @@ uint32_t FAudioSourceVoice_SetSourceSampleRate(
 	{
 		FAudio_PlatformUnlockMutex(voice->sendLock);
 		LOG_MUTEX_UNLOCK(voice->audio, voice->sendLock)
+		FAudio_PlatformUnlockMutex(voice->audio->sourceLock);
+		LOG_MUTEX_UNLOCK(voice->audio, voice->audio->sourceLock)
 		LOG_API_EXIT(voice->audio)
 		return 0;
 	}
@@ -2410,10 +3285,45 @@ uint32_t FAudioSourceVoice_SetSourceSampleRate(
 		newResampleSamples * voice->src.format->nChannels
 	);
 	voice->src.resampleSamples = newResampleSamples;
+
+	FAudio_PlatformUnlockMutex(voice->audio->sourceLock);
+	LOG_MUTEX_UNLOCK(voice->audio, voice->audio->sourceLock)
+	LOG_API_EXIT(voice->audio)
+	return 0;
+}
+
+uint32_t FAudioSourceVoice_SetResamplerQualityEXT(
+	FAudioSourceVoice *voice,
+	uint32_t Quality
+) {
+	LOG_API_ENTER(voice->audio)
+	FAudio_assert(voice->type == FAUDIO_VOICE_SOURCE);
+
+	if (Quality > FAUDIO_RESAMPLER_QUALITY_SINC)
+	{
+		LOG_API_EXIT(voice->audio)
+		return FAUDIO_E_INVALID_CALL;
+	}
+	FAudio_INTERNAL_SetResamplerQuality(voice, Quality);
+
 	LOG_API_EXIT(voice->audio)
 	return 0;
 }
 
+void FAudioSourceVoice_GetResamplerQualityEXT(
+	FAudioSourceVoice *voice,
+	uint32_t *pQuality
+) {
+	LOG_API_ENTER(voice->audio)
+	FAudio_assert(voice->type == FAUDIO_VOICE_SOURCE);
+
+	*pQuality = (voice->src.sincHistory != NULL) ?
+		FAUDIO_RESAMPLER_QUALITY_SINC :
+		FAUDIO_RESAMPLER_QUALITY_LINEAR;
+
+	LOG_API_EXIT(voice->audio)
+}
+
 /* FAudioMasteringVoice Interface */
 
 FAUDIOAPI uint32_t FAudioMasteringVoice_GetChannelMask(
@@ -382,7 +382,7 @@ void FAudio_INTERNAL_DecodeFFMPEG(
 
 	if (reseek)
 	{
-		FAudioBufferWMA *bufferWMA = &voice->src.bufferList->bufferWMA;
+		FAudioBufferWMA *bufferWMA = &voice->src.curBuffer.bufferWMA;
 		uint32_t byteOffset = voice->src.curBufferOffset * decSampleSize;
 		uint32_t packetIdx = bufferWMA->PacketCount - 1;
 
@@ -294,14 +294,349 @@ void FAudio_INTERNAL_InsertSubmixSorted(
 	FAudio_PlatformUnlockMutex(lock);
 }
 
+/* Buffer Queue */
+
+/* The queue is a bounded ring in the style of Vyukov's MPMC queue, though
+ * there is only ever one consumer (the mixer, or whoever is keeping it out).
+ * There can be more than one producer, since voice callbacks are allowed to
+ * submit buffers while the application does the same, so slots are claimed
+ * with a CAS on bufferTail. Each slot's sequence tells everyone what state
+ * it's in for a given position `pos`:
+ *
+ * sequence == pos: Empty, a producer may claim it
+ * sequence == pos + 1: Filled, the consumer may take it
+ * sequence == pos + FAUDIO_MAX_QUEUED_BUFFERS: Taken, empty for the next lap
+ *
+ * None of this allocates or locks, the entries live as long as the voice.
+ */
+
+#define BUFFER_QUEUE_MASK (FAUDIO_MAX_QUEUED_BUFFERS - 1)
+
+void FAudio_INTERNAL_AllocBufferQueue(FAudioSourceVoice *voice)
+{
+	uint32_t i;
+	voice->src.bufferQueue = (FAudioBufferEntry*) voice->audio->pMalloc(
+		sizeof(FAudioBufferEntry) * FAUDIO_MAX_QUEUED_BUFFERS
+	);
+	for (i = 0; i < FAUDIO_MAX_QUEUED_BUFFERS; i += 1)
+	{
+		voice->src.bufferQueue[i].sequence = (int32_t) i;
+	}
+	voice->src.bufferHead = 0;
+	voice->src.bufferTail = 0;
+	voice->src.buffersQueued = 0;
+	voice->src.hasCurBuffer = 0;
+	voice->src.curBufferContext = NULL;
+	voice->src.newBuffer = 1;
+}
+
+uint8_t FAudio_INTERNAL_PushBuffer(
+	FAudioSourceVoice *voice,
+	const FAudioBuffer *buffer,
+	const FAudioBufferWMA *bufferWMA
+) {
+	uint32_t pos;
+	int32_t diff;
+	FAudioBufferEntry *entry;
+
+	/* Reserve our place first, so that concurrent submitters can't both
+	 * pass the limit. The playing buffer counts against it too.
+	 */
+	if (	FAudio_PlatformAtomicAdd(&voice->src.buffersQueued, 1) >=
+		FAUDIO_MAX_QUEUED_BUFFERS	)
+	{
+		FAudio_PlatformAtomicAdd(&voice->src.buffersQueued, -1);
+		return 0;
+	}
+
+	/* Claim a slot... */
+	pos = (uint32_t) FAudio_PlatformAtomicGet(&voice->src.bufferTail);
+	while (1)
+	{
+		entry = &voice->src.bufferQueue[pos & BUFFER_QUEUE_MASK];
+		diff = (int32_t) (
+			(uint32_t) FAudio_PlatformAtomicGet(&entry->sequence) - pos
+		);
+		if (diff == 0)
+		{
+			if (FAudio_PlatformAtomicCAS(
+				&voice->src.bufferTail,
+				(int32_t) pos,
+				(int32_t) (pos + 1)
+			)) {
+				break;
+			}
+		}
+		else if (diff < 0)
+		{
+			/* Full, the mixer hasn't gotten to this one yet */
+			FAudio_PlatformAtomicAdd(&voice->src.buffersQueued, -1);
+			return 0;
+		}
+		pos = (uint32_t) FAudio_PlatformAtomicGet(&voice->src.bufferTail);
+	}
+
+	/* ... then fill it in and hand it over. */
+	FAudio_memcpy(&entry->buffer, buffer, sizeof(FAudioBuffer));
+	if (bufferWMA != NULL)
+	{
+		FAudio_memcpy(&entry->bufferWMA, bufferWMA, sizeof(FAudioBufferWMA));
+	}
+	FAudio_PlatformAtomicSet(&entry->sequence, (int32_t) (pos + 1));
+	return 1;
+}
+
+uint8_t FAudio_INTERNAL_DequeueBuffer(
+	FAudioSourceVoice *voice,
+	FAudioBufferEntry *entry
+) {
+	uint32_t pos = voice->src.bufferHead;
+	FAudioBufferEntry *slot = &voice->src.bufferQueue[pos & BUFFER_QUEUE_MASK];
+
+	if (FAudio_PlatformAtomicGet(&slot->sequence) != (int32_t) (pos + 1))
+	{
+		return 0;
+	}
+	FAudio_memcpy(entry, slot, sizeof(FAudioBufferEntry));
+	FAudio_PlatformAtomicSet(
+		&slot->sequence,
+		(int32_t) (pos + FAUDIO_MAX_QUEUED_BUFFERS)
+	);
+	voice->src.bufferHead = pos + 1;
+	return 1;
+}
+
+FAudioBufferEntry* FAudio_INTERNAL_PeekBuffer(
+	FAudioSourceVoice *voice,
+	uint32_t index
+) {
+	uint32_t pos;
+	FAudioBufferEntry *slot;
+
+	/* Index 0 is the current buffer, pulled from the queue if needed */
+	if (!voice->src.hasCurBuffer)
+	{
+		if (!FAudio_INTERNAL_DequeueBuffer(voice, &voice->src.curBuffer))
+		{
+			return NULL;
+		}
+		voice->src.hasCurBuffer = 1;
+		voice->src.curBufferOffset = voice->src.curBuffer.buffer.PlayBegin;
+
+		/* Clients may reuse the memory of finished buffers */
+		voice->src.msadpcmBlock[0] = NULL;
+		voice->src.msadpcmBlock[1] = NULL;
+		FAudio_INTERNAL_ReleasePCMCacheEntry(voice);
+		if (!voice->src.newBuffer)
+		{
+			FAudio_PlatformAtomicSetPtr(
+				&voice->src.curBufferContext,
+				voice->src.curBuffer.buffer.pContext
+			);
+		}
+	}
+	if (index == 0)
+	{
+		return &voice->src.curBuffer;
+	}
+
+	/* Everything after that is still in the queue */
+	pos = voice->src.bufferHead + index - 1;
+	slot = &voice->src.bufferQueue[pos & BUFFER_QUEUE_MASK];
+	if (	index > FAUDIO_MAX_QUEUED_BUFFERS ||
+		FAudio_PlatformAtomicGet(&slot->sequence) != (int32_t) (pos + 1)	)
+	{
+		return NULL;
+	}
+	return slot;
+}
+
+void FAudio_INTERNAL_PopBuffer(FAudioSourceVoice *voice)
+{
+	voice->src.hasCurBuffer = 0;
+	FAudio_PlatformAtomicAdd(&voice->src.buffersQueued, -1);
+	if (FAudio_INTERNAL_PeekBuffer(voice, 0) == NULL)
+	{
+		/* Whatever gets submitted next starts from scratch */
+		voice->src.newBuffer = 1;
+		FAudio_PlatformAtomicSetPtr(&voice->src.curBufferContext, NULL);
+	}
+}
+
+#undef BUFFER_QUEUE_MASK
+
+/* Voice Parameters */
+
+static void FAudio_INTERNAL_CopyParameters(
+	FAudioVoice *voice,
+	FAudioVoiceParameters *params
+) {
+	uint32_t i, oChan;
+	FAudioVoice *out;
+
+	params->volume = voice->volume;
+	params->freqRatio = (voice->type == FAUDIO_VOICE_SOURCE) ?
+		voice->src.freqRatio :
+		1.0f;
+	if (voice->type == FAUDIO_VOICE_MASTER)
+	{
+		return;
+	}
+
+	params->filter = voice->filter;
+	if (params->channelVolume != NULL)
+	{
+		FAudio_memcpy(
+			params->channelVolume,
+			voice->channelVolume,
+			sizeof(float) * voice->outputChannels
+		);
+	}
+	for (i = 0; i < params->sendCount; i += 1)
+	{
+		out = voice->sends.pSends[i].pOutputVoice;
+		oChan = (out->type == FAUDIO_VOICE_MASTER) ?
+			out->master.inputChannels :
+			out->mix.inputChannels;
+		FAudio_memcpy(
+			params->sendCoefficients[i],
+			voice->sendCoefficients[i],
+			sizeof(float) * voice->outputChannels * oChan
+		);
+		if (voice->sends.pSends[i].Flags & FAUDIO_SEND_USEFILTER)
+		{
+			params->sendFilter[i] = voice->sendFilter[i];
+		}
+	}
+}
+
+void FAudio_INTERNAL_AllocParameters(FAudioVoice *voice)
+{
+	uint32_t i, j, oChan;
+	FAudioVoice *out;
+	FAudioVoiceParameters *params;
+
+	/* The caller holds the mix lock for this voice as well as sendLock,
+	 * so neither the mixer nor PublishParameters can see the old arrays.
+	 */
+	FAudio_INTERNAL_FreeParameters(voice);
+	for (i = 0; i < 3; i += 1)
+	{
+		params = &voice->parameters[i];
+		if (voice->type != FAUDIO_VOICE_MASTER)
+		{
+			params->channelVolume = (float*) voice->audio->pMalloc(
+				sizeof(float) * voice->outputChannels
+			);
+			params->sendCount = voice->sends.SendCount;
+		}
+		if (params->sendCount > 0)
+		{
+			params->sendCoefficients = (float**) voice->audio->pMalloc(
+				sizeof(float*) * params->sendCount
+			);
+			params->sendFilter = (FAudioFilterParameters*) voice->audio->pMalloc(
+				sizeof(FAudioFilterParameters) * params->sendCount
+			);
+			for (j = 0; j < params->sendCount; j += 1)
+			{
+				out = voice->sends.pSends[j].pOutputVoice;
+				oChan = (out->type == FAUDIO_VOICE_MASTER) ?
+					out->master.inputChannels :
+					out->mix.inputChannels;
+				params->sendCoefficients[j] = (float*) voice->audio->pMalloc(
+					sizeof(float) * voice->outputChannels * oChan
+				);
+			}
+		}
+		FAudio_INTERNAL_CopyParameters(voice, params);
+	}
+	voice->parametersBack = 0;
+	voice->parametersFront = 1;
+	FAudio_PlatformAtomicSet(&voice->parametersShared, 2);
+}
+
+void FAudio_INTERNAL_FreeParameters(FAudioVoice *voice)
+{
+	uint32_t i, j;
+	FAudioVoiceParameters *params;
+
+	for (i = 0; i < 3; i += 1)
+	{
+		params = &voice->parameters[i];
+		if (params->channelVolume != NULL)
+		{
+			voice->audio->pFree(params->channelVolume);
+			params->channelVolume = NULL;
+		}
+		if (params->sendCount > 0)
+		{
+			for (j = 0; j < params->sendCount; j += 1)
+			{
+				voice->audio->pFree(params->sendCoefficients[j]);
+			}
+			voice->audio->pFree(params->sendCoefficients);
+			voice->audio->pFree(params->sendFilter);
+			params->sendCoefficients = NULL;
+			params->sendFilter = NULL;
+			params->sendCount = 0;
+		}
+	}
+}
+
+void FAudio_INTERNAL_PublishParameters(FAudioVoice *voice)
+{
+	if (voice->type != FAUDIO_VOICE_MASTER)
+	{
+		FAudio_PlatformLockMutex(voice->sendLock);
+		LOG_MUTEX_LOCK(voice->audio, voice->sendLock)
+		FAudio_PlatformLockMutex(voice->filterLock);
+		LOG_MUTEX_LOCK(voice->audio, voice->filterLock)
+	}
+	FAudio_PlatformLockMutex(voice->volumeLock);
+	LOG_MUTEX_LOCK(voice->audio, voice->volumeLock)
+
+	FAudio_INTERNAL_CopyParameters(
+		voice,
+		&voice->parameters[voice->parametersBack]
+	);
+	voice->parametersBack = FAudio_PlatformAtomicSet(
+		&voice->parametersShared,
+		voice->parametersBack | PARAMETERS_DIRTY
+	) & PARAMETERS_INDEX;
+
+	FAudio_PlatformUnlockMutex(voice->volumeLock);
+	LOG_MUTEX_UNLOCK(voice->audio, voice->volumeLock)
+	if (voice->type != FAUDIO_VOICE_MASTER)
+	{
+		FAudio_PlatformUnlockMutex(voice->filterLock);
+		LOG_MUTEX_UNLOCK(voice->audio, voice->filterLock)
+		FAudio_PlatformUnlockMutex(voice->sendLock);
+		LOG_MUTEX_UNLOCK(voice->audio, voice->sendLock)
+	}
+}
+
+static inline FAudioVoiceParameters* FAudio_INTERNAL_AcquireParameters(
+	FAudioVoice *voice
+) {
+	if (FAudio_PlatformAtomicGet(&voice->parametersShared) & PARAMETERS_DIRTY)
+	{
+		voice->parametersFront = FAudio_PlatformAtomicSet(
+			&voice->parametersShared,
+			voice->parametersFront
+		) & PARAMETERS_INDEX;
+	}
+	return &voice->parameters[voice->parametersFront];
+}
+
 static uint32_t FAudio_INTERNAL_GetBytesRequested(
 	FAudioSourceVoice *voice,
 	uint32_t decoding
 ) {
-	uint32_t end, result;
+	uint32_t i, end, result;
 	FAudioBuffer *buffer;
 	FAudioWaveFormatExtensible *fmt;
-	FAudioBufferEntry *list = voice->src.bufferList;
+	FAudioBufferEntry *list = FAudio_INTERNAL_PeekBuffer(voice, 0);
 
 	LOG_FUNC_ENTER(voice->audio)
 
@@ -313,6 +648,7 @@ static uint32_t FAudio_INTERNAL_GetBytesRequested(
 		return 0;
 	}
 #endif /* HAVE_FFMPEG */
+	i = 0;
 	while (list != NULL && decoding > 0)
 	{
 		buffer = &list->buffer;
@@ -337,7 +673,7 @@ static uint32_t FAudio_INTERNAL_GetBytesRequested(
 			break;
 		}
 		decoding -= end;
-		list = list->next;
+		list = FAudio_INTERNAL_PeekBuffer(voice, ++i);
 	}
 
 	/* Convert samples to bytes, factoring block alignment */
@@ -358,13 +694,35 @@ static uint32_t FAudio_INTERNAL_GetBytesRequested(
 	return result;
 }
 
+static inline void FAudio_INTERNAL_StartBuffer(
+	FAudioSourceVoice *voice,
+	FAudioBuffer *buffer
+) {
+	voice->src.newBuffer = 0;
+	FAudio_PlatformAtomicSetPtr(
+		&voice->src.curBufferContext,
+		buffer->pContext
+	);
+	if (	voice->src.callback != NULL &&
+		voice->src.callback->OnBufferStart != NULL	)
+	{
+		voice->src.callback->OnBufferStart(
+			voice->src.callback,
+			buffer->pContext
+		);
+	}
+}
+
 static void FAudio_INTERNAL_DecodeBuffers(
 	FAudioSourceVoice *voice,
+	float *decodeCache,
 	uint64_t *toDecode
 ) {
 	uint32_t end, endRead, decoding, decoded = 0;
-	FAudioBuffer *buffer = &voice->src.bufferList->buffer;
-	FAudioBufferEntry *toDelete;
+	FAudioBuffer *buffer = &voice->src.curBuffer.buffer;
+	FAudioBufferEntry *next;
+	void *finishedContext;
+	uint32_t finishedFlags;
 
 	LOG_FUNC_ENTER(voice->audio)
 
@@ -378,15 +736,7 @@ static void FAudio_INTERNAL_DecodeBuffers(
 		/* Start-of-buffer behavior */
 		if (voice->src.newBuffer)
 		{
-			voice->src.newBuffer = 0;
-			if (	voice->src.callback != NULL &&
-				voice->src.callback->OnBufferStart != NULL	)
-			{
-				voice->src.callback->OnBufferStart(
-					voice->src.callback,
-					buffer->pContext
-				);
-			}
+			FAudio_INTERNAL_StartBuffer(voice, buffer);
 		}
 
 		/* Check for end-of-buffer */
@@ -402,7 +752,7 @@ static void FAudio_INTERNAL_DecodeBuffers(
 		voice->src.decode(
 			voice,
 			buffer,
-			voice->audio->decodeCache + (
+			decodeCache + (
 				decoded * voice->src.format->nChannels
 			),
 			endRead
@@ -463,13 +813,14 @@ static void FAudio_INTERNAL_DecodeBuffers(
 					buffer
 				);
 
-				/* Change active buffer, delete finished buffer */
-				toDelete = voice->src.bufferList;
-				voice->src.bufferList = voice->src.bufferList->next;
-				if (voice->src.bufferList != NULL)
+				/* Change active buffer, recycle finished buffer */
+				finishedContext = buffer->pContext;
+				finishedFlags = buffer->Flags;
+				FAudio_INTERNAL_PopBuffer(voice);
+				next = FAudio_INTERNAL_PeekBuffer(voice, 0);
+				if (next != NULL)
 				{
-					buffer = &voice->src.bufferList->buffer;
-					voice->src.curBufferOffset = buffer->PlayBegin;
+					buffer = &next->buffer;
 				}
 				else
 				{
@@ -477,7 +828,7 @@ static void FAudio_INTERNAL_DecodeBuffers(
 
 					/* FIXME: I keep going past the buffer so fuck it */
 					FAudio_zero(
-						voice->audio->decodeCache + (
+						decodeCache + (
 							decoded *
 							voice->src.format->nChannels
 						),
@@ -495,10 +846,10 @@ static void FAudio_INTERNAL_DecodeBuffers(
 					{
 						voice->src.callback->OnBufferEnd(
 							voice->src.callback,
-							toDelete->buffer.pContext
+							finishedContext
 						);
 					}
-					if (	toDelete->buffer.Flags & FAUDIO_END_OF_STREAM &&
+					if (	finishedFlags & FAUDIO_END_OF_STREAM &&
 						voice->src.callback->OnStreamEnd != NULL	)
 					{
 						voice->src.callback->OnStreamEnd(
@@ -507,10 +858,13 @@ static void FAudio_INTERNAL_DecodeBuffers(
 					}
 
 					/* One last chance at redemption */
-					if (buffer == NULL && voice->src.bufferList != NULL)
+					if (buffer == NULL)
 					{
-						buffer = &voice->src.bufferList->buffer;
-						voice->src.curBufferOffset = buffer->PlayBegin;
+						next = FAudio_INTERNAL_PeekBuffer(voice, 0);
+						if (next != NULL)
+						{
+							buffer = &next->buffer;
+						}
 					}
 
 					if (buffer != NULL && voice->src.callback->OnBufferStart != NULL)
@@ -521,8 +875,6 @@ static void FAudio_INTERNAL_DecodeBuffers(
 						);
 					}
 				}
-
-				voice->audio->pFree(toDelete);
 			}
 		}
 	}
@@ -541,7 +893,7 @@ static void FAudio_INTERNAL_DecodeBuffers(
 		voice->src.decode(
 			voice,
 			buffer,
-			voice->audio->decodeCache + (
+			decodeCache + (
 				decoded * voice->src.format->nChannels
 			),
 			endRead
@@ -551,7 +903,7 @@ static void FAudio_INTERNAL_DecodeBuffers(
 		if (endRead < EXTRA_DECODE_PADDING)
 		{
 			FAudio_zero(
-				voice->audio->decodeCache + (
+				decodeCache + (
 					decoded * voice->src.format->nChannels
 				),
 				sizeof(float) * (
@@ -564,7 +916,7 @@ static void FAudio_INTERNAL_DecodeBuffers(
 	else
 	{
 		FAudio_zero(
-			voice->audio->decodeCache + (
+			decodeCache + (
 				decoded * voice->src.format->nChannels
 			),
 			sizeof(float) * (
@@ -578,69 +930,47 @@ static void FAudio_INTERNAL_DecodeBuffers(
 	LOG_FUNC_EXIT(voice->audio)
 }
 
-static inline void FAudio_INTERNAL_FilterVoice(
+static inline void FAudio_INTERNAL_ResizeWorkerCache(
 	FAudio *audio,
-	const FAudioFilterParameters *filter,
-	FAudioFilterState *filterState,
-	float *samples,
-	uint32_t numSamples,
-	uint16_t numChannels
+	float **cache,
+	uint32_t *cacheSamples,
+	uint32_t samples
 ) {
-	uint32_t j, ci;
-
-	LOG_FUNC_ENTER(audio)
-
-	/* Apply a digital state-variable filter to the voice.
-	 * The difference equations of the filter are:
-	 *
-	 * Yl(n) = F Yb(n - 1) + Yl(n - 1)
-	 * Yh(n) = x(n) - Yl(n) - OneOverQ Yb(n - 1)
-	 * Yb(n) = F Yh(n) + Yb(n - 1)
-	 * Yn(n) = Yl(n) + Yh(n)
-	 *
-	 * Please note that FAudioFilterParameters.Frequency is defined as:
-	 *
-	 * (2 * sin(pi * (desired filter cutoff frequency) / sampleRate))
-	 *
-	 * - @JohanSmet
-	 */
-
-	for (j = 0; j < numSamples; j += 1)
-	for (ci = 0; ci < numChannels; ci += 1)
+	if (samples > *cacheSamples)
 	{
-		filterState[ci][FAudioLowPassFilter] = filterState[ci][FAudioLowPassFilter] + (filter->Frequency * filterState[ci][FAudioBandPassFilter]);
-		filterState[ci][FAudioHighPassFilter] = samples[j * numChannels + ci] - filterState[ci][FAudioLowPassFilter] - (filter->OneOverQ * filterState[ci][FAudioBandPassFilter]);
-		filterState[ci][FAudioBandPassFilter] = (filter->Frequency * filterState[ci][FAudioHighPassFilter]) + filterState[ci][FAudioBandPassFilter];
-		filterState[ci][FAudioNotchFilter] = filterState[ci][FAudioHighPassFilter] + filterState[ci][FAudioLowPassFilter];
-		samples[j * numChannels + ci] = filterState[ci][filter->Type];
+		FAudio_PlatformAtomicAdd(
+			&audio->mixerCacheBytes,
+			(int32_t) (sizeof(float) * (samples - *cacheSamples))
+		);
+		*cacheSamples = samples;
+		*cache = (float*) audio->pRealloc(
+			*cache,
+			sizeof(float) * samples
+		);
 	}
-
-	LOG_FUNC_EXIT(audio)
 }
 
+/* `silent` says whether the buffer is known to be all zeroes, and on return
+ * whether the effects said their output was.
+ */
 static inline float *FAudio_INTERNAL_ProcessEffectChain(
 	FAudioVoice *voice,
+	FAudioMixWorker *worker,
 	float *buffer,
-	uint32_t *samples
+	uint32_t *samples,
+	uint8_t *silent
 ) {
 	uint32_t i;
 	FAPO *fapo;
+	FAudioEffectParameterBlock *block;
 	FAPOProcessBufferParameters srcParams, dstParams;
 
 	LOG_FUNC_ENTER(voice->audio)
 
 	/* Set up the buffer to be written into */
 	srcParams.pBuffer = buffer;
-	srcParams.BufferFlags = FAPO_BUFFER_SILENT;
+	srcParams.BufferFlags = *silent ? FAPO_BUFFER_SILENT : FAPO_BUFFER_VALID;
 	srcParams.ValidFrameCount = *samples;
-	for (i = 0; i < srcParams.ValidFrameCount; i += 1)
-	{
-		if (buffer[i] != 0.0f) /* Arbitrary! */
-		{
-			srcParams.BufferFlags = FAPO_BUFFER_VALID;
-			break;
-		}
-	}
 
 	/* Initialize output parameters to something sane */
 	dstParams.pBuffer = srcParams.pBuffer;
@@ -656,11 +986,13 @@ static inline float *FAudio_INTERNAL_ProcessEffectChain(
 		{
 			if (dstParams.pBuffer == buffer)
 			{
-				FAudio_INTERNAL_ResizeEffectChainCache(
+				FAudio_INTERNAL_ResizeWorkerCache(
 					voice->audio,
+					&worker->effectChainCache,
+					&worker->effectChainSamples,
 					voice->effects.desc[i].OutputChannels * srcParams.ValidFrameCount
 				);
-				dstParams.pBuffer = voice->audio->effectChainCache;
+				dstParams.pBuffer = worker->effectChainCache;
 			}
 			else
 			{
@@ -676,14 +1008,21 @@ static inline float *FAudio_INTERNAL_ProcessEffectChain(
 			);
 		}
 
-		if (voice->effects.parameterUpdates[i])
+		/* Not every FAPO sets this, assume they wrote something */
+		dstParams.BufferFlags = FAPO_BUFFER_VALID;
+
+		block = (FAudioEffectParameterBlock*) FAudio_PlatformAtomicSetPtr(
+			(void**) &voice->effects.parameters[i],
+			NULL
+		);
+		if (block != NULL)
 		{
 			fapo->SetParameters(
 				fapo,
-				voice->effects.parameters[i],
-				voice->effects.parameterSizes[i]
+				block + 1,
+				(uint32_t) block->size
 			);
-			voice->effects.parameterUpdates[i] = 0;
+			voice->audio->pFree(block);
 		}
 
 		fapo->Process(
@@ -699,127 +1038,305 @@ static inline float *FAudio_INTERNAL_ProcessEffectChain(
 	}
 
 	*samples = dstParams.ValidFrameCount;
+	*silent = (dstParams.BufferFlags == FAPO_BUFFER_SILENT);
 
 	LOG_FUNC_EXIT(voice->audio)
 	return (float*) dstParams.pBuffer;
 }
 
-static void FAudio_INTERNAL_MixSource(FAudioSourceVoice *voice)
+static inline uint32_t FAudio_INTERNAL_GetInputSamples(FAudioVoice *voice)
 {
-	/* Iterators */
-	uint32_t i;
-	/* Decode/Resample variables */
-	uint64_t toDecode;
-	uint64_t toResample;
-	/* Output mix variables */
+	if (voice->type == FAUDIO_VOICE_MASTER)
+	{
+		return voice->audio->updateSize * voice->master.inputChannels;
+	}
+	return voice->mix.inputSamples;
+}
+
+/* Returns where to mix into `out`, marking its first `frames` frames dirty */
+static inline float *FAudio_INTERNAL_GetSendStream(
+	FAudioMixWorker *worker,
+	FAudioVoice *out,
+	uint32_t frames,
+	uint32_t *oChan
+) {
+	uint32_t samples;
 	float *stream;
-	uint32_t mixed;
-	uint32_t oChan;
+
+	if (out->type == FAUDIO_VOICE_MASTER)
+	{
+		stream = out->master.output;
+		*oChan = out->master.inputChannels;
+	}
+	else
+	{
+		stream = out->mix.inputCache;
+		*oChan = out->mix.inputChannels;
+	}
+	if (worker->index == 0)
+	{
+		out->workerDirty[0] = FAudio_max(out->workerDirty[0], frames);
+		return stream;
+	}
+
+	/* Everyone but the engine thread mixes into a private buffer, which
+	 * gets summed into the real one by ReduceMixWorkers.
+	 */
+	if (out->workerDirty[worker->index] == 0)
+	{
+		if (out->workerCache[worker->index] == NULL)
+		{
+			samples = FAudio_INTERNAL_GetInputSamples(out);
+			out->workerCache[worker->index] = (float*) out->audio->pMalloc(
+				sizeof(float) * samples
+			);
+			FAudio_PlatformAtomicAdd(
+				&out->audio->mixerCacheBytes,
+				(int32_t) (sizeof(float) * samples)
+			);
+			FAudio_zero(
+				out->workerCache[worker->index],
+				sizeof(float) * samples
+			);
+		}
+		if (worker->dirtyCount == worker->dirtyCapacity)
+		{
+			worker->dirtyCapacity += 8;
+			FAudio_PlatformAtomicAdd(
+				&out->audio->mixerCacheBytes,
+				(int32_t) (sizeof(FAudioVoice*) * 8)
+			);
+			worker->dirty = (FAudioVoice**) out->audio->pRealloc(
+				worker->dirty,
+				sizeof(FAudioVoice*) * worker->dirtyCapacity
+			);
+		}
+		worker->dirty[worker->dirtyCount++] = out;
+	}
+	out->workerDirty[worker->index] = FAudio_max(
+		out->workerDirty[worker->index],
+		frames
+	);
+	return out->workerCache[worker->index];
+}
+
+FAudioResampleCallback FAudio_INTERNAL_GetResampler(
+	uint64_t resampleStep,
+	uint32_t channels
+) {
+	/* Exact 2:1 and 4:1 ratios, in either direction, get their own
+	 * resamplers. Other "nice" ratios like 44100:48000 aren't exact in
+	 * fixed point, so those still need the per-frame fractions.
+	 */
+	uint8_t up = (
+		resampleStep == FIXED_ONE / 2 ||
+		resampleStep == FIXED_ONE / 4
+	);
+	uint8_t down = (
+		resampleStep == FIXED_ONE * 2 ||
+		resampleStep == FIXED_ONE * 4
+	);
+
+	switch (channels)
+	{
+	case 1:
+		return up ? FAudio_INTERNAL_ResampleUpMono :
+			down ? FAudio_INTERNAL_ResampleDownMono :
+			FAudio_INTERNAL_ResampleMono;
+	case 2:
+		return up ? FAudio_INTERNAL_ResampleUpStereo :
+			down ? FAudio_INTERNAL_ResampleDownStereo :
+			FAudio_INTERNAL_ResampleStereo;
+	/* The SIMD multichannel resamplers beat the ratio ones anyway */
+	case 4:
+		return FAudio_INTERNAL_Resample4Channel;
+	case 6:
+		return FAudio_INTERNAL_Resample6Channel;
+	case 8:
+		return FAudio_INTERNAL_Resample8Channel;
+	default:
+		return up ? FAudio_INTERNAL_ResampleUpGeneric :
+			down ? FAudio_INTERNAL_ResampleDownGeneric :
+			FAudio_INTERNAL_ResampleGeneric;
+	}
+}
+
+static void FAudio_INTERNAL_UpdateResampleStep(
+	FAudioSourceVoice *voice,
+	FAudioVoiceParameters *params
+) {
 	FAudioVoice *out;
 	uint32_t outputRate;
 	double stepd;
-	float *finalSamples;
-
-	LOG_FUNC_ENTER(voice->audio)
 
 	/* Calculate the resample stepping value */
-	if (voice->src.resampleFreq != voice->src.freqRatio * voice->src.format->nSamplesPerSec)
+	if (voice->src.resampleFreq != params->freqRatio * voice->src.format->nSamplesPerSec)
 	{
-		FAudio_PlatformLockMutex(voice->sendLock);
-		LOG_MUTEX_LOCK(voice->audio, voice->sendLock)
 		out = (voice->sends.SendCount == 0) ?
 			voice->audio->master : /* Barf */
 			voice->sends.pSends->pOutputVoice;
-		FAudio_PlatformUnlockMutex(voice->sendLock);
-		LOG_MUTEX_UNLOCK(voice->audio, voice->sendLock)
 		outputRate = (out->type == FAUDIO_VOICE_MASTER) ?
 			out->master.inputSampleRate :
 			out->mix.inputSampleRate;
 		stepd = (
-			voice->src.freqRatio *
+			params->freqRatio *
 			(double) voice->src.format->nSamplesPerSec /
 			(double) outputRate
 		);
 		voice->src.resampleStep = DOUBLE_TO_FIXED(stepd);
-		voice->src.resampleFreq = voice->src.freqRatio * voice->src.format->nSamplesPerSec;
-	}
-
-	if (voice->src.active == 2)
-	{
-		/* We're just playing tails, skip all buffer stuff */
-		mixed = voice->src.resampleSamples;
-		FAudio_zero(
-			voice->audio->resampleCache,
-			mixed * voice->src.format->nChannels * sizeof(float)
+		voice->src.resampleFreq = params->freqRatio * voice->src.format->nSamplesPerSec;
+		voice->src.resample = FAudio_INTERNAL_GetResampler(
+			voice->src.resampleStep,
+			voice->src.format->nChannels
 		);
-		finalSamples = voice->audio->resampleCache;
-		goto sendwork;
 	}
+}
+
+static inline uint64_t FAudio_INTERNAL_GetFramesToDecode(
+	FAudioSourceVoice *voice,
+	uint32_t frames
+) {
+	uint64_t toDecode;
 
 	/* Base decode size, int to fixed... */
-	toDecode = voice->src.resampleSamples * voice->src.resampleStep;
+	toDecode = frames * voice->src.resampleStep;
 	/* ... rounded up based on current offset... */
 	toDecode += voice->src.curBufferOffsetDec + FIXED_FRACTION_MASK;
 	/* ... fixed to int, truncating extra fraction from rounding. */
-	toDecode >>= FIXED_PRECISION;
+	return toDecode >> FIXED_PRECISION;
+}
 
-	FAudio_PlatformLockMutex(voice->src.bufferLock);
-	LOG_MUTEX_LOCK(voice->audio, voice->src.bufferLock)
+static void FAudio_INTERNAL_DecodeSource(
+	FAudioSourceVoice *voice,
+	FAudioMixWorker *worker,
+	uint64_t *toDecode
+) {
+	/* Decode... */
+	FAudio_INTERNAL_DecodeBuffers(voice, worker->decodeCache, toDecode);
 
-	/* First voice callback */
-	if (	voice->src.callback != NULL &&
-		voice->src.callback->OnVoiceProcessingPassStart != NULL	)
+	/* Subtract any padding samples from the total, if applicable */
+	if (	voice->src.curBufferOffsetDec > 0 &&
+		voice->src.totalSamples > 0	)
 	{
-		voice->src.callback->OnVoiceProcessingPassStart(
-			voice->src.callback,
-			FAudio_INTERNAL_GetBytesRequested(voice, (uint32_t) toDecode)
-		);
+		voice->src.totalSamples -= 1;
 	}
+}
 
-	/* Nothing to do? */
-	if (voice->src.bufferList == NULL)
+static inline const float *FAudio_INTERNAL_GetSincTable(
+	FAudio *audio,
+	uint64_t resampleStep
+) {
+	uint32_t i = 0;
+	while (	i < SINC_CUTOFFS - 1 &&
+		resampleStep > DOUBLE_TO_FIXED(FAUDIO_INTERNAL_SINC_STEPS[i])	)
 	{
-		FAudio_PlatformUnlockMutex(voice->src.bufferLock);
-		LOG_MUTEX_UNLOCK(voice->audio, voice->src.bufferLock)
-		if (	voice->src.callback != NULL &&
-			voice->src.callback->OnVoiceProcessingPassEnd != NULL)
-		{
-			voice->src.callback->OnVoiceProcessingPassEnd(
-				voice->src.callback
-			);
-		}
-		LOG_FUNC_EXIT(voice->audio)
-		return;
+		i += 1;
 	}
+	return audio->sincTable + (i * SINC_PHASES * SINC_ROW);
+}
 
-	/* Decode... */
-	FAudio_INTERNAL_DecodeBuffers(voice, &toDecode);
+/* ResampleSource for voices using the sinc resampler. The frames it needs
+ * from before decodeCache are carried over from the last call in sincHistory.
+ */
+static float *FAudio_INTERNAL_ResampleSinc(
+	FAudioSourceVoice *voice,
+	FAudioMixWorker *worker,
+	uint64_t toResample
+) {
+	uint32_t channels = voice->src.format->nChannels;
+	float *history = worker->decodeCache - (SINC_HISTORY * channels);
+	float *finalSamples;
+	uint64_t consumed;
 
-	/* Subtract any padding samples from the total, if applicable */
-	if (	voice->src.curBufferOffsetDec > 0 &&
-		voice->src.totalSamples > 0	)
-	{
-		voice->src.totalSamples -= 1;
-	}
+	FAudio_memcpy(
+		history,
+		voice->src.sincHistory,
+		sizeof(float) * SINC_HISTORY * channels
+	);
 
-	/* Okay, we're done messing with client data */
-	if (	voice->src.callback != NULL &&
-		voice->src.callback->OnVoiceProcessingPassEnd != NULL)
+	/* Where the next decode will start, relative to decodeCache */
+	consumed = (
+		(voice->src.resampleOffset & FIXED_FRACTION_MASK) +
+		(toResample * voice->src.resampleStep)
+	) >> FIXED_PRECISION;
+
+	if (voice->src.resampleStep == FIXED_ONE)
 	{
-		voice->src.callback->OnVoiceProcessingPassEnd(
-			voice->src.callback
-		);
+		/* Still delayed, or leaving 1.0 would skip back */
+		finalSamples = worker->decodeCache - (SINC_DELAY * channels);
 	}
-
-	/* Nothing to resample? */
-	if (toDecode == 0)
+	else
 	{
-		FAudio_PlatformUnlockMutex(voice->src.bufferLock);
-		LOG_MUTEX_UNLOCK(voice->audio, voice->src.bufferLock)
-		LOG_FUNC_EXIT(voice->audio)
-		return;
+		if (channels == 1)
+		{
+			FAudio_INTERNAL_ResampleSincMono(
+				worker->decodeCache,
+				worker->resampleCache,
+				&voice->src.resampleOffset,
+				voice->src.resampleStep,
+				toResample,
+				1,
+				FAudio_INTERNAL_GetSincTable(
+					voice->audio,
+					voice->src.resampleStep
+				)
+			);
+		}
+		else if (channels == 2)
+		{
+			FAudio_INTERNAL_ResampleSincStereo(
+				worker->decodeCache,
+				worker->resampleCache,
+				&voice->src.resampleOffset,
+				voice->src.resampleStep,
+				toResample,
+				2,
+				FAudio_INTERNAL_GetSincTable(
+					voice->audio,
+					voice->src.resampleStep
+				)
+			);
+		}
+		else
+		{
+			FAudio_INTERNAL_ResampleSincGeneric(
+				worker->decodeCache,
+				worker->resampleCache,
+				&voice->src.resampleOffset,
+				voice->src.resampleStep,
+				toResample,
+				(uint8_t) channels,
+				FAudio_INTERNAL_GetSincTable(
+					voice->audio,
+					voice->src.resampleStep
+				)
+			);
+		}
+		finalSamples = worker->resampleCache;
 	}
 
+	/* Save this before anything gets filtered in place */
+	FAudio_memcpy(
+		voice->src.sincHistory,
+		history + (consumed * channels),
+		sizeof(float) * SINC_HISTORY * channels
+	);
+	return finalSamples;
+}
+
+/* Resamples what DecodeSource wrote into decodeCache, producing up to
+ * `frames` frames of output.
+ */
+static float *FAudio_INTERNAL_ResampleSource(
+	FAudioSourceVoice *voice,
+	FAudioMixWorker *worker,
+	uint64_t toDecode,
+	uint32_t frames,
+	uint32_t *mixed
+) {
+	uint64_t toResample;
+	float *finalSamples;
+
 	/* int to fixed... */
 	toResample = toDecode << FIXED_PRECISION;
 	/* ... round back down based on current offset... */
@@ -831,29 +1348,37 @@ static void FAudio_INTERNAL_MixSource(FAudioSourceVoice *voice)
 	/* Add the padding, for some reason this helps? */
 	toResample += EXTRA_DECODE_PADDING;
 	/* FIXME: I feel like this should be an assert but I suck */
-	toResample = FAudio_min(toResample, voice->src.resampleSamples);
+	toResample = FAudio_min(toResample, frames);
 
 	/* Resample... */
-	if (voice->src.resampleStep == FIXED_ONE)
+	if (voice->src.sincHistory != NULL)
+	{
+		finalSamples = FAudio_INTERNAL_ResampleSinc(
+			voice,
+			worker,
+			toResample
+		);
+	}
+	else if (voice->src.resampleStep == FIXED_ONE)
 	{
 		/* Actually, just use the existing buffer... */
-		finalSamples = voice->audio->decodeCache;
+		finalSamples = worker->decodeCache;
 	}
 	else
 	{
 		voice->src.resample(
-			voice->audio->decodeCache,
-			voice->audio->resampleCache,
+			worker->decodeCache,
+			worker->resampleCache,
 			&voice->src.resampleOffset,
 			voice->src.resampleStep,
 			toResample,
 			(uint8_t) voice->src.format->nChannels
 		);
-		finalSamples = voice->audio->resampleCache;
+		finalSamples = worker->resampleCache;
 	}
 
 	/* Update buffer offsets */
-	if (voice->src.bufferList != NULL)
+	if (voice->src.hasCurBuffer)
 	{
 		/* Increment fixed offset by resample size, int to fixed... */
 		voice->src.curBufferOffsetDec += toResample * voice->src.resampleStep;
@@ -875,46 +1400,246 @@ static void FAudio_INTERNAL_MixSource(FAudioSourceVoice *voice)
 		voice->src.curBufferOffset = 0;
 	}
 
-	/* Done with buffers, finally. */
-	FAudio_PlatformUnlockMutex(voice->src.bufferLock);
-	LOG_MUTEX_UNLOCK(voice->audio, voice->src.bufferLock)
-	mixed = (uint32_t) toResample;
+	*mixed = (uint32_t) toResample;
+	return finalSamples;
+}
+
+/* PCM voices playing at their native rate, without a filter, need neither the
+ * resampler nor a copy of their samples that can be modified, so the sends can
+ * read the client's buffer directly for float, or a single conversion of it
+ * for integer formats. Returns how many of the next frames can be read that
+ * way, up to the end of the current buffer, or 0 if the voice has to go
+ * through DecodeSource and ResampleSource.
+ */
+static inline uint32_t FAudio_INTERNAL_GetDirectFrames(
+	FAudioSourceVoice *voice,
+	uint32_t frames
+) {
+	uint32_t end;
+	FAudioBuffer *buffer = &voice->src.curBuffer.buffer;
+
+	if (	voice->src.resampleStep != FIXED_ONE ||
+		voice->src.curBufferOffsetDec != 0 ||
+		voice->src.sincHistory != NULL ||
+		(voice->flags & FAUDIO_VOICE_USEFILTER)	)
+	{
+		return 0;
+	}
+	if (	voice->src.decode == FAudio_INTERNAL_DecodePCM8 ||
+		voice->src.decode == FAudio_INTERNAL_DecodePCM16 ||
+		voice->src.decode == FAudio_INTERNAL_DecodePCM24	)
+	{
+		/* Still converted, keep it in L1 like MixSourceBlocks */
+		frames = FAudio_min(frames, MIX_BLOCK_FRAMES);
+	}
+	else if (voice->src.decode != FAudio_INTERNAL_DecodePCM32F)
+	{
+		return 0;
+	}
+
+	/* Loop and buffer ends are left to DecodeBuffers */
+	end = (buffer->LoopCount > 0) ?
+		(buffer->LoopBegin + buffer->LoopLength) :
+		buffer->PlayBegin + buffer->PlayLength;
+	if (voice->src.curBufferOffset >= end)
+	{
+		return 0;
+	}
+	return FAudio_min(frames, end - voice->src.curBufferOffset);
+}
+
+static float *FAudio_INTERNAL_ReadSourceDirect(
+	FAudioSourceVoice *voice,
+	FAudioMixWorker *worker,
+	uint32_t frames
+) {
+	float *samples;
+	FAudioBuffer *buffer = &voice->src.curBuffer.buffer;
+
+	if (voice->src.newBuffer)
+	{
+		FAudio_INTERNAL_StartBuffer(voice, buffer);
+	}
+
+	if (voice->src.decode == FAudio_INTERNAL_DecodePCM32F)
+	{
+		/* SendSource only reads from this without filters or effects */
+		samples = ((float*) buffer->pAudioData) + (
+			voice->src.curBufferOffset * voice->src.format->nChannels
+		);
+	}
+	else
+	{
+		/* No EXTRA_DECODE_PADDING, there's nothing to interpolate */
+		voice->src.decode(voice, buffer, worker->decodeCache, frames);
+		samples = worker->decodeCache;
+	}
+
+	voice->src.curBufferOffset += frames;
+	voice->src.totalSamples += frames;
+	return samples;
+}
+
+/* Decodes and resamples the voice into the worker's caches, returning the
+ * samples to be filtered and sent (or NULL if there are none).
+ */
+static float *FAudio_INTERNAL_RenderSource(
+	FAudioSourceVoice *voice,
+	FAudioMixWorker *worker,
+	FAudioVoiceParameters *params,
+	uint32_t *mixed
+) {
+	uint64_t toDecode;
+	float *finalSamples;
+
+	LOG_FUNC_ENTER(voice->audio)
+
+	FAudio_INTERNAL_UpdateResampleStep(voice, params);
+
+	if (voice->src.active == 2)
+	{
+		/* We're just playing tails, skip all buffer stuff */
+		*mixed = voice->src.resampleSamples;
+		FAudio_zero(
+			worker->resampleCache,
+			*mixed * voice->src.format->nChannels * sizeof(float)
+		);
+		LOG_FUNC_EXIT(voice->audio)
+		return worker->resampleCache;
+	}
+
+	toDecode = FAudio_INTERNAL_GetFramesToDecode(
+		voice,
+		voice->src.resampleSamples
+	);
+
+	/* First voice callback */
+	if (	voice->src.callback != NULL &&
+		voice->src.callback->OnVoiceProcessingPassStart != NULL	)
+	{
+		voice->src.callback->OnVoiceProcessingPassStart(
+			voice->src.callback,
+			FAudio_INTERNAL_GetBytesRequested(voice, (uint32_t) toDecode)
+		);
+	}
+
+	/* Nothing to do? */
+	if (FAudio_INTERNAL_PeekBuffer(voice, 0) == NULL)
+	{
+		if (	voice->src.callback != NULL &&
+			voice->src.callback->OnVoiceProcessingPassEnd != NULL)
+		{
+			voice->src.callback->OnVoiceProcessingPassEnd(
+				voice->src.callback
+			);
+		}
+		LOG_FUNC_EXIT(voice->audio)
+		return NULL;
+	}
+
+	FAudio_INTERNAL_DecodeSource(voice, worker, &toDecode);
+
+	/* Okay, we're done messing with client data */
+	if (	voice->src.callback != NULL &&
+		voice->src.callback->OnVoiceProcessingPassEnd != NULL)
+	{
+		voice->src.callback->OnVoiceProcessingPassEnd(
+			voice->src.callback
+		);
+	}
+
+	/* Nothing to resample? */
+	if (toDecode == 0)
+	{
+		LOG_FUNC_EXIT(voice->audio)
+		return NULL;
+	}
+
+	finalSamples = FAudio_INTERNAL_ResampleSource(
+		voice,
+		worker,
+		toDecode,
+		voice->src.resampleSamples,
+		mixed
+	);
+	LOG_FUNC_EXIT(voice->audio)
+	return finalSamples;
+}
+
+/* Whether a filter fed silence would only output (near enough) silence */
+static inline uint8_t FAudio_INTERNAL_FilterIsIdle(
+	FAudioFilterState *filterState,
+	uint32_t numChannels
+) {
+	uint32_t i;
+	const float *state = (const float*) filterState;
+	for (i = 0; i < numChannels * 4; i += 1)
+	{
+		if (FAudio_fabsf(state[i]) >= FILTER_IDLE_LEVEL)
+		{
+			return 0;
+		}
+	}
+	return 1;
+}
+
+/* Filters the samples from RenderSource (unless FilterMonoBatch already did),
+ * runs the effect chain and mixes the result into the voice's sends, starting
+ * `offset` frames into the output.
+ */
+static void FAudio_INTERNAL_SendSource(
+	FAudioSourceVoice *voice,
+	FAudioMixWorker *worker,
+	FAudioVoiceParameters *params,
+	float *finalSamples,
+	uint32_t mixed,
+	uint32_t offset,
+	uint8_t filtered
+) {
+	uint32_t i;
+	float *stream;
+	uint32_t oChan;
+	FAudioVoice *out;
+	uint8_t silent;
 
-sendwork:
-	FAudio_PlatformLockMutex(voice->sendLock);
-	LOG_MUTEX_LOCK(voice->audio, voice->sendLock)
+	LOG_FUNC_ENTER(voice->audio)
 
 	/* Nowhere to send it? Just skip the rest...*/
 	if (voice->sends.SendCount == 0)
 	{
-		FAudio_PlatformUnlockMutex(voice->sendLock);
-		LOG_MUTEX_UNLOCK(voice->audio, voice->sendLock)
 		LOG_FUNC_EXIT(voice->audio)
 		return;
 	}
 
+	/* Tails are rendered from a zeroed buffer, see RenderSource */
+	silent = (voice->src.active == 2);
+
 	/* Filters */
-	if (voice->flags & FAUDIO_VOICE_USEFILTER)
+	if ((voice->flags & FAUDIO_VOICE_USEFILTER) && !filtered)
 	{
-		FAudio_PlatformLockMutex(voice->filterLock);
-		LOG_MUTEX_LOCK(voice->audio, voice->filterLock)
-		FAudio_INTERNAL_FilterVoice(
-			voice->audio,
-			&voice->filter,
-			voice->filterState,
-			finalSamples,
-			mixed,
-			voice->src.format->nChannels
-		);
-		FAudio_PlatformUnlockMutex(voice->filterLock);
-		LOG_MUTEX_UNLOCK(voice->audio, voice->filterLock)
+		if (	!silent ||
+			!FAudio_INTERNAL_FilterIsIdle(
+				voice->filterState,
+				voice->src.format->nChannels
+			)	)
+		{
+			FAudio_INTERNAL_FilterVoice(
+				&params->filter,
+				voice->filterState,
+				finalSamples,
+				mixed,
+				voice->src.format->nChannels
+			);
+			silent = 0;
+		}
 	}
 
 	/* Process effect chain */
-	FAudio_PlatformLockMutex(voice->effectLock);
-	LOG_MUTEX_LOCK(voice->audio, voice->effectLock)
 	if (voice->effects.count > 0)
 	{
+		/* Effects always get the whole update, see MixSourceBlocks */
+		FAudio_assert(offset == 0);
+
 		/* If we didn't get the full size of the update, we have to fill
 		 * it with silence so the effect can process a whole update
 		 */
@@ -928,203 +1653,1092 @@ sendwork:
 		}
 		finalSamples = FAudio_INTERNAL_ProcessEffectChain(
 			voice,
+			worker,
 			finalSamples,
-			&mixed
+			&mixed,
+			&silent
+		);
+	}
+
+	/* Send float cache to sends */
+	for (i = 0; i < voice->sends.SendCount; i += 1)
+	{
+		/* Silence adds nothing, but a send filter may still be ringing */
+		if (	silent &&
+			!(voice->sends.pSends[i].Flags & FAUDIO_SEND_USEFILTER)	)
+		{
+			continue;
+		}
+
+		out = voice->sends.pSends[i].pOutputVoice;
+		stream = FAudio_INTERNAL_GetSendStream(
+			worker,
+			out,
+			offset + mixed,
+			&oChan
 		);
+		stream += offset * oChan;
+
+		if (!silent)
+		{
+			voice->sendMix[i](
+				mixed,
+				voice->outputChannels,
+				oChan,
+				params->volume,
+				finalSamples,
+				stream,
+				params->channelVolume,
+				params->sendCoefficients[i]
+			);
+		}
+
+		if (voice->sends.pSends[i].Flags & FAUDIO_SEND_USEFILTER)
+		{
+			FAudio_INTERNAL_FilterVoice(
+				&params->sendFilter[i],
+				voice->sendFilterState[i],
+				stream,
+				mixed,
+				oChan
+			);
+		}
+	}
+	LOG_FUNC_EXIT(voice->audio)
+}
+
+static void FAudio_INTERNAL_MixSource(
+	FAudioSourceVoice *voice,
+	FAudioMixWorker *worker
+) {
+	uint32_t mixed;
+	float *finalSamples;
+	FAudioVoiceParameters *params;
+
+	LOG_FUNC_ENTER(voice->audio)
+
+	/* Sends and effects can only change while sourceLock is held, which
+	 * is the case for this entire function. Everything else comes from
+	 * the latest published parameters.
+	 */
+	params = FAudio_INTERNAL_AcquireParameters(voice);
+
+	finalSamples = FAudio_INTERNAL_RenderSource(voice, worker, params, &mixed);
+	if (finalSamples != NULL)
+	{
+		FAudio_INTERNAL_SendSource(
+			voice,
+			worker,
+			params,
+			finalSamples,
+			mixed,
+			0,
+			0
+		);
+	}
+	LOG_FUNC_EXIT(voice->audio)
+}
+
+/* Like MixSource, but the update is decoded, resampled, filtered and mixed
+ * MIX_BLOCK_FRAMES at a time, so that the worker caches stay small enough to
+ * stay in L1 between each step. Effects need the whole update at once, so
+ * voices with an effect chain (or just playing tails) can't use this.
+ */
+static void FAudio_INTERNAL_MixSourceBlocks(
+	FAudioSourceVoice *voice,
+	FAudioMixWorker *worker
+) {
+	uint64_t toDecode;
+	uint32_t offset, frames, mixed;
+	float *finalSamples;
+	FAudioVoiceParameters *params;
+
+	LOG_FUNC_ENTER(voice->audio)
+
+	FAudio_assert(voice->effects.count == 0);
+	FAudio_assert(voice->src.active != 2);
+
+	params = FAudio_INTERNAL_AcquireParameters(voice);
+	FAudio_INTERNAL_UpdateResampleStep(voice, params);
+
+	/* First voice callback, for the whole update */
+	if (	voice->src.callback != NULL &&
+		voice->src.callback->OnVoiceProcessingPassStart != NULL	)
+	{
+		toDecode = FAudio_INTERNAL_GetFramesToDecode(
+			voice,
+			voice->src.resampleSamples
+		);
+		voice->src.callback->OnVoiceProcessingPassStart(
+			voice->src.callback,
+			FAudio_INTERNAL_GetBytesRequested(voice, (uint32_t) toDecode)
+		);
+	}
+
+	for (offset = 0; offset < voice->src.resampleSamples; offset += mixed)
+	{
+		/* Nothing (left) to do? */
+		if (FAudio_INTERNAL_PeekBuffer(voice, 0) == NULL)
+		{
+			break;
+		}
+
+		/* Can we skip decoding and resampling altogether? */
+		mixed = FAudio_INTERNAL_GetDirectFrames(
+			voice,
+			voice->src.resampleSamples - offset
+		);
+		if (mixed > 0)
+		{
+			finalSamples = FAudio_INTERNAL_ReadSourceDirect(
+				voice,
+				worker,
+				mixed
+			);
+			FAudio_INTERNAL_SendSource(
+				voice,
+				worker,
+				params,
+				finalSamples,
+				mixed,
+				offset,
+				0
+			);
+			continue;
+		}
+
+		frames = FAudio_min(
+			voice->src.resampleSamples - offset,
+			MIX_BLOCK_FRAMES
+		);
+		toDecode = FAudio_INTERNAL_GetFramesToDecode(voice, frames);
+		FAudio_INTERNAL_DecodeSource(voice, worker, &toDecode);
+		if (toDecode == 0)
+		{
+			break;
+		}
+
+		finalSamples = FAudio_INTERNAL_ResampleSource(
+			voice,
+			worker,
+			toDecode,
+			frames,
+			&mixed
+		);
+		FAudio_INTERNAL_SendSource(
+			voice,
+			worker,
+			params,
+			finalSamples,
+			mixed,
+			offset,
+			0
+		);
+
+		/* Ran out of buffers partway through the block? */
+		if (mixed < frames)
+		{
+			break;
+		}
+	}
+
+	/* Okay, we're done messing with client data */
+	if (	voice->src.callback != NULL &&
+		voice->src.callback->OnVoiceProcessingPassEnd != NULL)
+	{
+		voice->src.callback->OnVoiceProcessingPassEnd(
+			voice->src.callback
+		);
+
+		/* MixSource updates the offsets after this callback, so match
+		 * what it would do if the callback flushed the queue.
+		 */
+		if (!voice->src.hasCurBuffer)
+		{
+			voice->src.curBufferOffsetDec = 0;
+			voice->src.curBufferOffset = 0;
+		}
+	}
+	LOG_FUNC_EXIT(voice->audio)
+}
+
+static void FAudio_INTERNAL_FlushFilterBatch(FAudioMixWorker *worker)
+{
+	uint32_t i;
+	const FAudioFilterParameters *filters[FILTER_MONO_BATCH];
+	FAudioFilterState *filterStates[FILTER_MONO_BATCH];
+	float *samples[FILTER_MONO_BATCH];
+
+	if (worker->filterBatchCount == 0)
+	{
+		return;
+	}
+
+	for (i = 0; i < worker->filterBatchCount; i += 1)
+	{
+		filters[i] = &worker->filterBatchParams[i]->filter;
+		filterStates[i] = worker->filterBatchVoices[i]->filterState;
+		samples[i] = worker->filterBatchCache + (
+			i * worker->audio->resampleSamples
+		);
+	}
+	FAudio_INTERNAL_FilterMonoBatch(
+		filters,
+		filterStates,
+		samples,
+		worker->filterBatchMixed,
+		worker->filterBatchCount
+	);
+
+	/* Sent in the order they were rendered, same as MixSource would */
+	for (i = 0; i < worker->filterBatchCount; i += 1)
+	{
+		FAudio_INTERNAL_SendSource(
+			worker->filterBatchVoices[i],
+			worker,
+			worker->filterBatchParams[i],
+			samples[i],
+			worker->filterBatchMixed[i],
+			0,
+			1
+		);
+	}
+	worker->filterBatchCount = 0;
+}
+
+/* Like MixSource, but for filtered mono voices: the filter is deferred so
+ * that FilterMonoBatch can run several voices side by side.
+ */
+static void FAudio_INTERNAL_BatchSource(
+	FAudioSourceVoice *voice,
+	FAudioMixWorker *worker
+) {
+	uint32_t mixed;
+	float *finalSamples, *batchSamples;
+	FAudioVoiceParameters *params;
+
+	LOG_FUNC_ENTER(voice->audio)
+
+	params = FAudio_INTERNAL_AcquireParameters(voice);
+	finalSamples = FAudio_INTERNAL_RenderSource(voice, worker, params, &mixed);
+	if (finalSamples == NULL)
+	{
+		LOG_FUNC_EXIT(voice->audio)
+		return;
+	}
+
+	/* The next voice reuses the worker caches, so keep a copy */
+	batchSamples = worker->filterBatchCache + (
+		worker->filterBatchCount * worker->audio->resampleSamples
+	);
+	FAudio_memcpy(batchSamples, finalSamples, sizeof(float) * mixed);
+	worker->filterBatchVoices[worker->filterBatchCount] = voice;
+	worker->filterBatchParams[worker->filterBatchCount] = params;
+	worker->filterBatchMixed[worker->filterBatchCount] = mixed;
+	worker->filterBatchCount += 1;
+
+	if (worker->filterBatchCount == FILTER_MONO_BATCH)
+	{
+		FAudio_INTERNAL_FlushFilterBatch(worker);
+	}
+	LOG_FUNC_EXIT(voice->audio)
+}
+
+static void FAudio_INTERNAL_MixSubmix(
+	FAudioSubmixVoice *voice,
+	FAudioMixWorker *worker
+) {
+	uint32_t i;
+	float *stream;
+	uint32_t oChan;
+	FAudioVoice *out;
+	uint32_t resampled;
+	uint64_t resampleOffset = 0;
+	float *finalSamples;
+	FAudioVoiceParameters *params;
+	uint8_t silent;
+	uint32_t toZero;
+
+	LOG_FUNC_ENTER(voice->audio)
+
+	/* Same as MixSource, but with submixLock keeping the shape intact */
+	params = FAudio_INTERNAL_AcquireParameters(voice);
+
+	/* Only what got mixed in this update needs zeroing afterward */
+	silent = (voice->workerDirty[0] == 0);
+	toZero = voice->workerDirty[0] * voice->mix.inputChannels;
+
+	/* Nothing to do? */
+	if (voice->sends.SendCount == 0)
+	{
+		goto end;
+	}
+
+	/* Nothing mixed in, and nothing left to ring out? Only send filters
+	 * can still do anything, see below.
+	 */
+	resampled = voice->mix.outputSamples;
+	if (	silent &&
+		voice->effects.count == 0 &&
+		(	!(voice->flags & FAUDIO_VOICE_USEFILTER) ||
+			FAudio_INTERNAL_FilterIsIdle(
+				voice->filterState,
+				voice->mix.inputChannels
+			)	)	)
+	{
+		finalSamples = NULL;
+		goto send;
+	}
+
+	/* Resample */
+	if (voice->mix.resampleStep == FIXED_ONE)
+	{
+		/* Actually, just use the existing buffer... */
+		finalSamples = voice->mix.inputCache;
+		toZero = voice->mix.inputSamples;
+	}
+	else if (silent)
+	{
+		/* Resampling silence won't do much for it */
+		finalSamples = worker->resampleCache;
+		FAudio_zero(
+			finalSamples,
+			sizeof(float) * resampled * voice->mix.inputChannels
+		);
+	}
+	else
+	{
+		voice->mix.resample(
+			voice->mix.inputCache,
+			worker->resampleCache,
+			&resampleOffset,
+			voice->mix.resampleStep,
+			voice->mix.outputSamples,
+			(uint8_t) voice->mix.inputChannels
+		);
+		finalSamples = worker->resampleCache;
+	}
+
+	/* Submix overall volume is applied _before_ effects/filters, blech! */
+	if (params->volume != 1.0f && !silent)
+	{
+		FAudio_INTERNAL_Amplify(
+			finalSamples,
+			resampled * voice->mix.inputChannels,
+			params->volume
+		);
+	}
+
+	/* Filters */
+	if (voice->flags & FAUDIO_VOICE_USEFILTER)
+	{
+		if (	!silent ||
+			!FAudio_INTERNAL_FilterIsIdle(
+				voice->filterState,
+				voice->mix.inputChannels
+			)	)
+		{
+			FAudio_INTERNAL_FilterVoice(
+				&params->filter,
+				voice->filterState,
+				finalSamples,
+				resampled,
+				voice->mix.inputChannels
+			);
+			silent = 0;
+		}
+	}
+
+	/* Process effect chain */
+	if (voice->effects.count > 0)
+	{
+		finalSamples = FAudio_INTERNAL_ProcessEffectChain(
+			voice,
+			worker,
+			finalSamples,
+			&resampled,
+			&silent
+		);
+	}
+
+	/* Send float cache to sends */
+send:
+	for (i = 0; i < voice->sends.SendCount; i += 1)
+	{
+		/* Silence adds nothing, but a send filter may still be ringing */
+		if (	silent &&
+			!(voice->sends.pSends[i].Flags & FAUDIO_SEND_USEFILTER)	)
+		{
+			continue;
+		}
+
+		out = voice->sends.pSends[i].pOutputVoice;
+		stream = FAudio_INTERNAL_GetSendStream(
+			worker,
+			out,
+			resampled,
+			&oChan
+		);
+
+		if (!silent)
+		{
+			voice->sendMix[i](
+				resampled,
+				voice->outputChannels,
+				oChan,
+				1.0f,
+				finalSamples,
+				stream,
+				params->channelVolume,
+				params->sendCoefficients[i]
+			);
+		}
+
+		if (voice->sends.pSends[i].Flags & FAUDIO_SEND_USEFILTER)
+		{
+			FAudio_INTERNAL_FilterVoice(
+				&params->sendFilter[i],
+				voice->sendFilterState[i],
+				stream,
+				resampled,
+				oChan
+			);
+		}
+	}
+
+	/* Zero this at the end, for the next update */
+end:
+	FAudio_zero(
+		voice->mix.inputCache,
+		sizeof(float) * toZero
+	);
+	voice->workerDirty[0] = 0;
+	LOG_FUNC_EXIT(voice->audio)
+}
+
+/* Mix Workers */
+
+static void FAudio_INTERNAL_PrepareMixWorker(FAudioMixWorker *worker)
+{
+	FAudio_INTERNAL_ResizeWorkerCache(
+		worker->audio,
+		&worker->decodeBase,
+		&worker->decodeSamples,
+		SINC_HISTORY_SAMPLES + worker->audio->decodeSamples
+	);
+	worker->decodeCache = worker->decodeBase + SINC_HISTORY_SAMPLES;
+	FAudio_INTERNAL_ResizeWorkerCache(
+		worker->audio,
+		&worker->resampleCache,
+		&worker->resampleSamples,
+		worker->audio->resampleSamples
+	);
+	FAudio_INTERNAL_ResizeWorkerCache(
+		worker->audio,
+		&worker->filterBatchCache,
+		&worker->filterBatchSamples,
+		worker->audio->resampleSamples * FILTER_MONO_BATCH
+	);
+}
+
+static int32_t FAUDIOCALL FAudio_INTERNAL_MixWorkerThread(void *data)
+{
+	FAudioMixWorker *worker = (FAudioMixWorker*) data;
+
+	FAudio_PlatformThreadPriority(FAUDIO_THREAD_PRIORITY_HIGH);
+	while (1)
+	{
+		FAudio_PlatformWaitSemaphore(worker->wakeup);
+		if (worker->job == NULL)
+		{
+			/* SetMixWorkerCount wants us gone */
+			break;
+		}
+		worker->job(worker, worker->jobItems, worker->jobCount);
+		FAudio_PlatformSignalSemaphore(worker->audio->mixDone);
+	}
+	return 0;
+}
+
+static void FAudio_INTERNAL_RunMixJob(
+	FAudio *audio,
+	FAudioMixJob job,
+	void **items,
+	uint32_t count
+) {
+	uint32_t i, workers, chunk, extra;
+	FAudioMixWorker *worker;
+
+	LOG_FUNC_ENTER(audio)
+
+	workers = FAudio_min(audio->mixWorkerCount, count);
+	if (workers <= 1)
+	{
+		job(audio->mixWorkers[0], items, count);
+		LOG_FUNC_EXIT(audio)
+		return;
+	}
+
+	/* Items are split into contiguous runs in list order. The split only
+	 * depends on the item count, so the reduction order is always the
+	 * same for the same graph.
+	 */
+	chunk = count / workers;
+	extra = count % workers;
+	for (i = 0; i < workers; i += 1)
+	{
+		worker = audio->mixWorkers[i];
+		worker->job = job;
+		worker->jobItems = items;
+		worker->jobCount = chunk + (i < extra);
+		items += worker->jobCount;
+		if (i > 0)
+		{
+			FAudio_INTERNAL_PrepareMixWorker(worker);
+			FAudio_PlatformSignalSemaphore(worker->wakeup);
+		}
+	}
+
+	/* The engine thread does its share too... */
+	worker = audio->mixWorkers[0];
+	job(worker, worker->jobItems, worker->jobCount);
+
+	/* ... then waits for everyone else to finish. */
+	for (i = 1; i < workers; i += 1)
+	{
+		FAudio_PlatformWaitSemaphore(audio->mixDone);
+	}
+	LOG_FUNC_EXIT(audio)
+}
+
+static void FAudio_INTERNAL_ReduceMixWorkers(FAudio *audio)
+{
+	uint32_t i, j, k, samples, channels;
+	float *stream, *cache;
+	float sum;
+	FAudioVoice *out;
+	FAudioMixWorker *worker;
+
+	LOG_FUNC_ENTER(audio)
+
+	/* Workers are always summed in index order, so for a given graph the
+	 * output does not depend on how the threads were scheduled.
+	 */
+	for (i = 1; i < audio->mixWorkerCount; i += 1)
+	{
+		worker = audio->mixWorkers[i];
+		for (j = 0; j < worker->dirtyCount; j += 1)
+		{
+			out = worker->dirty[j];
+			if (out->type == FAUDIO_VOICE_MASTER)
+			{
+				stream = out->master.output;
+				channels = out->master.inputChannels;
+			}
+			else
+			{
+				stream = out->mix.inputCache;
+				channels = out->mix.inputChannels;
+			}
+			cache = out->workerCache[i];
+
+			/* Only the part this worker wrote can be nonzero */
+			samples = out->workerDirty[i] * channels;
+			for (k = 0; k < samples; k += 1)
+			{
+				sum = stream[k] + cache[k];
+				stream[k] = FAudio_clamp(
+					sum,
+					-FAUDIO_MAX_VOLUME_LEVEL,
+					FAUDIO_MAX_VOLUME_LEVEL
+				);
+			}
+			FAudio_zero(cache, sizeof(float) * samples);
+			out->workerDirty[0] = FAudio_max(
+				out->workerDirty[0],
+				out->workerDirty[i]
+			);
+			out->workerDirty[i] = 0;
+		}
+		worker->dirtyCount = 0;
+	}
+	LOG_FUNC_EXIT(audio)
+}
+
+static void FAUDIOCALL FAudio_INTERNAL_MixSourceJob(
+	FAudioMixWorker *worker,
+	void **items,
+	uint32_t count
+) {
+	uint32_t i;
+	uint64_t thread = FAudio_PlatformGetThreadID();
+	FAudioSourceVoice *voice;
+	for (i = 0; i < count; i += 1)
+	{
+		/* Lets callbacks act on their own buffer queue, see
+		 * FAudio_INTERNAL_LockBufferQueue
+		 */
+		voice = (FAudioSourceVoice*) items[i];
+		voice->src.mixThread = thread;
+		if (	voice->src.sincHistory != NULL ||
+			voice->src.resampleStep != FIXED_ONE	)
+		{
+			worker->resamplers += 1;
+		}
+		worker->matrixMixes += voice->sends.SendCount;
+		if (	voice->effects.count > 0 ||
+			voice->src.active == 2	)
+		{
+			/* Keep the send order the same as without batching */
+			FAudio_INTERNAL_FlushFilterBatch(worker);
+			FAudio_INTERNAL_MixSource(voice, worker);
+		}
+		else if (	voice->src.format->nChannels == 1 &&
+				(voice->flags & FAUDIO_VOICE_USEFILTER) &&
+				voice->sends.SendCount > 0	)
+		{
+			FAudio_INTERNAL_BatchSource(voice, worker);
+		}
+		else
+		{
+			FAudio_INTERNAL_FlushFilterBatch(worker);
+			FAudio_INTERNAL_MixSourceBlocks(voice, worker);
+		}
+		voice->src.mixThread = 0;
 	}
-	FAudio_PlatformUnlockMutex(voice->effectLock);
-	LOG_MUTEX_UNLOCK(voice->audio, voice->effectLock)
+	FAudio_INTERNAL_FlushFilterBatch(worker);
+}
 
-	/* Send float cache to sends */
-	FAudio_PlatformLockMutex(voice->volumeLock);
-	LOG_MUTEX_LOCK(voice->audio, voice->volumeLock)
-	for (i = 0; i < voice->sends.SendCount; i += 1)
+static void FAUDIOCALL FAudio_INTERNAL_MixSubmixJob(
+	FAudioMixWorker *worker,
+	void **items,
+	uint32_t count
+) {
+	uint32_t i;
+	FAudioSubmixVoice *voice;
+	for (i = 0; i < count; i += 1)
 	{
-		out = voice->sends.pSends[i].pOutputVoice;
-		if (out->type == FAUDIO_VOICE_MASTER)
+		voice = (FAudioSubmixVoice*) items[i];
+		if (voice->mix.resampleStep != FIXED_ONE)
 		{
-			stream = out->master.output;
-			oChan = out->master.inputChannels;
+			worker->resamplers += 1;
 		}
-		else
+		worker->matrixMixes += voice->sends.SendCount;
+		FAudio_INTERNAL_MixSubmix(voice, worker);
+	}
+}
+
+void FAudio_INTERNAL_SetMixWorkerCount(FAudio *audio, uint32_t count)
+{
+	uint32_t i;
+	FAudioMixWorker *worker;
+
+	LOG_FUNC_ENTER(audio)
+	FAudio_assert(count <= MAX_MIX_WORKERS);
+
+	/* Shut down the workers we no longer need... */
+	for (i = count; i < audio->mixWorkerCount; i += 1)
+	{
+		worker = audio->mixWorkers[i];
+		if (worker->thread != NULL)
 		{
-			stream = out->mix.inputCache;
-			oChan = out->mix.inputChannels;
+			worker->job = NULL;
+			FAudio_PlatformSignalSemaphore(worker->wakeup);
+			FAudio_PlatformWaitThread(worker->thread, NULL);
+			FAudio_PlatformDestroySemaphore(worker->wakeup);
 		}
-
-		voice->sendMix[i](
-			mixed,
-			voice->outputChannels,
-			oChan,
-			voice->volume,
-			finalSamples,
-			stream,
-			voice->channelVolume,
-			voice->sendCoefficients[i]
+		FAudio_PlatformAtomicAdd(
+			&audio->mixerCacheBytes,
+			-(int32_t) (
+				sizeof(float) * (
+					worker->decodeSamples +
+					worker->resampleSamples +
+					worker->effectChainSamples +
+					worker->filterBatchSamples
+				) +
+				sizeof(FAudioVoice*) * worker->dirtyCapacity
+			)
 		);
-
-		if (voice->sends.pSends[i].Flags & FAUDIO_SEND_USEFILTER)
+		audio->pFree(worker->decodeBase);
+		audio->pFree(worker->resampleCache);
+		audio->pFree(worker->effectChainCache);
+		audio->pFree(worker->filterBatchCache);
+		audio->pFree(worker->dirty);
+		audio->pFree(worker);
+		audio->mixWorkers[i] = NULL;
+	}
+
+	/* ... then start up any new ones. Worker 0 never gets a thread! */
+	for (i = audio->mixWorkerCount; i < count; i += 1)
+	{
+		worker = (FAudioMixWorker*) audio->pMalloc(sizeof(FAudioMixWorker));
+		FAudio_zero(worker, sizeof(FAudioMixWorker));
+		worker->audio = audio;
+		worker->index = i;
+		if (i > 0)
 		{
-			FAudio_INTERNAL_FilterVoice(
-				voice->audio,
-				&voice->sendFilter[i],
-				voice->sendFilterState[i],
-				stream,
-				mixed,
-				oChan
+			worker->wakeup = FAudio_PlatformCreateSemaphore(0);
+			worker->thread = FAudio_PlatformCreateThread(
+				FAudio_INTERNAL_MixWorkerThread,
+				"FAudioMixWorker",
+				worker
 			);
 		}
+		audio->mixWorkers[i] = worker;
 	}
-	FAudio_PlatformUnlockMutex(voice->volumeLock);
-	LOG_MUTEX_UNLOCK(voice->audio, voice->volumeLock)
 
-	FAudio_PlatformUnlockMutex(voice->sendLock);
-	LOG_MUTEX_UNLOCK(voice->audio, voice->sendLock)
+	audio->mixWorkerCount = count;
+	LOG_FUNC_EXIT(audio)
+}
+
+void FAudio_INTERNAL_AllocWorkerCaches(FAudioVoice *voice)
+{
+	LOG_FUNC_ENTER(voice->audio)
+	voice->workerCache = (float**) voice->audio->pMalloc(
+		sizeof(float*) * MAX_MIX_WORKERS
+	);
+	FAudio_zero(voice->workerCache, sizeof(float*) * MAX_MIX_WORKERS);
+	voice->workerDirty = (uint32_t*) voice->audio->pMalloc(
+		sizeof(uint32_t) * MAX_MIX_WORKERS
+	);
+	FAudio_zero(voice->workerDirty, sizeof(uint32_t) * MAX_MIX_WORKERS);
 	LOG_FUNC_EXIT(voice->audio)
 }
 
-static void FAudio_INTERNAL_MixSubmix(FAudioSubmixVoice *voice)
+void FAudio_INTERNAL_FreeWorkerCaches(FAudioVoice *voice)
 {
 	uint32_t i;
-	float *stream;
-	uint32_t oChan;
-	FAudioVoice *out;
-	uint32_t resampled;
-	uint64_t resampleOffset = 0;
-	float *finalSamples;
 
 	LOG_FUNC_ENTER(voice->audio)
-	FAudio_PlatformLockMutex(voice->sendLock);
-	LOG_MUTEX_LOCK(voice->audio, voice->sendLock)
-
-	/* Nothing to do? */
-	if (voice->sends.SendCount == 0)
+	if (voice->workerCache != NULL)
 	{
-		goto end;
+		for (i = 0; i < MAX_MIX_WORKERS; i += 1)
+		{
+			if (voice->workerCache[i] != NULL)
+			{
+				FAudio_PlatformAtomicAdd(
+					&voice->audio->mixerCacheBytes,
+					-(int32_t) (
+						sizeof(float) *
+						FAudio_INTERNAL_GetInputSamples(voice)
+					)
+				);
+				voice->audio->pFree(voice->workerCache[i]);
+			}
+		}
+		voice->audio->pFree(voice->workerCache);
+		voice->audio->pFree(voice->workerDirty);
+		voice->workerCache = NULL;
+		voice->workerDirty = NULL;
 	}
+	LOG_FUNC_EXIT(voice->audio)
+}
 
-	/* Resample */
-	if (voice->src.resampleStep == FIXED_ONE)
-	{
-		/* Actually, just use the existing buffer... */
-		finalSamples = voice->mix.inputCache;
-	}
-	else
+/* Render Plan */
+
+static inline void FAudio_INTERNAL_PlanAppend(
+	FAudio *audio,
+	void ***items,
+	uint32_t *count,
+	uint32_t *capacity,
+	void *item
+) {
+	if (*count == *capacity)
 	{
-		voice->mix.resample(
-			voice->mix.inputCache,
-			voice->audio->resampleCache,
-			&resampleOffset,
-			voice->mix.resampleStep,
-			voice->mix.outputSamples,
-			(uint8_t) voice->mix.inputChannels
+		*capacity += 64;
+		*items = (void**) audio->pRealloc(
+			*items,
+			sizeof(void*) * *capacity
 		);
-		finalSamples = voice->audio->resampleCache;
 	}
-	resampled = voice->mix.outputSamples * voice->mix.inputChannels;
+	(*items)[(*count)++] = item;
+}
 
-	/* Submix overall volume is applied _before_ effects/filters, blech! */
-	if (voice->volume != 1.0f)
+static inline void FAudio_INTERNAL_PlanEndStage(
+	FAudio *audio,
+	FAudioRenderPlan *plan
+) {
+	if (plan->stageCount == plan->stageCapacity)
 	{
-		FAudio_INTERNAL_Amplify(
-			finalSamples,
-			resampled,
-			voice->volume
+		plan->stageCapacity += 8;
+		plan->stageEnds = (uint32_t*) audio->pRealloc(
+			plan->stageEnds,
+			sizeof(uint32_t) * plan->stageCapacity
 		);
 	}
-	resampled /= voice->mix.inputChannels;
+	plan->stageEnds[plan->stageCount++] = plan->submixCount;
+}
 
-	/* Filters */
-	if (voice->flags & FAUDIO_VOICE_USEFILTER)
+#ifndef FAUDIO_DISABLE_DEBUGCONFIGURATION
+static void FAudio_INTERNAL_DumpPlanVoice(
+	FAudio *audio,
+	uint32_t index,
+	FAudioVoice *voice
+) {
+	uint32_t i;
+	FAudioVoice *out;
+
+	if (voice->type == FAUDIO_VOICE_SOURCE)
 	{
-		FAudio_PlatformLockMutex(voice->filterLock);
-		LOG_MUTEX_LOCK(voice->audio, voice->filterLock)
-		FAudio_INTERNAL_FilterVoice(
-			voice->audio,
-			&voice->filter,
-			voice->filterState,
-			finalSamples,
-			resampled,
-			voice->mix.inputChannels
+		LOG_DETAIL(
+			audio,
+			"  [%u] source %p: tag 0x%X, %u ch @ %u Hz, %u effects, %u sends",
+			index,
+			(void*) voice,
+			voice->src.format->wFormatTag,
+			voice->src.format->nChannels,
+			voice->src.format->nSamplesPerSec,
+			voice->effects.count,
+			voice->sends.SendCount
 		);
-		FAudio_PlatformUnlockMutex(voice->filterLock);
-		LOG_MUTEX_UNLOCK(voice->audio, voice->filterLock)
 	}
-
-	/* Process effect chain */
-	FAudio_PlatformLockMutex(voice->effectLock);
-	LOG_MUTEX_LOCK(voice->audio, voice->effectLock)
-	if (voice->effects.count > 0)
+	else
 	{
-		finalSamples = FAudio_INTERNAL_ProcessEffectChain(
-			voice,
-			finalSamples,
-			&resampled
+		LOG_DETAIL(
+			audio,
+			"  [%u] submix %p: stage %u, %u ch @ %u Hz, %u effects, %u sends",
+			index,
+			(void*) voice,
+			voice->mix.processingStage,
+			voice->mix.inputChannels,
+			voice->mix.inputSampleRate,
+			voice->effects.count,
+			voice->sends.SendCount
 		);
 	}
-	FAudio_PlatformUnlockMutex(voice->effectLock);
-	LOG_MUTEX_UNLOCK(voice->audio, voice->effectLock)
-
-	/* Send float cache to sends */
-	FAudio_PlatformLockMutex(voice->volumeLock);
-	LOG_MUTEX_LOCK(voice->audio, voice->volumeLock)
 	for (i = 0; i < voice->sends.SendCount; i += 1)
 	{
 		out = voice->sends.pSends[i].pOutputVoice;
-		if (out->type == FAUDIO_VOICE_MASTER)
+		LOG_DETAIL(
+			audio,
+			"      -> %s %p, %u -> %u ch%s",
+			(out->type == FAUDIO_VOICE_MASTER) ? "master" : "submix",
+			(void*) out,
+			voice->outputChannels,
+			(out->type == FAUDIO_VOICE_MASTER) ?
+				out->master.inputChannels :
+				out->mix.inputChannels,
+			(voice->sends.pSends[i].Flags & FAUDIO_SEND_USEFILTER) ?
+				", filtered" :
+				""
+		);
+	}
+}
+#endif /* FAUDIO_DISABLE_DEBUGCONFIGURATION */
+
+static void FAudio_INTERNAL_CompileSourcePlan(FAudio *audio)
+{
+	uint32_t total = 0;
+	LinkedList *list;
+	FAudioSourceVoice *source;
+	FAudioRenderPlan *plan = &audio->plan;
+
+	LOG_FUNC_ENTER(audio)
+
+	/* Inactive voices are left out entirely, so an update only costs as
+	 * much as the voices that are actually playing.
+	 */
+	plan->sourceCount = 0;
+	list = audio->sources;
+	while (list != NULL)
+	{
+		source = (FAudioSourceVoice*) list->entry;
+		if (source->src.active)
 		{
-			stream = out->master.output;
-			oChan = out->master.inputChannels;
+			FAudio_INTERNAL_PlanAppend(
+				audio,
+				&plan->sources,
+				&plan->sourceCount,
+				&plan->sourceCapacity,
+				source
+			);
 		}
-		else
+		total += 1;
+		list = list->next;
+	}
+
+#ifndef FAUDIO_DISABLE_DEBUGCONFIGURATION
+	if (audio->debug.TraceMask & FAUDIO_LOG_DETAIL)
+	{
+		uint32_t i;
+		LOG_DETAIL(
+			audio,
+			"Source plan: %u of %u source voices active",
+			plan->sourceCount,
+			total
+		);
+		for (i = 0; i < plan->sourceCount; i += 1)
 		{
-			stream = out->mix.inputCache;
-			oChan = out->mix.inputChannels;
+			FAudio_INTERNAL_DumpPlanVoice(
+				audio,
+				i,
+				(FAudioVoice*) plan->sources[i]
+			);
 		}
+	}
+#endif /* FAUDIO_DISABLE_DEBUGCONFIGURATION */
+	LOG_FUNC_EXIT(audio)
+}
 
-		voice->sendMix[i](
-			resampled,
-			voice->outputChannels,
-			oChan,
-			1.0f,
-			finalSamples,
-			stream,
-			voice->channelVolume,
-			voice->sendCoefficients[i]
+static void FAudio_INTERNAL_CompileSubmixPlan(FAudio *audio)
+{
+	uint32_t stage = 0;
+	LinkedList *list;
+	FAudioSubmixVoice *submix;
+	FAudioRenderPlan *plan = &audio->plan;
+
+	LOG_FUNC_ENTER(audio)
+
+	/* audio->submixes is already sorted by processing stage, so all that's
+	 * left to do is find where each stage ends.
+	 */
+	plan->submixCount = 0;
+	plan->stageCount = 0;
+	list = audio->submixes;
+	while (list != NULL)
+	{
+		submix = (FAudioSubmixVoice*) list->entry;
+		if (	plan->submixCount > 0 &&
+			submix->mix.processingStage != stage	)
+		{
+			FAudio_INTERNAL_PlanEndStage(audio, plan);
+		}
+		stage = submix->mix.processingStage;
+		FAudio_INTERNAL_PlanAppend(
+			audio,
+			&plan->submixes,
+			&plan->submixCount,
+			&plan->submixCapacity,
+			submix
 		);
+		list = list->next;
+	}
+	if (plan->submixCount > 0)
+	{
+		FAudio_INTERNAL_PlanEndStage(audio, plan);
+	}
 
-		if (voice->sends.pSends[i].Flags & FAUDIO_SEND_USEFILTER)
+#ifndef FAUDIO_DISABLE_DEBUGCONFIGURATION
+	if (audio->debug.TraceMask & FAUDIO_LOG_DETAIL)
+	{
+		uint32_t i;
+		LOG_DETAIL(
+			audio,
+			"Submix plan: %u submix voices in %u stages",
+			plan->submixCount,
+			plan->stageCount
+		);
+		for (i = 0; i < plan->submixCount; i += 1)
 		{
-			FAudio_INTERNAL_FilterVoice(
-				voice->audio,
-				&voice->sendFilter[i],
-				voice->sendFilterState[i],
-				stream,
-				resampled,
-				oChan
+			FAudio_INTERNAL_DumpPlanVoice(
+				audio,
+				i,
+				(FAudioVoice*) plan->submixes[i]
 			);
 		}
 	}
-	FAudio_PlatformUnlockMutex(voice->volumeLock);
-	LOG_MUTEX_UNLOCK(voice->audio, voice->volumeLock)
+#endif /* FAUDIO_DISABLE_DEBUGCONFIGURATION */
+	LOG_FUNC_EXIT(audio)
+}
 
-	/* Zero this at the end, for the next update */
-end:
-	FAudio_PlatformUnlockMutex(voice->sendLock);
-	LOG_MUTEX_UNLOCK(voice->audio, voice->sendLock)
-	FAudio_zero(
-		voice->mix.inputCache,
-		sizeof(float) * voice->mix.inputSamples
+void FAudio_INTERNAL_InvalidateRenderPlan(FAudio *audio, FAudioVoiceType type)
+{
+	/* Sources and submixes are compiled under different locks, so each
+	 * half has its own flag. The mixer picks it up on its next update.
+	 */
+	if (type == FAUDIO_VOICE_SOURCE)
+	{
+		FAudio_PlatformAtomicSet(&audio->plan.sourcesDirty, 1);
+	}
+	else if (type == FAUDIO_VOICE_SUBMIX)
+	{
+		FAudio_PlatformAtomicSet(&audio->plan.submixesDirty, 1);
+	}
+}
+
+void FAudio_INTERNAL_FreeRenderPlan(FAudio *audio)
+{
+	if (audio->plan.sources != NULL)
+	{
+		audio->pFree(audio->plan.sources);
+	}
+	if (audio->plan.submixes != NULL)
+	{
+		audio->pFree(audio->plan.submixes);
+	}
+	if (audio->plan.stageEnds != NULL)
+	{
+		audio->pFree(audio->plan.stageEnds);
+	}
+	FAudio_zero(&audio->plan, sizeof(FAudioRenderPlan));
+}
+
+/* Adds an update that ran from start to end to what FAudio_GetPerformanceData
+ * reports. An update that took longer to render than it takes to play can't
+ * have made it out in time, so that's what counts as a glitch.
+ */
+static void FAudio_INTERNAL_UpdatePerformanceData(
+	FAudio *audio,
+	uint64_t start,
+	uint64_t end
+) {
+	uint32_t i, resamplers = 0, matrixMixes = 0;
+	uint64_t deadline;
+	const uint64_t ticks = end - start;
+	FAudioMixWorker *worker;
+
+	for (i = 0; i < audio->mixWorkerCount; i += 1)
+	{
+		worker = audio->mixWorkers[i];
+		resamplers += worker->resamplers;
+		matrixMixes += worker->matrixMixes;
+		worker->resamplers = 0;
+		worker->matrixMixes = 0;
+	}
+	deadline = (
+		(uint64_t) audio->updateSize *
+		FAudio_timefrequency() /
+		audio->master->master.inputSampleRate
 	);
-	LOG_FUNC_EXIT(voice->audio)
+
+	FAudio_PlatformLockMutex(audio->sourceLock);
+	LOG_MUTEX_LOCK(audio, audio->sourceLock)
+	/* Only the part since the last query, or this could add up to more
+	 * than TotalCyclesSinceLastQuery
+	 */
+	if (end > audio->perfQueryTime)
+	{
+		audio->perfAudioTime += end - FAudio_max(start, audio->perfQueryTime);
+	}
+	if (audio->perfQuanta == 0 || ticks < audio->perfMinQuantum)
+	{
+		audio->perfMinQuantum = ticks;
+	}
+	if (ticks > audio->perfMaxQuantum)
+	{
+		audio->perfMaxQuantum = ticks;
+	}
+	audio->perfQuanta += 1;
+	if (ticks > deadline)
+	{
+		audio->perfGlitches += 1;
+	}
+	audio->perfResamplers = resamplers;
+	audio->perfMatrixMixes = matrixMixes;
+	FAudio_PlatformUnlockMutex(audio->sourceLock);
+	LOG_MUTEX_UNLOCK(audio, audio->sourceLock)
 }
 
 static void FAUDIOCALL FAudio_INTERNAL_GenerateOutput(FAudio *audio, float *output)
 {
+	uint64_t start;
 	uint32_t totalSamples;
+	uint32_t stage, stageStart;
 	LinkedList *list;
-	FAudioSourceVoice *source;
 	FAudioEngineCallback *callback;
+	FAudioVoiceParameters *params;
+	FAudioMixWorker *worker = audio->mixWorkers[0];
+	uint8_t silent;
 
 	LOG_FUNC_ENTER(audio)
 	if (!audio->active)
@@ -1132,6 +2746,7 @@ static void FAUDIOCALL FAudio_INTERNAL_GenerateOutput(FAudio *audio, float *outp
 		LOG_FUNC_EXIT(audio)
 		return;
 	}
+	start = FAudio_timecounter();
 
 	/* ProcessingPassStart callbacks */
 	FAudio_PlatformLockMutex(audio->callbackLock);
@@ -1151,6 +2766,9 @@ static void FAUDIOCALL FAudio_INTERNAL_GenerateOutput(FAudio *audio, float *outp
 	FAudio_PlatformUnlockMutex(audio->callbackLock);
 	LOG_MUTEX_UNLOCK(audio, audio->callbackLock)
 
+	/* Apply any committed changes, including those from PassStart */
+	FAudio_OPERATIONSET_Execute(audio);
+
 	/* Writes to master will directly write to output, but ONLY if there
 	 * isn't any channel-changing effect processing to do first.
 	 */
@@ -1171,54 +2789,81 @@ static void FAUDIOCALL FAudio_INTERNAL_GenerateOutput(FAudio *audio, float *outp
 		audio->master->master.output = output;
 	}
 
+	/* The engine thread's caches may need to grow for new voices */
+	FAudio_INTERNAL_PrepareMixWorker(worker);
+
 	/* Mix sources */
 	FAudio_PlatformLockMutex(audio->sourceLock);
 	LOG_MUTEX_LOCK(audio, audio->sourceLock)
-	list = audio->sources;
-	while (list != NULL)
+	if (FAudio_PlatformAtomicCAS(&audio->plan.sourcesDirty, 1, 0))
 	{
-		source = (FAudioSourceVoice*) list->entry;
-		if (source->src.active)
-		{
-			FAudio_INTERNAL_MixSource(source);
-		}
-		list = list->next;
+		FAudio_INTERNAL_CompileSourcePlan(audio);
 	}
+	FAudio_INTERNAL_RunMixJob(
+		audio,
+		FAudio_INTERNAL_MixSourceJob,
+		audio->plan.sources,
+		audio->plan.sourceCount
+	);
+	FAudio_INTERNAL_ReduceMixWorkers(audio);
+	audio->decodeStats.MSADPCMBlocksDecoded = FAudio_PlatformAtomicSet(
+		&audio->msadpcmBlocksDecoded,
+		0
+	);
+	audio->decodeStats.MSADPCMBlocksReused = FAudio_PlatformAtomicSet(
+		&audio->msadpcmBlocksReused,
+		0
+	);
+	audio->decodeStats.TotalMSADPCMBlocksDecoded +=
+		audio->decodeStats.MSADPCMBlocksDecoded;
 	FAudio_PlatformUnlockMutex(audio->sourceLock);
 	LOG_MUTEX_UNLOCK(audio, audio->sourceLock)
 
-	/* Mix submixes, ordered by processing stage */
+	/* Mix submixes, ordered by processing stage. Sends can only go to a
+	 * later stage, so all the submixes within one stage can run at once.
+	 */
 	FAudio_PlatformLockMutex(audio->submixLock);
 	LOG_MUTEX_LOCK(audio, audio->submixLock)
-	list = audio->submixes;
-	while (list != NULL)
+	if (FAudio_PlatformAtomicCAS(&audio->plan.submixesDirty, 1, 0))
 	{
-		FAudio_INTERNAL_MixSubmix((FAudioSubmixVoice*) list->entry);
-		list = list->next;
+		FAudio_INTERNAL_CompileSubmixPlan(audio);
+	}
+	stageStart = 0;
+	for (stage = 0; stage < audio->plan.stageCount; stage += 1)
+	{
+		FAudio_INTERNAL_RunMixJob(
+			audio,
+			FAudio_INTERNAL_MixSubmixJob,
+			audio->plan.submixes + stageStart,
+			audio->plan.stageEnds[stage] - stageStart
+		);
+		FAudio_INTERNAL_ReduceMixWorkers(audio);
+		stageStart = audio->plan.stageEnds[stage];
 	}
-	FAudio_PlatformUnlockMutex(audio->submixLock);
-	LOG_MUTEX_UNLOCK(audio, audio->submixLock)
 
-	/* Apply master volume */
-	if (audio->master->volume != 1.0f)
+	/* Apply master volume, past what got mixed in is still silence */
+	params = FAudio_INTERNAL_AcquireParameters(audio->master);
+	if (params->volume != 1.0f)
 	{
 		FAudio_INTERNAL_Amplify(
 			audio->master->master.output,
-			audio->updateSize * audio->master->master.inputChannels,
-			audio->master->volume
+			audio->master->workerDirty[0] * audio->master->master.inputChannels,
+			params->volume
 		);
 	}
+	silent = (audio->master->workerDirty[0] == 0);
+	audio->master->workerDirty[0] = 0;
 
-	/* Process master effect chain */
-	FAudio_PlatformLockMutex(audio->master->effectLock);
-	LOG_MUTEX_LOCK(audio, audio->master->effectLock)
+	/* Process master effect chain, submixLock covers this one too */
 	if (audio->master->effects.count > 0)
 	{
 		totalSamples = audio->updateSize;
 		float *effectOut = FAudio_INTERNAL_ProcessEffectChain(
 			audio->master,
+			worker,
 			audio->master->master.output,
-			&totalSamples
+			&totalSamples,
+			&silent
 		);
 
 		if (effectOut != output)
@@ -1237,8 +2882,8 @@ static void FAUDIOCALL FAudio_INTERNAL_GenerateOutput(FAudio *audio, float *outp
 			);
 		}
 	}
-	FAudio_PlatformUnlockMutex(audio->master->effectLock);
-	LOG_MUTEX_UNLOCK(audio, audio->master->effectLock)
+	FAudio_PlatformUnlockMutex(audio->submixLock);
+	LOG_MUTEX_UNLOCK(audio, audio->submixLock)
 
 	/* OnProcessingPassEnd callbacks */
 	FAudio_PlatformLockMutex(audio->callbackLock);
@@ -1257,6 +2902,12 @@ static void FAUDIOCALL FAudio_INTERNAL_GenerateOutput(FAudio *audio, float *outp
 	}
 	FAudio_PlatformUnlockMutex(audio->callbackLock);
 	LOG_MUTEX_UNLOCK(audio, audio->callbackLock)
+
+	FAudio_INTERNAL_UpdatePerformanceData(
+		audio,
+		start,
+		FAudio_timecounter()
+	);
 	LOG_FUNC_EXIT(audio)
 }
 
@@ -1279,16 +2930,69 @@ void FAudio_INTERNAL_UpdateEngine(FAudio *audio, float *output)
 	LOG_FUNC_EXIT(audio)
 }
 
+/* Fills frames of output, running the engine one quantum at a time. When an
+ * update doesn't fit in what's left of output, it's rendered to quantumCache
+ * instead and handed out at the start of the next call, so the engine always
+ * sees the same quantum however the platform slices its buffers. The output
+ * must be zeroed, just like for UpdateEngine.
+ */
+void FAudio_INTERNAL_RenderFrames(
+	FAudio *audio,
+	float *output,
+	uint32_t frames
+) {
+	uint32_t copy;
+	const uint32_t channels = audio->master->outputChannels;
+
+	LOG_FUNC_ENTER(audio)
+	while (frames > 0)
+	{
+		if (audio->quantumOffset < audio->updateSize)
+		{
+			/* Leftovers from the last update come first */
+			copy = FAudio_min(
+				frames,
+				audio->updateSize - audio->quantumOffset
+			);
+			FAudio_memcpy(
+				output,
+				audio->quantumCache + (audio->quantumOffset * channels),
+				sizeof(float) * copy * channels
+			);
+			audio->quantumOffset += copy;
+		}
+		else if (frames >= audio->updateSize)
+		{
+			/* A whole update fits, skip the copy */
+			FAudio_INTERNAL_UpdateEngine(audio, output);
+			copy = audio->updateSize;
+		}
+		else
+		{
+			FAudio_zero(
+				audio->quantumCache,
+				sizeof(float) * audio->updateSize * channels
+			);
+			FAudio_INTERNAL_UpdateEngine(audio, audio->quantumCache);
+			audio->quantumOffset = 0;
+			copy = 0;
+		}
+		output += copy * channels;
+		frames -= copy;
+	}
+	LOG_FUNC_EXIT(audio)
+}
+
+/* These only track the largest size needed by any voice. Each mix worker
+ * grows its own caches to match before mixing, on the mixer thread.
+ */
+
 void FAudio_INTERNAL_ResizeDecodeCache(FAudio *audio, uint32_t samples)
 {
 	LOG_FUNC_ENTER(audio)
 	if (samples > audio->decodeSamples)
 	{
 		audio->decodeSamples = samples;
-		audio->decodeCache = (float*) audio->pRealloc(
-			audio->decodeCache,
-			sizeof(float) * audio->decodeSamples
-		);
 	}
 	LOG_FUNC_EXIT(audio)
 }
@@ -1299,26 +3003,48 @@ void FAudio_INTERNAL_ResizeResampleCache(FAudio *audio, uint32_t samples)
 	if (samples > audio->resampleSamples)
 	{
 		audio->resampleSamples = samples;
-		audio->resampleCache = (float*) audio->pRealloc(
-			audio->resampleCache,
-			sizeof(float) * audio->resampleSamples
-		);
 	}
 	LOG_FUNC_EXIT(audio)
 }
 
-void FAudio_INTERNAL_ResizeEffectChainCache(FAudio *audio, uint32_t samples)
-{
-	LOG_FUNC_ENTER(audio)
-	if (samples > audio->effectChainSamples)
+void FAudio_INTERNAL_SetResamplerQuality(
+	FAudioSourceVoice *voice,
+	uint32_t quality
+) {
+	FAudio *audio = voice->audio;
+
+	/* The mixer reads both of these under sourceLock */
+	FAudio_PlatformLockMutex(audio->sourceLock);
+	LOG_MUTEX_LOCK(audio, audio->sourceLock)
+	if (quality == FAUDIO_RESAMPLER_QUALITY_SINC)
 	{
-		audio->effectChainSamples = samples;
-		audio->effectChainCache = (float*) audio->pRealloc(
-			audio->effectChainCache,
-			sizeof(float) * audio->effectChainSamples
+		if (audio->sincTable == NULL)
+		{
+			audio->sincTable = (float*) audio->pMalloc(
+				sizeof(float) * SINC_TABLE_SIZE
+			);
+			FAudio_INTERNAL_BuildSincTable(audio->sincTable);
+		}
+		if (voice->src.sincHistory == NULL)
+		{
+			voice->src.sincHistory = (float*) audio->pMalloc(
+				sizeof(float) *
+				SINC_HISTORY *
+				voice->src.format->nChannels
+			);
+		}
+		FAudio_zero(
+			voice->src.sincHistory,
+			sizeof(float) * SINC_HISTORY * voice->src.format->nChannels
 		);
 	}
-	LOG_FUNC_EXIT(audio)
+	else if (voice->src.sincHistory != NULL)
+	{
+		audio->pFree(voice->src.sincHistory);
+		voice->src.sincHistory = NULL;
+	}
+	FAudio_PlatformUnlockMutex(audio->sourceLock);
+	LOG_MUTEX_UNLOCK(audio, audio->sourceLock)
 }
 
 void FAudio_INTERNAL_AllocEffectChain(
@@ -1356,9 +3082,7 @@ void FAudio_INTERNAL_AllocEffectChain(
 			voice->effects.prop, \
 			voice->effects.count * sizeof(type) \
 		);
-	ALLOC_EFFECT_PROPERTY(parameters, void*)
-	ALLOC_EFFECT_PROPERTY(parameterSizes, uint32_t)
-	ALLOC_EFFECT_PROPERTY(parameterUpdates, uint8_t)
+	ALLOC_EFFECT_PROPERTY(parameters, FAudioEffectParameterBlock*)
 	ALLOC_EFFECT_PROPERTY(inPlaceProcessing, uint8_t)
 	#undef ALLOC_EFFECT_PROPERTY
 	LOG_FUNC_EXIT(voice->audio)
@@ -1379,12 +3103,14 @@ void FAudio_INTERNAL_FreeEffectChain(FAudioVoice *voice)
 	{
 		voice->effects.desc[i].pEffect->UnlockForProcess(voice->effects.desc[i].pEffect);
 		voice->effects.desc[i].pEffect->Release(voice->effects.desc[i].pEffect);
+		if (voice->effects.parameters[i] != NULL)
+		{
+			voice->audio->pFree(voice->effects.parameters[i]);
+		}
 	}
 
 	voice->audio->pFree(voice->effects.desc);
 	voice->audio->pFree(voice->effects.parameters);
-	voice->audio->pFree(voice->effects.parameterSizes);
-	voice->audio->pFree(voice->effects.parameterUpdates);
 	voice->audio->pFree(voice->effects.inPlaceProcessing);
 	LOG_FUNC_EXIT(voice->audio)
 }
@@ -1436,22 +3162,34 @@ void FAudio_INTERNAL_DecodePCM24(
 	float *decodeCache,
 	uint32_t samples
 ) {
-	uint32_t i, j;
+	uint32_t i;
 	const uint8_t *buf;
 	LOG_FUNC_ENTER(voice->audio)
 
-	/* FIXME: Uh... is this something that can be SIMD-ified? */
 	buf = buffer->pAudioData + (
 		voice->src.curBufferOffset * voice->src.format->nBlockAlign
 	);
+
+	/* Packed samples, which is pretty much always the case */
+	if (voice->src.format->nBlockAlign == voice->src.format->nChannels * 3)
+	{
+		FAudio_INTERNAL_Convert_S24_To_F32(
+			buf,
+			decodeCache,
+			samples * voice->src.format->nChannels
+		);
+		LOG_FUNC_EXIT(voice->audio)
+		return;
+	}
+
 	for (i = 0; i < samples; i += 1, buf += voice->src.format->nBlockAlign)
-	for (j = 0; j < voice->src.format->nChannels; j += 1)
 	{
-		*decodeCache++ = ((int32_t) (
-			((uint32_t) buf[(j * 3) + 2] << 24) |
-			((uint32_t) buf[(j * 3) + 1] << 16) |
-			((uint32_t) buf[(j * 3) + 0] << 8)
-		) >> 8) / 8388607.0f;
+		FAudio_INTERNAL_Convert_S24_To_F32_Scalar(
+			buf,
+			decodeCache,
+			voice->src.format->nChannels
+		);
+		decodeCache += voice->src.format->nChannels;
 	}
 
 	LOG_FUNC_EXIT(voice->audio)
@@ -1624,6 +3362,409 @@ static inline void FAudio_INTERNAL_DecodeStereoMSADPCMBlock(
 
 #undef READ
 
+/* Decodes the block at buf into the voice's block cache, unless that block is
+ * already there, which happens whenever a decode starts mid-block (that is,
+ * almost every update) and for the EXTRA_DECODE_PADDING lookahead. Either way,
+ * buf is moved to the next block, and the decoded block is returned.
+ */
+static inline int16_t *FAudio_INTERNAL_CacheMSADPCMBlock(
+	FAudioVoice *voice,
+	uint8_t **buf
+) {
+	uint8_t slot;
+	int16_t *blockCache;
+	const uint32_t blockSamples = 2 * (
+		voice->src.format->nBlockAlign -
+		(6 * voice->src.format->nChannels)
+	);
+
+	for (slot = 0; slot < 2; slot += 1)
+	{
+		if (*buf == voice->src.msadpcmBlock[slot])
+		{
+			*buf += voice->src.format->nBlockAlign;
+			FAudio_PlatformAtomicAdd(&voice->audio->msadpcmBlocksReused, 1);
+			return voice->src.msadpcmCache + (slot * blockSamples);
+		}
+	}
+
+	/* Replace the older of the two */
+	slot = !voice->src.msadpcmNewest;
+	voice->src.msadpcmNewest = slot;
+	voice->src.msadpcmBlock[slot] = *buf;
+	blockCache = voice->src.msadpcmCache + (slot * blockSamples);
+	if (voice->src.format->nChannels == 2)
+	{
+		FAudio_INTERNAL_DecodeStereoMSADPCMBlock(
+			buf,
+			blockCache,
+			voice->src.format->nBlockAlign
+		);
+	}
+	else
+	{
+		FAudio_INTERNAL_DecodeMonoMSADPCMBlock(
+			buf,
+			blockCache,
+			voice->src.format->nBlockAlign
+		);
+	}
+	FAudio_PlatformAtomicAdd(&voice->audio->msadpcmBlocksDecoded, 1);
+	return blockCache;
+}
+
+/* PCM Cache, see PCMCacheEXT */
+
+static void FAudio_INTERNAL_EvictPCMCacheEntry(
+	FAudio *audio,
+	FAudioPCMCacheEntry *entry
+) {
+	if (entry->prev != NULL)
+	{
+		entry->prev->next = entry->next;
+	}
+	else
+	{
+		audio->pcmCacheHead = entry->next;
+	}
+	if (entry->next != NULL)
+	{
+		entry->next->prev = entry->prev;
+	}
+	else
+	{
+		audio->pcmCacheTail = entry->prev;
+	}
+	audio->pcmCacheUsed -= entry->size;
+	audio->pcmCacheEntries -= 1;
+
+	if (entry->refcount == 0)
+	{
+		audio->pFree(entry->samples);
+		audio->pFree(entry);
+	}
+	else
+	{
+		/* The last voice to release it will free it */
+		entry->evicted = 1;
+	}
+}
+
+/* Evicts unused entries, least recently used first, until reserve more bytes
+ * fit in the budget. Returns 0 if that's not possible. pcmCacheLock must be
+ * held by the caller.
+ */
+uint8_t FAudio_INTERNAL_TrimPCMCache(FAudio *audio, uint32_t reserve)
+{
+	FAudioPCMCacheEntry *entry, *prev;
+
+	if (reserve > audio->pcmCacheBudget)
+	{
+		return 0;
+	}
+	entry = audio->pcmCacheTail;
+	while (	entry != NULL &&
+		audio->pcmCacheUsed > audio->pcmCacheBudget - reserve	)
+	{
+		prev = entry->prev;
+		if (entry->refcount == 0)
+		{
+			FAudio_INTERNAL_EvictPCMCacheEntry(audio, entry);
+			audio->pcmCacheEvictions += 1;
+		}
+		entry = prev;
+	}
+	return audio->pcmCacheUsed <= audio->pcmCacheBudget - reserve;
+}
+
+/* Drops every entry decoded from memory in [data, data + bytes). pcmCacheLock
+ * must be held by the caller.
+ */
+void FAudio_INTERNAL_InvalidatePCMCache(
+	FAudio *audio,
+	const uint8_t *data,
+	uint32_t bytes
+) {
+	FAudioPCMCacheEntry *entry, *next;
+
+	entry = audio->pcmCacheHead;
+	while (entry != NULL)
+	{
+		next = entry->next;
+		if (	(size_t) entry->data < (size_t) data + bytes &&
+			(size_t) data < (size_t) entry->data + entry->bytes	)
+		{
+			FAudio_INTERNAL_EvictPCMCacheEntry(audio, entry);
+		}
+		entry = next;
+	}
+}
+
+void FAudio_INTERNAL_ReleasePCMCacheEntry(FAudioSourceVoice *voice)
+{
+	FAudioPCMCacheEntry *entry = voice->src.pcmCacheEntry;
+
+	voice->src.pcmCacheEntry = NULL;
+	voice->src.pcmCacheChecked = 0;
+	if (entry == NULL)
+	{
+		return;
+	}
+
+	FAudio_PlatformLockMutex(voice->audio->pcmCacheLock);
+	LOG_MUTEX_LOCK(voice->audio, voice->audio->pcmCacheLock)
+	entry->refcount -= 1;
+	if (entry->evicted && entry->refcount == 0)
+	{
+		voice->audio->pFree(entry->samples);
+		voice->audio->pFree(entry);
+	}
+	FAudio_PlatformUnlockMutex(voice->audio->pcmCacheLock);
+	LOG_MUTEX_UNLOCK(voice->audio, voice->audio->pcmCacheLock)
+}
+
+void FAudio_INTERNAL_FreePCMCache(FAudio *audio)
+{
+	/* Entries still held by voices go away with those voices */
+	while (audio->pcmCacheHead != NULL)
+	{
+		FAudio_INTERNAL_EvictPCMCacheEntry(audio, audio->pcmCacheHead);
+	}
+}
+
+static FAudioPCMCacheEntry* FAudio_INTERNAL_FindPCMCacheEntry(
+	FAudio *audio,
+	const FAudioBuffer *buffer,
+	const FAudioWaveFormatEx *format
+) {
+	FAudioPCMCacheEntry *entry;
+
+	for (entry = audio->pcmCacheHead; entry != NULL; entry = entry->next)
+	{
+		if (	entry->data == buffer->pAudioData &&
+			entry->bytes == buffer->AudioBytes &&
+			entry->channels == format->nChannels &&
+			entry->blockAlign == format->nBlockAlign	)
+		{
+			break;
+		}
+	}
+	if (entry == NULL || entry == audio->pcmCacheHead)
+	{
+		return entry;
+	}
+
+	/* Move it to the front of the LRU list */
+	entry->prev->next = entry->next;
+	if (entry->next != NULL)
+	{
+		entry->next->prev = entry->prev;
+	}
+	else
+	{
+		audio->pcmCacheTail = entry->prev;
+	}
+	entry->prev = NULL;
+	entry->next = audio->pcmCacheHead;
+	audio->pcmCacheHead->prev = entry;
+	audio->pcmCacheHead = entry;
+	return entry;
+}
+
+/* Looks up a cacheable buffer as it's submitted, decoding it in full on a miss,
+ * so that the mixer never has to. This runs on the thread submitting the
+ * buffer, and decodes into its own memory, since the mixer may be using the
+ * voice's block cache at the same time.
+ */
+void FAudio_INTERNAL_FillPCMCache(
+	FAudioSourceVoice *voice,
+	const FAudioBuffer *buffer
+) {
+	FAudio *audio = voice->audio;
+	const FAudioWaveFormatEx *format = voice->src.format;
+	FAudioPCMCacheEntry *entry;
+	uint32_t i, blocks, bsize;
+	uint64_t size;
+	uint8_t *buf;
+	int16_t *blockCache;
+	uint8_t cacheable;
+
+	if (	format->wFormatTag != FAUDIO_FORMAT_MSADPCM ||
+		buffer->AudioBytes == 0 ||
+		(buffer->AudioBytes % format->nBlockAlign) != 0	)
+	{
+		return;
+	}
+	blocks = buffer->AudioBytes / format->nBlockAlign;
+	bsize = ((format->nBlockAlign / format->nChannels) - 6) * 2;
+	size = (uint64_t) blocks * bsize * format->nChannels * sizeof(float);
+
+	FAudio_PlatformLockMutex(audio->pcmCacheLock);
+	LOG_MUTEX_LOCK(audio, audio->pcmCacheLock)
+	if (audio->pcmCacheBudget == 0)
+	{
+		entry = NULL;
+		cacheable = 0;
+	}
+	else
+	{
+		entry = FAudio_INTERNAL_FindPCMCacheEntry(audio, buffer, format);
+		if (entry != NULL)
+		{
+			audio->pcmCacheHits += 1;
+		}
+		else
+		{
+			audio->pcmCacheMisses += 1;
+		}
+
+		/* One big sound shouldn't be able to push out all the small ones */
+		cacheable = (size <= audio->pcmCacheBudget / 4);
+	}
+	FAudio_PlatformUnlockMutex(audio->pcmCacheLock);
+	LOG_MUTEX_UNLOCK(audio, audio->pcmCacheLock)
+	if (entry != NULL || !cacheable)
+	{
+		return;
+	}
+
+	/* Decode outside of the lock, the mixer may be waiting on it */
+	entry = (FAudioPCMCacheEntry*) audio->pMalloc(sizeof(FAudioPCMCacheEntry));
+	FAudio_zero(entry, sizeof(FAudioPCMCacheEntry));
+	entry->data = (const uint8_t*) buffer->pAudioData;
+	entry->bytes = buffer->AudioBytes;
+	entry->channels = format->nChannels;
+	entry->blockAlign = format->nBlockAlign;
+	entry->frames = blocks * bsize;
+	entry->size = (uint32_t) size;
+	entry->samples = (float*) audio->pMalloc(entry->size);
+	blockCache = (int16_t*) audio->pMalloc(
+		sizeof(int16_t) * bsize * format->nChannels
+	);
+	buf = (uint8_t*) buffer->pAudioData;
+	for (i = 0; i < blocks; i += 1)
+	{
+		if (format->nChannels == 2)
+		{
+			FAudio_INTERNAL_DecodeStereoMSADPCMBlock(
+				&buf,
+				blockCache,
+				format->nBlockAlign
+			);
+		}
+		else
+		{
+			FAudio_INTERNAL_DecodeMonoMSADPCMBlock(
+				&buf,
+				blockCache,
+				format->nBlockAlign
+			);
+		}
+		FAudio_INTERNAL_Convert_S16_To_F32(
+			blockCache,
+			entry->samples + (i * bsize * format->nChannels),
+			bsize * format->nChannels
+		);
+	}
+	audio->pFree(blockCache);
+	FAudio_PlatformAtomicAdd(&audio->msadpcmBlocksDecoded, blocks);
+
+	FAudio_PlatformLockMutex(audio->pcmCacheLock);
+	LOG_MUTEX_LOCK(audio, audio->pcmCacheLock)
+	if (	FAudio_INTERNAL_FindPCMCacheEntry(audio, buffer, format) == NULL &&
+		FAudio_INTERNAL_TrimPCMCache(audio, entry->size)	)
+	{
+		entry->next = audio->pcmCacheHead;
+		if (audio->pcmCacheHead != NULL)
+		{
+			audio->pcmCacheHead->prev = entry;
+		}
+		else
+		{
+			audio->pcmCacheTail = entry;
+		}
+		audio->pcmCacheHead = entry;
+		audio->pcmCacheUsed += entry->size;
+		audio->pcmCacheEntries += 1;
+		entry = NULL;
+	}
+	FAudio_PlatformUnlockMutex(audio->pcmCacheLock);
+	LOG_MUTEX_UNLOCK(audio, audio->pcmCacheLock)
+
+	/* Another thread decoded it at the same time, or it didn't fit */
+	if (entry != NULL)
+	{
+		audio->pFree(entry->samples);
+		audio->pFree(entry);
+	}
+}
+
+/* Takes a reference on the buffer's entry for as long as the voice reads from
+ * it. Returns NULL when the buffer isn't cached (it was too big, or evicted
+ * since it was submitted), in which case the voice just decodes it as usual.
+ */
+static FAudioPCMCacheEntry* FAudio_INTERNAL_AcquirePCMCacheEntry(
+	FAudioSourceVoice *voice,
+	const FAudioBuffer *buffer
+) {
+	FAudio *audio = voice->audio;
+	FAudioPCMCacheEntry *entry;
+
+	FAudio_PlatformLockMutex(audio->pcmCacheLock);
+	LOG_MUTEX_LOCK(audio, audio->pcmCacheLock)
+	entry = FAudio_INTERNAL_FindPCMCacheEntry(
+		audio,
+		buffer,
+		voice->src.format
+	);
+	if (entry != NULL)
+	{
+		entry->refcount += 1;
+	}
+	FAudio_PlatformUnlockMutex(audio->pcmCacheLock);
+	LOG_MUTEX_UNLOCK(audio, audio->pcmCacheLock)
+	return entry;
+}
+
+/* Serves the read from the PCM cache when the current buffer is in it. Returns
+ * 0 when the voice has to decode the buffer itself.
+ */
+static inline uint8_t FAudio_INTERNAL_DecodeFromPCMCache(
+	FAudioVoice *voice,
+	FAudioBuffer *buffer,
+	float *decodeCache,
+	uint32_t samples
+) {
+	FAudioPCMCacheEntry *entry;
+
+	if (!voice->src.pcmCacheChecked)
+	{
+		voice->src.pcmCacheChecked = 1;
+		if (buffer->Flags & FAUDIO_BUFFER_CACHEABLE_EXT)
+		{
+			voice->src.pcmCacheEntry = FAudio_INTERNAL_AcquirePCMCacheEntry(
+				voice,
+				buffer
+			);
+		}
+	}
+	entry = voice->src.pcmCacheEntry;
+	if (	entry == NULL ||
+		voice->src.curBufferOffset + samples > entry->frames	)
+	{
+		return 0;
+	}
+
+	FAudio_memcpy(
+		decodeCache,
+		entry->samples + (
+			voice->src.curBufferOffset * entry->channels
+		),
+		sizeof(float) * samples * entry->channels
+	);
+	return 1;
+}
+
 void FAudio_INTERNAL_DecodeMonoMSADPCM(
 	FAudioVoice *voice,
 	FAudioBuffer *buffer,
@@ -1635,16 +3776,20 @@ void FAudio_INTERNAL_DecodeMonoMSADPCM(
 
 	/* Read pointers */
 	uint8_t *buf;
+	int16_t *blockCache;
 	int32_t midOffset;
 
-	/* PCM block cache */
-	int16_t blockCache[1012]; /* Max block size */
-
 	/* Block size */
 	uint32_t bsize = (voice->src.format->nBlockAlign - 6) * 2;
 
 	LOG_FUNC_ENTER(voice->audio)
 
+	if (FAudio_INTERNAL_DecodeFromPCMCache(voice, buffer, decodeCache, samples))
+	{
+		LOG_FUNC_EXIT(voice->audio)
+		return;
+	}
+
 	/* Where are we starting? */
 	buf = (uint8_t*) buffer->pAudioData + (
 		(voice->src.curBufferOffset / bsize) *
@@ -1658,11 +3803,7 @@ void FAudio_INTERNAL_DecodeMonoMSADPCM(
 	while (done < samples)
 	{
 		copy = FAudio_min(samples - done, bsize - midOffset);
-		FAudio_INTERNAL_DecodeMonoMSADPCMBlock(
-			&buf,
-			blockCache,
-			voice->src.format->nBlockAlign
-		);
+		blockCache = FAudio_INTERNAL_CacheMSADPCMBlock(voice, &buf);
 		FAudio_INTERNAL_Convert_S16_To_F32(
 			blockCache + midOffset,
 			decodeCache,
@@ -1686,16 +3827,20 @@ void FAudio_INTERNAL_DecodeStereoMSADPCM(
 
 	/* Read pointers */
 	uint8_t *buf;
+	int16_t *blockCache;
 	int32_t midOffset;
 
-	/* PCM block cache */
-	int16_t blockCache[2024]; /* Max block size */
-
 	/* Align, block size */
 	uint32_t bsize = ((voice->src.format->nBlockAlign / 2) - 6) * 2;
 
 	LOG_FUNC_ENTER(voice->audio)
 
+	if (FAudio_INTERNAL_DecodeFromPCMCache(voice, buffer, decodeCache, samples))
+	{
+		LOG_FUNC_EXIT(voice->audio)
+		return;
+	}
+
 	/* Where are we starting? */
 	buf = (uint8_t*) buffer->pAudioData + (
 		(voice->src.curBufferOffset / bsize) *
@@ -1709,11 +3854,7 @@ void FAudio_INTERNAL_DecodeStereoMSADPCM(
 	while (done < samples)
 	{
 		copy = FAudio_min(samples - done, bsize - midOffset);
-		FAudio_INTERNAL_DecodeStereoMSADPCMBlock(
-			&buf,
-			blockCache,
-			voice->src.format->nBlockAlign
-		);
+		blockCache = FAudio_INTERNAL_CacheMSADPCMBlock(voice, &buf);
 		FAudio_INTERNAL_Convert_S16_To_F32(
 			blockCache + (midOffset * 2),
 			decodeCache,
@@ -63,6 +63,7 @@
 #define FAudio_abs(x) abs(x)
 #define FAudio_ldexp(v, e) ldexp(v, e)
 #define FAudio_exp(x) exp(x)
+#define FAudio_sqrt(x) sqrt(x)
 
 #define FAudio_cosf(x) cosf(x)
 #define FAudio_sinf(x) sinf(x)
@@ -78,6 +79,7 @@
 #define FAudio_vsnprintf vsnprintf
 #define FAudio_Log(msg) fprintf(stderr, "%s\n", msg);
 #define FAudio_getenv getenv
+#define FAudio_atoi atoi
 #define FAudio_PRIu64 PRIu64
 #define FAudio_PRIx64 PRIx64
 #else
@@ -112,6 +114,7 @@
 #define FAudio_abs(x) SDL_abs(x)
 #define FAudio_ldexp(v, e) SDL_scalbn(v, e)
 #define FAudio_exp(x) SDL_exp(x)
+#define FAudio_sqrt(x) SDL_sqrt(x)
 
 #define FAudio_cosf(x) SDL_cosf(x)
 #define FAudio_sinf(x) SDL_sinf(x)
@@ -139,6 +142,7 @@
 #define FAudio_vsnprintf SDL_vsnprintf
 #define FAudio_Log(msg) SDL_Log("%s\n", msg);
 #define FAudio_getenv SDL_getenv
+#define FAudio_atoi SDL_atoi
 #define FAudio_PRIu64 SDL_PRIu64
 #define FAudio_PRIx64 SDL_PRIx64
 #endif
@@ -177,6 +181,7 @@
 
 typedef void* FAudioThread;
 typedef void* FAudioMutex;
+typedef void* FAudioSemaphore;
 typedef int32_t (FAUDIOCALL * FAudioThreadFunc)(void* data);
 typedef enum FAudioThreadPriority
 {
@@ -226,7 +231,11 @@ struct FAudioBufferEntry
 {
 	FAudioBuffer buffer;
 	FAudioBufferWMA bufferWMA;
-	FAudioBufferEntry *next;
+
+	/* Slot state when this lives in a voice's bufferQueue, see
+	 * FAudio_INTERNAL_PushBuffer for how it's used.
+	 */
+	int32_t sequence;
 };
 
 typedef void (FAUDIOCALL * FAudioDecodeCallback)(
@@ -245,6 +254,20 @@ typedef void (FAUDIOCALL * FAudioResampleCallback)(
 	uint8_t channels
 );
 
+/* Like FAudioResampleCallback, but dCache must be preceded by SINC_HISTORY
+ * frames of history, and `table` is one cutoff's worth of the table from
+ * FAudio_INTERNAL_BuildSincTable.
+ */
+typedef void (FAUDIOCALL * FAudioSincResampleCallback)(
+	float *restrict dCache,
+	float *restrict resampleCache,
+	uint64_t *resampleOffset,
+	uint64_t resampleStep,
+	uint64_t toResample,
+	uint8_t channels,
+	const float *restrict table
+);
+
 typedef void (FAUDIOCALL * FAudioMixCallback)(
 	uint32_t toMix,
 	uint32_t srcChans,
@@ -258,6 +281,164 @@ typedef void (FAUDIOCALL * FAudioMixCallback)(
 
 typedef float FAudioFilterState[4];
 
+/* Mix Workers */
+
+#define MAX_MIX_WORKERS 32
+
+typedef struct FAudio_OPERATIONSET_Operation FAudio_OPERATIONSET_Operation;
+
+/* Idle source voices for one CreateSourceVoicePoolEXT key. Voices that were
+ * handed out stay in audio->sources, they are simply inactive while idle.
+ */
+typedef struct FAudioSourceVoicePool FAudioSourceVoicePool;
+struct FAudioSourceVoicePool
+{
+	/* Key, exactly as given to FAudio_CreateSourceVoicePoolEXT */
+	FAudioWaveFormatEx *format;
+	uint32_t flags;
+	float maxFreqRatio;
+
+	/* Stack of idle voices, big enough to hold every voice in the pool */
+	FAudioSourceVoice **idle;
+	uint32_t idleCount;
+	uint32_t idleCapacity;
+
+	FAudioSourceVoicePoolStatisticsEXT stats;
+	FAudioSourceVoicePool *next;
+};
+
+/* A cacheable buffer decoded in full, shared by every voice that plays it.
+ * Entries that get evicted while voices are still reading from them are
+ * unlinked right away, but only freed once the last voice lets go.
+ */
+typedef struct FAudioPCMCacheEntry FAudioPCMCacheEntry;
+struct FAudioPCMCacheEntry
+{
+	/* Key, the buffer and the format it was decoded with */
+	const uint8_t *data;
+	uint32_t bytes;
+	uint16_t channels;
+	uint16_t blockAlign;
+
+	float *samples;
+	uint32_t frames;
+	uint32_t size;		/* What counts against the budget */
+	uint32_t refcount;	/* Voices reading from samples */
+	uint8_t evicted;
+
+	/* LRU list, most recently used first */
+	FAudioPCMCacheEntry *prev;
+	FAudioPCMCacheEntry *next;
+};
+
+/* Voice parameters as seen by the mixer. Each voice keeps three of these: the
+ * API thread fills in its back copy and swaps it with the shared one, and the
+ * mixer swaps its front copy with the shared one whenever a newer one has been
+ * published. Neither side ever waits on the other.
+ */
+typedef struct FAudioVoiceParameters
+{
+	float volume;
+	float freqRatio;
+	FAudioFilterParameters filter;
+	float *channelVolume;
+	uint32_t sendCount;
+	float **sendCoefficients;
+	FAudioFilterParameters *sendFilter;
+} FAudioVoiceParameters;
+
+#define PARAMETERS_INDEX 0x3
+#define PARAMETERS_DIRTY 0x4
+
+/* SetEffectParameters data waiting for the mixer, handed over by pointer
+ * swap. The parameter data immediately follows this header.
+ */
+typedef struct FAudioEffectParameterBlock
+{
+	uint64_t size;
+} FAudioEffectParameterBlock;
+
+typedef struct FAudioMixWorker FAudioMixWorker;
+
+typedef void (FAUDIOCALL * FAudioMixJob)(
+	FAudioMixWorker *worker,
+	void **items,
+	uint32_t count
+);
+
+/* FilterMonoBatch filters up to this many mono voices at once */
+#define FILTER_MONO_BATCH 4
+
+/* A filter whose state is all below this has nothing left to ring out */
+#define FILTER_IDLE_LEVEL 0.0000001f
+
+struct FAudioMixWorker
+{
+	FAudio *audio;
+	uint32_t index;
+	FAudioThread thread;
+	FAudioSemaphore wakeup;
+
+	/* Current job, written by the mixer thread before wakeup */
+	FAudioMixJob job;
+	void **jobItems;
+	uint32_t jobCount;
+
+	/* Temp storage for processing, interleaved PCM32F. decodeCache is
+	 * preceded by SINC_HISTORY_SAMPLES of room for the sinc resampler,
+	 * decodeBase is the actual allocation.
+	 */
+	uint32_t decodeSamples;
+	uint32_t resampleSamples;
+	uint32_t effectChainSamples;
+	float *decodeBase;
+	float *decodeCache;
+	float *resampleCache;
+	float *effectChainCache;
+
+	/* Filtered mono voices waiting to go through FilterMonoBatch.
+	 * Each one gets audio->resampleSamples of filterBatchCache.
+	 */
+	uint32_t filterBatchCount;
+	FAudioVoice *filterBatchVoices[FILTER_MONO_BATCH];
+	FAudioVoiceParameters *filterBatchParams[FILTER_MONO_BATCH];
+	uint32_t filterBatchMixed[FILTER_MONO_BATCH];
+	uint32_t filterBatchSamples;
+	float *filterBatchCache;
+
+	/* Counted for FAudio_GetPerformanceData, summed after each update */
+	uint32_t resamplers;
+	uint32_t matrixMixes;
+
+	/* Voices whose workerCache[index] was written during this job */
+	FAudioVoice **dirty;
+	uint32_t dirtyCount;
+	uint32_t dirtyCapacity;
+};
+
+/* The voice graph flattened into the order the mixer runs it in. Each half is
+ * rebuilt under its mix lock, only when its dirty flag has been raised.
+ */
+typedef struct FAudioRenderPlan
+{
+	/* Active source voices, in audio->sources order */
+	int32_t sourcesDirty;
+	void **sources;
+	uint32_t sourceCount;
+	uint32_t sourceCapacity;
+
+	/* All submixes, in audio->submixes order. Stage i runs
+	 * submixes[stageEnds[i - 1]] up to submixes[stageEnds[i]].
+	 */
+	int32_t submixesDirty;
+	void **submixes;
+	uint32_t submixCount;
+	uint32_t submixCapacity;
+	uint32_t *stageEnds;
+	uint32_t stageCount;
+	uint32_t stageCapacity;
+} FAudioRenderPlan;
+
 /* Public FAudio Types */
 
 struct FAudio
@@ -266,6 +447,26 @@ struct FAudio
 	uint8_t active;
 	uint32_t refcount;
 	uint32_t updateSize;
+
+	/* See QuantumSizeEXT. quantumSize is what the client asked for, or 0
+	 * to use whatever the device wants. quantumCache holds the rest of an
+	 * update that didn't fit in the last device buffer, starting from
+	 * quantumOffset (updateSize when there's nothing left).
+	 */
+	uint32_t quantumSize;
+	float *quantumCache;
+	uint32_t quantumOffset;
+
+	/* See HeadlessEXT */
+	uint32_t headlessMode;
+	char *headlessPath;
+
+	/* See RenderEXT. renderCache holds float output before it's converted
+	 * to the client's format, and is sized for one update.
+	 */
+	float *renderCache;
+	uint32_t renderCacheSamples;
+	uint32_t ditherSeed;
 	FAudioMasteringVoice *master;
 	LinkedList *sources;
 	LinkedList *submixes;
@@ -275,14 +476,77 @@ struct FAudio
 	FAudioMutex callbackLock;
 	FAudioWaveFormatExtensible *mixFormat;
 
-	/* Temp storage for processing, interleaved PCM32F */
+	/* Temp storage sizes, the caches belong to each FAudioMixWorker */
 	#define EXTRA_DECODE_PADDING 2
+	#define MIX_BLOCK_FRAMES 128
 	uint32_t decodeSamples;
 	uint32_t resampleSamples;
-	uint32_t effectChainSamples;
-	float *decodeCache;
-	float *resampleCache;
-	float *effectChainCache;
+
+	/* Mixer threads, mixWorkers[0] is always the engine thread itself */
+	uint32_t mixWorkerCount;
+	FAudioMixWorker *mixWorkers[MAX_MIX_WORKERS];
+	FAudioSemaphore mixDone;
+
+	/* What the mixer actually walks each update, see FAudioRenderPlan */
+	FAudioRenderPlan plan;
+
+	/* OperationSet queue, pushed lock-free by the client threads and
+	 * drained by the mixer at the start of each update
+	 */
+	void *queuedOperations;
+	FAudio_OPERATIONSET_Operation *pendingOperations;
+	FAudioMutex operationLock;
+
+	/* Source voice pools, see FAudio_CreateSourceVoicePoolEXT */
+	FAudioSourceVoicePool *voicePools;
+	FAudioMutex voicePoolLock;
+
+	/* Resampler quality for new source voices, see ResamplerQualityEXT.
+	 * sincTable is only allocated once a voice asks for it.
+	 */
+	uint32_t resamplerQuality;
+	float *sincTable;
+
+	/* See DecodeStatisticsEXT. The counters are bumped by the mix
+	 * workers, then moved to decodeStats after each update's sources.
+	 */
+	int32_t msadpcmBlocksDecoded;
+	int32_t msadpcmBlocksReused;
+	FAudioDecodeStatisticsEXT decodeStats;
+
+	/* See FAudio_GetPerformanceData. Times are FAudio_timecounter ticks.
+	 * The mixer adds each update under sourceLock, and every query takes
+	 * what was added since the last one and starts over.
+	 */
+	uint64_t perfQueryTime;
+	uint64_t perfAudioTime;
+	uint64_t perfMinQuantum;
+	uint64_t perfMaxQuantum;
+	uint32_t perfQuanta;
+	uint32_t perfGlitches;
+	uint32_t perfResamplers;
+	uint32_t perfMatrixMixes;
+
+	/* Frames the platform buffers past the engine, set by PlatformInit */
+	uint32_t platformLatency;
+
+	/* Bytes in the caches the mixer grows by itself, which can't be
+	 * tallied up from the voices
+	 */
+	int32_t mixerCacheBytes;
+
+	/* Shared decoded buffers, see PCMCacheEXT. All of this is protected by
+	 * pcmCacheLock, which the mix workers take while holding sourceLock.
+	 */
+	FAudioPCMCacheEntry *pcmCacheHead;
+	FAudioPCMCacheEntry *pcmCacheTail;
+	uint32_t pcmCacheBudget;
+	uint32_t pcmCacheUsed;
+	uint32_t pcmCacheEntries;
+	uint32_t pcmCacheHits;
+	uint32_t pcmCacheMisses;
+	uint32_t pcmCacheEvictions;
+	FAudioMutex pcmCacheLock;
 
 	/* Allocator callbacks */
 	FAudioMallocFunc pMalloc;
@@ -317,9 +581,7 @@ struct FAudioVoice
 	{
 		uint32_t count;
 		FAudioEffectDescriptor *desc;
-		void **parameters;
-		uint32_t *parameterSizes;
-		uint8_t *parameterUpdates;
+		FAudioEffectParameterBlock **parameters;
 		uint8_t *inPlaceProcessing;
 	} effects;
 	FAudioFilterParameters filter;
@@ -333,6 +595,23 @@ struct FAudioVoice
 	uint32_t outputChannels;
 	FAudioMutex volumeLock;
 
+	/* What the mixer actually reads, see FAudioVoiceParameters.
+	 * parametersShared is an index, plus PARAMETERS_DIRTY when the API
+	 * thread has published something the mixer has not picked up yet.
+	 */
+	FAudioVoiceParameters parameters[3];
+	int32_t parametersShared;
+	uint8_t parametersBack;
+	uint8_t parametersFront;
+
+	/* Per-worker accumulation for submix/master inputs, see MixThreadsEXT.
+	 * Both arrays are MAX_MIX_WORKERS long, workerCache[0] is never used.
+	 * workerDirty is how many frames of each cache have been mixed into
+	 * this update, with [0] covering the voice's own input. 0 is silence.
+	 */
+	float **workerCache;
+	uint32_t *workerDirty;
+
 	union
 	{
 		struct
@@ -348,6 +627,29 @@ struct FAudioVoice
 			uint64_t curBufferOffsetDec;
 			uint32_t curBufferOffset;
 
+			/* Sinc resampler, NULL when using resample instead.
+			 * The SINC_HISTORY frames before the next decode.
+			 */
+			float *sincHistory;
+
+			/* MSADPCM, the last two blocks that were decoded, one
+			 * after the other in msadpcmCache. msadpcmBlock is where
+			 * each starts in the current buffer, or NULL when there's
+			 * nothing cached. Resampled voices step back a frame to
+			 * interpolate, so a read can go back into the previous
+			 * block right after the lookahead moved on to the next.
+			 */
+			int16_t *msadpcmCache;
+			const uint8_t *msadpcmBlock[2];
+			uint8_t msadpcmNewest;
+
+			/* The PCM cache entry for curBuffer, if any. Buffers
+			 * are only looked up once, pcmCacheChecked is cleared
+			 * whenever curBuffer changes.
+			 */
+			FAudioPCMCacheEntry *pcmCacheEntry;
+			uint8_t pcmCacheChecked;
+
 			/* FFmpeg */
 #ifdef HAVE_FFMPEG
 			struct FAudioFFmpeg *ffmpeg;
@@ -365,8 +667,24 @@ struct FAudioVoice
 			float freqRatio;
 			uint8_t newBuffer;
 			uint64_t totalSamples;
-			FAudioBufferEntry *bufferList;
-			FAudioMutex bufferLock;
+
+			/* Buffer queue. SubmitSourceBuffer fills bufferQueue,
+			 * a ring of FAUDIO_MAX_QUEUED_BUFFERS entries, and the
+			 * mixer moves the head into curBuffer when it gets to
+			 * it. Everything but bufferTail, buffersQueued and
+			 * curBufferContext belongs to the mixer.
+			 */
+			FAudioBufferEntry *bufferQueue;
+			uint32_t bufferHead;
+			int32_t bufferTail;
+			int32_t buffersQueued;
+			FAudioBufferEntry curBuffer;
+			uint8_t hasCurBuffer;
+			void *curBufferContext;
+			uint64_t mixThread;
+
+			/* Set if DestroyVoice should recycle this voice */
+			FAudioSourceVoicePool *pool;
 		} src;
 		struct
 		{
@@ -405,9 +723,56 @@ void FAudio_INTERNAL_InsertSubmixSorted(
 	FAudioMallocFunc pMalloc
 );
 void FAudio_INTERNAL_UpdateEngine(FAudio *audio, float *output);
+void FAudio_INTERNAL_RenderFrames(
+	FAudio *audio,
+	float *output,
+	uint32_t frames
+);
 void FAudio_INTERNAL_ResizeDecodeCache(FAudio *audio, uint32_t size);
 void FAudio_INTERNAL_ResizeResampleCache(FAudio *audio, uint32_t size);
-void FAudio_INTERNAL_ResizeEffectChainCache(FAudio *audio, uint32_t samples);
+void FAudio_INTERNAL_SetMixWorkerCount(FAudio *audio, uint32_t count);
+void FAudio_INTERNAL_AllocWorkerCaches(FAudioVoice *voice);
+void FAudio_INTERNAL_InvalidateRenderPlan(FAudio *audio, FAudioVoiceType type);
+void FAudio_INTERNAL_FreeRenderPlan(FAudio *audio);
+void FAudio_INTERNAL_FreeWorkerCaches(FAudioVoice *voice);
+FAudioResampleCallback FAudio_INTERNAL_GetResampler(
+	uint64_t resampleStep,
+	uint32_t channels
+);
+void FAudio_INTERNAL_SetResamplerQuality(
+	FAudioSourceVoice *voice,
+	uint32_t quality
+);
+uint8_t FAudio_INTERNAL_TrimPCMCache(FAudio *audio, uint32_t reserve);
+void FAudio_INTERNAL_InvalidatePCMCache(
+	FAudio *audio,
+	const uint8_t *data,
+	uint32_t bytes
+);
+void FAudio_INTERNAL_FillPCMCache(
+	FAudioSourceVoice *voice,
+	const FAudioBuffer *buffer
+);
+void FAudio_INTERNAL_ReleasePCMCacheEntry(FAudioSourceVoice *voice);
+void FAudio_INTERNAL_FreePCMCache(FAudio *audio);
+void FAudio_INTERNAL_AllocBufferQueue(FAudioSourceVoice *voice);
+uint8_t FAudio_INTERNAL_PushBuffer(
+	FAudioSourceVoice *voice,
+	const FAudioBuffer *buffer,
+	const FAudioBufferWMA *bufferWMA
+);
+uint8_t FAudio_INTERNAL_DequeueBuffer(
+	FAudioSourceVoice *voice,
+	FAudioBufferEntry *entry
+);
+FAudioBufferEntry* FAudio_INTERNAL_PeekBuffer(
+	FAudioSourceVoice *voice,
+	uint32_t index
+);
+void FAudio_INTERNAL_PopBuffer(FAudioSourceVoice *voice);
+void FAudio_INTERNAL_AllocParameters(FAudioVoice *voice);
+void FAudio_INTERNAL_FreeParameters(FAudioVoice *voice);
+void FAudio_INTERNAL_PublishParameters(FAudioVoice *voice);
 void FAudio_INTERNAL_AllocEffectChain(
 	FAudioVoice *voice,
 	const FAudioEffectChain *pEffectChain
@@ -528,8 +893,119 @@ CREATE_FAPOFX_FUNC(Reverb)
 CREATE_FAPOFX_FUNC(Echo)
 #undef CREATE_FAPOFX_FUNC
 
+/* Source Voice Pools */
+
+uint32_t FAudio_VOICEPOOL_Create(
+	FAudio *audio,
+	const FAudioWaveFormatEx *pSourceFormat,
+	uint32_t Flags,
+	float MaxFrequencyRatio,
+	uint32_t VoiceCount
+);
+uint32_t FAudio_VOICEPOOL_GetStatistics(
+	FAudio *audio,
+	const FAudioWaveFormatEx *pSourceFormat,
+	uint32_t Flags,
+	float MaxFrequencyRatio,
+	FAudioSourceVoicePoolStatisticsEXT *pStatistics
+);
+uint8_t FAudio_VOICEPOOL_Acquire(
+	FAudio *audio,
+	FAudioSourceVoice **ppSourceVoice,
+	const FAudioWaveFormatEx *pSourceFormat,
+	uint32_t Flags,
+	float MaxFrequencyRatio,
+	FAudioVoiceCallback *pCallback,
+	const FAudioVoiceSends *pSendList,
+	FAudioSourceVoicePool **ppMissedPool
+);
+void FAudio_VOICEPOOL_AddVoice(
+	FAudioSourceVoicePool *pool,
+	FAudioSourceVoice *voice
+);
+void FAudio_VOICEPOOL_Recycle(FAudioSourceVoice *voice);
+void FAudio_VOICEPOOL_FreeIdle(FAudio *audio);
+void FAudio_VOICEPOOL_DestroyAll(FAudio *audio);
+
+/* Operation Sets */
+
+void FAudio_OPERATIONSET_Commit(FAudio *audio, uint32_t OperationSet);
+void FAudio_OPERATIONSET_Execute(FAudio *audio);
+void FAudio_OPERATIONSET_ClearAll(FAudio *audio);
+void FAudio_OPERATIONSET_ClearAllForVoice(FAudioVoice *voice);
+
+void FAudio_OPERATIONSET_QueueEnableEffect(
+	FAudioVoice *voice,
+	uint32_t EffectIndex,
+	uint32_t OperationSet
+);
+void FAudio_OPERATIONSET_QueueDisableEffect(
+	FAudioVoice *voice,
+	uint32_t EffectIndex,
+	uint32_t OperationSet
+);
+void FAudio_OPERATIONSET_QueueSetEffectParameters(
+	FAudioVoice *voice,
+	uint32_t EffectIndex,
+	const void *pParameters,
+	uint32_t ParametersByteSize,
+	uint32_t OperationSet
+);
+void FAudio_OPERATIONSET_QueueSetFilterParameters(
+	FAudioVoice *voice,
+	const FAudioFilterParameters *pParameters,
+	uint32_t OperationSet
+);
+void FAudio_OPERATIONSET_QueueSetOutputFilterParameters(
+	FAudioVoice *voice,
+	FAudioVoice *pDestinationVoice,
+	const FAudioFilterParameters *pParameters,
+	uint32_t OperationSet
+);
+void FAudio_OPERATIONSET_QueueSetVolume(
+	FAudioVoice *voice,
+	float Volume,
+	uint32_t OperationSet
+);
+void FAudio_OPERATIONSET_QueueSetChannelVolumes(
+	FAudioVoice *voice,
+	uint32_t Channels,
+	const float *pVolumes,
+	uint32_t OperationSet
+);
+void FAudio_OPERATIONSET_QueueSetOutputMatrix(
+	FAudioVoice *voice,
+	FAudioVoice *pDestinationVoice,
+	uint32_t SourceChannels,
+	uint32_t DestinationChannels,
+	const float *pLevelMatrix,
+	uint32_t OperationSet
+);
+void FAudio_OPERATIONSET_QueueStart(
+	FAudioSourceVoice *voice,
+	uint32_t Flags,
+	uint32_t OperationSet
+);
+void FAudio_OPERATIONSET_QueueStop(
+	FAudioSourceVoice *voice,
+	uint32_t Flags,
+	uint32_t OperationSet
+);
+void FAudio_OPERATIONSET_QueueExitLoop(
+	FAudioSourceVoice *voice,
+	uint32_t OperationSet
+);
+void FAudio_OPERATIONSET_QueueSetFrequencyRatio(
+	FAudioSourceVoice *voice,
+	float Ratio,
+	uint32_t OperationSet
+);
+
 /* SIMD Stuff */
 
+/* NULL-terminated, see FAudio_internal_simd.c */
+extern const char *FAudio_INTERNAL_SIMDKernels[];
+
 /* Callbacks declared as functions (rather than function pointers) are
  * scalar-only, for now. SIMD versions should be possible for these.
  */
@@ -544,6 +1020,16 @@ extern void (*FAudio_INTERNAL_Convert_S16_To_F32)(
 	float *restrict dst,
 	uint32_t len
 );
+extern void (*FAudio_INTERNAL_Convert_S24_To_F32)(
+	const uint8_t *restrict src,
+	float *restrict dst,
+	uint32_t len
+);
+extern void (*FAudio_INTERNAL_Convert_F32_To_S16)(
+	const float *restrict src,
+	int16_t *restrict dst,
+	uint32_t len
+);
 
 extern FAudioResampleCallback FAudio_INTERNAL_ResampleMono;
 extern FAudioResampleCallback FAudio_INTERNAL_ResampleStereo;
@@ -556,13 +1042,117 @@ extern void FAudio_INTERNAL_ResampleGeneric(
 	uint8_t channels
 );
 
+extern FAudioResampleCallback FAudio_INTERNAL_Resample4Channel;
+extern FAudioResampleCallback FAudio_INTERNAL_Resample6Channel;
+extern FAudioResampleCallback FAudio_INTERNAL_Resample8Channel;
+
+/* Only valid for steps of exactly 1/2 or 1/4 (Up) and 2 or 4 (Down), see
+ * FAudio_INTERNAL_GetResampler.
+ */
+extern FAudioResampleCallback FAudio_INTERNAL_ResampleUpMono;
+extern FAudioResampleCallback FAudio_INTERNAL_ResampleUpStereo;
+extern FAudioResampleCallback FAudio_INTERNAL_ResampleDownMono;
+extern FAudioResampleCallback FAudio_INTERNAL_ResampleDownStereo;
+extern void FAudio_INTERNAL_ResampleUpGeneric(
+	float *restrict dCache,
+	float *restrict resampleCache,
+	uint64_t *resampleOffset,
+	uint64_t resampleStep,
+	uint64_t toResample,
+	uint8_t channels
+);
+extern void FAudio_INTERNAL_ResampleDownGeneric(
+	float *restrict dCache,
+	float *restrict resampleCache,
+	uint64_t *resampleOffset,
+	uint64_t resampleStep,
+	uint64_t toResample,
+	uint8_t channels
+);
+
+extern FAudioSincResampleCallback FAudio_INTERNAL_ResampleSincMono;
+extern FAudioSincResampleCallback FAudio_INTERNAL_ResampleSincStereo;
+extern void FAudio_INTERNAL_ResampleSincGeneric(
+	float *restrict dCache,
+	float *restrict resampleCache,
+	uint64_t *resampleOffset,
+	uint64_t resampleStep,
+	uint64_t toResample,
+	uint8_t channels,
+	const float *restrict table
+);
+
 extern void (*FAudio_INTERNAL_Amplify)(
 	float *output,
 	uint32_t totalSamples,
 	float volume
 );
 
+/* The scalar versions are always built, so SIMD versions can be checked
+ * against them.
+ */
+void FAudio_INTERNAL_Convert_U8_To_F32_Scalar(
+	const uint8_t *restrict src,
+	float *restrict dst,
+	uint32_t len
+);
+void FAudio_INTERNAL_Convert_S16_To_F32_Scalar(
+	const int16_t *restrict src,
+	float *restrict dst,
+	uint32_t len
+);
+void FAudio_INTERNAL_Convert_S24_To_F32_Scalar(
+	const uint8_t *restrict src,
+	float *restrict dst,
+	uint32_t len
+);
+void FAudio_INTERNAL_Convert_F32_To_S16_Scalar(
+	const float *restrict src,
+	int16_t *restrict dst,
+	uint32_t len
+);
+void FAudio_INTERNAL_ResampleMono_Scalar(
+	float *restrict dCache,
+	float *restrict resampleCache,
+	uint64_t *resampleOffset,
+	uint64_t resampleStep,
+	uint64_t toResample,
+	uint8_t UNUSED
+);
+void FAudio_INTERNAL_ResampleStereo_Scalar(
+	float *restrict dCache,
+	float *restrict resampleCache,
+	uint64_t *resampleOffset,
+	uint64_t resampleStep,
+	uint64_t toResample,
+	uint8_t UNUSED
+);
+void FAudio_INTERNAL_ResampleSincMono_Scalar(
+	float *restrict dCache,
+	float *restrict resampleCache,
+	uint64_t *resampleOffset,
+	uint64_t resampleStep,
+	uint64_t toResample,
+	uint8_t UNUSED,
+	const float *restrict table
+);
+void FAudio_INTERNAL_ResampleSincStereo_Scalar(
+	float *restrict dCache,
+	float *restrict resampleCache,
+	uint64_t *resampleOffset,
+	uint64_t resampleStep,
+	uint64_t toResample,
+	uint8_t UNUSED,
+	const float *restrict table
+);
+void FAudio_INTERNAL_Amplify_Scalar(
+	float *output,
+	uint32_t totalSamples,
+	float volume
+);
+
 #define MIX_FUNC(type) \
+	extern FAudioMixCallback FAudio_INTERNAL_Mix_##type; \
 	extern void FAudio_INTERNAL_Mix_##type##_Scalar( \
 		uint32_t toMix, \
 		uint32_t srcChans, \
@@ -584,7 +1174,41 @@ MIX_FUNC(2in_6out)
 MIX_FUNC(2in_8out)
 #undef MIX_FUNC
 
-void FAudio_INTERNAL_InitSIMDFunctions(uint8_t hasSSE2, uint8_t hasNEON);
+extern void (*FAudio_INTERNAL_FilterVoice)(
+	const FAudioFilterParameters *filter,
+	FAudioFilterState *filterState,
+	float *restrict samples,
+	uint32_t numSamples,
+	uint16_t numChannels
+);
+extern void (*FAudio_INTERNAL_FilterMonoBatch)(
+	const FAudioFilterParameters **filters,
+	FAudioFilterState **filterStates,
+	float **samples,
+	const uint32_t *numSamples,
+	uint32_t count
+);
+void FAudio_INTERNAL_FilterVoice_Scalar(
+	const FAudioFilterParameters *filter,
+	FAudioFilterState *filterState,
+	float *restrict samples,
+	uint32_t numSamples,
+	uint16_t numChannels
+);
+void FAudio_INTERNAL_FilterMonoBatch_Scalar(
+	const FAudioFilterParameters **filters,
+	FAudioFilterState **filterStates,
+	float **samples,
+	const uint32_t *numSamples,
+	uint32_t count
+);
+
+void FAudio_INTERNAL_InitSIMDFunctions(
+	uint8_t hasSSE2,
+	uint8_t hasAVX2,
+	uint8_t hasAVX512F,
+	uint8_t hasNEON
+);
 
 /* Decoders */
 
@@ -621,6 +1245,7 @@ void FAudio_PlatformAddRef(void);
 void FAudio_PlatformRelease(void);
 void FAudio_PlatformInit(FAudio *audio, uint32_t deviceIndex);
 void FAudio_PlatformQuit(FAudio *audio);
+void FAudio_PlatformStartEngine(FAudio *audio);
 
 uint32_t FAudio_PlatformGetDeviceCount(void);
 void FAudio_PlatformGetDeviceDetails(
@@ -642,11 +1267,27 @@ FAudioMutex FAudio_PlatformCreateMutex(void);
 void FAudio_PlatformDestroyMutex(FAudioMutex mutex);
 void FAudio_PlatformLockMutex(FAudioMutex mutex);
 void FAudio_PlatformUnlockMutex(FAudioMutex mutex);
+FAudioSemaphore FAudio_PlatformCreateSemaphore(uint32_t initialValue);
+void FAudio_PlatformDestroySemaphore(FAudioSemaphore semaphore);
+void FAudio_PlatformWaitSemaphore(FAudioSemaphore semaphore);
+void FAudio_PlatformSignalSemaphore(FAudioSemaphore semaphore);
 void FAudio_sleep(uint32_t ms);
 
+/* Atomics */
+
+int32_t FAudio_PlatformAtomicGet(int32_t *ptr);
+int32_t FAudio_PlatformAtomicSet(int32_t *ptr, int32_t value);
+int32_t FAudio_PlatformAtomicAdd(int32_t *ptr, int32_t value);
+uint8_t FAudio_PlatformAtomicCAS(int32_t *ptr, int32_t oldValue, int32_t newValue);
+void* FAudio_PlatformAtomicGetPtr(void **ptr);
+void* FAudio_PlatformAtomicSetPtr(void **ptr, void *value);
+uint8_t FAudio_PlatformAtomicCASPtr(void **ptr, void *oldValue, void *newValue);
+
 /* Time */
 
 uint32_t FAudio_timems(void);
+uint64_t FAudio_timecounter(void);
+uint64_t FAudio_timefrequency(void);
 
 /* Resampling */
 
@@ -703,4 +1344,34 @@ uint32_t FAudio_timems(void);
 	((fxd & FIXED_FRACTION_MASK) * (1.0f / FIXED_ONE)) /* Fraction part */ \
 )
 
+/* Windowed-sinc resampler, see ResamplerQualityEXT.
+ *
+ * Each output sample is a SINC_TAPS-tap FIR over the input. The taps for the
+ * offset's fraction come from a table of SINC_PHASES phases, picked with the
+ * top SINC_PHASE_BITS of the fraction and lerped toward the next phase with
+ * the rest of it.
+ *
+ * So that it never reads further ahead than the linear resamplers do (one
+ * frame), the output is delayed by SINC_DELAY input frames. That means each
+ * sample also needs the SINC_HISTORY frames before the decode cache.
+ *
+ * Pitching up needs a lower cutoff to keep from aliasing, so there is one
+ * table per SINC_CUTOFFS steps, see FAudio_INTERNAL_BuildSincTable.
+ */
+#define SINC_TAPS		32
+#define SINC_PHASE_BITS		7
+#define SINC_PHASES		(1 << SINC_PHASE_BITS)
+#define SINC_PHASE_SHIFT	(FIXED_PRECISION - SINC_PHASE_BITS)
+#define SINC_LERP_MASK		((1 << SINC_PHASE_SHIFT) - 1)
+#define SINC_LERP_SCALE		(1.0f / (1 << SINC_PHASE_SHIFT))
+#define SINC_DELAY		(SINC_TAPS / 2 - 1)
+#define SINC_HISTORY		(SINC_TAPS - 2)
+#define SINC_HISTORY_SAMPLES	(SINC_HISTORY * FAUDIO_MAX_AUDIO_CHANNELS)
+#define SINC_CUTOFFS		9
+#define SINC_ROW		(SINC_TAPS * 2) /* Taps, then deltas to the next phase */
+#define SINC_TABLE_SIZE		(SINC_CUTOFFS * SINC_PHASES * SINC_ROW)
+
+extern const double FAUDIO_INTERNAL_SINC_STEPS[SINC_CUTOFFS];
+void FAudio_INTERNAL_BuildSincTable(float *table);
+
 /* vim: set noexpandtab shiftwidth=8 tabstop=8: */
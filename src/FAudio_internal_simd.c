@@ -26,14 +26,17 @@
 
 #include "FAudio_internal.h"
 
-/* SECTION 0: SSE/NEON Detection */
+/* SECTION 0: SSE/AVX/NEON Detection */
 
 /* The SSE/NEON detection comes from MojoAL:
  * https://hg.icculus.org/icculus/mojoAL/file/default/mojoal.c
  */
 
+/* The scalar functions are always built, even where SSE2/NEON are
+ * guaranteed, so that FAUDIO_SIMD=scalar can be used for comparisons.
+ */
+
 #if defined(__x86_64__)
-#define NEED_SCALAR_CONVERTER_FALLBACKS 0  /* x86_64 guarantees SSE2. */
 #ifndef __SSE2__ /* For some reason this is not always defined? -flibit */
 #define __SSE2__
 #endif
@@ -41,11 +44,6 @@
 #ifndef __SSE2__
 #error macOS does not have SSE2? Bad compiler? They actually moved to ARM?!
 #endif
-#define NEED_SCALAR_CONVERTER_FALLBACKS 0  /* Mac OS X/Intel guarantees SSE2. */
-#elif defined(__aarch64__) || defined(_M_ARM64)
-#define NEED_SCALAR_CONVERTER_FALLBACKS 0  /* AArch64 guarantees NEON. */
-#else
-#define NEED_SCALAR_CONVERTER_FALLBACKS 1
 #endif
 
 /* Our NEON paths require AArch64 */
@@ -63,6 +61,26 @@
 #define HAVE_SSE2_INTRINSICS 1
 #endif
 
+/* AVX2 and AVX-512F are not baseline anywhere, so rather than building the
+ * whole file for them, only the functions that use them are compiled for
+ * those targets. InitSIMDFunctions makes sure they only run where supported.
+ */
+#if HAVE_SSE2_INTRINSICS && (defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86))
+#if defined(__GNUC__) || defined(__clang__)
+#include <immintrin.h>
+#define FAUDIO_TARGET_AVX2 __attribute__((target("avx2")))
+#define FAUDIO_TARGET_AVX512F __attribute__((target("avx512f")))
+#define HAVE_AVX2_INTRINSICS 1
+#define HAVE_AVX512F_INTRINSICS 1
+#elif defined(_MSC_VER) && _MSC_VER >= 1910
+#include <immintrin.h>
+#define FAUDIO_TARGET_AVX2
+#define FAUDIO_TARGET_AVX512F
+#define HAVE_AVX2_INTRINSICS 1
+#define HAVE_AVX512F_INTRINSICS 1
+#endif
+#endif
+
 /* SECTION 1: Type Converters */
 
 /* The SSE/NEON converters are based on SDL_audiotypecvt:
@@ -71,8 +89,13 @@
 
 #define DIVBY128 0.0078125f
 #define DIVBY32768 0.000030517578125f
+#define DIVBY8388607 (1.0f / 8388607.0f)
+
+/* Adding and subtracting 1.5 * 2^23 rounds to the nearest integer (ties to
+ * even, like the SIMD conversions) for anything in the int16 range.
+ */
+#define ROUNDMAGIC 12582912.0f
 
-#if NEED_SCALAR_CONVERTER_FALLBACKS
 void FAudio_INTERNAL_Convert_U8_To_F32_Scalar(
 	const uint8_t *restrict src,
 	float *restrict dst,
@@ -96,7 +119,42 @@ void FAudio_INTERNAL_Convert_S16_To_F32_Scalar(
 		*dst++ = *src++ * DIVBY32768;
 	}
 }
-#endif /* NEED_SCALAR_CONVERTER_FALLBACKS */
+
+/* Packed little-endian 24-bit samples, 3 bytes each */
+void FAudio_INTERNAL_Convert_S24_To_F32_Scalar(
+	const uint8_t *restrict src,
+	float *restrict dst,
+	uint32_t len
+) {
+	uint32_t i;
+	for (i = 0; i < len; i += 1, src += 3)
+	{
+		*dst++ = ((int32_t) (
+			((uint32_t) src[2] << 24) |
+			((uint32_t) src[1] << 16) |
+			((uint32_t) src[0] << 8)
+		) >> 8) * DIVBY8388607;
+	}
+}
+
+/* The clamps are written the way SSE's min/max work, so NaN comes out as
+ * 32767 everywhere.
+ */
+void FAudio_INTERNAL_Convert_F32_To_S16_Scalar(
+	const float *restrict src,
+	int16_t *restrict dst,
+	uint32_t len
+) {
+	uint32_t i;
+	float sample;
+	for (i = 0; i < len; i += 1)
+	{
+		sample = *src++ * 32768.0f;
+		sample = (sample < 32767.0f) ? sample : 32767.0f;
+		sample = (sample > -32768.0f) ? sample : -32768.0f;
+		*dst++ = (int16_t) ((sample + ROUNDMAGIC) - ROUNDMAGIC);
+	}
+}
 
 #if HAVE_SSE2_INTRINSICS
 void FAudio_INTERNAL_Convert_U8_To_F32_SSE2(
@@ -197,8 +255,247 @@ void FAudio_INTERNAL_Convert_S16_To_F32_SSE2(
         i--; src--; dst--;
     }
 }
+
+void FAudio_INTERNAL_Convert_S24_To_F32_SSE2(
+	const uint8_t *restrict src,
+	float *restrict dst,
+	uint32_t len
+) {
+	uint32_t i;
+	__m128i bytes, ints;
+	const __m128 divby8388607 = _mm_set1_ps(DIVBY8388607);
+
+	/* Each load takes 16 bytes for 4 samples (12 bytes), so stop while
+	 * there are still 2 samples left over to keep from reading past src.
+	 */
+	for (i = 0; i + 6 <= len; i += 4, src += 12)
+	{
+		bytes = _mm_loadu_si128((const __m128i*) src);
+
+		/* Shift each sample to the bottom of its own register, then
+		 * gather the low 32 bits of those into one register...
+		 */
+		ints = _mm_unpacklo_epi64(
+			_mm_unpacklo_epi32(bytes, _mm_srli_si128(bytes, 3)),
+			_mm_unpacklo_epi32(
+				_mm_srli_si128(bytes, 6),
+				_mm_srli_si128(bytes, 9)
+			)
+		);
+
+		/* ... and replace the stray 4th byte with the sign. */
+		ints = _mm_srai_epi32(_mm_slli_epi32(ints, 8), 8);
+		_mm_storeu_ps(dst + i, _mm_mul_ps(_mm_cvtepi32_ps(ints), divby8388607));
+	}
+	FAudio_INTERNAL_Convert_S24_To_F32_Scalar(src, dst + i, len - i);
+}
+
+void FAudio_INTERNAL_Convert_F32_To_S16_SSE2(
+	const float *restrict src,
+	int16_t *restrict dst,
+	uint32_t len
+) {
+	uint32_t i;
+	__m128i a, b;
+	const uint32_t vecLen = len & ~7;
+	const __m128 mul = _mm_set1_ps(32768.0f);
+	const __m128 max = _mm_set1_ps(32767.0f);
+	const __m128 min = _mm_set1_ps(-32768.0f);
+	for (i = 0; i < vecLen; i += 8)
+	{
+		/* Clamp, round to int32, then pack 8 of those into int16 */
+		a = _mm_cvtps_epi32(_mm_max_ps(_mm_min_ps(
+			_mm_mul_ps(_mm_loadu_ps(src + i), mul),
+			max
+		), min));
+		b = _mm_cvtps_epi32(_mm_max_ps(_mm_min_ps(
+			_mm_mul_ps(_mm_loadu_ps(src + i + 4), mul),
+			max
+		), min));
+		_mm_storeu_si128((__m128i*) (dst + i), _mm_packs_epi32(a, b));
+	}
+	FAudio_INTERNAL_Convert_F32_To_S16_Scalar(src + i, dst + i, len - i);
+}
 #endif /* HAVE_SSE2_INTRINSICS */
 
+#if HAVE_AVX2_INTRINSICS
+FAUDIO_TARGET_AVX2
+void FAudio_INTERNAL_Convert_U8_To_F32_AVX2(
+	const uint8_t *restrict src,
+	float *restrict dst,
+	uint32_t len
+) {
+	uint32_t i;
+	const uint32_t vecLen = len & ~7;
+	const __m256 divby128 = _mm256_set1_ps(DIVBY128);
+	const __m256 minus1 = _mm256_set1_ps(-1.0f);
+	for (i = 0; i < vecLen; i += 8)
+	{
+		/* Zero-extend 8 uint8 to int32, then convert as in SSE2 */
+		const __m256i ints = _mm256_cvtepu8_epi32(
+			_mm_loadl_epi64((const __m128i*) (src + i))
+		);
+		_mm256_storeu_ps(dst + i, _mm256_add_ps(
+			_mm256_mul_ps(_mm256_cvtepi32_ps(ints), divby128),
+			minus1
+		));
+	}
+	for (i = vecLen; i < len; i += 1)
+	{
+		dst[i] = (((float) src[i]) * DIVBY128) - 1.0f;
+	}
+}
+
+FAUDIO_TARGET_AVX2
+void FAudio_INTERNAL_Convert_S16_To_F32_AVX2(
+	const int16_t *restrict src,
+	float *restrict dst,
+	uint32_t len
+) {
+	uint32_t i;
+	const uint32_t vecLen = len & ~7;
+	const __m256 divby32768 = _mm256_set1_ps(DIVBY32768);
+	for (i = 0; i < vecLen; i += 8)
+	{
+		/* Sign-extend 8 sint16 to int32, then convert as in SSE2 */
+		const __m256i ints = _mm256_cvtepi16_epi32(
+			_mm_loadu_si128((const __m128i*) (src + i))
+		);
+		_mm256_storeu_ps(dst + i, _mm256_mul_ps(
+			_mm256_cvtepi32_ps(ints),
+			divby32768
+		));
+	}
+	for (i = vecLen; i < len; i += 1)
+	{
+		dst[i] = ((float) src[i]) * DIVBY32768;
+	}
+}
+
+FAUDIO_TARGET_AVX2
+void FAudio_INTERNAL_Convert_S24_To_F32_AVX2(
+	const uint8_t *restrict src,
+	float *restrict dst,
+	uint32_t len
+) {
+	uint32_t i;
+	__m256i bytes;
+	const __m256 divby8388607 = _mm256_set1_ps(DIVBY8388607);
+
+	/* Moves bytes 12-27 up to the high lane, so each lane holds 4 samples */
+	const __m256i lanes = _mm256_setr_epi32(0, 1, 2, 3, 3, 4, 5, 6);
+
+	/* Each sample goes to the top 3 bytes of an int32, so that shifting
+	 * back down sign-extends it.
+	 */
+	const __m256i shuffle = _mm256_setr_epi8(
+		-1, 0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11,
+		-1, 0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11
+	);
+
+	/* 32 bytes per load for 8 samples (24 bytes), see SSE2 */
+	for (i = 0; i + 11 <= len; i += 8, src += 24)
+	{
+		bytes = _mm256_loadu_si256((const __m256i*) src);
+		bytes = _mm256_shuffle_epi8(
+			_mm256_permutevar8x32_epi32(bytes, lanes),
+			shuffle
+		);
+		_mm256_storeu_ps(dst + i, _mm256_mul_ps(
+			_mm256_cvtepi32_ps(_mm256_srai_epi32(bytes, 8)),
+			divby8388607
+		));
+	}
+	FAudio_INTERNAL_Convert_S24_To_F32_Scalar(src, dst + i, len - i);
+}
+
+FAUDIO_TARGET_AVX2
+void FAudio_INTERNAL_Convert_F32_To_S16_AVX2(
+	const float *restrict src,
+	int16_t *restrict dst,
+	uint32_t len
+) {
+	uint32_t i;
+	__m256i a, b;
+	const uint32_t vecLen = len & ~15;
+	const __m256 mul = _mm256_set1_ps(32768.0f);
+	const __m256 max = _mm256_set1_ps(32767.0f);
+	const __m256 min = _mm256_set1_ps(-32768.0f);
+	for (i = 0; i < vecLen; i += 16)
+	{
+		/* See SSE2 */
+		a = _mm256_cvtps_epi32(_mm256_max_ps(_mm256_min_ps(
+			_mm256_mul_ps(_mm256_loadu_ps(src + i), mul),
+			max
+		), min));
+		b = _mm256_cvtps_epi32(_mm256_max_ps(_mm256_min_ps(
+			_mm256_mul_ps(_mm256_loadu_ps(src + i + 8), mul),
+			max
+		), min));
+
+		/* packs works within each lane, so put the quarters back in order */
+		_mm256_storeu_si256(
+			(__m256i*) (dst + i),
+			_mm256_permute4x64_epi64(_mm256_packs_epi32(a, b), 0xD8)
+		);
+	}
+	FAudio_INTERNAL_Convert_F32_To_S16_Scalar(src + i, dst + i, len - i);
+}
+#endif /* HAVE_AVX2_INTRINSICS */
+
+#if HAVE_AVX512F_INTRINSICS
+FAUDIO_TARGET_AVX512F
+void FAudio_INTERNAL_Convert_U8_To_F32_AVX512F(
+	const uint8_t *restrict src,
+	float *restrict dst,
+	uint32_t len
+) {
+	uint32_t i;
+	const uint32_t vecLen = len & ~15;
+	const __m512 divby128 = _mm512_set1_ps(DIVBY128);
+	const __m512 minus1 = _mm512_set1_ps(-1.0f);
+	for (i = 0; i < vecLen; i += 16)
+	{
+		const __m512i ints = _mm512_cvtepu8_epi32(
+			_mm_loadu_si128((const __m128i*) (src + i))
+		);
+		_mm512_storeu_ps(dst + i, _mm512_add_ps(
+			_mm512_mul_ps(_mm512_cvtepi32_ps(ints), divby128),
+			minus1
+		));
+	}
+	for (i = vecLen; i < len; i += 1)
+	{
+		dst[i] = (((float) src[i]) * DIVBY128) - 1.0f;
+	}
+}
+
+FAUDIO_TARGET_AVX512F
+void FAudio_INTERNAL_Convert_S16_To_F32_AVX512F(
+	const int16_t *restrict src,
+	float *restrict dst,
+	uint32_t len
+) {
+	uint32_t i;
+	const uint32_t vecLen = len & ~15;
+	const __m512 divby32768 = _mm512_set1_ps(DIVBY32768);
+	for (i = 0; i < vecLen; i += 16)
+	{
+		const __m512i ints = _mm512_cvtepi16_epi32(
+			_mm256_loadu_si256((const __m256i*) (src + i))
+		);
+		_mm512_storeu_ps(dst + i, _mm512_mul_ps(
+			_mm512_cvtepi32_ps(ints),
+			divby32768
+		));
+	}
+	for (i = vecLen; i < len; i += 1)
+	{
+		dst[i] = ((float) src[i]) * DIVBY32768;
+	}
+}
+#endif /* HAVE_AVX512F_INTRINSICS */
+
 #if HAVE_NEON_INTRINSICS
 void FAudio_INTERNAL_Convert_U8_To_F32_NEON(
 	const uint8_t *restrict src,
@@ -285,6 +582,77 @@ void FAudio_INTERNAL_Convert_S16_To_F32_NEON(
         i--; src--; dst--;
     }
 }
+
+void FAudio_INTERNAL_Convert_S24_To_F32_NEON(
+	const uint8_t *restrict src,
+	float *restrict dst,
+	uint32_t len
+) {
+	uint32_t i;
+	uint8x8x3_t bytes;
+	int16x8_t high;
+	uint16x8_t low;
+	const float32x4_t divby8388607 = vdupq_n_f32(DIVBY8388607);
+	for (i = 0; i + 8 <= len; i += 8, src += 24)
+	{
+		/* Deinterleave 8 samples into their low, middle and high bytes */
+		bytes = vld3_u8(src);
+
+		/* The top 16 bits carry the sign... */
+		high = vreinterpretq_s16_u16(vorrq_u16(
+			vshll_n_u8(bytes.val[2], 8),
+			vmovl_u8(bytes.val[1])
+		));
+		low = vmovl_u8(bytes.val[0]);
+
+		/* ... so widen those signed, then shift the low byte back in */
+		vst1q_f32(dst + i, vmulq_f32(vcvtq_f32_s32(vorrq_s32(
+			vshlq_n_s32(vmovl_s16(vget_low_s16(high)), 8),
+			vreinterpretq_s32_u32(vmovl_u16(vget_low_u16(low)))
+		)), divby8388607));
+		vst1q_f32(dst + i + 4, vmulq_f32(vcvtq_f32_s32(vorrq_s32(
+			vshlq_n_s32(vmovl_s16(vget_high_s16(high)), 8),
+			vreinterpretq_s32_u32(vmovl_u16(vget_high_u16(low)))
+		)), divby8388607));
+	}
+	FAudio_INTERNAL_Convert_S24_To_F32_Scalar(src, dst + i, len - i);
+}
+
+static inline int32x4_t FAudio_INTERNAL_F32_To_S32_NEON(float32x4_t sample)
+{
+	const float32x4_t max = vdupq_n_f32(32767.0f);
+	const float32x4_t min = vdupq_n_f32(-32768.0f);
+	const float32x4_t magic = vdupq_n_f32(ROUNDMAGIC);
+
+	/* vmin/vmax would pass NaN through, so compare and select like SSE */
+	sample = vbslq_f32(vcltq_f32(sample, max), sample, max);
+	sample = vbslq_f32(vcgtq_f32(sample, min), sample, min);
+
+	/* ARMv7 can only truncate, so round the same way as the scalar path */
+	return vcvtq_s32_f32(vsubq_f32(vaddq_f32(sample, magic), magic));
+}
+
+void FAudio_INTERNAL_Convert_F32_To_S16_NEON(
+	const float *restrict src,
+	int16_t *restrict dst,
+	uint32_t len
+) {
+	uint32_t i;
+	const uint32_t vecLen = len & ~7;
+	const float32x4_t mul = vdupq_n_f32(32768.0f);
+	for (i = 0; i < vecLen; i += 8)
+	{
+		vst1q_s16(dst + i, vcombine_s16(
+			vqmovn_s32(FAudio_INTERNAL_F32_To_S32_NEON(
+				vmulq_f32(vld1q_f32(src + i), mul)
+			)),
+			vqmovn_s32(FAudio_INTERNAL_F32_To_S32_NEON(
+				vmulq_f32(vld1q_f32(src + i + 4), mul)
+			))
+		));
+	}
+	FAudio_INTERNAL_Convert_F32_To_S16_Scalar(src + i, dst + i, len - i);
+}
 #endif /* HAVE_NEON_INTRINSICS */
 
 /* SECTION 2: Linear Resamplers */
@@ -328,7 +696,6 @@ void FAudio_INTERNAL_ResampleGeneric(
 	}
 }
 
-#if NEED_SCALAR_CONVERTER_FALLBACKS
 void FAudio_INTERNAL_ResampleMono_Scalar(
 	float *restrict dCache,
 	float *restrict resampleCache,
@@ -405,7 +772,6 @@ void FAudio_INTERNAL_ResampleStereo_Scalar(
 		cur &= FIXED_FRACTION_MASK;
 	}
 }
-#endif /* NEED_SCALAR_CONVERTER_FALLBACKS */
 
 /* The SSE2 versions of the resamplers come from @8thMage! */
 
@@ -432,6 +798,11 @@ void FAudio_INTERNAL_ResampleMono_SSE2(
 	{
 		header = 0;
 	}
+	/* Too short to ever reach an aligned address */
+	if (header > toResample)
+	{
+		header = toResample;
+	}
 	for (i = 0; i < header; i += 1)
 	{
 		/* lerp, then convert to float value */
@@ -603,6 +974,11 @@ void FAudio_INTERNAL_ResampleStereo_SSE2(
 	{
 		header = 0;
 	}
+	/* Too short to ever reach an aligned address */
+	if (header > toResample)
+	{
+		header = toResample;
+	}
 	cur_scalar = *resampleOffset & FIXED_FRACTION_MASK;
 	for (i = 0; i < header; i += 2)
 	{
@@ -753,8 +1129,13 @@ void FAudio_INTERNAL_ResampleStereo_SSE2(
 }
 #endif /* HAVE_SSE2_INTRINSICS */
 
-#if HAVE_NEON_INTRINSICS
-void FAudio_INTERNAL_ResampleMono_NEON(
+/* The AVX2 resamplers use the same fixed point math as the SSE2 ones, but
+ * gather the samples rather than loading each pair by hand.
+ */
+
+#if HAVE_AVX2_INTRINSICS
+FAUDIO_TARGET_AVX2
+void FAudio_INTERNAL_ResampleMono_AVX2(
 	float *restrict dCache,
 	float *restrict resampleCache,
 	uint64_t *resampleOffset,
@@ -762,21 +1143,73 @@ void FAudio_INTERNAL_ResampleMono_NEON(
 	uint64_t toResample,
 	uint8_t UNUSED
 ) {
-	uint32_t i, header, tail;
-	uint64_t cur_scalar_1, cur_scalar_2, cur_scalar_3;
-	float *dCache_1, *dCache_2, *dCache_3;
+	uint32_t i, j, tail;
+	int32_t offsets[8];
+	uint64_t cur_lane;
 	uint64_t cur_scalar = *resampleOffset & FIXED_FRACTION_MASK;
-	float32x4_t one_over_fixed_one, half, current_next_0_1, current_next_2_3,
-		current, next, sub, cur_fixed, mul, res;
-	int32x4_t cur_frac, adder_frac, adder_frac_loop;
+	__m256 one_over_fixed_one, half, current, next, sub, cur_fixed, mul, res;
+	__m256i cur_frac, adder_frac_loop, index;
 
-	/* This is the header, the Dest needs to be aligned to 16B */
-	header = (16 - ((size_t) resampleCache) % 16) / 4;
-	if (header == 4)
+	/* See ResampleMono_SSE2 for how cur_frac works, this is just 8 wide */
+	cur_frac = _mm256_set1_epi32(
+		(uint32_t) (cur_scalar & FIXED_FRACTION_MASK) - DOUBLE_TO_FIXED(0.5)
+	);
+	cur_frac = _mm256_add_epi32(cur_frac, _mm256_setr_epi32(
+		0,
+		(uint32_t) (resampleStep & FIXED_FRACTION_MASK),
+		(uint32_t) ((resampleStep * 2) & FIXED_FRACTION_MASK),
+		(uint32_t) ((resampleStep * 3) & FIXED_FRACTION_MASK),
+		(uint32_t) ((resampleStep * 4) & FIXED_FRACTION_MASK),
+		(uint32_t) ((resampleStep * 5) & FIXED_FRACTION_MASK),
+		(uint32_t) ((resampleStep * 6) & FIXED_FRACTION_MASK),
+		(uint32_t) ((resampleStep * 7) & FIXED_FRACTION_MASK)
+	));
+
+	/* Constants */
+	one_over_fixed_one = _mm256_set1_ps(1.0f / FIXED_ONE);
+	half = _mm256_set1_ps(0.5f);
+	adder_frac_loop = _mm256_set1_epi32(
+		(uint32_t) ((resampleStep * 8) & FIXED_FRACTION_MASK)
+	);
+
+	tail = toResample % 8;
+	for (i = 0; i < toResample - tail; i += 8, resampleCache += 8)
 	{
-		header = 0;
+		/* Where each of the 8 samples starts, relative to dCache */
+		cur_lane = cur_scalar;
+		for (j = 0; j < 8; j += 1, cur_lane += resampleStep)
+		{
+			offsets[j] = (int32_t) (cur_lane >> FIXED_PRECISION);
+		}
+		index = _mm256_loadu_si256((const __m256i*) offsets);
+		current = _mm256_i32gather_ps(dCache, index, 4);
+		next = _mm256_i32gather_ps(dCache + 1, index, 4);
+
+		sub = _mm256_sub_ps(next, current);
+		cur_fixed = _mm256_add_ps(
+			_mm256_mul_ps(
+				_mm256_cvtepi32_ps(cur_frac),
+				one_over_fixed_one
+			),
+			half
+		);
+		mul = _mm256_mul_ps(sub, cur_fixed);
+		res = _mm256_add_ps(current, mul);
+
+		/* Store back */
+		_mm256_storeu_ps(resampleCache, res);
+
+		/* Update dCache for next iteration */
+		cur_scalar += resampleStep * 8;
+		dCache += (cur_scalar >> FIXED_PRECISION);
+		cur_scalar &= FIXED_FRACTION_MASK;
+
+		cur_frac = _mm256_add_epi32(cur_frac, adder_frac_loop);
 	}
-	for (i = 0; i < header; i += 1)
+	*resampleOffset += resampleStep * (toResample - tail);
+
+	/* This is the tail. */
+	for (i = 0; i < tail; i += 1)
 	{
 		/* lerp, then convert to float value */
 		*resampleCache++ = (float) (
@@ -800,82 +1233,244 @@ void FAudio_INTERNAL_ResampleMono_NEON(
 		 */
 		cur_scalar &= FIXED_FRACTION_MASK;
 	}
+}
 
-	toResample -= header;
+FAUDIO_TARGET_AVX2
+void FAudio_INTERNAL_ResampleStereo_AVX2(
+	float *restrict dCache,
+	float *restrict resampleCache,
+	uint64_t *resampleOffset,
+	uint64_t resampleStep,
+	uint64_t toResample,
+	uint8_t UNUSED
+) {
+	uint32_t i, j, tail;
+	int32_t offsets[8];
+	uint64_t cur_lane;
+	uint64_t cur_scalar = *resampleOffset & FIXED_FRACTION_MASK;
+	__m256 one_over_fixed_one, half, current, next, sub, cur_fixed, mul, res;
+	__m256i cur_frac, adder_frac_loop, index;
 
-	/* initialising the varius cur
-	 * cur_frac is the fractional part of cur with 4 samples. as the
-	 * fractional part is 32 bit unsigned value, it can be just added
-	 * and the modulu operation for keeping the fractional part will be implicit.
-	 * the 0.5 is for converting signed values to float (no unsigned convert),
-	 * the 0.5 is added later.
-	 */
-	cur_frac = vdupq_n_s32(
+	/* 4 frames at a time, both channels of a frame share a fraction */
+	cur_frac = _mm256_set1_epi32(
 		(uint32_t) (cur_scalar & FIXED_FRACTION_MASK) - DOUBLE_TO_FIXED(0.5)
 	);
-	int32_t __attribute__((aligned(16))) data[4] =
-	{
+	cur_frac = _mm256_add_epi32(cur_frac, _mm256_setr_epi32(
+		0,
 		0,
 		(uint32_t) (resampleStep & FIXED_FRACTION_MASK),
+		(uint32_t) (resampleStep & FIXED_FRACTION_MASK),
+		(uint32_t) ((resampleStep * 2) & FIXED_FRACTION_MASK),
 		(uint32_t) ((resampleStep * 2) & FIXED_FRACTION_MASK),
+		(uint32_t) ((resampleStep * 3) & FIXED_FRACTION_MASK),
 		(uint32_t) ((resampleStep * 3) & FIXED_FRACTION_MASK)
-	};
-	adder_frac = vld1q_s32(data);
-	cur_frac = vaddq_s32(cur_frac, adder_frac);
-
-	/* The various cur_scalar is for the different samples
-	 * (1, 2, 3 compared to original cur_scalar = 0)
-	 */
-	cur_scalar_1 = cur_scalar + resampleStep;
-	cur_scalar_2 = cur_scalar + resampleStep * 2;
-	cur_scalar_3 = cur_scalar + resampleStep * 3;
-	dCache_1 = dCache + (cur_scalar_1 >> FIXED_PRECISION);
-	dCache_2 = dCache + (cur_scalar_2 >> FIXED_PRECISION);
-	dCache_3 = dCache + (cur_scalar_3 >> FIXED_PRECISION);
-	cur_scalar &= FIXED_FRACTION_MASK;
-	cur_scalar_1 &= FIXED_FRACTION_MASK;
-	cur_scalar_2 &= FIXED_FRACTION_MASK;
-	cur_scalar_3 &= FIXED_FRACTION_MASK;
+	));
 
 	/* Constants */
-	one_over_fixed_one = vdupq_n_f32(1.0f / FIXED_ONE);
-	half = vdupq_n_f32(0.5f);
-	adder_frac_loop = vdupq_n_s32(
+	one_over_fixed_one = _mm256_set1_ps(1.0f / FIXED_ONE);
+	half = _mm256_set1_ps(0.5f);
+	adder_frac_loop = _mm256_set1_epi32(
 		(uint32_t) ((resampleStep * 4) & FIXED_FRACTION_MASK)
 	);
 
 	tail = toResample % 4;
-	for (i = 0; i < toResample - tail; i += 4, resampleCache += 4)
+	for (i = 0; i < toResample - tail; i += 4, resampleCache += 8)
 	{
-		/* current next holds 2 pairs of the sample and the sample + 1
-		 * after that need to separate them.
-		 */
-		current_next_0_1 = vcombine_f32(
-			vld1_f32(dCache),
-			vld1_f32(dCache_1)
-		);
-		current_next_2_3 = vcombine_f32(
-			vld1_f32(dCache_2),
-			vld1_f32(dCache_3)
-		);
-
-		/* Unpack them to have seperate current and next in 2 vectors. */
-		current = vuzp1q_f32(current_next_0_1, current_next_2_3);
-		next = vuzp2q_f32(current_next_0_1, current_next_2_3);
-
-		sub = vsubq_f32(next, current);
-
-		/* Convert the fractional part to float and then mul to get the fractions out.
-		 * then add back the 0.5 we subtracted before.
-		 */
-		cur_fixed = vaddq_f32(
-			vmulq_f32(
-				vcvtq_f32_s32(cur_frac),
+		/* Where each of the 4 frames starts, relative to dCache */
+		cur_lane = cur_scalar;
+		for (j = 0; j < 8; j += 2, cur_lane += resampleStep)
+		{
+			offsets[j] = (int32_t) (cur_lane >> FIXED_PRECISION) * 2;
+			offsets[j + 1] = offsets[j] + 1;
+		}
+		index = _mm256_loadu_si256((const __m256i*) offsets);
+		current = _mm256_i32gather_ps(dCache, index, 4);
+		next = _mm256_i32gather_ps(dCache + 2, index, 4);
+
+		sub = _mm256_sub_ps(next, current);
+		cur_fixed = _mm256_add_ps(
+			_mm256_mul_ps(
+				_mm256_cvtepi32_ps(cur_frac),
 				one_over_fixed_one
 			),
 			half
 		);
-		mul = vmulq_f32(sub, cur_fixed);
+		mul = _mm256_mul_ps(sub, cur_fixed);
+		res = _mm256_add_ps(current, mul);
+
+		/* Store back */
+		_mm256_storeu_ps(resampleCache, res);
+
+		/* Update dCache for next iteration */
+		cur_scalar += resampleStep * 4;
+		dCache += (cur_scalar >> FIXED_PRECISION) * 2;
+		cur_scalar &= FIXED_FRACTION_MASK;
+
+		cur_frac = _mm256_add_epi32(cur_frac, adder_frac_loop);
+	}
+	*resampleOffset += resampleStep * (toResample - tail);
+
+	/* This is the tail. */
+	for (i = 0; i < tail; i += 1)
+	{
+		/* lerp, then convert to float value */
+		*resampleCache++ = (float) (
+			dCache[0] +
+			(dCache[2] - dCache[0]) *
+			FIXED_TO_FLOAT(cur_scalar)
+		);
+		*resampleCache++ = (float) (
+			dCache[1] +
+			(dCache[3] - dCache[1]) *
+			FIXED_TO_FLOAT(cur_scalar)
+		);
+
+		/* Increment fraction offset by the stepping value */
+		*resampleOffset += resampleStep;
+		cur_scalar += resampleStep;
+
+		/* Only increment the sample offset by integer values.
+		 * Sometimes this will be 0 until cur accumulates
+		 * enough steps, especially for "slow" rates.
+		 */
+		dCache += (cur_scalar >> FIXED_PRECISION) * 2;
+
+		/* Now that any integer has been added, drop it.
+		 * The offset pointer will preserve the total.
+		 */
+		cur_scalar &= FIXED_FRACTION_MASK;
+	}
+}
+#endif /* HAVE_AVX2_INTRINSICS */
+
+#if HAVE_NEON_INTRINSICS
+void FAudio_INTERNAL_ResampleMono_NEON(
+	float *restrict dCache,
+	float *restrict resampleCache,
+	uint64_t *resampleOffset,
+	uint64_t resampleStep,
+	uint64_t toResample,
+	uint8_t UNUSED
+) {
+	uint32_t i, header, tail;
+	uint64_t cur_scalar_1, cur_scalar_2, cur_scalar_3;
+	float *dCache_1, *dCache_2, *dCache_3;
+	uint64_t cur_scalar = *resampleOffset & FIXED_FRACTION_MASK;
+	float32x4_t one_over_fixed_one, half, current_next_0_1, current_next_2_3,
+		current, next, sub, cur_fixed, mul, res;
+	int32x4_t cur_frac, adder_frac, adder_frac_loop;
+
+	/* This is the header, the Dest needs to be aligned to 16B */
+	header = (16 - ((size_t) resampleCache) % 16) / 4;
+	if (header == 4)
+	{
+		header = 0;
+	}
+	/* Too short to ever reach an aligned address */
+	if (header > toResample)
+	{
+		header = toResample;
+	}
+	for (i = 0; i < header; i += 1)
+	{
+		/* lerp, then convert to float value */
+		*resampleCache++ = (float) (
+			dCache[0] +
+			(dCache[1] - dCache[0]) *
+			FIXED_TO_FLOAT(cur_scalar)
+		);
+
+		/* Increment fraction offset by the stepping value */
+		*resampleOffset += resampleStep;
+		cur_scalar += resampleStep;
+
+		/* Only increment the sample offset by integer values.
+		 * Sometimes this will be 0 until cur accumulates
+		 * enough steps, especially for "slow" rates.
+		 */
+		dCache += (cur_scalar >> FIXED_PRECISION);
+
+		/* Now that any integer has been added, drop it.
+		 * The offset pointer will preserve the total.
+		 */
+		cur_scalar &= FIXED_FRACTION_MASK;
+	}
+
+	toResample -= header;
+
+	/* initialising the varius cur
+	 * cur_frac is the fractional part of cur with 4 samples. as the
+	 * fractional part is 32 bit unsigned value, it can be just added
+	 * and the modulu operation for keeping the fractional part will be implicit.
+	 * the 0.5 is for converting signed values to float (no unsigned convert),
+	 * the 0.5 is added later.
+	 */
+	cur_frac = vdupq_n_s32(
+		(uint32_t) (cur_scalar & FIXED_FRACTION_MASK) - DOUBLE_TO_FIXED(0.5)
+	);
+	int32_t __attribute__((aligned(16))) data[4] =
+	{
+		0,
+		(uint32_t) (resampleStep & FIXED_FRACTION_MASK),
+		(uint32_t) ((resampleStep * 2) & FIXED_FRACTION_MASK),
+		(uint32_t) ((resampleStep * 3) & FIXED_FRACTION_MASK)
+	};
+	adder_frac = vld1q_s32(data);
+	cur_frac = vaddq_s32(cur_frac, adder_frac);
+
+	/* The various cur_scalar is for the different samples
+	 * (1, 2, 3 compared to original cur_scalar = 0)
+	 */
+	cur_scalar_1 = cur_scalar + resampleStep;
+	cur_scalar_2 = cur_scalar + resampleStep * 2;
+	cur_scalar_3 = cur_scalar + resampleStep * 3;
+	dCache_1 = dCache + (cur_scalar_1 >> FIXED_PRECISION);
+	dCache_2 = dCache + (cur_scalar_2 >> FIXED_PRECISION);
+	dCache_3 = dCache + (cur_scalar_3 >> FIXED_PRECISION);
+	cur_scalar &= FIXED_FRACTION_MASK;
+	cur_scalar_1 &= FIXED_FRACTION_MASK;
+	cur_scalar_2 &= FIXED_FRACTION_MASK;
+	cur_scalar_3 &= FIXED_FRACTION_MASK;
+
+	/* Constants */
+	one_over_fixed_one = vdupq_n_f32(1.0f / FIXED_ONE);
+	half = vdupq_n_f32(0.5f);
+	adder_frac_loop = vdupq_n_s32(
+		(uint32_t) ((resampleStep * 4) & FIXED_FRACTION_MASK)
+	);
+
+	tail = toResample % 4;
+	for (i = 0; i < toResample - tail; i += 4, resampleCache += 4)
+	{
+		/* current next holds 2 pairs of the sample and the sample + 1
+		 * after that need to separate them.
+		 */
+		current_next_0_1 = vcombine_f32(
+			vld1_f32(dCache),
+			vld1_f32(dCache_1)
+		);
+		current_next_2_3 = vcombine_f32(
+			vld1_f32(dCache_2),
+			vld1_f32(dCache_3)
+		);
+
+		/* Unpack them to have seperate current and next in 2 vectors. */
+		current = vuzp1q_f32(current_next_0_1, current_next_2_3);
+		next = vuzp2q_f32(current_next_0_1, current_next_2_3);
+
+		sub = vsubq_f32(next, current);
+
+		/* Convert the fractional part to float and then mul to get the fractions out.
+		 * then add back the 0.5 we subtracted before.
+		 */
+		cur_fixed = vaddq_f32(
+			vmulq_f32(
+				vcvtq_f32_s32(cur_frac),
+				one_over_fixed_one
+			),
+			half
+		);
+		mul = vmulq_f32(sub, cur_fixed);
 		res = vaddq_f32(current, mul);
 
 		/* Store back */
@@ -946,6 +1541,11 @@ void FAudio_INTERNAL_ResampleStereo_NEON(
 	{
 		header = 0;
 	}
+	/* Too short to ever reach an aligned address */
+	if (header > toResample)
+	{
+		header = toResample;
+	}
 	cur_scalar = *resampleOffset & FIXED_FRACTION_MASK;
 	for (i = 0; i < header; i += 2)
 	{
@@ -1090,138 +1690,3068 @@ void FAudio_INTERNAL_ResampleStereo_NEON(
 }
 #endif /* HAVE_NEON_INTRINSICS */
 
-/* SECTION 3: Amplifiers */
+/* Multichannel resamplers, for 4.0, 5.1 and 7.1 voices. These do the same
+ * stepping as ResampleGeneric, one output frame at a time, with the frame's
+ * channels lerped together in vectors.
+ */
 
-#if NEED_SCALAR_CONVERTER_FALLBACKS
-void FAudio_INTERNAL_Amplify_Scalar(
-	float* output,
-	uint32_t totalSamples,
-	float volume
-) {
-	uint32_t i;
-	for (i = 0; i < totalSamples; i += 1)
-	{
-		output[i] *= volume;
-		output[i] = FAudio_clamp(
-			output[i],
-			-FAUDIO_MAX_VOLUME_LEVEL,
-			FAUDIO_MAX_VOLUME_LEVEL
-		);
-	}
+/* The fraction of a 32.32 offset as a float. Going through int32 keeps this a
+ * single conversion on 32-bit x86 too; a float can't hold more than 24 bits
+ * of it anyway.
+ */
+static inline float FAudio_INTERNAL_FixedFraction(uint64_t cur)
+{
+	return (float) (int32_t) ((cur & FIXED_FRACTION_MASK) >> 1) * (2.0f / FIXED_ONE);
 }
-#endif /* NEED_SCALAR_CONVERTER_FALLBACKS */
-
-/* The SSE2 version of the amplifier comes from @8thMage! */
 
 #if HAVE_SSE2_INTRINSICS
-void FAudio_INTERNAL_Amplify_SSE2(
-	float* output,
-	uint32_t totalSamples,
-	float volume
+void FAudio_INTERNAL_Resample4Channel_SSE2(
+	float *restrict dCache,
+	float *restrict resampleCache,
+	uint64_t *resampleOffset,
+	uint64_t resampleStep,
+	uint64_t toResample,
+	uint8_t UNUSED
 ) {
-	uint32_t i;
-	uint32_t header = (16 - (((size_t) output) % 16)) / 4;
-	uint32_t tail = (totalSamples - header) % 4;
-	__m128 volumeVec, minVolumeVec, maxVolumeVec, outVec;
-	if (header == 4)
-	{
-		header = 0;
-	}
-	if (tail == 4)
-	{
-		tail = 0;
-	}
+	uint64_t i;
+	uint64_t cur = *resampleOffset & FIXED_FRACTION_MASK;
+	__m128 frac, current, next;
 
-	for (i = 0; i < header; i += 1)
+	for (i = 0; i < toResample; i += 1)
 	{
-		output[i] *= volume;
-		output[i] = FAudio_clamp(
-			output[i],
-			-FAUDIO_MAX_VOLUME_LEVEL,
-			FAUDIO_MAX_VOLUME_LEVEL
-		);
-	}
+		frac = _mm_set1_ps(FAudio_INTERNAL_FixedFraction(cur));
+		current = _mm_loadu_ps(dCache);
+		next = _mm_loadu_ps(dCache + 4);
+		_mm_storeu_ps(resampleCache, _mm_add_ps(
+			current,
+			_mm_mul_ps(_mm_sub_ps(next, current), frac)
+		));
+		resampleCache += 4;
 
-	volumeVec = _mm_set1_ps(volume);
-	minVolumeVec = _mm_set1_ps(-FAUDIO_MAX_VOLUME_LEVEL);
-	maxVolumeVec = _mm_set1_ps(FAUDIO_MAX_VOLUME_LEVEL);
-	for (i = header; i < totalSamples - tail; i += 4)
-	{
-		outVec = _mm_load_ps(output + i);
-		outVec = _mm_mul_ps(outVec, volumeVec);
-		outVec = _mm_max_ps(outVec, minVolumeVec);
-		outVec = _mm_min_ps(outVec, maxVolumeVec);
-		_mm_store_ps(output + i, outVec);
+		cur += resampleStep;
+		dCache += (cur >> FIXED_PRECISION) * 4;
+		cur &= FIXED_FRACTION_MASK;
 	}
+	*resampleOffset += toResample * resampleStep;
+}
 
-	for (i = totalSamples - tail; i < totalSamples; i += 1)
+void FAudio_INTERNAL_Resample6Channel_SSE2(
+	float *restrict dCache,
+	float *restrict resampleCache,
+	uint64_t *resampleOffset,
+	uint64_t resampleStep,
+	uint64_t toResample,
+	uint8_t UNUSED
+) {
+	uint64_t i;
+	uint64_t cur = *resampleOffset & FIXED_FRACTION_MASK;
+	__m128 frac, current, next, currentRear, nextRear;
+
+	for (i = 0; i < toResample; i += 1)
 	{
-		output[i] *= volume;
-		output[i] = FAudio_clamp(
-			output[i],
-			-FAUDIO_MAX_VOLUME_LEVEL,
-			FAUDIO_MAX_VOLUME_LEVEL
-		);
+		frac = _mm_set1_ps(FAudio_INTERNAL_FixedFraction(cur));
+
+		/* Channels 0-3 */
+		current = _mm_loadu_ps(dCache);
+		next = _mm_loadu_ps(dCache + 6);
+		_mm_storeu_ps(resampleCache, _mm_add_ps(
+			current,
+			_mm_mul_ps(_mm_sub_ps(next, current), frac)
+		));
+
+		/* Channels 4-5, in the low half of a vector */
+		currentRear = _mm_loadl_pi(_mm_setzero_ps(), (const __m64*) (dCache + 4));
+		nextRear = _mm_loadl_pi(_mm_setzero_ps(), (const __m64*) (dCache + 10));
+		_mm_storel_pi((__m64*) (resampleCache + 4), _mm_add_ps(
+			currentRear,
+			_mm_mul_ps(_mm_sub_ps(nextRear, currentRear), frac)
+		));
+		resampleCache += 6;
+
+		cur += resampleStep;
+		dCache += (cur >> FIXED_PRECISION) * 6;
+		cur &= FIXED_FRACTION_MASK;
 	}
+	*resampleOffset += toResample * resampleStep;
 }
-#endif /* HAVE_SSE2_INTRINSICS */
 
-#if HAVE_NEON_INTRINSICS
-void FAudio_INTERNAL_Amplify_NEON(
-	float* output,
-	uint32_t totalSamples,
+void FAudio_INTERNAL_Resample8Channel_SSE2(
+	float *restrict dCache,
+	float *restrict resampleCache,
+	uint64_t *resampleOffset,
+	uint64_t resampleStep,
+	uint64_t toResample,
+	uint8_t UNUSED
+) {
+	uint64_t i;
+	uint64_t cur = *resampleOffset & FIXED_FRACTION_MASK;
+	__m128 frac, current, next;
+
+	for (i = 0; i < toResample; i += 1)
+	{
+		frac = _mm_set1_ps(FAudio_INTERNAL_FixedFraction(cur));
+		current = _mm_loadu_ps(dCache);
+		next = _mm_loadu_ps(dCache + 8);
+		_mm_storeu_ps(resampleCache, _mm_add_ps(
+			current,
+			_mm_mul_ps(_mm_sub_ps(next, current), frac)
+		));
+		current = _mm_loadu_ps(dCache + 4);
+		next = _mm_loadu_ps(dCache + 12);
+		_mm_storeu_ps(resampleCache + 4, _mm_add_ps(
+			current,
+			_mm_mul_ps(_mm_sub_ps(next, current), frac)
+		));
+		resampleCache += 8;
+
+		cur += resampleStep;
+		dCache += (cur >> FIXED_PRECISION) * 8;
+		cur &= FIXED_FRACTION_MASK;
+	}
+	*resampleOffset += toResample * resampleStep;
+}
+#endif /* HAVE_SSE2_INTRINSICS */
+
+#if HAVE_NEON_INTRINSICS
+void FAudio_INTERNAL_Resample4Channel_NEON(
+	float *restrict dCache,
+	float *restrict resampleCache,
+	uint64_t *resampleOffset,
+	uint64_t resampleStep,
+	uint64_t toResample,
+	uint8_t UNUSED
+) {
+	uint64_t i;
+	uint64_t cur = *resampleOffset & FIXED_FRACTION_MASK;
+	float32x4_t frac, current, next;
+
+	for (i = 0; i < toResample; i += 1)
+	{
+		frac = vdupq_n_f32(FAudio_INTERNAL_FixedFraction(cur));
+		current = vld1q_f32(dCache);
+		next = vld1q_f32(dCache + 4);
+		vst1q_f32(resampleCache, vaddq_f32(
+			current,
+			vmulq_f32(vsubq_f32(next, current), frac)
+		));
+		resampleCache += 4;
+
+		cur += resampleStep;
+		dCache += (cur >> FIXED_PRECISION) * 4;
+		cur &= FIXED_FRACTION_MASK;
+	}
+	*resampleOffset += toResample * resampleStep;
+}
+
+void FAudio_INTERNAL_Resample6Channel_NEON(
+	float *restrict dCache,
+	float *restrict resampleCache,
+	uint64_t *resampleOffset,
+	uint64_t resampleStep,
+	uint64_t toResample,
+	uint8_t UNUSED
+) {
+	uint64_t i;
+	uint64_t cur = *resampleOffset & FIXED_FRACTION_MASK;
+	float32x4_t frac, current, next;
+	float32x2_t currentRear, nextRear;
+
+	for (i = 0; i < toResample; i += 1)
+	{
+		frac = vdupq_n_f32(FAudio_INTERNAL_FixedFraction(cur));
+
+		/* Channels 0-3 */
+		current = vld1q_f32(dCache);
+		next = vld1q_f32(dCache + 6);
+		vst1q_f32(resampleCache, vaddq_f32(
+			current,
+			vmulq_f32(vsubq_f32(next, current), frac)
+		));
+
+		/* Channels 4-5, in the low half of a vector */
+		currentRear = vld1_f32(dCache + 4);
+		nextRear = vld1_f32(dCache + 10);
+		vst1_f32(resampleCache + 4, vadd_f32(
+			currentRear,
+			vmul_f32(vsub_f32(nextRear, currentRear), vget_low_f32(frac))
+		));
+		resampleCache += 6;
+
+		cur += resampleStep;
+		dCache += (cur >> FIXED_PRECISION) * 6;
+		cur &= FIXED_FRACTION_MASK;
+	}
+	*resampleOffset += toResample * resampleStep;
+}
+
+void FAudio_INTERNAL_Resample8Channel_NEON(
+	float *restrict dCache,
+	float *restrict resampleCache,
+	uint64_t *resampleOffset,
+	uint64_t resampleStep,
+	uint64_t toResample,
+	uint8_t UNUSED
+) {
+	uint64_t i;
+	uint64_t cur = *resampleOffset & FIXED_FRACTION_MASK;
+	float32x4_t frac, current, next;
+
+	for (i = 0; i < toResample; i += 1)
+	{
+		frac = vdupq_n_f32(FAudio_INTERNAL_FixedFraction(cur));
+		current = vld1q_f32(dCache);
+		next = vld1q_f32(dCache + 8);
+		vst1q_f32(resampleCache, vaddq_f32(
+			current,
+			vmulq_f32(vsubq_f32(next, current), frac)
+		));
+		current = vld1q_f32(dCache + 4);
+		next = vld1q_f32(dCache + 12);
+		vst1q_f32(resampleCache + 4, vaddq_f32(
+			current,
+			vmulq_f32(vsubq_f32(next, current), frac)
+		));
+		resampleCache += 8;
+
+		cur += resampleStep;
+		dCache += (cur >> FIXED_PRECISION) * 8;
+		cur &= FIXED_FRACTION_MASK;
+	}
+	*resampleOffset += toResample * resampleStep;
+}
+#endif /* HAVE_NEON_INTRINSICS */
+
+/* Integer ratio resamplers, for steps of exactly 1/2, 1/4, 2 or 4. These cover
+ * the common 22050/24000Hz and 11025Hz assets played at 44100/48000Hz.
+ * With these steps the lerp fractions repeat every 2 or 4 output frames when
+ * upsampling and never change when downsampling, so they are computed once
+ * per call instead of once per frame. The fixed point offset still ends up
+ * exactly where the generic resamplers would leave it.
+ */
+
+/* Resamples the slow way until the fraction wraps around, so that the fast
+ * loop always starts with the first of the repeating fractions. Returns the
+ * number of frames that were resampled.
+ */
+static inline uint64_t FAudio_INTERNAL_ResampleUpHead(
+	float *restrict dCache,
+	float *restrict resampleCache,
+	uint64_t *resampleOffset,
+	uint64_t resampleStep,
+	uint64_t toResample,
+	uint8_t channels
+) {
+	uint64_t cur = *resampleOffset & FIXED_FRACTION_MASK;
+	uint64_t head;
+
+	if (cur < resampleStep)
+	{
+		return 0;
+	}
+	head = FAudio_min(
+		(FIXED_ONE - cur + resampleStep - 1) / resampleStep,
+		toResample
+	);
+	FAudio_INTERNAL_ResampleGeneric(
+		dCache,
+		resampleCache,
+		resampleOffset,
+		resampleStep,
+		head,
+		channels
+	);
+	return head;
+}
+
+void FAudio_INTERNAL_ResampleUpGeneric(
+	float *restrict dCache,
+	float *restrict resampleCache,
+	uint64_t *resampleOffset,
+	uint64_t resampleStep,
+	uint64_t toResample,
+	uint8_t channels
+) {
+	double frac[4];
+	uint64_t i, head, cycles;
+	uint32_t j, k, ratio;
+	uint64_t cur = *resampleOffset & FIXED_FRACTION_MASK;
+
+	head = FAudio_INTERNAL_ResampleUpHead(
+		dCache,
+		resampleCache,
+		resampleOffset,
+		resampleStep,
+		toResample,
+		channels
+	);
+	dCache += ((cur + head * resampleStep) >> FIXED_PRECISION) * channels;
+	resampleCache += head * channels;
+	toResample -= head;
+	cur = *resampleOffset & FIXED_FRACTION_MASK;
+
+	ratio = (uint32_t) (FIXED_ONE / resampleStep);
+	FAudio_assert(ratio <= 4);
+	for (k = 0; k < ratio; k += 1)
+	{
+		frac[k] = FIXED_TO_DOUBLE((cur + k * resampleStep));
+	}
+
+	/* Each input frame produces exactly `ratio` output frames */
+	cycles = toResample / ratio;
+	for (i = 0; i < cycles; i += 1)
+	{
+		for (k = 0; k < ratio; k += 1)
+		{
+			for (j = 0; j < channels; j += 1)
+			{
+				*resampleCache++ = (float) (
+					dCache[j] +
+					(dCache[j + channels] - dCache[j]) *
+					frac[k]
+				);
+			}
+		}
+		dCache += channels;
+	}
+	*resampleOffset += cycles << FIXED_PRECISION;
+
+	FAudio_INTERNAL_ResampleGeneric(
+		dCache,
+		resampleCache,
+		resampleOffset,
+		resampleStep,
+		toResample - (cycles * ratio),
+		channels
+	);
+}
+
+void FAudio_INTERNAL_ResampleDownGeneric(
+	float *restrict dCache,
+	float *restrict resampleCache,
+	uint64_t *resampleOffset,
+	uint64_t resampleStep,
+	uint64_t toResample,
+	uint8_t channels
+) {
+	uint64_t i;
+	uint32_t j;
+	const double frac = FIXED_TO_DOUBLE((*resampleOffset & FIXED_FRACTION_MASK));
+	const uint32_t stride = (uint32_t) (resampleStep >> FIXED_PRECISION) * channels;
+
+	FAudio_assert((resampleStep & FIXED_FRACTION_MASK) == 0);
+	for (i = 0; i < toResample; i += 1)
+	{
+		for (j = 0; j < channels; j += 1)
+		{
+			*resampleCache++ = (float) (
+				dCache[j] +
+				(dCache[j + channels] - dCache[j]) *
+				frac
+			);
+		}
+		dCache += stride;
+	}
+	*resampleOffset += toResample * resampleStep;
+}
+
+#if HAVE_SSE2_INTRINSICS
+void FAudio_INTERNAL_ResampleUpMono_SSE2(
+	float *restrict dCache,
+	float *restrict resampleCache,
+	uint64_t *resampleOffset,
+	uint64_t resampleStep,
+	uint64_t toResample,
+	uint8_t UNUSED
+) {
+	uint64_t i, head, cycles;
+	uint64_t cur = *resampleOffset & FIXED_FRACTION_MASK;
+	float f0, f1, f2, f3;
+	__m128 frac, current, next, sub;
+
+	head = FAudio_INTERNAL_ResampleUpHead(
+		dCache,
+		resampleCache,
+		resampleOffset,
+		resampleStep,
+		toResample,
+		1
+	);
+	dCache += (cur + head * resampleStep) >> FIXED_PRECISION;
+	resampleCache += head;
+	toResample -= head;
+	cur = *resampleOffset & FIXED_FRACTION_MASK;
+
+	f0 = FIXED_TO_FLOAT(cur);
+	f1 = FIXED_TO_FLOAT((cur + resampleStep));
+	if (resampleStep == FIXED_ONE / 2)
+	{
+		/* 4 input frames become 8 output frames */
+		frac = _mm_setr_ps(f0, f1, f0, f1);
+		cycles = toResample / 8;
+		for (i = 0; i < cycles; i += 1)
+		{
+			current = _mm_loadu_ps(dCache);
+			next = _mm_loadu_ps(dCache + 1);
+			sub = _mm_sub_ps(next, current);
+			_mm_storeu_ps(resampleCache, _mm_add_ps(
+				_mm_unpacklo_ps(current, current),
+				_mm_mul_ps(_mm_unpacklo_ps(sub, sub), frac)
+			));
+			_mm_storeu_ps(resampleCache + 4, _mm_add_ps(
+				_mm_unpackhi_ps(current, current),
+				_mm_mul_ps(_mm_unpackhi_ps(sub, sub), frac)
+			));
+			dCache += 4;
+			resampleCache += 8;
+		}
+		toResample -= cycles * 8;
+	}
+	else
+	{
+		/* 4 input frames become 16 output frames */
+		f2 = FIXED_TO_FLOAT((cur + resampleStep * 2));
+		f3 = FIXED_TO_FLOAT((cur + resampleStep * 3));
+		frac = _mm_setr_ps(f0, f1, f2, f3);
+		cycles = toResample / 16;
+		for (i = 0; i < cycles; i += 1)
+		{
+			current = _mm_loadu_ps(dCache);
+			next = _mm_loadu_ps(dCache + 1);
+			sub = _mm_sub_ps(next, current);
+			#define UPSAMPLE_LANE(lane) \
+				_mm_storeu_ps(resampleCache + lane * 4, _mm_add_ps( \
+					_mm_shuffle_ps(current, current, _MM_SHUFFLE(lane, lane, lane, lane)), \
+					_mm_mul_ps( \
+						_mm_shuffle_ps(sub, sub, _MM_SHUFFLE(lane, lane, lane, lane)), \
+						frac \
+					) \
+				));
+			UPSAMPLE_LANE(0)
+			UPSAMPLE_LANE(1)
+			UPSAMPLE_LANE(2)
+			UPSAMPLE_LANE(3)
+			#undef UPSAMPLE_LANE
+			dCache += 4;
+			resampleCache += 16;
+		}
+		toResample -= cycles * 16;
+	}
+	*resampleOffset += (cycles * 4) << FIXED_PRECISION;
+
+	FAudio_INTERNAL_ResampleGeneric(
+		dCache,
+		resampleCache,
+		resampleOffset,
+		resampleStep,
+		toResample,
+		1
+	);
+}
+
+void FAudio_INTERNAL_ResampleUpStereo_SSE2(
+	float *restrict dCache,
+	float *restrict resampleCache,
+	uint64_t *resampleOffset,
+	uint64_t resampleStep,
+	uint64_t toResample,
+	uint8_t UNUSED
+) {
+	uint64_t i, head, cycles;
+	uint64_t cur = *resampleOffset & FIXED_FRACTION_MASK;
+	float f0, f1, f2, f3;
+	__m128 frac01, frac23, current, next, sub, lo, hi, subLo, subHi;
+
+	head = FAudio_INTERNAL_ResampleUpHead(
+		dCache,
+		resampleCache,
+		resampleOffset,
+		resampleStep,
+		toResample,
+		2
+	);
+	dCache += ((cur + head * resampleStep) >> FIXED_PRECISION) * 2;
+	resampleCache += head * 2;
+	toResample -= head;
+	cur = *resampleOffset & FIXED_FRACTION_MASK;
+
+	f0 = FIXED_TO_FLOAT(cur);
+	f1 = FIXED_TO_FLOAT((cur + resampleStep));
+	frac01 = _mm_setr_ps(f0, f0, f1, f1);
+	if (resampleStep == FIXED_ONE / 2)
+	{
+		/* 2 input frames become 4 output frames */
+		cycles = toResample / 4;
+		for (i = 0; i < cycles; i += 1)
+		{
+			current = _mm_loadu_ps(dCache);
+			next = _mm_loadu_ps(dCache + 2);
+			sub = _mm_sub_ps(next, current);
+			lo = _mm_movelh_ps(current, current);
+			hi = _mm_movehl_ps(current, current);
+			subLo = _mm_movelh_ps(sub, sub);
+			subHi = _mm_movehl_ps(sub, sub);
+			_mm_storeu_ps(resampleCache, _mm_add_ps(lo, _mm_mul_ps(subLo, frac01)));
+			_mm_storeu_ps(resampleCache + 4, _mm_add_ps(hi, _mm_mul_ps(subHi, frac01)));
+			dCache += 4;
+			resampleCache += 8;
+		}
+		toResample -= cycles * 4;
+	}
+	else
+	{
+		/* 2 input frames become 8 output frames */
+		f2 = FIXED_TO_FLOAT((cur + resampleStep * 2));
+		f3 = FIXED_TO_FLOAT((cur + resampleStep * 3));
+		frac23 = _mm_setr_ps(f2, f2, f3, f3);
+		cycles = toResample / 8;
+		for (i = 0; i < cycles; i += 1)
+		{
+			current = _mm_loadu_ps(dCache);
+			next = _mm_loadu_ps(dCache + 2);
+			sub = _mm_sub_ps(next, current);
+			lo = _mm_movelh_ps(current, current);
+			hi = _mm_movehl_ps(current, current);
+			subLo = _mm_movelh_ps(sub, sub);
+			subHi = _mm_movehl_ps(sub, sub);
+			_mm_storeu_ps(resampleCache, _mm_add_ps(lo, _mm_mul_ps(subLo, frac01)));
+			_mm_storeu_ps(resampleCache + 4, _mm_add_ps(lo, _mm_mul_ps(subLo, frac23)));
+			_mm_storeu_ps(resampleCache + 8, _mm_add_ps(hi, _mm_mul_ps(subHi, frac01)));
+			_mm_storeu_ps(resampleCache + 12, _mm_add_ps(hi, _mm_mul_ps(subHi, frac23)));
+			dCache += 4;
+			resampleCache += 16;
+		}
+		toResample -= cycles * 8;
+	}
+	*resampleOffset += (cycles * 2) << FIXED_PRECISION;
+
+	FAudio_INTERNAL_ResampleGeneric(
+		dCache,
+		resampleCache,
+		resampleOffset,
+		resampleStep,
+		toResample,
+		2
+	);
+}
+
+void FAudio_INTERNAL_ResampleDownMono_SSE2(
+	float *restrict dCache,
+	float *restrict resampleCache,
+	uint64_t *resampleOffset,
+	uint64_t resampleStep,
+	uint64_t toResample,
+	uint8_t UNUSED
+) {
+	uint64_t i, cycles = toResample / 4;
+	__m128 current, next, a, b;
+	const __m128 frac = _mm_set1_ps(
+		FIXED_TO_FLOAT((*resampleOffset & FIXED_FRACTION_MASK))
+	);
+
+	for (i = 0; i < cycles; i += 1)
+	{
+		if (resampleStep == FIXED_ONE * 2)
+		{
+			a = _mm_loadu_ps(dCache);
+			b = _mm_loadu_ps(dCache + 4);
+		}
+		else
+		{
+			/* Only the first two frames of each group of 4 are read */
+			a = _mm_loadh_pi(
+				_mm_loadl_pi(_mm_setzero_ps(), (const __m64*) dCache),
+				(const __m64*) (dCache + 4)
+			);
+			b = _mm_loadh_pi(
+				_mm_loadl_pi(_mm_setzero_ps(), (const __m64*) (dCache + 8)),
+				(const __m64*) (dCache + 12)
+			);
+		}
+		current = _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0));
+		next = _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1));
+		_mm_storeu_ps(resampleCache, _mm_add_ps(
+			current,
+			_mm_mul_ps(_mm_sub_ps(next, current), frac)
+		));
+		dCache += (resampleStep >> FIXED_PRECISION) * 4;
+		resampleCache += 4;
+	}
+	*resampleOffset += cycles * 4 * resampleStep;
+
+	FAudio_INTERNAL_ResampleDownGeneric(
+		dCache,
+		resampleCache,
+		resampleOffset,
+		resampleStep,
+		toResample - (cycles * 4),
+		1
+	);
+}
+
+void FAudio_INTERNAL_ResampleDownStereo_SSE2(
+	float *restrict dCache,
+	float *restrict resampleCache,
+	uint64_t *resampleOffset,
+	uint64_t resampleStep,
+	uint64_t toResample,
+	uint8_t UNUSED
+) {
+	uint64_t i, cycles = toResample / 2;
+	const uint32_t stride = (uint32_t) (resampleStep >> FIXED_PRECISION) * 2;
+	__m128 current, next, a, b;
+	const __m128 frac = _mm_set1_ps(
+		FIXED_TO_FLOAT((*resampleOffset & FIXED_FRACTION_MASK))
+	);
+
+	for (i = 0; i < cycles; i += 1)
+	{
+		/* The two frames used for each output frame */
+		a = _mm_loadu_ps(dCache);
+		b = _mm_loadu_ps(dCache + stride);
+		current = _mm_movelh_ps(a, b);
+		next = _mm_movehl_ps(b, a);
+		_mm_storeu_ps(resampleCache, _mm_add_ps(
+			current,
+			_mm_mul_ps(_mm_sub_ps(next, current), frac)
+		));
+		dCache += stride * 2;
+		resampleCache += 4;
+	}
+	*resampleOffset += cycles * 2 * resampleStep;
+
+	FAudio_INTERNAL_ResampleDownGeneric(
+		dCache,
+		resampleCache,
+		resampleOffset,
+		resampleStep,
+		toResample - (cycles * 2),
+		2
+	);
+}
+#endif /* HAVE_SSE2_INTRINSICS */
+
+#if HAVE_NEON_INTRINSICS
+void FAudio_INTERNAL_ResampleUpMono_NEON(
+	float *restrict dCache,
+	float *restrict resampleCache,
+	uint64_t *resampleOffset,
+	uint64_t resampleStep,
+	uint64_t toResample,
+	uint8_t UNUSED
+) {
+	uint64_t i, head, cycles;
+	uint64_t cur = *resampleOffset & FIXED_FRACTION_MASK;
+	float f[4];
+	float32x4_t frac, current, next, sub;
+	float32x4x2_t currentZip, subZip;
+
+	head = FAudio_INTERNAL_ResampleUpHead(
+		dCache,
+		resampleCache,
+		resampleOffset,
+		resampleStep,
+		toResample,
+		1
+	);
+	dCache += (cur + head * resampleStep) >> FIXED_PRECISION;
+	resampleCache += head;
+	toResample -= head;
+	cur = *resampleOffset & FIXED_FRACTION_MASK;
+
+	f[0] = FIXED_TO_FLOAT(cur);
+	f[1] = FIXED_TO_FLOAT((cur + resampleStep));
+	if (resampleStep == FIXED_ONE / 2)
+	{
+		/* 4 input frames become 8 output frames */
+		f[2] = f[0];
+		f[3] = f[1];
+		frac = vld1q_f32(f);
+		cycles = toResample / 8;
+		for (i = 0; i < cycles; i += 1)
+		{
+			current = vld1q_f32(dCache);
+			next = vld1q_f32(dCache + 1);
+			sub = vsubq_f32(next, current);
+			currentZip = vzipq_f32(current, current);
+			subZip = vzipq_f32(sub, sub);
+			vst1q_f32(resampleCache, vaddq_f32(
+				currentZip.val[0],
+				vmulq_f32(subZip.val[0], frac)
+			));
+			vst1q_f32(resampleCache + 4, vaddq_f32(
+				currentZip.val[1],
+				vmulq_f32(subZip.val[1], frac)
+			));
+			dCache += 4;
+			resampleCache += 8;
+		}
+		toResample -= cycles * 8;
+	}
+	else
+	{
+		/* 4 input frames become 16 output frames */
+		f[2] = FIXED_TO_FLOAT((cur + resampleStep * 2));
+		f[3] = FIXED_TO_FLOAT((cur + resampleStep * 3));
+		frac = vld1q_f32(f);
+		cycles = toResample / 16;
+		for (i = 0; i < cycles; i += 1)
+		{
+			current = vld1q_f32(dCache);
+			next = vld1q_f32(dCache + 1);
+			sub = vsubq_f32(next, current);
+			#define UPSAMPLE_LANE(lane, half, index) \
+				vst1q_f32(resampleCache + lane * 4, vaddq_f32( \
+					vdupq_lane_f32(half(current), index), \
+					vmulq_f32(vdupq_lane_f32(half(sub), index), frac) \
+				));
+			UPSAMPLE_LANE(0, vget_low_f32, 0)
+			UPSAMPLE_LANE(1, vget_low_f32, 1)
+			UPSAMPLE_LANE(2, vget_high_f32, 0)
+			UPSAMPLE_LANE(3, vget_high_f32, 1)
+			#undef UPSAMPLE_LANE
+			dCache += 4;
+			resampleCache += 16;
+		}
+		toResample -= cycles * 16;
+	}
+	*resampleOffset += (cycles * 4) << FIXED_PRECISION;
+
+	FAudio_INTERNAL_ResampleGeneric(
+		dCache,
+		resampleCache,
+		resampleOffset,
+		resampleStep,
+		toResample,
+		1
+	);
+}
+
+void FAudio_INTERNAL_ResampleUpStereo_NEON(
+	float *restrict dCache,
+	float *restrict resampleCache,
+	uint64_t *resampleOffset,
+	uint64_t resampleStep,
+	uint64_t toResample,
+	uint8_t UNUSED
+) {
+	uint64_t i, head, cycles;
+	uint64_t cur = *resampleOffset & FIXED_FRACTION_MASK;
+	float f[4];
+	float32x4_t frac01, frac23, current, next, sub, lo, hi, subLo, subHi;
+
+	head = FAudio_INTERNAL_ResampleUpHead(
+		dCache,
+		resampleCache,
+		resampleOffset,
+		resampleStep,
+		toResample,
+		2
+	);
+	dCache += ((cur + head * resampleStep) >> FIXED_PRECISION) * 2;
+	resampleCache += head * 2;
+	toResample -= head;
+	cur = *resampleOffset & FIXED_FRACTION_MASK;
+
+	f[0] = f[1] = FIXED_TO_FLOAT(cur);
+	f[2] = f[3] = FIXED_TO_FLOAT((cur + resampleStep));
+	frac01 = vld1q_f32(f);
+	if (resampleStep == FIXED_ONE / 2)
+	{
+		/* 2 input frames become 4 output frames */
+		cycles = toResample / 4;
+		for (i = 0; i < cycles; i += 1)
+		{
+			current = vld1q_f32(dCache);
+			next = vld1q_f32(dCache + 2);
+			sub = vsubq_f32(next, current);
+			lo = vcombine_f32(vget_low_f32(current), vget_low_f32(current));
+			hi = vcombine_f32(vget_high_f32(current), vget_high_f32(current));
+			subLo = vcombine_f32(vget_low_f32(sub), vget_low_f32(sub));
+			subHi = vcombine_f32(vget_high_f32(sub), vget_high_f32(sub));
+			vst1q_f32(resampleCache, vaddq_f32(lo, vmulq_f32(subLo, frac01)));
+			vst1q_f32(resampleCache + 4, vaddq_f32(hi, vmulq_f32(subHi, frac01)));
+			dCache += 4;
+			resampleCache += 8;
+		}
+		toResample -= cycles * 4;
+	}
+	else
+	{
+		/* 2 input frames become 8 output frames */
+		f[0] = f[1] = FIXED_TO_FLOAT((cur + resampleStep * 2));
+		f[2] = f[3] = FIXED_TO_FLOAT((cur + resampleStep * 3));
+		frac23 = vld1q_f32(f);
+		cycles = toResample / 8;
+		for (i = 0; i < cycles; i += 1)
+		{
+			current = vld1q_f32(dCache);
+			next = vld1q_f32(dCache + 2);
+			sub = vsubq_f32(next, current);
+			lo = vcombine_f32(vget_low_f32(current), vget_low_f32(current));
+			hi = vcombine_f32(vget_high_f32(current), vget_high_f32(current));
+			subLo = vcombine_f32(vget_low_f32(sub), vget_low_f32(sub));
+			subHi = vcombine_f32(vget_high_f32(sub), vget_high_f32(sub));
+			vst1q_f32(resampleCache, vaddq_f32(lo, vmulq_f32(subLo, frac01)));
+			vst1q_f32(resampleCache + 4, vaddq_f32(lo, vmulq_f32(subLo, frac23)));
+			vst1q_f32(resampleCache + 8, vaddq_f32(hi, vmulq_f32(subHi, frac01)));
+			vst1q_f32(resampleCache + 12, vaddq_f32(hi, vmulq_f32(subHi, frac23)));
+			dCache += 4;
+			resampleCache += 16;
+		}
+		toResample -= cycles * 8;
+	}
+	*resampleOffset += (cycles * 2) << FIXED_PRECISION;
+
+	FAudio_INTERNAL_ResampleGeneric(
+		dCache,
+		resampleCache,
+		resampleOffset,
+		resampleStep,
+		toResample,
+		2
+	);
+}
+
+void FAudio_INTERNAL_ResampleDownMono_NEON(
+	float *restrict dCache,
+	float *restrict resampleCache,
+	uint64_t *resampleOffset,
+	uint64_t resampleStep,
+	uint64_t toResample,
+	uint8_t UNUSED
+) {
+	uint64_t i, cycles = toResample / 4;
+	float32x4_t a, b, current, next;
+	float32x4x2_t unzip;
+	const float32x4_t frac = vdupq_n_f32(
+		FIXED_TO_FLOAT((*resampleOffset & FIXED_FRACTION_MASK))
+	);
+
+	for (i = 0; i < cycles; i += 1)
+	{
+		if (resampleStep == FIXED_ONE * 2)
+		{
+			a = vld1q_f32(dCache);
+			b = vld1q_f32(dCache + 4);
+		}
+		else
+		{
+			/* Only the first two frames of each group of 4 are read */
+			a = vcombine_f32(vld1_f32(dCache), vld1_f32(dCache + 4));
+			b = vcombine_f32(vld1_f32(dCache + 8), vld1_f32(dCache + 12));
+		}
+		unzip = vuzpq_f32(a, b);
+		current = unzip.val[0];
+		next = unzip.val[1];
+		vst1q_f32(resampleCache, vaddq_f32(
+			current,
+			vmulq_f32(vsubq_f32(next, current), frac)
+		));
+		dCache += (resampleStep >> FIXED_PRECISION) * 4;
+		resampleCache += 4;
+	}
+	*resampleOffset += cycles * 4 * resampleStep;
+
+	FAudio_INTERNAL_ResampleDownGeneric(
+		dCache,
+		resampleCache,
+		resampleOffset,
+		resampleStep,
+		toResample - (cycles * 4),
+		1
+	);
+}
+
+void FAudio_INTERNAL_ResampleDownStereo_NEON(
+	float *restrict dCache,
+	float *restrict resampleCache,
+	uint64_t *resampleOffset,
+	uint64_t resampleStep,
+	uint64_t toResample,
+	uint8_t UNUSED
+) {
+	uint64_t i, cycles = toResample / 2;
+	const uint32_t stride = (uint32_t) (resampleStep >> FIXED_PRECISION) * 2;
+	float32x4_t a, b, current, next;
+	const float32x4_t frac = vdupq_n_f32(
+		FIXED_TO_FLOAT((*resampleOffset & FIXED_FRACTION_MASK))
+	);
+
+	for (i = 0; i < cycles; i += 1)
+	{
+		/* The two frames used for each output frame */
+		a = vld1q_f32(dCache);
+		b = vld1q_f32(dCache + stride);
+		current = vcombine_f32(vget_low_f32(a), vget_low_f32(b));
+		next = vcombine_f32(vget_high_f32(a), vget_high_f32(b));
+		vst1q_f32(resampleCache, vaddq_f32(
+			current,
+			vmulq_f32(vsubq_f32(next, current), frac)
+		));
+		dCache += stride * 2;
+		resampleCache += 4;
+	}
+	*resampleOffset += cycles * 2 * resampleStep;
+
+	FAudio_INTERNAL_ResampleDownGeneric(
+		dCache,
+		resampleCache,
+		resampleOffset,
+		resampleStep,
+		toResample - (cycles * 2),
+		2
+	);
+}
+#endif /* HAVE_NEON_INTRINSICS */
+
+/* SECTION 3: Sinc Resamplers */
+
+/* Table n is used for steps up to FAUDIO_INTERNAL_SINC_STEPS[n], and the
+ * last one for anything faster than that (which will alias some).
+ */
+const double FAUDIO_INTERNAL_SINC_STEPS[SINC_CUTOFFS] =
+{
+	1.0,
+	1.189207115002721, /* 2^(1/4) */
+	1.414213562373095,
+	1.681792830507429,
+	2.0,
+	2.378414230005442,
+	2.828427124746190,
+	3.363585661014858,
+	4.0
+};
+
+/* Kaiser window beta, for about 80dB of stopband attenuation */
+#define SINC_KAISER_BETA 8.0
+
+/* Cutoff for steps <= 1, relative to the input Nyquist. The transition band
+ * of a 32-tap window is about this wide, so anything near Nyquist is gone.
+ */
+#define SINC_CUTOFF 0.84
+
+static double FAudio_INTERNAL_BesselI0(double x)
+{
+	/* Power series, which converges quickly enough for SINC_KAISER_BETA */
+	double sum = 1.0, term = 1.0;
+	uint32_t k;
+	for (k = 1; k < 32; k += 1)
+	{
+		term *= (x / (2.0 * k)) * (x / (2.0 * k));
+		sum += term;
+	}
+	return sum;
+}
+
+static void FAudio_INTERNAL_BuildSincPhase(
+	double *taps,
+	double cutoff,
+	double fraction
+) {
+	const double pi = FAudio_acos(-1.0);
+	double x, u, sum = 0.0;
+	uint32_t i;
+	for (i = 0; i < SINC_TAPS; i += 1)
+	{
+		/* Tap i reads SINC_HISTORY frames back from the resample
+		 * offset, and the kernel is centered SINC_DELAY frames back.
+		 */
+		x = ((double) i - SINC_DELAY - fraction) * cutoff;
+		u = ((double) i - SINC_DELAY - fraction) / (SINC_TAPS / 2);
+		taps[i] = (x == 0.0) ? 1.0 : FAudio_sin(pi * x) / (pi * x);
+		taps[i] *= FAudio_INTERNAL_BesselI0(
+			SINC_KAISER_BETA * FAudio_sqrt(FAudio_max(0.0, 1.0 - u * u))
+		);
+		sum += taps[i];
+	}
+
+	/* Unity gain at DC, whatever the phase */
+	for (i = 0; i < SINC_TAPS; i += 1)
+	{
+		taps[i] /= sum;
+	}
+}
+
+void FAudio_INTERNAL_BuildSincTable(float *table)
+{
+	double cur[SINC_TAPS], next[SINC_TAPS];
+	double cutoff;
+	uint32_t i, j, k;
+
+	for (i = 0; i < SINC_CUTOFFS; i += 1)
+	{
+		cutoff = SINC_CUTOFF / FAUDIO_INTERNAL_SINC_STEPS[i];
+		FAudio_INTERNAL_BuildSincPhase(cur, cutoff, 0.0);
+		for (j = 0; j < SINC_PHASES; j += 1)
+		{
+			FAudio_INTERNAL_BuildSincPhase(
+				next,
+				cutoff,
+				(double) (j + 1) / SINC_PHASES
+			);
+			for (k = 0; k < SINC_TAPS; k += 1)
+			{
+				table[k] = (float) cur[k];
+				table[k + SINC_TAPS] = (float) (next[k] - cur[k]);
+			}
+			FAudio_memcpy(cur, next, sizeof(cur));
+			table += SINC_ROW;
+		}
+	}
+}
+
+void FAudio_INTERNAL_ResampleSincGeneric(
+	float *restrict dCache,
+	float *restrict resampleCache,
+	uint64_t *resampleOffset,
+	uint64_t resampleStep,
+	uint64_t toResample,
+	uint8_t channels,
+	const float *restrict table
+) {
+	uint32_t i, j, k;
+	uint64_t cur = *resampleOffset & FIXED_FRACTION_MASK;
+	const float *row;
+	float taps[SINC_TAPS];
+	float t, sum;
+
+	/* The first tap is SINC_HISTORY frames back */
+	dCache -= SINC_HISTORY * channels;
+	for (i = 0; i < toResample; i += 1)
+	{
+		/* Pick the phase, then lerp toward the next one */
+		row = table + (cur >> SINC_PHASE_SHIFT) * SINC_ROW;
+		t = (float) (cur & SINC_LERP_MASK) * SINC_LERP_SCALE;
+		for (k = 0; k < SINC_TAPS; k += 1)
+		{
+			taps[k] = row[k] + row[k + SINC_TAPS] * t;
+		}
+
+		for (j = 0; j < channels; j += 1)
+		{
+			sum = 0.0f;
+			for (k = 0; k < SINC_TAPS; k += 1)
+			{
+				sum += taps[k] * dCache[k * channels + j];
+			}
+			*resampleCache++ = sum;
+		}
+
+		/* Same stepping as the linear resamplers */
+		*resampleOffset += resampleStep;
+		cur += resampleStep;
+		dCache += (cur >> FIXED_PRECISION) * channels;
+		cur &= FIXED_FRACTION_MASK;
+	}
+}
+
+void FAudio_INTERNAL_ResampleSincMono_Scalar(
+	float *restrict dCache,
+	float *restrict resampleCache,
+	uint64_t *resampleOffset,
+	uint64_t resampleStep,
+	uint64_t toResample,
+	uint8_t UNUSED,
+	const float *restrict table
+) {
+	uint32_t i, k;
+	uint64_t cur = *resampleOffset & FIXED_FRACTION_MASK;
+	const float *row;
+	float t, sum;
+
+	dCache -= SINC_HISTORY;
+	for (i = 0; i < toResample; i += 1)
+	{
+		row = table + (cur >> SINC_PHASE_SHIFT) * SINC_ROW;
+		t = (float) (cur & SINC_LERP_MASK) * SINC_LERP_SCALE;
+		sum = 0.0f;
+		for (k = 0; k < SINC_TAPS; k += 1)
+		{
+			sum += (row[k] + row[k + SINC_TAPS] * t) * dCache[k];
+		}
+		*resampleCache++ = sum;
+
+		*resampleOffset += resampleStep;
+		cur += resampleStep;
+		dCache += (cur >> FIXED_PRECISION);
+		cur &= FIXED_FRACTION_MASK;
+	}
+}
+
+void FAudio_INTERNAL_ResampleSincStereo_Scalar(
+	float *restrict dCache,
+	float *restrict resampleCache,
+	uint64_t *resampleOffset,
+	uint64_t resampleStep,
+	uint64_t toResample,
+	uint8_t UNUSED,
+	const float *restrict table
+) {
+	uint32_t i, k;
+	uint64_t cur = *resampleOffset & FIXED_FRACTION_MASK;
+	const float *row;
+	float t, tap, sumL, sumR;
+
+	dCache -= SINC_HISTORY * 2;
+	for (i = 0; i < toResample; i += 1)
+	{
+		row = table + (cur >> SINC_PHASE_SHIFT) * SINC_ROW;
+		t = (float) (cur & SINC_LERP_MASK) * SINC_LERP_SCALE;
+		sumL = 0.0f;
+		sumR = 0.0f;
+		for (k = 0; k < SINC_TAPS; k += 1)
+		{
+			tap = row[k] + row[k + SINC_TAPS] * t;
+			sumL += tap * dCache[k * 2];
+			sumR += tap * dCache[k * 2 + 1];
+		}
+		*resampleCache++ = sumL;
+		*resampleCache++ = sumR;
+
+		*resampleOffset += resampleStep;
+		cur += resampleStep;
+		dCache += (cur >> FIXED_PRECISION) * 2;
+		cur &= FIXED_FRACTION_MASK;
+	}
+}
+
+#if HAVE_SSE2_INTRINSICS
+void FAudio_INTERNAL_ResampleSincMono_SSE2(
+	float *restrict dCache,
+	float *restrict resampleCache,
+	uint64_t *resampleOffset,
+	uint64_t resampleStep,
+	uint64_t toResample,
+	uint8_t UNUSED,
+	const float *restrict table
+) {
+	uint32_t i, k;
+	uint64_t cur = *resampleOffset & FIXED_FRACTION_MASK;
+	const float *row;
+	__m128 t, tap, sum;
+
+	dCache -= SINC_HISTORY;
+	for (i = 0; i < toResample; i += 1)
+	{
+		row = table + (cur >> SINC_PHASE_SHIFT) * SINC_ROW;
+		t = _mm_set1_ps((float) (cur & SINC_LERP_MASK) * SINC_LERP_SCALE);
+		sum = _mm_setzero_ps();
+		for (k = 0; k < SINC_TAPS; k += 4)
+		{
+			tap = _mm_add_ps(
+				_mm_loadu_ps(row + k),
+				_mm_mul_ps(_mm_loadu_ps(row + k + SINC_TAPS), t)
+			);
+			sum = _mm_add_ps(
+				sum,
+				_mm_mul_ps(tap, _mm_loadu_ps(dCache + k))
+			);
+		}
+
+		/* Horizontal add, the total ends up in the lowest lane */
+		sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+		sum = _mm_add_ss(sum, _mm_shuffle_ps(sum, sum, _MM_SHUFFLE(1, 1, 1, 1)));
+		_mm_store_ss(resampleCache++, sum);
+
+		*resampleOffset += resampleStep;
+		cur += resampleStep;
+		dCache += (cur >> FIXED_PRECISION);
+		cur &= FIXED_FRACTION_MASK;
+	}
+}
+
+void FAudio_INTERNAL_ResampleSincStereo_SSE2(
+	float *restrict dCache,
+	float *restrict resampleCache,
+	uint64_t *resampleOffset,
+	uint64_t resampleStep,
+	uint64_t toResample,
+	uint8_t UNUSED,
+	const float *restrict table
+) {
+	uint32_t i, k;
+	uint64_t cur = *resampleOffset & FIXED_FRACTION_MASK;
+	const float *row;
+	__m128 t, tap, sumLo, sumHi;
+
+	dCache -= SINC_HISTORY * 2;
+	for (i = 0; i < toResample; i += 1)
+	{
+		row = table + (cur >> SINC_PHASE_SHIFT) * SINC_ROW;
+		t = _mm_set1_ps((float) (cur & SINC_LERP_MASK) * SINC_LERP_SCALE);
+		sumLo = _mm_setzero_ps();
+		sumHi = _mm_setzero_ps();
+		for (k = 0; k < SINC_TAPS; k += 4)
+		{
+			tap = _mm_add_ps(
+				_mm_loadu_ps(row + k),
+				_mm_mul_ps(_mm_loadu_ps(row + k + SINC_TAPS), t)
+			);
+
+			/* t0 t0 t1 t1 against L0 R0 L1 R1, and so on */
+			sumLo = _mm_add_ps(
+				sumLo,
+				_mm_mul_ps(
+					_mm_unpacklo_ps(tap, tap),
+					_mm_loadu_ps(dCache + k * 2)
+				)
+			);
+			sumHi = _mm_add_ps(
+				sumHi,
+				_mm_mul_ps(
+					_mm_unpackhi_ps(tap, tap),
+					_mm_loadu_ps(dCache + k * 2 + 4)
+				)
+			);
+		}
+
+		/* L R L R, down to L R */
+		sumLo = _mm_add_ps(sumLo, sumHi);
+		sumLo = _mm_add_ps(sumLo, _mm_movehl_ps(sumLo, sumLo));
+		_mm_storel_pi((__m64*) resampleCache, sumLo);
+		resampleCache += 2;
+
+		*resampleOffset += resampleStep;
+		cur += resampleStep;
+		dCache += (cur >> FIXED_PRECISION) * 2;
+		cur &= FIXED_FRACTION_MASK;
+	}
+}
+#endif /* HAVE_SSE2_INTRINSICS */
+
+#if HAVE_AVX2_INTRINSICS
+FAUDIO_TARGET_AVX2
+void FAudio_INTERNAL_ResampleSincMono_AVX2(
+	float *restrict dCache,
+	float *restrict resampleCache,
+	uint64_t *resampleOffset,
+	uint64_t resampleStep,
+	uint64_t toResample,
+	uint8_t UNUSED,
+	const float *restrict table
+) {
+	uint32_t i, k;
+	uint64_t cur = *resampleOffset & FIXED_FRACTION_MASK;
+	const float *row;
+	__m256 t, tap, sum;
+	__m128 total;
+
+	dCache -= SINC_HISTORY;
+	for (i = 0; i < toResample; i += 1)
+	{
+		row = table + (cur >> SINC_PHASE_SHIFT) * SINC_ROW;
+		t = _mm256_set1_ps((float) (cur & SINC_LERP_MASK) * SINC_LERP_SCALE);
+		sum = _mm256_setzero_ps();
+		for (k = 0; k < SINC_TAPS; k += 8)
+		{
+			tap = _mm256_add_ps(
+				_mm256_loadu_ps(row + k),
+				_mm256_mul_ps(_mm256_loadu_ps(row + k + SINC_TAPS), t)
+			);
+			sum = _mm256_add_ps(
+				sum,
+				_mm256_mul_ps(tap, _mm256_loadu_ps(dCache + k))
+			);
+		}
+
+		total = _mm_add_ps(
+			_mm256_castps256_ps128(sum),
+			_mm256_extractf128_ps(sum, 1)
+		);
+		total = _mm_add_ps(total, _mm_movehl_ps(total, total));
+		total = _mm_add_ss(total, _mm_shuffle_ps(total, total, _MM_SHUFFLE(1, 1, 1, 1)));
+		_mm_store_ss(resampleCache++, total);
+
+		*resampleOffset += resampleStep;
+		cur += resampleStep;
+		dCache += (cur >> FIXED_PRECISION);
+		cur &= FIXED_FRACTION_MASK;
+	}
+}
+
+FAUDIO_TARGET_AVX2
+void FAudio_INTERNAL_ResampleSincStereo_AVX2(
+	float *restrict dCache,
+	float *restrict resampleCache,
+	uint64_t *resampleOffset,
+	uint64_t resampleStep,
+	uint64_t toResample,
+	uint8_t UNUSED,
+	const float *restrict table
+) {
+	uint32_t i, k;
+	uint64_t cur = *resampleOffset & FIXED_FRACTION_MASK;
+	const float *row;
+	__m256 t, tap, lo, hi, sumLo, sumHi;
+	__m128 total;
+
+	dCache -= SINC_HISTORY * 2;
+	for (i = 0; i < toResample; i += 1)
+	{
+		row = table + (cur >> SINC_PHASE_SHIFT) * SINC_ROW;
+		t = _mm256_set1_ps((float) (cur & SINC_LERP_MASK) * SINC_LERP_SCALE);
+		sumLo = _mm256_setzero_ps();
+		sumHi = _mm256_setzero_ps();
+		for (k = 0; k < SINC_TAPS; k += 8)
+		{
+			tap = _mm256_add_ps(
+				_mm256_loadu_ps(row + k),
+				_mm256_mul_ps(_mm256_loadu_ps(row + k + SINC_TAPS), t)
+			);
+
+			/* Unpacks stay within each 128-bit lane, so this gives
+			 * t0 t0 t1 t1 t4 t4 t5 t5 and t2 t2 t3 t3 t6 t6 t7 t7...
+			 */
+			lo = _mm256_unpacklo_ps(tap, tap);
+			hi = _mm256_unpackhi_ps(tap, tap);
+
+			/* ... which get swapped back into t0-t3 and t4-t7 */
+			sumLo = _mm256_add_ps(
+				sumLo,
+				_mm256_mul_ps(
+					_mm256_permute2f128_ps(lo, hi, 0x20),
+					_mm256_loadu_ps(dCache + k * 2)
+				)
+			);
+			sumHi = _mm256_add_ps(
+				sumHi,
+				_mm256_mul_ps(
+					_mm256_permute2f128_ps(lo, hi, 0x31),
+					_mm256_loadu_ps(dCache + k * 2 + 8)
+				)
+			);
+		}
+
+		sumLo = _mm256_add_ps(sumLo, sumHi);
+		total = _mm_add_ps(
+			_mm256_castps256_ps128(sumLo),
+			_mm256_extractf128_ps(sumLo, 1)
+		);
+		total = _mm_add_ps(total, _mm_movehl_ps(total, total));
+		_mm_storel_pi((__m64*) resampleCache, total);
+		resampleCache += 2;
+
+		*resampleOffset += resampleStep;
+		cur += resampleStep;
+		dCache += (cur >> FIXED_PRECISION) * 2;
+		cur &= FIXED_FRACTION_MASK;
+	}
+}
+#endif /* HAVE_AVX2_INTRINSICS */
+
+#if HAVE_NEON_INTRINSICS
+void FAudio_INTERNAL_ResampleSincMono_NEON(
+	float *restrict dCache,
+	float *restrict resampleCache,
+	uint64_t *resampleOffset,
+	uint64_t resampleStep,
+	uint64_t toResample,
+	uint8_t UNUSED,
+	const float *restrict table
+) {
+	uint32_t i, k;
+	uint64_t cur = *resampleOffset & FIXED_FRACTION_MASK;
+	const float *row;
+	float t;
+	float32x4_t tap, sum;
+	float32x2_t total;
+
+	dCache -= SINC_HISTORY;
+	for (i = 0; i < toResample; i += 1)
+	{
+		row = table + (cur >> SINC_PHASE_SHIFT) * SINC_ROW;
+		t = (float) (cur & SINC_LERP_MASK) * SINC_LERP_SCALE;
+		sum = vdupq_n_f32(0.0f);
+		for (k = 0; k < SINC_TAPS; k += 4)
+		{
+			tap = vmlaq_n_f32(
+				vld1q_f32(row + k),
+				vld1q_f32(row + k + SINC_TAPS),
+				t
+			);
+			sum = vmlaq_f32(sum, tap, vld1q_f32(dCache + k));
+		}
+
+		total = vadd_f32(vget_low_f32(sum), vget_high_f32(sum));
+		total = vpadd_f32(total, total);
+		vst1_lane_f32(resampleCache++, total, 0);
+
+		*resampleOffset += resampleStep;
+		cur += resampleStep;
+		dCache += (cur >> FIXED_PRECISION);
+		cur &= FIXED_FRACTION_MASK;
+	}
+}
+
+void FAudio_INTERNAL_ResampleSincStereo_NEON(
+	float *restrict dCache,
+	float *restrict resampleCache,
+	uint64_t *resampleOffset,
+	uint64_t resampleStep,
+	uint64_t toResample,
+	uint8_t UNUSED,
+	const float *restrict table
+) {
+	uint32_t i, k;
+	uint64_t cur = *resampleOffset & FIXED_FRACTION_MASK;
+	const float *row;
+	float t;
+	float32x4_t tap, sumLo, sumHi;
+	float32x4x2_t taps;
+
+	dCache -= SINC_HISTORY * 2;
+	for (i = 0; i < toResample; i += 1)
+	{
+		row = table + (cur >> SINC_PHASE_SHIFT) * SINC_ROW;
+		t = (float) (cur & SINC_LERP_MASK) * SINC_LERP_SCALE;
+		sumLo = vdupq_n_f32(0.0f);
+		sumHi = vdupq_n_f32(0.0f);
+		for (k = 0; k < SINC_TAPS; k += 4)
+		{
+			tap = vmlaq_n_f32(
+				vld1q_f32(row + k),
+				vld1q_f32(row + k + SINC_TAPS),
+				t
+			);
+
+			/* t0 t0 t1 t1 against L0 R0 L1 R1, and so on */
+			taps = vzipq_f32(tap, tap);
+			sumLo = vmlaq_f32(sumLo, taps.val[0], vld1q_f32(dCache + k * 2));
+			sumHi = vmlaq_f32(sumHi, taps.val[1], vld1q_f32(dCache + k * 2 + 4));
+		}
+
+		sumLo = vaddq_f32(sumLo, sumHi);
+		vst1_f32(
+			resampleCache,
+			vadd_f32(vget_low_f32(sumLo), vget_high_f32(sumLo))
+		);
+		resampleCache += 2;
+
+		*resampleOffset += resampleStep;
+		cur += resampleStep;
+		dCache += (cur >> FIXED_PRECISION) * 2;
+		cur &= FIXED_FRACTION_MASK;
+	}
+}
+#endif /* HAVE_NEON_INTRINSICS */
+
+/* SECTION 4: Amplifiers */
+
+void FAudio_INTERNAL_Amplify_Scalar(
+	float* output,
+	uint32_t totalSamples,
+	float volume
+) {
+	uint32_t i;
+	for (i = 0; i < totalSamples; i += 1)
+	{
+		output[i] *= volume;
+		output[i] = FAudio_clamp(
+			output[i],
+			-FAUDIO_MAX_VOLUME_LEVEL,
+			FAUDIO_MAX_VOLUME_LEVEL
+		);
+	}
+}
+
+/* The SSE2 version of the amplifier comes from @8thMage! */
+
+#if HAVE_SSE2_INTRINSICS
+void FAudio_INTERNAL_Amplify_SSE2(
+	float* output,
+	uint32_t totalSamples,
+	float volume
+) {
+	uint32_t i;
+	uint32_t header = (16 - (((size_t) output) % 16)) / 4;
+	uint32_t tail;
+	__m128 volumeVec, minVolumeVec, maxVolumeVec, outVec;
+	if (header == 4)
+	{
+		header = 0;
+	}
+
+	/* Too short to ever reach an aligned address */
+	if (header > totalSamples)
+	{
+		header = totalSamples;
+	}
+	tail = (totalSamples - header) % 4;
+
+	for (i = 0; i < header; i += 1)
+	{
+		output[i] *= volume;
+		output[i] = FAudio_clamp(
+			output[i],
+			-FAUDIO_MAX_VOLUME_LEVEL,
+			FAUDIO_MAX_VOLUME_LEVEL
+		);
+	}
+
+	volumeVec = _mm_set1_ps(volume);
+	minVolumeVec = _mm_set1_ps(-FAUDIO_MAX_VOLUME_LEVEL);
+	maxVolumeVec = _mm_set1_ps(FAUDIO_MAX_VOLUME_LEVEL);
+	for (i = header; i < totalSamples - tail; i += 4)
+	{
+		outVec = _mm_load_ps(output + i);
+		outVec = _mm_mul_ps(outVec, volumeVec);
+		outVec = _mm_max_ps(outVec, minVolumeVec);
+		outVec = _mm_min_ps(outVec, maxVolumeVec);
+		_mm_store_ps(output + i, outVec);
+	}
+
+	for (i = totalSamples - tail; i < totalSamples; i += 1)
+	{
+		output[i] *= volume;
+		output[i] = FAudio_clamp(
+			output[i],
+			-FAUDIO_MAX_VOLUME_LEVEL,
+			FAUDIO_MAX_VOLUME_LEVEL
+		);
+	}
+}
+#endif /* HAVE_SSE2_INTRINSICS */
+
+#if HAVE_AVX2_INTRINSICS
+FAUDIO_TARGET_AVX2
+void FAudio_INTERNAL_Amplify_AVX2(
+	float* output,
+	uint32_t totalSamples,
+	float volume
+) {
+	uint32_t i;
+	const uint32_t vecSamples = totalSamples & ~7;
+	const __m256 volumeVec = _mm256_set1_ps(volume);
+	const __m256 minVolumeVec = _mm256_set1_ps(-FAUDIO_MAX_VOLUME_LEVEL);
+	const __m256 maxVolumeVec = _mm256_set1_ps(FAUDIO_MAX_VOLUME_LEVEL);
+	__m256 outVec;
+	for (i = 0; i < vecSamples; i += 8)
+	{
+		outVec = _mm256_loadu_ps(output + i);
+		outVec = _mm256_mul_ps(outVec, volumeVec);
+		outVec = _mm256_max_ps(outVec, minVolumeVec);
+		outVec = _mm256_min_ps(outVec, maxVolumeVec);
+		_mm256_storeu_ps(output + i, outVec);
+	}
+	FAudio_INTERNAL_Amplify_Scalar(
+		output + vecSamples,
+		totalSamples - vecSamples,
+		volume
+	);
+}
+#endif /* HAVE_AVX2_INTRINSICS */
+
+#if HAVE_AVX512F_INTRINSICS
+FAUDIO_TARGET_AVX512F
+void FAudio_INTERNAL_Amplify_AVX512F(
+	float* output,
+	uint32_t totalSamples,
+	float volume
+) {
+	uint32_t i;
+	const uint32_t vecSamples = totalSamples & ~15;
+	const __m512 volumeVec = _mm512_set1_ps(volume);
+	const __m512 minVolumeVec = _mm512_set1_ps(-FAUDIO_MAX_VOLUME_LEVEL);
+	const __m512 maxVolumeVec = _mm512_set1_ps(FAUDIO_MAX_VOLUME_LEVEL);
+	__m512 outVec;
+	for (i = 0; i < vecSamples; i += 16)
+	{
+		outVec = _mm512_loadu_ps(output + i);
+		outVec = _mm512_mul_ps(outVec, volumeVec);
+		outVec = _mm512_max_ps(outVec, minVolumeVec);
+		outVec = _mm512_min_ps(outVec, maxVolumeVec);
+		_mm512_storeu_ps(output + i, outVec);
+	}
+	FAudio_INTERNAL_Amplify_Scalar(
+		output + vecSamples,
+		totalSamples - vecSamples,
+		volume
+	);
+}
+#endif /* HAVE_AVX512F_INTRINSICS */
+
+#if HAVE_NEON_INTRINSICS
+void FAudio_INTERNAL_Amplify_NEON(
+	float* output,
+	uint32_t totalSamples,
 	float volume
 ) {
 	uint32_t i;
-	uint32_t header = (16 - (((size_t) output) % 16)) / 4;
-	uint32_t tail = (totalSamples - header) % 4;
-	float32x4_t volumeVec, minVolumeVec, maxVolumeVec, outVec;
-	if (header == 4)
+	uint32_t header = (16 - (((size_t) output) % 16)) / 4;
+	uint32_t tail;
+	float32x4_t volumeVec, minVolumeVec, maxVolumeVec, outVec;
+	if (header == 4)
+	{
+		header = 0;
+	}
+
+	/* Too short to ever reach an aligned address */
+	if (header > totalSamples)
+	{
+		header = totalSamples;
+	}
+	tail = (totalSamples - header) % 4;
+
+	for (i = 0; i < header; i += 1)
+	{
+		output[i] *= volume;
+		output[i] = FAudio_clamp(
+			output[i],
+			-FAUDIO_MAX_VOLUME_LEVEL,
+			FAUDIO_MAX_VOLUME_LEVEL
+		);
+	}
+
+	volumeVec = vdupq_n_f32(volume);
+	minVolumeVec = vdupq_n_f32(-FAUDIO_MAX_VOLUME_LEVEL);
+	maxVolumeVec = vdupq_n_f32(FAUDIO_MAX_VOLUME_LEVEL);
+	for (i = header; i < totalSamples - tail; i += 4)
+	{
+		outVec = vld1q_f32(output + i);
+		outVec = vmulq_f32(outVec, volumeVec);
+		outVec = vmaxq_f32(outVec, minVolumeVec);
+		outVec = vminq_f32(outVec, maxVolumeVec);
+		vst1q_f32(output + i, outVec);
+	}
+
+	for (i = totalSamples - tail; i < totalSamples; i += 1)
+	{
+		output[i] *= volume;
+		output[i] = FAudio_clamp(
+			output[i],
+			-FAUDIO_MAX_VOLUME_LEVEL,
+			FAUDIO_MAX_VOLUME_LEVEL
+		);
+	}
+}
+#endif /* HAVE_NEON_INTRINSICS */
+
+/* SECTION 5: Mixer Functions */
+
+void FAudio_INTERNAL_Mix_Generic_Scalar(
+	uint32_t toMix,
+	uint32_t srcChans,
+	uint32_t dstChans,
+	float baseVolume,
+	float *restrict src,
+	float *restrict dst,
+	float *restrict channelVolume,
+	float *restrict coefficients
+) {
+	uint32_t i, co, ci;
+	for (i = 0; i < toMix; i += 1, src += srcChans, dst += dstChans)
+	for (co = 0; co < dstChans; co += 1)
+	{
+		for (ci = 0; ci < srcChans; ci += 1)
+		{
+			dst[co] += (
+				src[ci] *
+				channelVolume[ci] *
+				baseVolume *
+				coefficients[co * srcChans + ci]
+			);
+		}
+		dst[co] = FAudio_clamp(
+			dst[co],
+			-FAUDIO_MAX_VOLUME_LEVEL,
+			FAUDIO_MAX_VOLUME_LEVEL
+		);
+	}
+}
+
+void FAudio_INTERNAL_Mix_1in_1out_Scalar(
+	uint32_t toMix,
+	uint32_t UNUSED1,
+	uint32_t UNUSED2,
+	float baseVolume,
+	float *restrict src,
+	float *restrict dst,
+	float *restrict channelVolume,
+	float *restrict coefficients
+) {
+	uint32_t i;
+	float totalVolume = baseVolume * channelVolume[0] * coefficients[0];
+	for (i = 0; i < toMix; i += 1, src += 1, dst += 1)
+	{
+		/* Base source data, combined with the coefficients... */
+		dst[0] += src[0] * totalVolume;
+
+		/* ... then clamped. */
+		dst[0] = FAudio_clamp(
+			dst[0],
+			-FAUDIO_MAX_VOLUME_LEVEL,
+			FAUDIO_MAX_VOLUME_LEVEL
+		);
+	}
+}
+
+void FAudio_INTERNAL_Mix_1in_2out_Scalar(
+	uint32_t toMix,
+	uint32_t UNUSED1,
+	uint32_t UNUSED2,
+	float baseVolume,
+	float *restrict src,
+	float *restrict dst,
+	float *restrict channelVolume,
+	float *restrict coefficients
+) {
+	uint32_t i;
+	float totalVolume = baseVolume * channelVolume[0];
+	for (i = 0; i < toMix; i += 1, src += 1, dst += 2)
+	{
+		/* Base source data... */
+		const float sample = src[0] * totalVolume;
+
+		/* ... combined with the coefficients... */
+		dst[0] += sample * coefficients[0];
+		dst[1] += sample * coefficients[1];
+
+		/* ... then clamped. */
+		dst[0] = FAudio_clamp(
+			dst[0],
+			-FAUDIO_MAX_VOLUME_LEVEL,
+			FAUDIO_MAX_VOLUME_LEVEL
+		);
+		dst[1] = FAudio_clamp(
+			dst[1],
+			-FAUDIO_MAX_VOLUME_LEVEL,
+			FAUDIO_MAX_VOLUME_LEVEL
+		);
+	}
+}
+
+void FAudio_INTERNAL_Mix_1in_6out_Scalar(
+	uint32_t toMix,
+	uint32_t UNUSED1,
+	uint32_t UNUSED2,
+	float baseVolume,
+	float *restrict src,
+	float *restrict dst,
+	float *restrict channelVolume,
+	float *restrict coefficients
+) {
+	uint32_t i;
+	float totalVolume = baseVolume * channelVolume[0];
+	for (i = 0; i < toMix; i += 1, src += 1, dst += 6)
+	{
+		/* Base source data... */
+		const float sample = src[0] * totalVolume;
+
+		/* ... combined with the coefficients... */
+		dst[0] += sample * coefficients[0];
+		dst[1] += sample * coefficients[1];
+		dst[2] += sample * coefficients[2];
+		dst[3] += sample * coefficients[3];
+		dst[4] += sample * coefficients[4];
+		dst[5] += sample * coefficients[5];
+
+		/* ... then clamped. */
+		dst[0] = FAudio_clamp(
+			dst[0],
+			-FAUDIO_MAX_VOLUME_LEVEL,
+			FAUDIO_MAX_VOLUME_LEVEL
+		);
+		dst[1] = FAudio_clamp(
+			dst[1],
+			-FAUDIO_MAX_VOLUME_LEVEL,
+			FAUDIO_MAX_VOLUME_LEVEL
+		);
+		dst[2] = FAudio_clamp(
+			dst[2],
+			-FAUDIO_MAX_VOLUME_LEVEL,
+			FAUDIO_MAX_VOLUME_LEVEL
+		);
+		dst[3] = FAudio_clamp(
+			dst[3],
+			-FAUDIO_MAX_VOLUME_LEVEL,
+			FAUDIO_MAX_VOLUME_LEVEL
+		);
+		dst[4] = FAudio_clamp(
+			dst[4],
+			-FAUDIO_MAX_VOLUME_LEVEL,
+			FAUDIO_MAX_VOLUME_LEVEL
+		);
+		dst[5] = FAudio_clamp(
+			dst[5],
+			-FAUDIO_MAX_VOLUME_LEVEL,
+			FAUDIO_MAX_VOLUME_LEVEL
+		);
+	}
+}
+
+void FAudio_INTERNAL_Mix_1in_8out_Scalar(
+	uint32_t toMix,
+	uint32_t UNUSED1,
+	uint32_t UNUSED2,
+	float baseVolume,
+	float *restrict src,
+	float *restrict dst,
+	float *restrict channelVolume,
+	float *restrict coefficients
+) {
+	uint32_t i;
+	float totalVolume = baseVolume * channelVolume[0];
+	for (i = 0; i < toMix; i += 1, src += 1, dst += 8)
+	{
+		/* Base source data... */
+		const float sample = src[0] * totalVolume;
+
+		/* ... combined with the coefficients... */
+		dst[0] += sample * coefficients[0];
+		dst[1] += sample * coefficients[1];
+		dst[2] += sample * coefficients[2];
+		dst[3] += sample * coefficients[3];
+		dst[4] += sample * coefficients[4];
+		dst[5] += sample * coefficients[5];
+		dst[6] += sample * coefficients[6];
+		dst[7] += sample * coefficients[7];
+
+		/* ... then clamped. */
+		dst[0] = FAudio_clamp(
+			dst[0],
+			-FAUDIO_MAX_VOLUME_LEVEL,
+			FAUDIO_MAX_VOLUME_LEVEL
+		);
+		dst[1] = FAudio_clamp(
+			dst[1],
+			-FAUDIO_MAX_VOLUME_LEVEL,
+			FAUDIO_MAX_VOLUME_LEVEL
+		);
+		dst[2] = FAudio_clamp(
+			dst[2],
+			-FAUDIO_MAX_VOLUME_LEVEL,
+			FAUDIO_MAX_VOLUME_LEVEL
+		);
+		dst[3] = FAudio_clamp(
+			dst[3],
+			-FAUDIO_MAX_VOLUME_LEVEL,
+			FAUDIO_MAX_VOLUME_LEVEL
+		);
+		dst[4] = FAudio_clamp(
+			dst[4],
+			-FAUDIO_MAX_VOLUME_LEVEL,
+			FAUDIO_MAX_VOLUME_LEVEL
+		);
+		dst[5] = FAudio_clamp(
+			dst[5],
+			-FAUDIO_MAX_VOLUME_LEVEL,
+			FAUDIO_MAX_VOLUME_LEVEL
+		);
+		dst[6] = FAudio_clamp(
+			dst[6],
+			-FAUDIO_MAX_VOLUME_LEVEL,
+			FAUDIO_MAX_VOLUME_LEVEL
+		);
+		dst[7] = FAudio_clamp(
+			dst[7],
+			-FAUDIO_MAX_VOLUME_LEVEL,
+			FAUDIO_MAX_VOLUME_LEVEL
+		);
+	}
+}
+
+void FAudio_INTERNAL_Mix_2in_1out_Scalar(
+	uint32_t toMix,
+	uint32_t UNUSED1,
+	uint32_t UNUSED2,
+	float baseVolume,
+	float *restrict src,
+	float *restrict dst,
+	float *restrict channelVolume,
+	float *restrict coefficients
+) {
+	uint32_t i;
+	float totalVolumeL = baseVolume * channelVolume[0] * coefficients[0];
+	float totalVolumeR = baseVolume * channelVolume[1] * coefficients[1];
+	for (i = 0; i < toMix; i += 1, src += 2, dst += 1)
+	{
+		/* Base source data, combined with the coefficients... */
+		dst[0] += (
+			(src[0] * totalVolumeL) +
+			(src[1] * totalVolumeR)
+		);
+
+		/* ... then clamped. */
+		dst[0] = FAudio_clamp(
+			dst[0],
+			-FAUDIO_MAX_VOLUME_LEVEL,
+			FAUDIO_MAX_VOLUME_LEVEL
+		);
+	}
+}
+
+void FAudio_INTERNAL_Mix_2in_2out_Scalar(
+	uint32_t toMix,
+	uint32_t UNUSED1,
+	uint32_t UNUSED2,
+	float baseVolume,
+	float *restrict src,
+	float *restrict dst,
+	float *restrict channelVolume,
+	float *restrict coefficients
+) {
+	uint32_t i;
+	float totalVolumeL = baseVolume * channelVolume[0];
+	float totalVolumeR = baseVolume * channelVolume[1];
+	for (i = 0; i < toMix; i += 1, src += 2, dst += 2)
+	{
+		/* Base source data... */
+		const float left = src[0] * totalVolumeL;
+		const float right = src[1] * totalVolumeR;
+
+		/* ... combined with the coefficients... */
+		dst[0] += (
+			(left * coefficients[0]) +
+			(right * coefficients[1])
+		);
+		dst[1] += (
+			(left * coefficients[2]) +
+			(right * coefficients[3])
+		);
+
+		/* ... then clamped. */
+		dst[0] = FAudio_clamp(
+			dst[0],
+			-FAUDIO_MAX_VOLUME_LEVEL,
+			FAUDIO_MAX_VOLUME_LEVEL
+		);
+		dst[1] = FAudio_clamp(
+			dst[1],
+			-FAUDIO_MAX_VOLUME_LEVEL,
+			FAUDIO_MAX_VOLUME_LEVEL
+		);
+	}
+}
+
+void FAudio_INTERNAL_Mix_2in_6out_Scalar(
+	uint32_t toMix,
+	uint32_t UNUSED1,
+	uint32_t UNUSED2,
+	float baseVolume,
+	float *restrict src,
+	float *restrict dst,
+	float *restrict channelVolume,
+	float *restrict coefficients
+) {
+	uint32_t i;
+	float totalVolumeL = baseVolume * channelVolume[0];
+	float totalVolumeR = baseVolume * channelVolume[1];
+	for (i = 0; i < toMix; i += 1, src += 2, dst += 6)
+	{
+		/* Base source data... */
+		const float left = src[0] * totalVolumeL;
+		const float right = src[1] * totalVolumeR;
+
+		/* ... combined with the coefficients... */
+		dst[0] += (
+			(left * coefficients[0]) +
+			(right * coefficients[1])
+		);
+		dst[1] += (
+			(left * coefficients[2]) +
+			(right * coefficients[3])
+		);
+		dst[2] += (
+			(left * coefficients[4]) +
+			(right * coefficients[5])
+		);
+		dst[3] += (
+			(left * coefficients[6]) +
+			(right * coefficients[7])
+		);
+		dst[4] += (
+			(left * coefficients[8]) +
+			(right * coefficients[9])
+		);
+		dst[5] += (
+			(left * coefficients[10]) +
+			(right * coefficients[11])
+		);
+
+		/* ... then clamped. */
+		dst[0] = FAudio_clamp(
+			dst[0],
+			-FAUDIO_MAX_VOLUME_LEVEL,
+			FAUDIO_MAX_VOLUME_LEVEL
+		);
+		dst[1] = FAudio_clamp(
+			dst[1],
+			-FAUDIO_MAX_VOLUME_LEVEL,
+			FAUDIO_MAX_VOLUME_LEVEL
+		);
+		dst[2] = FAudio_clamp(
+			dst[2],
+			-FAUDIO_MAX_VOLUME_LEVEL,
+			FAUDIO_MAX_VOLUME_LEVEL
+		);
+		dst[3] = FAudio_clamp(
+			dst[3],
+			-FAUDIO_MAX_VOLUME_LEVEL,
+			FAUDIO_MAX_VOLUME_LEVEL
+		);
+		dst[4] = FAudio_clamp(
+			dst[4],
+			-FAUDIO_MAX_VOLUME_LEVEL,
+			FAUDIO_MAX_VOLUME_LEVEL
+		);
+		dst[5] = FAudio_clamp(
+			dst[5],
+			-FAUDIO_MAX_VOLUME_LEVEL,
+			FAUDIO_MAX_VOLUME_LEVEL
+		);
+	}
+}
+
+void FAudio_INTERNAL_Mix_2in_8out_Scalar(
+	uint32_t toMix,
+	uint32_t UNUSED1,
+	uint32_t UNUSED2,
+	float baseVolume,
+	float *restrict src,
+	float *restrict dst,
+	float *restrict channelVolume,
+	float *restrict coefficients
+) {
+	uint32_t i;
+	float totalVolumeL = baseVolume * channelVolume[0];
+	float totalVolumeR = baseVolume * channelVolume[1];
+	for (i = 0; i < toMix; i += 1, src += 2, dst += 8)
+	{
+		/* Base source data... */
+		const float left = src[0] * totalVolumeL;
+		const float right = src[1] * totalVolumeR;
+
+		/* ... combined with the coefficients... */
+		dst[0] += (
+			(left * coefficients[0]) +
+			(right * coefficients[1])
+		);
+		dst[1] += (
+			(left * coefficients[2]) +
+			(right * coefficients[3])
+		);
+		dst[2] += (
+			(left * coefficients[4]) +
+			(right * coefficients[5])
+		);
+		dst[3] += (
+			(left * coefficients[6]) +
+			(right * coefficients[7])
+		);
+		dst[4] += (
+			(left * coefficients[8]) +
+			(right * coefficients[9])
+		);
+		dst[5] += (
+			(left * coefficients[10]) +
+			(right * coefficients[11])
+		);
+		dst[6] += (
+			(left * coefficients[12]) +
+			(right * coefficients[13])
+		);
+		dst[7] += (
+			(left * coefficients[14]) +
+			(right * coefficients[15])
+		);
+
+		/* ... then clamped. */
+		dst[0] = FAudio_clamp(
+			dst[0],
+			-FAUDIO_MAX_VOLUME_LEVEL,
+			FAUDIO_MAX_VOLUME_LEVEL
+		);
+		dst[1] = FAudio_clamp(
+			dst[1],
+			-FAUDIO_MAX_VOLUME_LEVEL,
+			FAUDIO_MAX_VOLUME_LEVEL
+		);
+		dst[2] = FAudio_clamp(
+			dst[2],
+			-FAUDIO_MAX_VOLUME_LEVEL,
+			FAUDIO_MAX_VOLUME_LEVEL
+		);
+		dst[3] = FAudio_clamp(
+			dst[3],
+			-FAUDIO_MAX_VOLUME_LEVEL,
+			FAUDIO_MAX_VOLUME_LEVEL
+		);
+		dst[4] = FAudio_clamp(
+			dst[4],
+			-FAUDIO_MAX_VOLUME_LEVEL,
+			FAUDIO_MAX_VOLUME_LEVEL
+		);
+		dst[5] = FAudio_clamp(
+			dst[5],
+			-FAUDIO_MAX_VOLUME_LEVEL,
+			FAUDIO_MAX_VOLUME_LEVEL
+		);
+		dst[6] = FAudio_clamp(
+			dst[6],
+			-FAUDIO_MAX_VOLUME_LEVEL,
+			FAUDIO_MAX_VOLUME_LEVEL
+		);
+		dst[7] = FAudio_clamp(
+			dst[7],
+			-FAUDIO_MAX_VOLUME_LEVEL,
+			FAUDIO_MAX_VOLUME_LEVEL
+		);
+	}
+}
+
+/* The SIMD mixers do the same math as the scalar mixers above, in the same
+ * order. Whatever is left over after the last full vector is handed to the
+ * scalar version of the same mixer.
+ */
+
+#if HAVE_SSE2_INTRINSICS
+static inline __m128 FAudio_INTERNAL_MixClamp_SSE2(__m128 sample)
+{
+	return _mm_min_ps(
+		_mm_max_ps(sample, _mm_set1_ps(-FAUDIO_MAX_VOLUME_LEVEL)),
+		_mm_set1_ps(FAUDIO_MAX_VOLUME_LEVEL)
+	);
+}
+
+void FAudio_INTERNAL_Mix_Generic_SSE2(
+	uint32_t toMix,
+	uint32_t srcChans,
+	uint32_t dstChans,
+	float baseVolume,
+	float *restrict src,
+	float *restrict dst,
+	float *restrict channelVolume,
+	float *restrict coefficients
+) {
+	uint32_t i, co, ci, vecFrames;
+	float sample;
+	float coefficientsT[8 * 8];
+	__m128 coefficientVec[8];
+	__m128 dstVec, sampleVec;
+
+	if (srcChans > 8 || dstChans > 8 || dstChans == 3)
+	{
+		FAudio_INTERNAL_Mix_Generic_Scalar(
+			toMix,
+			srcChans,
+			dstChans,
+			baseVolume,
+			src,
+			dst,
+			channelVolume,
+			coefficients
+		);
+		return;
+	}
+
+	if (dstChans == 1)
+	{
+		/* Four frames per vector */
+		for (ci = 0; ci < srcChans; ci += 1)
+		{
+			coefficientVec[ci] = _mm_set1_ps(coefficients[ci]);
+		}
+		vecFrames = toMix & ~3;
+		for (i = 0; i < vecFrames; i += 4, src += srcChans * 4, dst += 4)
+		{
+			dstVec = _mm_loadu_ps(dst);
+			for (ci = 0; ci < srcChans; ci += 1)
+			{
+				sampleVec = _mm_setr_ps(
+					src[ci],
+					src[srcChans + ci],
+					src[srcChans * 2 + ci],
+					src[srcChans * 3 + ci]
+				);
+				sampleVec = _mm_mul_ps(
+					_mm_mul_ps(
+						sampleVec,
+						_mm_set1_ps(channelVolume[ci])
+					),
+					_mm_set1_ps(baseVolume)
+				);
+				dstVec = _mm_add_ps(
+					dstVec,
+					_mm_mul_ps(sampleVec, coefficientVec[ci])
+				);
+			}
+			_mm_storeu_ps(dst, FAudio_INTERNAL_MixClamp_SSE2(dstVec));
+		}
+	}
+	else if (dstChans == 2)
+	{
+		/* Two frames per vector */
+		for (ci = 0; ci < srcChans; ci += 1)
+		{
+			coefficientVec[ci] = _mm_setr_ps(
+				coefficients[ci],
+				coefficients[srcChans + ci],
+				coefficients[ci],
+				coefficients[srcChans + ci]
+			);
+		}
+		vecFrames = toMix & ~1;
+		for (i = 0; i < vecFrames; i += 2, src += srcChans * 2, dst += 4)
+		{
+			dstVec = _mm_loadu_ps(dst);
+			for (ci = 0; ci < srcChans; ci += 1)
+			{
+				sampleVec = _mm_setr_ps(
+					src[ci],
+					src[ci],
+					src[srcChans + ci],
+					src[srcChans + ci]
+				);
+				sampleVec = _mm_mul_ps(
+					_mm_mul_ps(
+						sampleVec,
+						_mm_set1_ps(channelVolume[ci])
+					),
+					_mm_set1_ps(baseVolume)
+				);
+				dstVec = _mm_add_ps(
+					dstVec,
+					_mm_mul_ps(sampleVec, coefficientVec[ci])
+				);
+			}
+			_mm_storeu_ps(dst, FAudio_INTERNAL_MixClamp_SSE2(dstVec));
+		}
+	}
+	else
+	{
+		/* Four output channels per vector, the coefficients are
+		 * transposed so that each group can be loaded directly
+		 */
+		for (co = 0; co < dstChans; co += 1)
+		for (ci = 0; ci < srcChans; ci += 1)
+		{
+			coefficientsT[ci * dstChans + co] = coefficients[co * srcChans + ci];
+		}
+		vecFrames = toMix;
+		for (i = 0; i < vecFrames; i += 1, src += srcChans, dst += dstChans)
+		{
+			for (co = 0; co + 4 <= dstChans; co += 4)
+			{
+				dstVec = _mm_loadu_ps(dst + co);
+				for (ci = 0; ci < srcChans; ci += 1)
+				{
+					sample = src[ci] * channelVolume[ci] * baseVolume;
+					dstVec = _mm_add_ps(
+						dstVec,
+						_mm_mul_ps(
+							_mm_set1_ps(sample),
+							_mm_loadu_ps(
+								coefficientsT +
+								ci * dstChans +
+								co
+							)
+						)
+					);
+				}
+				_mm_storeu_ps(
+					dst + co,
+					FAudio_INTERNAL_MixClamp_SSE2(dstVec)
+				);
+			}
+			for (; co < dstChans; co += 1)
+			{
+				for (ci = 0; ci < srcChans; ci += 1)
+				{
+					dst[co] += (
+						src[ci] *
+						channelVolume[ci] *
+						baseVolume *
+						coefficients[co * srcChans + ci]
+					);
+				}
+				dst[co] = FAudio_clamp(
+					dst[co],
+					-FAUDIO_MAX_VOLUME_LEVEL,
+					FAUDIO_MAX_VOLUME_LEVEL
+				);
+			}
+		}
+	}
+
+	FAudio_INTERNAL_Mix_Generic_Scalar(
+		toMix - vecFrames,
+		srcChans,
+		dstChans,
+		baseVolume,
+		src,
+		dst,
+		channelVolume,
+		coefficients
+	);
+}
+
+void FAudio_INTERNAL_Mix_1in_1out_SSE2(
+	uint32_t toMix,
+	uint32_t UNUSED1,
+	uint32_t UNUSED2,
+	float baseVolume,
+	float *restrict src,
+	float *restrict dst,
+	float *restrict channelVolume,
+	float *restrict coefficients
+) {
+	uint32_t i;
+	const uint32_t vecFrames = toMix & ~3;
+	__m128 volumeVec = _mm_set1_ps(
+		baseVolume * channelVolume[0] * coefficients[0]
+	);
+	__m128 dstVec;
+	for (i = 0; i < vecFrames; i += 4)
+	{
+		dstVec = _mm_add_ps(
+			_mm_loadu_ps(dst + i),
+			_mm_mul_ps(_mm_loadu_ps(src + i), volumeVec)
+		);
+		_mm_storeu_ps(dst + i, FAudio_INTERNAL_MixClamp_SSE2(dstVec));
+	}
+	FAudio_INTERNAL_Mix_1in_1out_Scalar(
+		toMix - vecFrames,
+		UNUSED1,
+		UNUSED2,
+		baseVolume,
+		src + vecFrames,
+		dst + vecFrames,
+		channelVolume,
+		coefficients
+	);
+}
+
+void FAudio_INTERNAL_Mix_1in_2out_SSE2(
+	uint32_t toMix,
+	uint32_t UNUSED1,
+	uint32_t UNUSED2,
+	float baseVolume,
+	float *restrict src,
+	float *restrict dst,
+	float *restrict channelVolume,
+	float *restrict coefficients
+) {
+	uint32_t i;
+	const uint32_t vecFrames = toMix & ~3;
+	__m128 volumeVec = _mm_set1_ps(baseVolume * channelVolume[0]);
+	__m128 coefVec = _mm_setr_ps(
+		coefficients[0],
+		coefficients[1],
+		coefficients[0],
+		coefficients[1]
+	);
+	__m128 sampleVec, dstVec;
+	for (i = 0; i < vecFrames; i += 4)
+	{
+		/* Base source data... */
+		sampleVec = _mm_mul_ps(_mm_loadu_ps(src + i), volumeVec);
+
+		/* ... combined with the coefficients, then clamped. */
+		dstVec = _mm_add_ps(
+			_mm_loadu_ps(dst + i * 2),
+			_mm_mul_ps(_mm_unpacklo_ps(sampleVec, sampleVec), coefVec)
+		);
+		_mm_storeu_ps(dst + i * 2, FAudio_INTERNAL_MixClamp_SSE2(dstVec));
+		dstVec = _mm_add_ps(
+			_mm_loadu_ps(dst + i * 2 + 4),
+			_mm_mul_ps(_mm_unpackhi_ps(sampleVec, sampleVec), coefVec)
+		);
+		_mm_storeu_ps(dst + i * 2 + 4, FAudio_INTERNAL_MixClamp_SSE2(dstVec));
+	}
+	FAudio_INTERNAL_Mix_1in_2out_Scalar(
+		toMix - vecFrames,
+		UNUSED1,
+		UNUSED2,
+		baseVolume,
+		src + vecFrames,
+		dst + vecFrames * 2,
+		channelVolume,
+		coefficients
+	);
+}
+
+void FAudio_INTERNAL_Mix_1in_6out_SSE2(
+	uint32_t toMix,
+	uint32_t UNUSED1,
+	uint32_t UNUSED2,
+	float baseVolume,
+	float *restrict src,
+	float *restrict dst,
+	float *restrict channelVolume,
+	float *restrict coefficients
+) {
+	uint32_t i;
+	float *out;
+	const uint32_t vecFrames = toMix & ~3;
+	__m128 volumeVec = _mm_set1_ps(baseVolume * channelVolume[0]);
+	__m128 coef0123 = _mm_loadu_ps(coefficients);
+	__m128 coef4501 = _mm_setr_ps(
+		coefficients[4],
+		coefficients[5],
+		coefficients[0],
+		coefficients[1]
+	);
+	__m128 coef2345 = _mm_loadu_ps(coefficients + 2);
+	__m128 sampleVec, dstVec;
+
+	#define MIX_1IN_6OUT(offset, coef, shuffle) \
+		dstVec = _mm_add_ps( \
+			_mm_loadu_ps(out + offset), \
+			_mm_mul_ps( \
+				_mm_shuffle_ps(sampleVec, sampleVec, shuffle), \
+				coef \
+			) \
+		); \
+		_mm_storeu_ps(out + offset, FAudio_INTERNAL_MixClamp_SSE2(dstVec));
+	for (i = 0; i < vecFrames; i += 4)
+	{
+		sampleVec = _mm_mul_ps(_mm_loadu_ps(src + i), volumeVec);
+		out = dst + i * 6;
+		MIX_1IN_6OUT(0, coef0123, _MM_SHUFFLE(0, 0, 0, 0))
+		MIX_1IN_6OUT(4, coef4501, _MM_SHUFFLE(1, 1, 0, 0))
+		MIX_1IN_6OUT(8, coef2345, _MM_SHUFFLE(1, 1, 1, 1))
+		MIX_1IN_6OUT(12, coef0123, _MM_SHUFFLE(2, 2, 2, 2))
+		MIX_1IN_6OUT(16, coef4501, _MM_SHUFFLE(3, 3, 2, 2))
+		MIX_1IN_6OUT(20, coef2345, _MM_SHUFFLE(3, 3, 3, 3))
+	}
+	#undef MIX_1IN_6OUT
+	FAudio_INTERNAL_Mix_1in_6out_Scalar(
+		toMix - vecFrames,
+		UNUSED1,
+		UNUSED2,
+		baseVolume,
+		src + vecFrames,
+		dst + vecFrames * 6,
+		channelVolume,
+		coefficients
+	);
+}
+
+void FAudio_INTERNAL_Mix_1in_8out_SSE2(
+	uint32_t toMix,
+	uint32_t UNUSED1,
+	uint32_t UNUSED2,
+	float baseVolume,
+	float *restrict src,
+	float *restrict dst,
+	float *restrict channelVolume,
+	float *restrict coefficients
+) {
+	uint32_t i;
+	float totalVolume = baseVolume * channelVolume[0];
+	__m128 coefLo = _mm_loadu_ps(coefficients);
+	__m128 coefHi = _mm_loadu_ps(coefficients + 4);
+	__m128 sampleVec, dstVec;
+	for (i = 0; i < toMix; i += 1, src += 1, dst += 8)
+	{
+		sampleVec = _mm_set1_ps(src[0] * totalVolume);
+		dstVec = _mm_add_ps(
+			_mm_loadu_ps(dst),
+			_mm_mul_ps(sampleVec, coefLo)
+		);
+		_mm_storeu_ps(dst, FAudio_INTERNAL_MixClamp_SSE2(dstVec));
+		dstVec = _mm_add_ps(
+			_mm_loadu_ps(dst + 4),
+			_mm_mul_ps(sampleVec, coefHi)
+		);
+		_mm_storeu_ps(dst + 4, FAudio_INTERNAL_MixClamp_SSE2(dstVec));
+	}
+}
+
+void FAudio_INTERNAL_Mix_2in_1out_SSE2(
+	uint32_t toMix,
+	uint32_t UNUSED1,
+	uint32_t UNUSED2,
+	float baseVolume,
+	float *restrict src,
+	float *restrict dst,
+	float *restrict channelVolume,
+	float *restrict coefficients
+) {
+	uint32_t i;
+	const uint32_t vecFrames = toMix & ~3;
+	__m128 volumeL = _mm_set1_ps(
+		baseVolume * channelVolume[0] * coefficients[0]
+	);
+	__m128 volumeR = _mm_set1_ps(
+		baseVolume * channelVolume[1] * coefficients[1]
+	);
+	__m128 src01, src23, left, right, dstVec;
+	for (i = 0; i < vecFrames; i += 4)
+	{
+		/* Deinterleave four frames... */
+		src01 = _mm_loadu_ps(src + i * 2);
+		src23 = _mm_loadu_ps(src + i * 2 + 4);
+		left = _mm_shuffle_ps(src01, src23, _MM_SHUFFLE(2, 0, 2, 0));
+		right = _mm_shuffle_ps(src01, src23, _MM_SHUFFLE(3, 1, 3, 1));
+
+		/* ... then mix and clamp. */
+		dstVec = _mm_add_ps(
+			_mm_loadu_ps(dst + i),
+			_mm_add_ps(
+				_mm_mul_ps(left, volumeL),
+				_mm_mul_ps(right, volumeR)
+			)
+		);
+		_mm_storeu_ps(dst + i, FAudio_INTERNAL_MixClamp_SSE2(dstVec));
+	}
+	FAudio_INTERNAL_Mix_2in_1out_Scalar(
+		toMix - vecFrames,
+		UNUSED1,
+		UNUSED2,
+		baseVolume,
+		src + vecFrames * 2,
+		dst + vecFrames,
+		channelVolume,
+		coefficients
+	);
+}
+
+void FAudio_INTERNAL_Mix_2in_2out_SSE2(
+	uint32_t toMix,
+	uint32_t UNUSED1,
+	uint32_t UNUSED2,
+	float baseVolume,
+	float *restrict src,
+	float *restrict dst,
+	float *restrict channelVolume,
+	float *restrict coefficients
+) {
+	uint32_t i;
+	const uint32_t vecFrames = toMix & ~1;
+	__m128 volumeVec = _mm_setr_ps(
+		baseVolume * channelVolume[0],
+		baseVolume * channelVolume[1],
+		baseVolume * channelVolume[0],
+		baseVolume * channelVolume[1]
+	);
+	__m128 coefL = _mm_setr_ps(
+		coefficients[0],
+		coefficients[2],
+		coefficients[0],
+		coefficients[2]
+	);
+	__m128 coefR = _mm_setr_ps(
+		coefficients[1],
+		coefficients[3],
+		coefficients[1],
+		coefficients[3]
+	);
+	__m128 sampleVec, dstVec;
+	for (i = 0; i < vecFrames; i += 2)
+	{
+		/* Base source data, two frames at a time... */
+		sampleVec = _mm_mul_ps(_mm_loadu_ps(src + i * 2), volumeVec);
+
+		/* ... combined with the coefficients, then clamped. */
+		dstVec = _mm_add_ps(
+			_mm_loadu_ps(dst + i * 2),
+			_mm_add_ps(
+				_mm_mul_ps(
+					_mm_shuffle_ps(
+						sampleVec,
+						sampleVec,
+						_MM_SHUFFLE(2, 2, 0, 0)
+					),
+					coefL
+				),
+				_mm_mul_ps(
+					_mm_shuffle_ps(
+						sampleVec,
+						sampleVec,
+						_MM_SHUFFLE(3, 3, 1, 1)
+					),
+					coefR
+				)
+			)
+		);
+		_mm_storeu_ps(dst + i * 2, FAudio_INTERNAL_MixClamp_SSE2(dstVec));
+	}
+	FAudio_INTERNAL_Mix_2in_2out_Scalar(
+		toMix - vecFrames,
+		UNUSED1,
+		UNUSED2,
+		baseVolume,
+		src + vecFrames * 2,
+		dst + vecFrames * 2,
+		channelVolume,
+		coefficients
+	);
+}
+
+void FAudio_INTERNAL_Mix_2in_6out_SSE2(
+	uint32_t toMix,
+	uint32_t UNUSED1,
+	uint32_t UNUSED2,
+	float baseVolume,
+	float *restrict src,
+	float *restrict dst,
+	float *restrict channelVolume,
+	float *restrict coefficients
+) {
+	uint32_t i;
+	float *out;
+	const uint32_t vecFrames = toMix & ~1;
+	__m128 volumeVec = _mm_setr_ps(
+		baseVolume * channelVolume[0],
+		baseVolume * channelVolume[1],
+		baseVolume * channelVolume[0],
+		baseVolume * channelVolume[1]
+	);
+	__m128 coefL[3], coefR[3];
+	__m128 sampleVec, dstVec;
+
+	/* Two frames are three vectors: 0-3, 4-5 + 0-1, 2-5 */
+	coefL[0] = _mm_setr_ps(
+		coefficients[0],
+		coefficients[2],
+		coefficients[4],
+		coefficients[6]
+	);
+	coefL[1] = _mm_setr_ps(
+		coefficients[8],
+		coefficients[10],
+		coefficients[0],
+		coefficients[2]
+	);
+	coefL[2] = _mm_setr_ps(
+		coefficients[4],
+		coefficients[6],
+		coefficients[8],
+		coefficients[10]
+	);
+	coefR[0] = _mm_setr_ps(
+		coefficients[1],
+		coefficients[3],
+		coefficients[5],
+		coefficients[7]
+	);
+	coefR[1] = _mm_setr_ps(
+		coefficients[9],
+		coefficients[11],
+		coefficients[1],
+		coefficients[3]
+	);
+	coefR[2] = _mm_setr_ps(
+		coefficients[5],
+		coefficients[7],
+		coefficients[9],
+		coefficients[11]
+	);
+
+	#define MIX_2IN_6OUT(index, shuffleL, shuffleR) \
+		dstVec = _mm_add_ps( \
+			_mm_loadu_ps(out + index * 4), \
+			_mm_add_ps( \
+				_mm_mul_ps( \
+					_mm_shuffle_ps(sampleVec, sampleVec, shuffleL), \
+					coefL[index] \
+				), \
+				_mm_mul_ps( \
+					_mm_shuffle_ps(sampleVec, sampleVec, shuffleR), \
+					coefR[index] \
+				) \
+			) \
+		); \
+		_mm_storeu_ps(out + index * 4, FAudio_INTERNAL_MixClamp_SSE2(dstVec));
+	for (i = 0; i < vecFrames; i += 2)
+	{
+		sampleVec = _mm_mul_ps(_mm_loadu_ps(src + i * 2), volumeVec);
+		out = dst + i * 6;
+		MIX_2IN_6OUT(0, _MM_SHUFFLE(0, 0, 0, 0), _MM_SHUFFLE(1, 1, 1, 1))
+		MIX_2IN_6OUT(1, _MM_SHUFFLE(2, 2, 0, 0), _MM_SHUFFLE(3, 3, 1, 1))
+		MIX_2IN_6OUT(2, _MM_SHUFFLE(2, 2, 2, 2), _MM_SHUFFLE(3, 3, 3, 3))
+	}
+	#undef MIX_2IN_6OUT
+	FAudio_INTERNAL_Mix_2in_6out_Scalar(
+		toMix - vecFrames,
+		UNUSED1,
+		UNUSED2,
+		baseVolume,
+		src + vecFrames * 2,
+		dst + vecFrames * 6,
+		channelVolume,
+		coefficients
+	);
+}
+
+void FAudio_INTERNAL_Mix_2in_8out_SSE2(
+	uint32_t toMix,
+	uint32_t UNUSED1,
+	uint32_t UNUSED2,
+	float baseVolume,
+	float *restrict src,
+	float *restrict dst,
+	float *restrict channelVolume,
+	float *restrict coefficients
+) {
+	uint32_t i;
+	float totalVolumeL = baseVolume * channelVolume[0];
+	float totalVolumeR = baseVolume * channelVolume[1];
+	__m128 coefLLo = _mm_setr_ps(
+		coefficients[0],
+		coefficients[2],
+		coefficients[4],
+		coefficients[6]
+	);
+	__m128 coefLHi = _mm_setr_ps(
+		coefficients[8],
+		coefficients[10],
+		coefficients[12],
+		coefficients[14]
+	);
+	__m128 coefRLo = _mm_setr_ps(
+		coefficients[1],
+		coefficients[3],
+		coefficients[5],
+		coefficients[7]
+	);
+	__m128 coefRHi = _mm_setr_ps(
+		coefficients[9],
+		coefficients[11],
+		coefficients[13],
+		coefficients[15]
+	);
+	__m128 left, right, dstVec;
+	for (i = 0; i < toMix; i += 1, src += 2, dst += 8)
+	{
+		left = _mm_set1_ps(src[0] * totalVolumeL);
+		right = _mm_set1_ps(src[1] * totalVolumeR);
+		dstVec = _mm_add_ps(
+			_mm_loadu_ps(dst),
+			_mm_add_ps(
+				_mm_mul_ps(left, coefLLo),
+				_mm_mul_ps(right, coefRLo)
+			)
+		);
+		_mm_storeu_ps(dst, FAudio_INTERNAL_MixClamp_SSE2(dstVec));
+		dstVec = _mm_add_ps(
+			_mm_loadu_ps(dst + 4),
+			_mm_add_ps(
+				_mm_mul_ps(left, coefLHi),
+				_mm_mul_ps(right, coefRHi)
+			)
+		);
+		_mm_storeu_ps(dst + 4, FAudio_INTERNAL_MixClamp_SSE2(dstVec));
+	}
+}
+#endif /* HAVE_SSE2_INTRINSICS */
+
+#if HAVE_AVX2_INTRINSICS
+FAUDIO_TARGET_AVX2
+static inline __m256 FAudio_INTERNAL_MixClamp_AVX2(__m256 sample)
+{
+	return _mm256_min_ps(
+		_mm256_max_ps(sample, _mm256_set1_ps(-FAUDIO_MAX_VOLUME_LEVEL)),
+		_mm256_set1_ps(FAUDIO_MAX_VOLUME_LEVEL)
+	);
+}
+
+FAUDIO_TARGET_AVX2
+void FAudio_INTERNAL_Mix_1in_1out_AVX2(
+	uint32_t toMix,
+	uint32_t UNUSED1,
+	uint32_t UNUSED2,
+	float baseVolume,
+	float *restrict src,
+	float *restrict dst,
+	float *restrict channelVolume,
+	float *restrict coefficients
+) {
+	uint32_t i;
+	const uint32_t vecFrames = toMix & ~7;
+	__m256 volumeVec = _mm256_set1_ps(
+		baseVolume * channelVolume[0] * coefficients[0]
+	);
+	__m256 dstVec;
+	for (i = 0; i < vecFrames; i += 8)
 	{
-		header = 0;
+		dstVec = _mm256_add_ps(
+			_mm256_loadu_ps(dst + i),
+			_mm256_mul_ps(_mm256_loadu_ps(src + i), volumeVec)
+		);
+		_mm256_storeu_ps(dst + i, FAudio_INTERNAL_MixClamp_AVX2(dstVec));
 	}
-	if (tail == 4)
+	FAudio_INTERNAL_Mix_1in_1out_Scalar(
+		toMix - vecFrames,
+		UNUSED1,
+		UNUSED2,
+		baseVolume,
+		src + vecFrames,
+		dst + vecFrames,
+		channelVolume,
+		coefficients
+	);
+}
+
+FAUDIO_TARGET_AVX2
+void FAudio_INTERNAL_Mix_1in_2out_AVX2(
+	uint32_t toMix,
+	uint32_t UNUSED1,
+	uint32_t UNUSED2,
+	float baseVolume,
+	float *restrict src,
+	float *restrict dst,
+	float *restrict channelVolume,
+	float *restrict coefficients
+) {
+	uint32_t i;
+	const uint32_t vecFrames = toMix & ~3;
+	const __m256i dupIndex = _mm256_setr_epi32(0, 0, 1, 1, 2, 2, 3, 3);
+	__m256 volumeVec = _mm256_set1_ps(baseVolume * channelVolume[0]);
+	__m256 coefVec = _mm256_setr_ps(
+		coefficients[0],
+		coefficients[1],
+		coefficients[0],
+		coefficients[1],
+		coefficients[0],
+		coefficients[1],
+		coefficients[0],
+		coefficients[1]
+	);
+	__m256 sampleVec, dstVec;
+	for (i = 0; i < vecFrames; i += 4)
 	{
-		tail = 0;
+		/* Base source data, each sample copied for both outputs... */
+		sampleVec = _mm256_mul_ps(
+			_mm256_permutevar8x32_ps(
+				_mm256_castps128_ps256(_mm_loadu_ps(src + i)),
+				dupIndex
+			),
+			volumeVec
+		);
+
+		/* ... combined with the coefficients, then clamped. */
+		dstVec = _mm256_add_ps(
+			_mm256_loadu_ps(dst + i * 2),
+			_mm256_mul_ps(sampleVec, coefVec)
+		);
+		_mm256_storeu_ps(dst + i * 2, FAudio_INTERNAL_MixClamp_AVX2(dstVec));
 	}
+	FAudio_INTERNAL_Mix_1in_2out_Scalar(
+		toMix - vecFrames,
+		UNUSED1,
+		UNUSED2,
+		baseVolume,
+		src + vecFrames,
+		dst + vecFrames * 2,
+		channelVolume,
+		coefficients
+	);
+}
 
-	for (i = 0; i < header; i += 1)
+FAUDIO_TARGET_AVX2
+void FAudio_INTERNAL_Mix_1in_8out_AVX2(
+	uint32_t toMix,
+	uint32_t UNUSED1,
+	uint32_t UNUSED2,
+	float baseVolume,
+	float *restrict src,
+	float *restrict dst,
+	float *restrict channelVolume,
+	float *restrict coefficients
+) {
+	uint32_t i;
+	float totalVolume = baseVolume * channelVolume[0];
+	__m256 coefVec = _mm256_loadu_ps(coefficients);
+	__m256 dstVec;
+	for (i = 0; i < toMix; i += 1, src += 1, dst += 8)
 	{
-		output[i] *= volume;
-		output[i] = FAudio_clamp(
-			output[i],
-			-FAUDIO_MAX_VOLUME_LEVEL,
-			FAUDIO_MAX_VOLUME_LEVEL
+		dstVec = _mm256_add_ps(
+			_mm256_loadu_ps(dst),
+			_mm256_mul_ps(_mm256_set1_ps(src[0] * totalVolume), coefVec)
 		);
+		_mm256_storeu_ps(dst, FAudio_INTERNAL_MixClamp_AVX2(dstVec));
 	}
+}
 
-	volumeVec = vdupq_n_f32(volume);
-	minVolumeVec = vdupq_n_f32(-FAUDIO_MAX_VOLUME_LEVEL);
-	maxVolumeVec = vdupq_n_f32(FAUDIO_MAX_VOLUME_LEVEL);
-	for (i = header; i < totalSamples - tail; i += 4)
+FAUDIO_TARGET_AVX2
+void FAudio_INTERNAL_Mix_2in_2out_AVX2(
+	uint32_t toMix,
+	uint32_t UNUSED1,
+	uint32_t UNUSED2,
+	float baseVolume,
+	float *restrict src,
+	float *restrict dst,
+	float *restrict channelVolume,
+	float *restrict coefficients
+) {
+	uint32_t i;
+	const uint32_t vecFrames = toMix & ~3;
+	const float totalVolumeL = baseVolume * channelVolume[0];
+	const float totalVolumeR = baseVolume * channelVolume[1];
+	__m256 volumeVec = _mm256_setr_ps(
+		totalVolumeL,
+		totalVolumeR,
+		totalVolumeL,
+		totalVolumeR,
+		totalVolumeL,
+		totalVolumeR,
+		totalVolumeL,
+		totalVolumeR
+	);
+	__m256 coefL = _mm256_setr_ps(
+		coefficients[0],
+		coefficients[2],
+		coefficients[0],
+		coefficients[2],
+		coefficients[0],
+		coefficients[2],
+		coefficients[0],
+		coefficients[2]
+	);
+	__m256 coefR = _mm256_setr_ps(
+		coefficients[1],
+		coefficients[3],
+		coefficients[1],
+		coefficients[3],
+		coefficients[1],
+		coefficients[3],
+		coefficients[1],
+		coefficients[3]
+	);
+	__m256 sampleVec, dstVec;
+	for (i = 0; i < vecFrames; i += 4)
 	{
-		outVec = vld1q_f32(output + i);
-		outVec = vmulq_f32(outVec, volumeVec);
-		outVec = vmaxq_f32(outVec, minVolumeVec);
-		outVec = vminq_f32(outVec, maxVolumeVec);
-		vst1q_f32(output + i, outVec);
+		/* Base source data, four frames at a time... */
+		sampleVec = _mm256_mul_ps(_mm256_loadu_ps(src + i * 2), volumeVec);
+
+		/* ... combined with the coefficients, then clamped. */
+		dstVec = _mm256_add_ps(
+			_mm256_loadu_ps(dst + i * 2),
+			_mm256_add_ps(
+				_mm256_mul_ps(_mm256_moveldup_ps(sampleVec), coefL),
+				_mm256_mul_ps(_mm256_movehdup_ps(sampleVec), coefR)
+			)
+		);
+		_mm256_storeu_ps(dst + i * 2, FAudio_INTERNAL_MixClamp_AVX2(dstVec));
 	}
+	FAudio_INTERNAL_Mix_2in_2out_Scalar(
+		toMix - vecFrames,
+		UNUSED1,
+		UNUSED2,
+		baseVolume,
+		src + vecFrames * 2,
+		dst + vecFrames * 2,
+		channelVolume,
+		coefficients
+	);
+}
 
-	for (i = totalSamples - tail; i < totalSamples; i += 1)
+FAUDIO_TARGET_AVX2
+void FAudio_INTERNAL_Mix_2in_8out_AVX2(
+	uint32_t toMix,
+	uint32_t UNUSED1,
+	uint32_t UNUSED2,
+	float baseVolume,
+	float *restrict src,
+	float *restrict dst,
+	float *restrict channelVolume,
+	float *restrict coefficients
+) {
+	uint32_t i;
+	float totalVolumeL = baseVolume * channelVolume[0];
+	float totalVolumeR = baseVolume * channelVolume[1];
+	__m256 coefL = _mm256_setr_ps(
+		coefficients[0],
+		coefficients[2],
+		coefficients[4],
+		coefficients[6],
+		coefficients[8],
+		coefficients[10],
+		coefficients[12],
+		coefficients[14]
+	);
+	__m256 coefR = _mm256_setr_ps(
+		coefficients[1],
+		coefficients[3],
+		coefficients[5],
+		coefficients[7],
+		coefficients[9],
+		coefficients[11],
+		coefficients[13],
+		coefficients[15]
+	);
+	__m256 dstVec;
+	for (i = 0; i < toMix; i += 1, src += 2, dst += 8)
 	{
-		output[i] *= volume;
-		output[i] = FAudio_clamp(
-			output[i],
-			-FAUDIO_MAX_VOLUME_LEVEL,
-			FAUDIO_MAX_VOLUME_LEVEL
+		dstVec = _mm256_add_ps(
+			_mm256_loadu_ps(dst),
+			_mm256_add_ps(
+				_mm256_mul_ps(_mm256_set1_ps(src[0] * totalVolumeL), coefL),
+				_mm256_mul_ps(_mm256_set1_ps(src[1] * totalVolumeR), coefR)
+			)
 		);
+		_mm256_storeu_ps(dst, FAudio_INTERNAL_MixClamp_AVX2(dstVec));
 	}
 }
-#endif /* HAVE_NEON_INTRINSICS */
+#endif /* HAVE_AVX2_INTRINSICS */
+
+#if HAVE_AVX512F_INTRINSICS
+FAUDIO_TARGET_AVX512F
+void FAudio_INTERNAL_Mix_1in_1out_AVX512F(
+	uint32_t toMix,
+	uint32_t UNUSED1,
+	uint32_t UNUSED2,
+	float baseVolume,
+	float *restrict src,
+	float *restrict dst,
+	float *restrict channelVolume,
+	float *restrict coefficients
+) {
+	uint32_t i;
+	const uint32_t vecFrames = toMix & ~15;
+	const __m512 minVolumeVec = _mm512_set1_ps(-FAUDIO_MAX_VOLUME_LEVEL);
+	const __m512 maxVolumeVec = _mm512_set1_ps(FAUDIO_MAX_VOLUME_LEVEL);
+	__m512 volumeVec = _mm512_set1_ps(
+		baseVolume * channelVolume[0] * coefficients[0]
+	);
+	__m512 dstVec;
+	for (i = 0; i < vecFrames; i += 16)
+	{
+		dstVec = _mm512_add_ps(
+			_mm512_loadu_ps(dst + i),
+			_mm512_mul_ps(_mm512_loadu_ps(src + i), volumeVec)
+		);
+		dstVec = _mm512_min_ps(
+			_mm512_max_ps(dstVec, minVolumeVec),
+			maxVolumeVec
+		);
+		_mm512_storeu_ps(dst + i, dstVec);
+	}
+	FAudio_INTERNAL_Mix_1in_1out_Scalar(
+		toMix - vecFrames,
+		UNUSED1,
+		UNUSED2,
+		baseVolume,
+		src + vecFrames,
+		dst + vecFrames,
+		channelVolume,
+		coefficients
+	);
+}
+#endif /* HAVE_AVX512F_INTRINSICS */
+
+#if HAVE_NEON_INTRINSICS
+static inline float32x4_t FAudio_INTERNAL_MixClamp_NEON(float32x4_t sample)
+{
+	return vminq_f32(
+		vmaxq_f32(sample, vdupq_n_f32(-FAUDIO_MAX_VOLUME_LEVEL)),
+		vdupq_n_f32(FAUDIO_MAX_VOLUME_LEVEL)
+	);
+}
 
-/* SECTION 4: Mixer Functions */
+static inline float32x4_t FAudio_INTERNAL_MixSet_NEON(
+	float a,
+	float b,
+	float c,
+	float d
+) {
+	const float values[4] = { a, b, c, d };
+	return vld1q_f32(values);
+}
 
-void FAudio_INTERNAL_Mix_Generic_Scalar(
+void FAudio_INTERNAL_Mix_Generic_NEON(
 	uint32_t toMix,
 	uint32_t srcChans,
 	uint32_t dstChans,
@@ -1231,28 +4761,169 @@ void FAudio_INTERNAL_Mix_Generic_Scalar(
 	float *restrict channelVolume,
 	float *restrict coefficients
 ) {
-	uint32_t i, co, ci;
-	for (i = 0; i < toMix; i += 1, src += srcChans, dst += dstChans)
-	for (co = 0; co < dstChans; co += 1)
+	uint32_t i, co, ci, vecFrames;
+	float sample;
+	float coefficientsT[8 * 8];
+	float32x4_t coefficientVec[8];
+	float32x4_t dstVec, sampleVec;
+
+	if (srcChans > 8 || dstChans > 8 || dstChans == 3)
+	{
+		FAudio_INTERNAL_Mix_Generic_Scalar(
+			toMix,
+			srcChans,
+			dstChans,
+			baseVolume,
+			src,
+			dst,
+			channelVolume,
+			coefficients
+		);
+		return;
+	}
+
+	if (dstChans == 1)
 	{
+		/* Four frames per vector */
 		for (ci = 0; ci < srcChans; ci += 1)
 		{
-			dst[co] += (
-				src[ci] *
-				channelVolume[ci] *
-				baseVolume *
-				coefficients[co * srcChans + ci]
+			coefficientVec[ci] = vdupq_n_f32(coefficients[ci]);
+		}
+		vecFrames = toMix & ~3;
+		for (i = 0; i < vecFrames; i += 4, src += srcChans * 4, dst += 4)
+		{
+			dstVec = vld1q_f32(dst);
+			for (ci = 0; ci < srcChans; ci += 1)
+			{
+				sampleVec = FAudio_INTERNAL_MixSet_NEON(
+					src[ci],
+					src[srcChans + ci],
+					src[srcChans * 2 + ci],
+					src[srcChans * 3 + ci]
+				);
+				sampleVec = vmulq_f32(
+					vmulq_f32(
+						sampleVec,
+						vdupq_n_f32(channelVolume[ci])
+					),
+					vdupq_n_f32(baseVolume)
+				);
+				dstVec = vaddq_f32(
+					dstVec,
+					vmulq_f32(sampleVec, coefficientVec[ci])
+				);
+			}
+			vst1q_f32(dst, FAudio_INTERNAL_MixClamp_NEON(dstVec));
+		}
+	}
+	else if (dstChans == 2)
+	{
+		/* Two frames per vector */
+		for (ci = 0; ci < srcChans; ci += 1)
+		{
+			coefficientVec[ci] = FAudio_INTERNAL_MixSet_NEON(
+				coefficients[ci],
+				coefficients[srcChans + ci],
+				coefficients[ci],
+				coefficients[srcChans + ci]
 			);
 		}
-		dst[co] = FAudio_clamp(
-			dst[co],
-			-FAUDIO_MAX_VOLUME_LEVEL,
-			FAUDIO_MAX_VOLUME_LEVEL
-		);
+		vecFrames = toMix & ~1;
+		for (i = 0; i < vecFrames; i += 2, src += srcChans * 2, dst += 4)
+		{
+			dstVec = vld1q_f32(dst);
+			for (ci = 0; ci < srcChans; ci += 1)
+			{
+				sampleVec = FAudio_INTERNAL_MixSet_NEON(
+					src[ci],
+					src[ci],
+					src[srcChans + ci],
+					src[srcChans + ci]
+				);
+				sampleVec = vmulq_f32(
+					vmulq_f32(
+						sampleVec,
+						vdupq_n_f32(channelVolume[ci])
+					),
+					vdupq_n_f32(baseVolume)
+				);
+				dstVec = vaddq_f32(
+					dstVec,
+					vmulq_f32(sampleVec, coefficientVec[ci])
+				);
+			}
+			vst1q_f32(dst, FAudio_INTERNAL_MixClamp_NEON(dstVec));
+		}
+	}
+	else
+	{
+		/* Four output channels per vector, the coefficients are
+		 * transposed so that each group can be loaded directly
+		 */
+		for (co = 0; co < dstChans; co += 1)
+		for (ci = 0; ci < srcChans; ci += 1)
+		{
+			coefficientsT[ci * dstChans + co] = coefficients[co * srcChans + ci];
+		}
+		vecFrames = toMix;
+		for (i = 0; i < vecFrames; i += 1, src += srcChans, dst += dstChans)
+		{
+			for (co = 0; co + 4 <= dstChans; co += 4)
+			{
+				dstVec = vld1q_f32(dst + co);
+				for (ci = 0; ci < srcChans; ci += 1)
+				{
+					sample = src[ci] * channelVolume[ci] * baseVolume;
+					dstVec = vaddq_f32(
+						dstVec,
+						vmulq_f32(
+							vdupq_n_f32(sample),
+							vld1q_f32(
+								coefficientsT +
+								ci * dstChans +
+								co
+							)
+						)
+					);
+				}
+				vst1q_f32(
+					dst + co,
+					FAudio_INTERNAL_MixClamp_NEON(dstVec)
+				);
+			}
+			for (; co < dstChans; co += 1)
+			{
+				for (ci = 0; ci < srcChans; ci += 1)
+				{
+					dst[co] += (
+						src[ci] *
+						channelVolume[ci] *
+						baseVolume *
+						coefficients[co * srcChans + ci]
+					);
+				}
+				dst[co] = FAudio_clamp(
+					dst[co],
+					-FAUDIO_MAX_VOLUME_LEVEL,
+					FAUDIO_MAX_VOLUME_LEVEL
+				);
+			}
+		}
 	}
+
+	FAudio_INTERNAL_Mix_Generic_Scalar(
+		toMix - vecFrames,
+		srcChans,
+		dstChans,
+		baseVolume,
+		src,
+		dst,
+		channelVolume,
+		coefficients
+	);
 }
 
-void FAudio_INTERNAL_Mix_1in_1out_Scalar(
+void FAudio_INTERNAL_Mix_1in_1out_NEON(
 	uint32_t toMix,
 	uint32_t UNUSED1,
 	uint32_t UNUSED2,
@@ -1263,22 +4934,32 @@ void FAudio_INTERNAL_Mix_1in_1out_Scalar(
 	float *restrict coefficients
 ) {
 	uint32_t i;
-	float totalVolume = baseVolume * channelVolume[0] * coefficients[0];
-	for (i = 0; i < toMix; i += 1, src += 1, dst += 1)
+	const uint32_t vecFrames = toMix & ~3;
+	float32x4_t volumeVec = vdupq_n_f32(
+		baseVolume * channelVolume[0] * coefficients[0]
+	);
+	float32x4_t dstVec;
+	for (i = 0; i < vecFrames; i += 4)
 	{
-		/* Base source data, combined with the coefficients... */
-		dst[0] += src[0] * totalVolume;
-
-		/* ... then clamped. */
-		dst[0] = FAudio_clamp(
-			dst[0],
-			-FAUDIO_MAX_VOLUME_LEVEL,
-			FAUDIO_MAX_VOLUME_LEVEL
+		dstVec = vaddq_f32(
+			vld1q_f32(dst + i),
+			vmulq_f32(vld1q_f32(src + i), volumeVec)
 		);
+		vst1q_f32(dst + i, FAudio_INTERNAL_MixClamp_NEON(dstVec));
 	}
+	FAudio_INTERNAL_Mix_1in_1out_Scalar(
+		toMix - vecFrames,
+		UNUSED1,
+		UNUSED2,
+		baseVolume,
+		src + vecFrames,
+		dst + vecFrames,
+		channelVolume,
+		coefficients
+	);
 }
 
-void FAudio_INTERNAL_Mix_1in_2out_Scalar(
+void FAudio_INTERNAL_Mix_1in_2out_NEON(
 	uint32_t toMix,
 	uint32_t UNUSED1,
 	uint32_t UNUSED2,
@@ -1289,31 +4970,45 @@ void FAudio_INTERNAL_Mix_1in_2out_Scalar(
 	float *restrict coefficients
 ) {
 	uint32_t i;
-	float totalVolume = baseVolume * channelVolume[0];
-	for (i = 0; i < toMix; i += 1, src += 1, dst += 2)
+	const uint32_t vecFrames = toMix & ~3;
+	float32x4_t volumeVec = vdupq_n_f32(baseVolume * channelVolume[0]);
+	float32x4_t coefVec = FAudio_INTERNAL_MixSet_NEON(
+		coefficients[0],
+		coefficients[1],
+		coefficients[0],
+		coefficients[1]
+	);
+	float32x4_t sampleVec, dstVec;
+	for (i = 0; i < vecFrames; i += 4)
 	{
 		/* Base source data... */
-		const float sample = src[0] * totalVolume;
-
-		/* ... combined with the coefficients... */
-		dst[0] += sample * coefficients[0];
-		dst[1] += sample * coefficients[1];
+		sampleVec = vmulq_f32(vld1q_f32(src + i), volumeVec);
 
-		/* ... then clamped. */
-		dst[0] = FAudio_clamp(
-			dst[0],
-			-FAUDIO_MAX_VOLUME_LEVEL,
-			FAUDIO_MAX_VOLUME_LEVEL
+		/* ... combined with the coefficients, then clamped. */
+		dstVec = vaddq_f32(
+			vld1q_f32(dst + i * 2),
+			vmulq_f32(vzip1q_f32(sampleVec, sampleVec), coefVec)
 		);
-		dst[1] = FAudio_clamp(
-			dst[1],
-			-FAUDIO_MAX_VOLUME_LEVEL,
-			FAUDIO_MAX_VOLUME_LEVEL
+		vst1q_f32(dst + i * 2, FAudio_INTERNAL_MixClamp_NEON(dstVec));
+		dstVec = vaddq_f32(
+			vld1q_f32(dst + i * 2 + 4),
+			vmulq_f32(vzip2q_f32(sampleVec, sampleVec), coefVec)
 		);
+		vst1q_f32(dst + i * 2 + 4, FAudio_INTERNAL_MixClamp_NEON(dstVec));
 	}
+	FAudio_INTERNAL_Mix_1in_2out_Scalar(
+		toMix - vecFrames,
+		UNUSED1,
+		UNUSED2,
+		baseVolume,
+		src + vecFrames,
+		dst + vecFrames * 2,
+		channelVolume,
+		coefficients
+	);
 }
 
-void FAudio_INTERNAL_Mix_1in_6out_Scalar(
+void FAudio_INTERNAL_Mix_1in_6out_NEON(
 	uint32_t toMix,
 	uint32_t UNUSED1,
 	uint32_t UNUSED2,
@@ -1324,55 +5019,81 @@ void FAudio_INTERNAL_Mix_1in_6out_Scalar(
 	float *restrict coefficients
 ) {
 	uint32_t i;
-	float totalVolume = baseVolume * channelVolume[0];
-	for (i = 0; i < toMix; i += 1, src += 1, dst += 6)
+	float *out;
+	const uint32_t vecFrames = toMix & ~3;
+	float32x4_t volumeVec = vdupq_n_f32(baseVolume * channelVolume[0]);
+	float32x4_t coef0123 = vld1q_f32(coefficients);
+	float32x4_t coef4501 = FAudio_INTERNAL_MixSet_NEON(
+		coefficients[4],
+		coefficients[5],
+		coefficients[0],
+		coefficients[1]
+	);
+	float32x4_t coef2345 = vld1q_f32(coefficients + 2);
+	float32x4_t sampleVec, dstVec;
+
+	#define MIX_1IN_6OUT(offset, coef, samples) \
+		dstVec = vaddq_f32( \
+			vld1q_f32(out + offset), \
+			vmulq_f32(samples, coef) \
+		); \
+		vst1q_f32(out + offset, FAudio_INTERNAL_MixClamp_NEON(dstVec));
+	for (i = 0; i < vecFrames; i += 4)
 	{
-		/* Base source data... */
-		const float sample = src[0] * totalVolume;
-
-		/* ... combined with the coefficients... */
-		dst[0] += sample * coefficients[0];
-		dst[1] += sample * coefficients[1];
-		dst[2] += sample * coefficients[2];
-		dst[3] += sample * coefficients[3];
-		dst[4] += sample * coefficients[4];
-		dst[5] += sample * coefficients[5];
+		sampleVec = vmulq_f32(vld1q_f32(src + i), volumeVec);
+		out = dst + i * 6;
+		MIX_1IN_6OUT(0, coef0123, vdupq_laneq_f32(sampleVec, 0))
+		MIX_1IN_6OUT(4, coef4501, vzip1q_f32(sampleVec, sampleVec))
+		MIX_1IN_6OUT(8, coef2345, vdupq_laneq_f32(sampleVec, 1))
+		MIX_1IN_6OUT(12, coef0123, vdupq_laneq_f32(sampleVec, 2))
+		MIX_1IN_6OUT(16, coef4501, vzip2q_f32(sampleVec, sampleVec))
+		MIX_1IN_6OUT(20, coef2345, vdupq_laneq_f32(sampleVec, 3))
+	}
+	#undef MIX_1IN_6OUT
+	FAudio_INTERNAL_Mix_1in_6out_Scalar(
+		toMix - vecFrames,
+		UNUSED1,
+		UNUSED2,
+		baseVolume,
+		src + vecFrames,
+		dst + vecFrames * 6,
+		channelVolume,
+		coefficients
+	);
+}
 
-		/* ... then clamped. */
-		dst[0] = FAudio_clamp(
-			dst[0],
-			-FAUDIO_MAX_VOLUME_LEVEL,
-			FAUDIO_MAX_VOLUME_LEVEL
-		);
-		dst[1] = FAudio_clamp(
-			dst[1],
-			-FAUDIO_MAX_VOLUME_LEVEL,
-			FAUDIO_MAX_VOLUME_LEVEL
-		);
-		dst[2] = FAudio_clamp(
-			dst[2],
-			-FAUDIO_MAX_VOLUME_LEVEL,
-			FAUDIO_MAX_VOLUME_LEVEL
-		);
-		dst[3] = FAudio_clamp(
-			dst[3],
-			-FAUDIO_MAX_VOLUME_LEVEL,
-			FAUDIO_MAX_VOLUME_LEVEL
-		);
-		dst[4] = FAudio_clamp(
-			dst[4],
-			-FAUDIO_MAX_VOLUME_LEVEL,
-			FAUDIO_MAX_VOLUME_LEVEL
+void FAudio_INTERNAL_Mix_1in_8out_NEON(
+	uint32_t toMix,
+	uint32_t UNUSED1,
+	uint32_t UNUSED2,
+	float baseVolume,
+	float *restrict src,
+	float *restrict dst,
+	float *restrict channelVolume,
+	float *restrict coefficients
+) {
+	uint32_t i;
+	float totalVolume = baseVolume * channelVolume[0];
+	float32x4_t coefLo = vld1q_f32(coefficients);
+	float32x4_t coefHi = vld1q_f32(coefficients + 4);
+	float32x4_t sampleVec, dstVec;
+	for (i = 0; i < toMix; i += 1, src += 1, dst += 8)
+	{
+		sampleVec = vdupq_n_f32(src[0] * totalVolume);
+		dstVec = vaddq_f32(
+			vld1q_f32(dst),
+			vmulq_f32(sampleVec, coefLo)
 		);
-		dst[5] = FAudio_clamp(
-			dst[5],
-			-FAUDIO_MAX_VOLUME_LEVEL,
-			FAUDIO_MAX_VOLUME_LEVEL
+		vst1q_f32(dst, FAudio_INTERNAL_MixClamp_NEON(dstVec));
+		dstVec = vaddq_f32(
+			vld1q_f32(dst + 4),
+			vmulq_f32(sampleVec, coefHi)
 		);
+		vst1q_f32(dst + 4, FAudio_INTERNAL_MixClamp_NEON(dstVec));
 	}
 }
 
-void FAudio_INTERNAL_Mix_1in_8out_Scalar(
+void FAudio_INTERNAL_Mix_2in_1out_NEON(
 	uint32_t toMix,
 	uint32_t UNUSED1,
 	uint32_t UNUSED2,
@@ -1383,67 +5104,43 @@ void FAudio_INTERNAL_Mix_1in_8out_Scalar(
 	float *restrict coefficients
 ) {
 	uint32_t i;
-	float totalVolume = baseVolume * channelVolume[0];
-	for (i = 0; i < toMix; i += 1, src += 1, dst += 8)
+	const uint32_t vecFrames = toMix & ~3;
+	float32x4_t volumeL = vdupq_n_f32(
+		baseVolume * channelVolume[0] * coefficients[0]
+	);
+	float32x4_t volumeR = vdupq_n_f32(
+		baseVolume * channelVolume[1] * coefficients[1]
+	);
+	float32x4x2_t samples;
+	float32x4_t dstVec;
+	for (i = 0; i < vecFrames; i += 4)
 	{
-		/* Base source data... */
-		const float sample = src[0] * totalVolume;
-
-		/* ... combined with the coefficients... */
-		dst[0] += sample * coefficients[0];
-		dst[1] += sample * coefficients[1];
-		dst[2] += sample * coefficients[2];
-		dst[3] += sample * coefficients[3];
-		dst[4] += sample * coefficients[4];
-		dst[5] += sample * coefficients[5];
-		dst[6] += sample * coefficients[6];
-		dst[7] += sample * coefficients[7];
-
-		/* ... then clamped. */
-		dst[0] = FAudio_clamp(
-			dst[0],
-			-FAUDIO_MAX_VOLUME_LEVEL,
-			FAUDIO_MAX_VOLUME_LEVEL
-		);
-		dst[1] = FAudio_clamp(
-			dst[1],
-			-FAUDIO_MAX_VOLUME_LEVEL,
-			FAUDIO_MAX_VOLUME_LEVEL
-		);
-		dst[2] = FAudio_clamp(
-			dst[2],
-			-FAUDIO_MAX_VOLUME_LEVEL,
-			FAUDIO_MAX_VOLUME_LEVEL
-		);
-		dst[3] = FAudio_clamp(
-			dst[3],
-			-FAUDIO_MAX_VOLUME_LEVEL,
-			FAUDIO_MAX_VOLUME_LEVEL
-		);
-		dst[4] = FAudio_clamp(
-			dst[4],
-			-FAUDIO_MAX_VOLUME_LEVEL,
-			FAUDIO_MAX_VOLUME_LEVEL
-		);
-		dst[5] = FAudio_clamp(
-			dst[5],
-			-FAUDIO_MAX_VOLUME_LEVEL,
-			FAUDIO_MAX_VOLUME_LEVEL
-		);
-		dst[6] = FAudio_clamp(
-			dst[6],
-			-FAUDIO_MAX_VOLUME_LEVEL,
-			FAUDIO_MAX_VOLUME_LEVEL
-		);
-		dst[7] = FAudio_clamp(
-			dst[7],
-			-FAUDIO_MAX_VOLUME_LEVEL,
-			FAUDIO_MAX_VOLUME_LEVEL
+		/* Deinterleave four frames... */
+		samples = vld2q_f32(src + i * 2);
+
+		/* ... then mix and clamp. */
+		dstVec = vaddq_f32(
+			vld1q_f32(dst + i),
+			vaddq_f32(
+				vmulq_f32(samples.val[0], volumeL),
+				vmulq_f32(samples.val[1], volumeR)
+			)
 		);
+		vst1q_f32(dst + i, FAudio_INTERNAL_MixClamp_NEON(dstVec));
 	}
+	FAudio_INTERNAL_Mix_2in_1out_Scalar(
+		toMix - vecFrames,
+		UNUSED1,
+		UNUSED2,
+		baseVolume,
+		src + vecFrames * 2,
+		dst + vecFrames,
+		channelVolume,
+		coefficients
+	);
 }
 
-void FAudio_INTERNAL_Mix_2in_1out_Scalar(
+void FAudio_INTERNAL_Mix_2in_2out_NEON(
 	uint32_t toMix,
 	uint32_t UNUSED1,
 	uint32_t UNUSED2,
@@ -1454,26 +5151,156 @@ void FAudio_INTERNAL_Mix_2in_1out_Scalar(
 	float *restrict coefficients
 ) {
 	uint32_t i;
-	float totalVolumeL = baseVolume * channelVolume[0] * coefficients[0];
-	float totalVolumeR = baseVolume * channelVolume[1] * coefficients[1];
-	for (i = 0; i < toMix; i += 1, src += 2, dst += 1)
+	const uint32_t vecFrames = toMix & ~1;
+	float32x4_t volumeVec = FAudio_INTERNAL_MixSet_NEON(
+		baseVolume * channelVolume[0],
+		baseVolume * channelVolume[1],
+		baseVolume * channelVolume[0],
+		baseVolume * channelVolume[1]
+	);
+	float32x4_t coefL = FAudio_INTERNAL_MixSet_NEON(
+		coefficients[0],
+		coefficients[2],
+		coefficients[0],
+		coefficients[2]
+	);
+	float32x4_t coefR = FAudio_INTERNAL_MixSet_NEON(
+		coefficients[1],
+		coefficients[3],
+		coefficients[1],
+		coefficients[3]
+	);
+	float32x4_t sampleVec, dstVec;
+	for (i = 0; i < vecFrames; i += 2)
 	{
-		/* Base source data, combined with the coefficients... */
-		dst[0] += (
-			(src[0] * totalVolumeL) +
-			(src[1] * totalVolumeR)
+		/* Base source data, two frames at a time... */
+		sampleVec = vmulq_f32(vld1q_f32(src + i * 2), volumeVec);
+
+		/* ... combined with the coefficients, then clamped. */
+		dstVec = vaddq_f32(
+			vld1q_f32(dst + i * 2),
+			vaddq_f32(
+				vmulq_f32(vtrn1q_f32(sampleVec, sampleVec), coefL),
+				vmulq_f32(vtrn2q_f32(sampleVec, sampleVec), coefR)
+			)
 		);
+		vst1q_f32(dst + i * 2, FAudio_INTERNAL_MixClamp_NEON(dstVec));
+	}
+	FAudio_INTERNAL_Mix_2in_2out_Scalar(
+		toMix - vecFrames,
+		UNUSED1,
+		UNUSED2,
+		baseVolume,
+		src + vecFrames * 2,
+		dst + vecFrames * 2,
+		channelVolume,
+		coefficients
+	);
+}
 
-		/* ... then clamped. */
-		dst[0] = FAudio_clamp(
-			dst[0],
-			-FAUDIO_MAX_VOLUME_LEVEL,
-			FAUDIO_MAX_VOLUME_LEVEL
-		);
+void FAudio_INTERNAL_Mix_2in_6out_NEON(
+	uint32_t toMix,
+	uint32_t UNUSED1,
+	uint32_t UNUSED2,
+	float baseVolume,
+	float *restrict src,
+	float *restrict dst,
+	float *restrict channelVolume,
+	float *restrict coefficients
+) {
+	uint32_t i;
+	float *out;
+	const uint32_t vecFrames = toMix & ~1;
+	float32x4_t volumeVec = FAudio_INTERNAL_MixSet_NEON(
+		baseVolume * channelVolume[0],
+		baseVolume * channelVolume[1],
+		baseVolume * channelVolume[0],
+		baseVolume * channelVolume[1]
+	);
+	float32x4_t coefL[3], coefR[3];
+	float32x4_t sampleVec, dstVec;
+
+	/* Two frames are three vectors: 0-3, 4-5 + 0-1, 2-5 */
+	coefL[0] = FAudio_INTERNAL_MixSet_NEON(
+		coefficients[0],
+		coefficients[2],
+		coefficients[4],
+		coefficients[6]
+	);
+	coefL[1] = FAudio_INTERNAL_MixSet_NEON(
+		coefficients[8],
+		coefficients[10],
+		coefficients[0],
+		coefficients[2]
+	);
+	coefL[2] = FAudio_INTERNAL_MixSet_NEON(
+		coefficients[4],
+		coefficients[6],
+		coefficients[8],
+		coefficients[10]
+	);
+	coefR[0] = FAudio_INTERNAL_MixSet_NEON(
+		coefficients[1],
+		coefficients[3],
+		coefficients[5],
+		coefficients[7]
+	);
+	coefR[1] = FAudio_INTERNAL_MixSet_NEON(
+		coefficients[9],
+		coefficients[11],
+		coefficients[1],
+		coefficients[3]
+	);
+	coefR[2] = FAudio_INTERNAL_MixSet_NEON(
+		coefficients[5],
+		coefficients[7],
+		coefficients[9],
+		coefficients[11]
+	);
+
+	#define MIX_2IN_6OUT(index, left, right) \
+		dstVec = vaddq_f32( \
+			vld1q_f32(out + index * 4), \
+			vaddq_f32( \
+				vmulq_f32(left, coefL[index]), \
+				vmulq_f32(right, coefR[index]) \
+			) \
+		); \
+		vst1q_f32(out + index * 4, FAudio_INTERNAL_MixClamp_NEON(dstVec));
+	for (i = 0; i < vecFrames; i += 2)
+	{
+		sampleVec = vmulq_f32(vld1q_f32(src + i * 2), volumeVec);
+		out = dst + i * 6;
+		MIX_2IN_6OUT(
+			0,
+			vdupq_laneq_f32(sampleVec, 0),
+			vdupq_laneq_f32(sampleVec, 1)
+		)
+		MIX_2IN_6OUT(
+			1,
+			vtrn1q_f32(sampleVec, sampleVec),
+			vtrn2q_f32(sampleVec, sampleVec)
+		)
+		MIX_2IN_6OUT(
+			2,
+			vdupq_laneq_f32(sampleVec, 2),
+			vdupq_laneq_f32(sampleVec, 3)
+		)
 	}
+	#undef MIX_2IN_6OUT
+	FAudio_INTERNAL_Mix_2in_6out_Scalar(
+		toMix - vecFrames,
+		UNUSED1,
+		UNUSED2,
+		baseVolume,
+		src + vecFrames * 2,
+		dst + vecFrames * 6,
+		channelVolume,
+		coefficients
+	);
 }
 
-void FAudio_INTERNAL_Mix_2in_2out_Scalar(
+void FAudio_INTERNAL_Mix_2in_8out_NEON(
 	uint32_t toMix,
 	uint32_t UNUSED1,
 	uint32_t UNUSED2,
@@ -1486,213 +5313,705 @@ void FAudio_INTERNAL_Mix_2in_2out_Scalar(
 	uint32_t i;
 	float totalVolumeL = baseVolume * channelVolume[0];
 	float totalVolumeR = baseVolume * channelVolume[1];
-	for (i = 0; i < toMix; i += 1, src += 2, dst += 2)
+	float32x4_t coefLLo = FAudio_INTERNAL_MixSet_NEON(
+		coefficients[0],
+		coefficients[2],
+		coefficients[4],
+		coefficients[6]
+	);
+	float32x4_t coefLHi = FAudio_INTERNAL_MixSet_NEON(
+		coefficients[8],
+		coefficients[10],
+		coefficients[12],
+		coefficients[14]
+	);
+	float32x4_t coefRLo = FAudio_INTERNAL_MixSet_NEON(
+		coefficients[1],
+		coefficients[3],
+		coefficients[5],
+		coefficients[7]
+	);
+	float32x4_t coefRHi = FAudio_INTERNAL_MixSet_NEON(
+		coefficients[9],
+		coefficients[11],
+		coefficients[13],
+		coefficients[15]
+	);
+	float32x4_t left, right, dstVec;
+	for (i = 0; i < toMix; i += 1, src += 2, dst += 8)
 	{
-		/* Base source data... */
-		const float left = src[0] * totalVolumeL;
-		const float right = src[1] * totalVolumeR;
+		left = vdupq_n_f32(src[0] * totalVolumeL);
+		right = vdupq_n_f32(src[1] * totalVolumeR);
+		dstVec = vaddq_f32(
+			vld1q_f32(dst),
+			vaddq_f32(
+				vmulq_f32(left, coefLLo),
+				vmulq_f32(right, coefRLo)
+			)
+		);
+		vst1q_f32(dst, FAudio_INTERNAL_MixClamp_NEON(dstVec));
+		dstVec = vaddq_f32(
+			vld1q_f32(dst + 4),
+			vaddq_f32(
+				vmulq_f32(left, coefLHi),
+				vmulq_f32(right, coefRHi)
+			)
+		);
+		vst1q_f32(dst + 4, FAudio_INTERNAL_MixClamp_NEON(dstVec));
+	}
+}
+#endif /* HAVE_NEON_INTRINSICS */
 
-		/* ... combined with the coefficients... */
-		dst[0] += (
-			(left * coefficients[0]) +
-			(right * coefficients[1])
+/* SECTION 6: State-Variable Filters */
+
+/* Apply a digital state-variable filter to the voice.
+ * The difference equations of the filter are:
+ *
+ * Yl(n) = F Yb(n - 1) + Yl(n - 1)
+ * Yh(n) = x(n) - Yl(n) - OneOverQ Yb(n - 1)
+ * Yb(n) = F Yh(n) + Yb(n - 1)
+ * Yn(n) = Yl(n) + Yh(n)
+ *
+ * Please note that FAudioFilterParameters.Frequency is defined as:
+ *
+ * (2 * sin(pi * (desired filter cutoff frequency) / sampleRate))
+ *
+ * - @JohanSmet
+ */
+
+void FAudio_INTERNAL_FilterVoice_Scalar(
+	const FAudioFilterParameters *filter,
+	FAudioFilterState *filterState,
+	float *restrict samples,
+	uint32_t numSamples,
+	uint16_t numChannels
+) {
+	uint32_t j, ci;
+	for (j = 0; j < numSamples; j += 1)
+	for (ci = 0; ci < numChannels; ci += 1)
+	{
+		filterState[ci][FAudioLowPassFilter] = filterState[ci][FAudioLowPassFilter] + (filter->Frequency * filterState[ci][FAudioBandPassFilter]);
+		filterState[ci][FAudioHighPassFilter] = samples[j * numChannels + ci] - filterState[ci][FAudioLowPassFilter] - (filter->OneOverQ * filterState[ci][FAudioBandPassFilter]);
+		filterState[ci][FAudioBandPassFilter] = (filter->Frequency * filterState[ci][FAudioHighPassFilter]) + filterState[ci][FAudioBandPassFilter];
+		filterState[ci][FAudioNotchFilter] = filterState[ci][FAudioHighPassFilter] + filterState[ci][FAudioLowPassFilter];
+		samples[j * numChannels + ci] = filterState[ci][filter->Type];
+	}
+}
+
+void FAudio_INTERNAL_FilterMonoBatch_Scalar(
+	const FAudioFilterParameters **filters,
+	FAudioFilterState **filterStates,
+	float **samples,
+	const uint32_t *numSamples,
+	uint32_t count
+) {
+	uint32_t i;
+	for (i = 0; i < count; i += 1)
+	{
+		FAudio_INTERNAL_FilterVoice_Scalar(
+			filters[i],
+			filterStates[i],
+			samples[i],
+			numSamples[i],
+			1
 		);
-		dst[1] += (
-			(left * coefficients[2]) +
-			(right * coefficients[3])
+	}
+}
+
+/* The SIMD filters run one channel (or for FilterMonoBatch, one voice) per
+ * lane. The filter state is transposed into vectors on the way in and back
+ * out again when done, so the FAudioFilterState layout does not change.
+ */
+
+#if HAVE_SSE2_INTRINSICS
+static inline __m128 FAudio_INTERNAL_FilterStep_SSE2(
+	__m128 sample,
+	__m128 frequency,
+	__m128 oneOverQ,
+	const __m128 *select,
+	__m128 *state
+) {
+	state[FAudioLowPassFilter] = _mm_add_ps(
+		state[FAudioLowPassFilter],
+		_mm_mul_ps(frequency, state[FAudioBandPassFilter])
+	);
+	state[FAudioHighPassFilter] = _mm_sub_ps(
+		_mm_sub_ps(sample, state[FAudioLowPassFilter]),
+		_mm_mul_ps(oneOverQ, state[FAudioBandPassFilter])
+	);
+	state[FAudioBandPassFilter] = _mm_add_ps(
+		_mm_mul_ps(frequency, state[FAudioHighPassFilter]),
+		state[FAudioBandPassFilter]
+	);
+	state[FAudioNotchFilter] = _mm_add_ps(
+		state[FAudioHighPassFilter],
+		state[FAudioLowPassFilter]
+	);
+
+	/* Each lane may want a different output, select is all-ones where
+	 * that lane's filter->Type matches.
+	 */
+	return _mm_or_ps(
+		_mm_or_ps(
+			_mm_and_ps(state[FAudioLowPassFilter], select[FAudioLowPassFilter]),
+			_mm_and_ps(state[FAudioBandPassFilter], select[FAudioBandPassFilter])
+		),
+		_mm_or_ps(
+			_mm_and_ps(state[FAudioHighPassFilter], select[FAudioHighPassFilter]),
+			_mm_and_ps(state[FAudioNotchFilter], select[FAudioNotchFilter])
+		)
+	);
+}
+
+void FAudio_INTERNAL_FilterVoice_SSE2(
+	const FAudioFilterParameters *filter,
+	FAudioFilterState *filterState,
+	float *restrict samples,
+	uint32_t numSamples,
+	uint16_t numChannels
+) {
+	uint32_t j, ci, k;
+	float lanes[4][8];
+	__m128 frequency, oneOverQ, select[4], lo[4], hi[4];
+
+	/* Stereo, quad, 5.1 and 7.1 fill one or two vectors well enough */
+	if (	numChannels != 2 &&
+		numChannels != 4 &&
+		numChannels != 6 &&
+		numChannels != 8	)
+	{
+		FAudio_INTERNAL_FilterVoice_Scalar(
+			filter,
+			filterState,
+			samples,
+			numSamples,
+			numChannels
+		);
+		return;
+	}
+
+	FAudio_zero(lanes, sizeof(lanes));
+	for (ci = 0; ci < numChannels; ci += 1)
+	for (k = 0; k < 4; k += 1)
+	{
+		lanes[k][ci] = filterState[ci][k];
+	}
+	for (k = 0; k < 4; k += 1)
+	{
+		lo[k] = _mm_loadu_ps(lanes[k]);
+		hi[k] = _mm_loadu_ps(lanes[k] + 4);
+		select[k] = _mm_castsi128_ps(
+			_mm_set1_epi32(filter->Type == k ? -1 : 0)
+		);
+	}
+	frequency = _mm_set1_ps(filter->Frequency);
+	oneOverQ = _mm_set1_ps(filter->OneOverQ);
+
+	switch (numChannels)
+	{
+	case 2:
+		for (j = 0; j < numSamples; j += 1, samples += 2)
+		{
+			_mm_storel_pi((__m64*) samples, FAudio_INTERNAL_FilterStep_SSE2(
+				_mm_loadl_pi(_mm_setzero_ps(), (const __m64*) samples),
+				frequency, oneOverQ, select, lo
+			));
+		}
+		break;
+	case 4:
+		for (j = 0; j < numSamples; j += 1, samples += 4)
+		{
+			_mm_storeu_ps(samples, FAudio_INTERNAL_FilterStep_SSE2(
+				_mm_loadu_ps(samples),
+				frequency, oneOverQ, select, lo
+			));
+		}
+		break;
+	case 6:
+		for (j = 0; j < numSamples; j += 1, samples += 6)
+		{
+			_mm_storeu_ps(samples, FAudio_INTERNAL_FilterStep_SSE2(
+				_mm_loadu_ps(samples),
+				frequency, oneOverQ, select, lo
+			));
+			_mm_storel_pi((__m64*) (samples + 4), FAudio_INTERNAL_FilterStep_SSE2(
+				_mm_loadl_pi(_mm_setzero_ps(), (const __m64*) (samples + 4)),
+				frequency, oneOverQ, select, hi
+			));
+		}
+		break;
+	case 8:
+		for (j = 0; j < numSamples; j += 1, samples += 8)
+		{
+			_mm_storeu_ps(samples, FAudio_INTERNAL_FilterStep_SSE2(
+				_mm_loadu_ps(samples),
+				frequency, oneOverQ, select, lo
+			));
+			_mm_storeu_ps(samples + 4, FAudio_INTERNAL_FilterStep_SSE2(
+				_mm_loadu_ps(samples + 4),
+				frequency, oneOverQ, select, hi
+			));
+		}
+		break;
+	}
+
+	for (k = 0; k < 4; k += 1)
+	{
+		_mm_storeu_ps(lanes[k], lo[k]);
+		_mm_storeu_ps(lanes[k] + 4, hi[k]);
+	}
+	for (ci = 0; ci < numChannels; ci += 1)
+	for (k = 0; k < 4; k += 1)
+	{
+		filterState[ci][k] = lanes[k][ci];
+	}
+}
+
+void FAudio_INTERNAL_FilterMonoBatch_SSE2(
+	const FAudioFilterParameters **filters,
+	FAudioFilterState **filterStates,
+	float **samples,
+	const uint32_t *numSamples,
+	uint32_t count
+) {
+	uint32_t i, j, k, common;
+	float *src[4];
+	float lanes[4][4];
+	__m128 frequency, oneOverQ, select[4], state[4];
+	__m128 t0, t1, t2, t3;
+
+	FAudio_assert(count <= 4);
+	if (count < 2)
+	{
+		FAudio_INTERNAL_FilterMonoBatch_Scalar(
+			filters,
+			filterStates,
+			samples,
+			numSamples,
+			count
+		);
+		return;
+	}
+
+	/* Unused lanes read the first voice's samples and are never stored */
+	FAudio_zero(lanes, sizeof(lanes));
+	common = numSamples[0];
+	for (i = 0; i < 4; i += 1)
+	{
+		src[i] = samples[(i < count) ? i : 0];
+	}
+	for (i = 0; i < count; i += 1)
+	{
+		common = FAudio_min(common, numSamples[i]);
+		for (k = 0; k < 4; k += 1)
+		{
+			lanes[k][i] = filterStates[i][0][k];
+		}
+	}
+	for (k = 0; k < 4; k += 1)
+	{
+		state[k] = _mm_loadu_ps(lanes[k]);
+		select[k] = _mm_castsi128_ps(_mm_setr_epi32(
+			(count > 0 && filters[0]->Type == k) ? -1 : 0,
+			(count > 1 && filters[1]->Type == k) ? -1 : 0,
+			(count > 2 && filters[2]->Type == k) ? -1 : 0,
+			(count > 3 && filters[3]->Type == k) ? -1 : 0
+		));
+	}
+	frequency = _mm_setr_ps(
+		filters[0]->Frequency,
+		filters[1]->Frequency,
+		(count > 2) ? filters[2]->Frequency : 0.0f,
+		(count > 3) ? filters[3]->Frequency : 0.0f
+	);
+	oneOverQ = _mm_setr_ps(
+		filters[0]->OneOverQ,
+		filters[1]->OneOverQ,
+		(count > 2) ? filters[2]->OneOverQ : 0.0f,
+		(count > 3) ? filters[3]->OneOverQ : 0.0f
+	);
+
+	/* Four samples from each voice, transposed so each vector is one
+	 * point in time across all of the voices...
+	 */
+	for (j = 0; j + 4 <= common; j += 4)
+	{
+		t0 = _mm_loadu_ps(src[0] + j);
+		t1 = _mm_loadu_ps(src[1] + j);
+		t2 = _mm_loadu_ps(src[2] + j);
+		t3 = _mm_loadu_ps(src[3] + j);
+		_MM_TRANSPOSE4_PS(t0, t1, t2, t3);
+		t0 = FAudio_INTERNAL_FilterStep_SSE2(t0, frequency, oneOverQ, select, state);
+		t1 = FAudio_INTERNAL_FilterStep_SSE2(t1, frequency, oneOverQ, select, state);
+		t2 = FAudio_INTERNAL_FilterStep_SSE2(t2, frequency, oneOverQ, select, state);
+		t3 = FAudio_INTERNAL_FilterStep_SSE2(t3, frequency, oneOverQ, select, state);
+		_MM_TRANSPOSE4_PS(t0, t1, t2, t3);
+		_mm_storeu_ps(src[0] + j, t0);
+		_mm_storeu_ps(src[1] + j, t1);
+		if (count > 2)
+		{
+			_mm_storeu_ps(src[2] + j, t2);
+		}
+		if (count > 3)
+		{
+			_mm_storeu_ps(src[3] + j, t3);
+		}
+	}
+
+	/* ... then one at a time for what's left over. */
+	for (; j < common; j += 1)
+	{
+		t0 = FAudio_INTERNAL_FilterStep_SSE2(
+			_mm_setr_ps(src[0][j], src[1][j], src[2][j], src[3][j]),
+			frequency, oneOverQ, select, state
+		);
+		_mm_storeu_ps(lanes[0], t0);
+		for (i = 0; i < count; i += 1)
+		{
+			src[i][j] = lanes[0][i];
+		}
+	}
+
+	for (k = 0; k < 4; k += 1)
+	{
+		_mm_storeu_ps(lanes[k], state[k]);
+	}
+	for (i = 0; i < count; i += 1)
+	{
+		for (k = 0; k < 4; k += 1)
+		{
+			filterStates[i][0][k] = lanes[k][i];
+		}
+
+		/* Voices that got more samples than the others finish alone */
+		FAudio_INTERNAL_FilterVoice_Scalar(
+			filters[i],
+			filterStates[i],
+			src[i] + common,
+			numSamples[i] - common,
+			1
+		);
+	}
+}
+#endif /* HAVE_SSE2_INTRINSICS */
+
+#if HAVE_NEON_INTRINSICS
+static inline float32x4_t FAudio_INTERNAL_FilterStep_NEON(
+	float32x4_t sample,
+	float32x4_t frequency,
+	float32x4_t oneOverQ,
+	const uint32x4_t *select,
+	float32x4_t *state
+) {
+	state[FAudioLowPassFilter] = vaddq_f32(
+		state[FAudioLowPassFilter],
+		vmulq_f32(frequency, state[FAudioBandPassFilter])
+	);
+	state[FAudioHighPassFilter] = vsubq_f32(
+		vsubq_f32(sample, state[FAudioLowPassFilter]),
+		vmulq_f32(oneOverQ, state[FAudioBandPassFilter])
+	);
+	state[FAudioBandPassFilter] = vaddq_f32(
+		vmulq_f32(frequency, state[FAudioHighPassFilter]),
+		state[FAudioBandPassFilter]
+	);
+	state[FAudioNotchFilter] = vaddq_f32(
+		state[FAudioHighPassFilter],
+		state[FAudioLowPassFilter]
+	);
+
+	/* Each lane may want a different output, select is all-ones where
+	 * that lane's filter->Type matches.
+	 */
+	return vreinterpretq_f32_u32(vorrq_u32(
+		vorrq_u32(
+			vandq_u32(vreinterpretq_u32_f32(state[FAudioLowPassFilter]), select[FAudioLowPassFilter]),
+			vandq_u32(vreinterpretq_u32_f32(state[FAudioBandPassFilter]), select[FAudioBandPassFilter])
+		),
+		vorrq_u32(
+			vandq_u32(vreinterpretq_u32_f32(state[FAudioHighPassFilter]), select[FAudioHighPassFilter]),
+			vandq_u32(vreinterpretq_u32_f32(state[FAudioNotchFilter]), select[FAudioNotchFilter])
+		)
+	));
+}
+
+void FAudio_INTERNAL_FilterVoice_NEON(
+	const FAudioFilterParameters *filter,
+	FAudioFilterState *filterState,
+	float *restrict samples,
+	uint32_t numSamples,
+	uint16_t numChannels
+) {
+	uint32_t j, ci, k;
+	float lanes[4][8];
+	float32x4_t frequency, oneOverQ, lo[4], hi[4];
+	uint32x4_t select[4];
+
+	/* Stereo, quad, 5.1 and 7.1 fill one or two vectors well enough */
+	if (	numChannels != 2 &&
+		numChannels != 4 &&
+		numChannels != 6 &&
+		numChannels != 8	)
+	{
+		FAudio_INTERNAL_FilterVoice_Scalar(
+			filter,
+			filterState,
+			samples,
+			numSamples,
+			numChannels
 		);
+		return;
+	}
+
+	FAudio_zero(lanes, sizeof(lanes));
+	for (ci = 0; ci < numChannels; ci += 1)
+	for (k = 0; k < 4; k += 1)
+	{
+		lanes[k][ci] = filterState[ci][k];
+	}
+	for (k = 0; k < 4; k += 1)
+	{
+		lo[k] = vld1q_f32(lanes[k]);
+		hi[k] = vld1q_f32(lanes[k] + 4);
+		select[k] = vdupq_n_u32(filter->Type == k ? 0xFFFFFFFF : 0);
+	}
+	frequency = vdupq_n_f32(filter->Frequency);
+	oneOverQ = vdupq_n_f32(filter->OneOverQ);
+
+	switch (numChannels)
+	{
+	case 2:
+		for (j = 0; j < numSamples; j += 1, samples += 2)
+		{
+			vst1_f32(samples, vget_low_f32(FAudio_INTERNAL_FilterStep_NEON(
+				vcombine_f32(vld1_f32(samples), vdup_n_f32(0.0f)),
+				frequency, oneOverQ, select, lo
+			)));
+		}
+		break;
+	case 4:
+		for (j = 0; j < numSamples; j += 1, samples += 4)
+		{
+			vst1q_f32(samples, FAudio_INTERNAL_FilterStep_NEON(
+				vld1q_f32(samples),
+				frequency, oneOverQ, select, lo
+			));
+		}
+		break;
+	case 6:
+		for (j = 0; j < numSamples; j += 1, samples += 6)
+		{
+			vst1q_f32(samples, FAudio_INTERNAL_FilterStep_NEON(
+				vld1q_f32(samples),
+				frequency, oneOverQ, select, lo
+			));
+			vst1_f32(samples + 4, vget_low_f32(FAudio_INTERNAL_FilterStep_NEON(
+				vcombine_f32(vld1_f32(samples + 4), vdup_n_f32(0.0f)),
+				frequency, oneOverQ, select, hi
+			)));
+		}
+		break;
+	case 8:
+		for (j = 0; j < numSamples; j += 1, samples += 8)
+		{
+			vst1q_f32(samples, FAudio_INTERNAL_FilterStep_NEON(
+				vld1q_f32(samples),
+				frequency, oneOverQ, select, lo
+			));
+			vst1q_f32(samples + 4, FAudio_INTERNAL_FilterStep_NEON(
+				vld1q_f32(samples + 4),
+				frequency, oneOverQ, select, hi
+			));
+		}
+		break;
+	}
 
-		/* ... then clamped. */
-		dst[0] = FAudio_clamp(
-			dst[0],
-			-FAUDIO_MAX_VOLUME_LEVEL,
-			FAUDIO_MAX_VOLUME_LEVEL
-		);
-		dst[1] = FAudio_clamp(
-			dst[1],
-			-FAUDIO_MAX_VOLUME_LEVEL,
-			FAUDIO_MAX_VOLUME_LEVEL
-		);
+	for (k = 0; k < 4; k += 1)
+	{
+		vst1q_f32(lanes[k], lo[k]);
+		vst1q_f32(lanes[k] + 4, hi[k]);
+	}
+	for (ci = 0; ci < numChannels; ci += 1)
+	for (k = 0; k < 4; k += 1)
+	{
+		filterState[ci][k] = lanes[k][ci];
 	}
 }
 
-void FAudio_INTERNAL_Mix_2in_6out_Scalar(
-	uint32_t toMix,
-	uint32_t UNUSED1,
-	uint32_t UNUSED2,
-	float baseVolume,
-	float *restrict src,
-	float *restrict dst,
-	float *restrict channelVolume,
-	float *restrict coefficients
+void FAudio_INTERNAL_FilterMonoBatch_NEON(
+	const FAudioFilterParameters **filters,
+	FAudioFilterState **filterStates,
+	float **samples,
+	const uint32_t *numSamples,
+	uint32_t count
 ) {
-	uint32_t i;
-	float totalVolumeL = baseVolume * channelVolume[0];
-	float totalVolumeR = baseVolume * channelVolume[1];
-	for (i = 0; i < toMix; i += 1, src += 2, dst += 6)
+	uint32_t i, j, k, common;
+	float *src[4];
+	float lanes[4][4];
+	uint32_t masks[4];
+	float32x4_t frequency, oneOverQ, state[4];
+	float32x4_t t0, t1, t2, t3;
+	float32x4x2_t t01, t23;
+	uint32x4_t select[4];
+
+	FAudio_assert(count <= 4);
+	if (count < 2)
 	{
-		/* Base source data... */
-		const float left = src[0] * totalVolumeL;
-		const float right = src[1] * totalVolumeR;
-
-		/* ... combined with the coefficients... */
-		dst[0] += (
-			(left * coefficients[0]) +
-			(right * coefficients[1])
-		);
-		dst[1] += (
-			(left * coefficients[2]) +
-			(right * coefficients[3])
-		);
-		dst[2] += (
-			(left * coefficients[4]) +
-			(right * coefficients[5])
-		);
-		dst[3] += (
-			(left * coefficients[6]) +
-			(right * coefficients[7])
-		);
-		dst[4] += (
-			(left * coefficients[8]) +
-			(right * coefficients[9])
-		);
-		dst[5] += (
-			(left * coefficients[10]) +
-			(right * coefficients[11])
+		FAudio_INTERNAL_FilterMonoBatch_Scalar(
+			filters,
+			filterStates,
+			samples,
+			numSamples,
+			count
 		);
+		return;
+	}
 
-		/* ... then clamped. */
-		dst[0] = FAudio_clamp(
-			dst[0],
-			-FAUDIO_MAX_VOLUME_LEVEL,
-			FAUDIO_MAX_VOLUME_LEVEL
-		);
-		dst[1] = FAudio_clamp(
-			dst[1],
-			-FAUDIO_MAX_VOLUME_LEVEL,
-			FAUDIO_MAX_VOLUME_LEVEL
-		);
-		dst[2] = FAudio_clamp(
-			dst[2],
-			-FAUDIO_MAX_VOLUME_LEVEL,
-			FAUDIO_MAX_VOLUME_LEVEL
-		);
-		dst[3] = FAudio_clamp(
-			dst[3],
-			-FAUDIO_MAX_VOLUME_LEVEL,
-			FAUDIO_MAX_VOLUME_LEVEL
-		);
-		dst[4] = FAudio_clamp(
-			dst[4],
-			-FAUDIO_MAX_VOLUME_LEVEL,
-			FAUDIO_MAX_VOLUME_LEVEL
-		);
-		dst[5] = FAudio_clamp(
-			dst[5],
-			-FAUDIO_MAX_VOLUME_LEVEL,
-			FAUDIO_MAX_VOLUME_LEVEL
-		);
+	/* Unused lanes read the first voice's samples and are never stored */
+	FAudio_zero(lanes, sizeof(lanes));
+	common = numSamples[0];
+	for (i = 0; i < 4; i += 1)
+	{
+		src[i] = samples[(i < count) ? i : 0];
 	}
-}
+	for (i = 0; i < count; i += 1)
+	{
+		common = FAudio_min(common, numSamples[i]);
+		for (k = 0; k < 4; k += 1)
+		{
+			lanes[k][i] = filterStates[i][0][k];
+		}
+	}
+	for (k = 0; k < 4; k += 1)
+	{
+		state[k] = vld1q_f32(lanes[k]);
+		for (i = 0; i < 4; i += 1)
+		{
+			masks[i] = (i < count && filters[i]->Type == k) ? 0xFFFFFFFF : 0;
+		}
+		select[k] = vld1q_u32(masks);
+	}
+	for (i = 0; i < 4; i += 1)
+	{
+		lanes[0][i] = (i < count) ? filters[i]->Frequency : 0.0f;
+		lanes[1][i] = (i < count) ? filters[i]->OneOverQ : 0.0f;
+	}
+	frequency = vld1q_f32(lanes[0]);
+	oneOverQ = vld1q_f32(lanes[1]);
 
-void FAudio_INTERNAL_Mix_2in_8out_Scalar(
-	uint32_t toMix,
-	uint32_t UNUSED1,
-	uint32_t UNUSED2,
-	float baseVolume,
-	float *restrict src,
-	float *restrict dst,
-	float *restrict channelVolume,
-	float *restrict coefficients
-) {
-	uint32_t i;
-	float totalVolumeL = baseVolume * channelVolume[0];
-	float totalVolumeR = baseVolume * channelVolume[1];
-	for (i = 0; i < toMix; i += 1, src += 2, dst += 8)
+	/* Four samples from each voice, transposed so each vector is one
+	 * point in time across all of the voices...
+	 */
+#define TRANSPOSE4_NEON(r0, r1, r2, r3) \
+	t01 = vtrnq_f32(r0, r1); \
+	t23 = vtrnq_f32(r2, r3); \
+	r0 = vcombine_f32(vget_low_f32(t01.val[0]), vget_low_f32(t23.val[0])); \
+	r1 = vcombine_f32(vget_low_f32(t01.val[1]), vget_low_f32(t23.val[1])); \
+	r2 = vcombine_f32(vget_high_f32(t01.val[0]), vget_high_f32(t23.val[0])); \
+	r3 = vcombine_f32(vget_high_f32(t01.val[1]), vget_high_f32(t23.val[1]));
+	for (j = 0; j + 4 <= common; j += 4)
 	{
-		/* Base source data... */
-		const float left = src[0] * totalVolumeL;
-		const float right = src[1] * totalVolumeR;
+		t0 = vld1q_f32(src[0] + j);
+		t1 = vld1q_f32(src[1] + j);
+		t2 = vld1q_f32(src[2] + j);
+		t3 = vld1q_f32(src[3] + j);
+		TRANSPOSE4_NEON(t0, t1, t2, t3)
+		t0 = FAudio_INTERNAL_FilterStep_NEON(t0, frequency, oneOverQ, select, state);
+		t1 = FAudio_INTERNAL_FilterStep_NEON(t1, frequency, oneOverQ, select, state);
+		t2 = FAudio_INTERNAL_FilterStep_NEON(t2, frequency, oneOverQ, select, state);
+		t3 = FAudio_INTERNAL_FilterStep_NEON(t3, frequency, oneOverQ, select, state);
+		TRANSPOSE4_NEON(t0, t1, t2, t3)
+		vst1q_f32(src[0] + j, t0);
+		vst1q_f32(src[1] + j, t1);
+		if (count > 2)
+		{
+			vst1q_f32(src[2] + j, t2);
+		}
+		if (count > 3)
+		{
+			vst1q_f32(src[3] + j, t3);
+		}
+	}
+#undef TRANSPOSE4_NEON
 
-		/* ... combined with the coefficients... */
-		dst[0] += (
-			(left * coefficients[0]) +
-			(right * coefficients[1])
-		);
-		dst[1] += (
-			(left * coefficients[2]) +
-			(right * coefficients[3])
-		);
-		dst[2] += (
-			(left * coefficients[4]) +
-			(right * coefficients[5])
-		);
-		dst[3] += (
-			(left * coefficients[6]) +
-			(right * coefficients[7])
-		);
-		dst[4] += (
-			(left * coefficients[8]) +
-			(right * coefficients[9])
-		);
-		dst[5] += (
-			(left * coefficients[10]) +
-			(right * coefficients[11])
-		);
-		dst[6] += (
-			(left * coefficients[12]) +
-			(right * coefficients[13])
-		);
-		dst[7] += (
-			(left * coefficients[14]) +
-			(right * coefficients[15])
+	/* ... then one at a time for what's left over. */
+	for (; j < common; j += 1)
+	{
+		for (i = 0; i < 4; i += 1)
+		{
+			lanes[0][i] = src[i][j];
+		}
+		t0 = FAudio_INTERNAL_FilterStep_NEON(
+			vld1q_f32(lanes[0]),
+			frequency, oneOverQ, select, state
 		);
+		vst1q_f32(lanes[0], t0);
+		for (i = 0; i < count; i += 1)
+		{
+			src[i][j] = lanes[0][i];
+		}
+	}
 
-		/* ... then clamped. */
-		dst[0] = FAudio_clamp(
-			dst[0],
-			-FAUDIO_MAX_VOLUME_LEVEL,
-			FAUDIO_MAX_VOLUME_LEVEL
-		);
-		dst[1] = FAudio_clamp(
-			dst[1],
-			-FAUDIO_MAX_VOLUME_LEVEL,
-			FAUDIO_MAX_VOLUME_LEVEL
-		);
-		dst[2] = FAudio_clamp(
-			dst[2],
-			-FAUDIO_MAX_VOLUME_LEVEL,
-			FAUDIO_MAX_VOLUME_LEVEL
-		);
-		dst[3] = FAudio_clamp(
-			dst[3],
-			-FAUDIO_MAX_VOLUME_LEVEL,
-			FAUDIO_MAX_VOLUME_LEVEL
-		);
-		dst[4] = FAudio_clamp(
-			dst[4],
-			-FAUDIO_MAX_VOLUME_LEVEL,
-			FAUDIO_MAX_VOLUME_LEVEL
-		);
-		dst[5] = FAudio_clamp(
-			dst[5],
-			-FAUDIO_MAX_VOLUME_LEVEL,
-			FAUDIO_MAX_VOLUME_LEVEL
-		);
-		dst[6] = FAudio_clamp(
-			dst[6],
-			-FAUDIO_MAX_VOLUME_LEVEL,
-			FAUDIO_MAX_VOLUME_LEVEL
-		);
-		dst[7] = FAudio_clamp(
-			dst[7],
-			-FAUDIO_MAX_VOLUME_LEVEL,
-			FAUDIO_MAX_VOLUME_LEVEL
+	for (k = 0; k < 4; k += 1)
+	{
+		vst1q_f32(lanes[k], state[k]);
+	}
+	for (i = 0; i < count; i += 1)
+	{
+		for (k = 0; k < 4; k += 1)
+		{
+			filterStates[i][0][k] = lanes[k][i];
+		}
+
+		/* Voices that got more samples than the others finish alone */
+		FAudio_INTERNAL_FilterVoice_Scalar(
+			filters[i],
+			filterStates[i],
+			src[i] + common,
+			numSamples[i] - common,
+			1
 		);
 	}
 }
+#endif /* HAVE_NEON_INTRINSICS */
+
+/* SECTION 7: InitSIMDFunctions. Assigns based on SSE2/AVX2/AVX-512F/NEON support. */
 
-/* SECTION 5: InitSIMDFunctions. Assigns based on SSE2/NEON support. */
+/* The name of every function pointer below, without the FAudio_INTERNAL_
+ * prefix. tests/simd.c fails for any kernel listed here that it doesn't
+ * check against the scalar version, so add new pointers to this list too.
+ */
+const char *FAudio_INTERNAL_SIMDKernels[] =
+{
+	"Convert_U8_To_F32",
+	"Convert_S16_To_F32",
+	"Convert_S24_To_F32",
+	"Convert_F32_To_S16",
+	"ResampleMono",
+	"ResampleStereo",
+	"Resample4Channel",
+	"Resample6Channel",
+	"Resample8Channel",
+	"ResampleUpMono",
+	"ResampleUpStereo",
+	"ResampleDownMono",
+	"ResampleDownStereo",
+	"ResampleSincMono",
+	"ResampleSincStereo",
+	"Amplify",
+	"Mix_Generic",
+	"Mix_1in_1out",
+	"Mix_1in_2out",
+	"Mix_1in_6out",
+	"Mix_1in_8out",
+	"Mix_2in_1out",
+	"Mix_2in_2out",
+	"Mix_2in_6out",
+	"Mix_2in_8out",
+	"FilterVoice",
+	"FilterMonoBatch",
+	NULL
+};
 
 void (*FAudio_INTERNAL_Convert_U8_To_F32)(
 	const uint8_t *restrict src,
@@ -1704,9 +6023,28 @@ void (*FAudio_INTERNAL_Convert_S16_To_F32)(
 	float *restrict dst,
 	uint32_t len
 );
+void (*FAudio_INTERNAL_Convert_S24_To_F32)(
+	const uint8_t *restrict src,
+	float *restrict dst,
+	uint32_t len
+);
+void (*FAudio_INTERNAL_Convert_F32_To_S16)(
+	const float *restrict src,
+	int16_t *restrict dst,
+	uint32_t len
+);
 
 FAudioResampleCallback FAudio_INTERNAL_ResampleMono;
 FAudioResampleCallback FAudio_INTERNAL_ResampleStereo;
+FAudioResampleCallback FAudio_INTERNAL_Resample4Channel;
+FAudioResampleCallback FAudio_INTERNAL_Resample6Channel;
+FAudioResampleCallback FAudio_INTERNAL_Resample8Channel;
+FAudioResampleCallback FAudio_INTERNAL_ResampleUpMono;
+FAudioResampleCallback FAudio_INTERNAL_ResampleUpStereo;
+FAudioResampleCallback FAudio_INTERNAL_ResampleDownMono;
+FAudioResampleCallback FAudio_INTERNAL_ResampleDownStereo;
+FAudioSincResampleCallback FAudio_INTERNAL_ResampleSincMono;
+FAudioSincResampleCallback FAudio_INTERNAL_ResampleSincStereo;
 
 void (*FAudio_INTERNAL_Amplify)(
 	float *output,
@@ -1714,16 +6052,162 @@ void (*FAudio_INTERNAL_Amplify)(
 	float volume
 );
 
-void FAudio_INTERNAL_InitSIMDFunctions(uint8_t hasSSE2, uint8_t hasNEON)
-{
+FAudioMixCallback FAudio_INTERNAL_Mix_Generic;
+FAudioMixCallback FAudio_INTERNAL_Mix_1in_1out;
+FAudioMixCallback FAudio_INTERNAL_Mix_1in_2out;
+FAudioMixCallback FAudio_INTERNAL_Mix_1in_6out;
+FAudioMixCallback FAudio_INTERNAL_Mix_1in_8out;
+FAudioMixCallback FAudio_INTERNAL_Mix_2in_1out;
+FAudioMixCallback FAudio_INTERNAL_Mix_2in_2out;
+FAudioMixCallback FAudio_INTERNAL_Mix_2in_6out;
+FAudioMixCallback FAudio_INTERNAL_Mix_2in_8out;
+
+void (*FAudio_INTERNAL_FilterVoice)(
+	const FAudioFilterParameters *filter,
+	FAudioFilterState *filterState,
+	float *restrict samples,
+	uint32_t numSamples,
+	uint16_t numChannels
+);
+void (*FAudio_INTERNAL_FilterMonoBatch)(
+	const FAudioFilterParameters **filters,
+	FAudioFilterState **filterStates,
+	float **samples,
+	const uint32_t *numSamples,
+	uint32_t count
+);
+
+void FAudio_INTERNAL_InitSIMDFunctions(
+	uint8_t hasSSE2,
+	uint8_t hasAVX2,
+	uint8_t hasAVX512F,
+	uint8_t hasNEON
+) {
+	/* FAUDIO_SIMD caps the tier, so that the tiers can be compared on the
+	 * same machine. Asking for something the CPU lacks does not enable it.
+	 */
+	const char *tier = FAudio_getenv("FAUDIO_SIMD");
+	if (tier != NULL)
+	{
+		if (FAudio_strcmp(tier, "scalar") == 0)
+		{
+			hasSSE2 = 0;
+			hasAVX2 = 0;
+			hasAVX512F = 0;
+			hasNEON = 0;
+		}
+		else if (FAudio_strcmp(tier, "sse2") == 0)
+		{
+			hasAVX2 = 0;
+			hasAVX512F = 0;
+		}
+		else if (FAudio_strcmp(tier, "avx2") == 0)
+		{
+			hasAVX512F = 0;
+		}
+	}
+#if !HAVE_SSE2_INTRINSICS
+	(void) hasSSE2;
+#endif
+#if !HAVE_SSE2_INTRINSICS || !HAVE_AVX2_INTRINSICS
+	(void) hasAVX2;
+#endif
+#if !HAVE_SSE2_INTRINSICS || !HAVE_AVX512F_INTRINSICS
+	(void) hasAVX512F;
+#endif
+#if !HAVE_NEON_INTRINSICS
+	(void) hasNEON;
+#endif
+
+	/* Each tier starts from the one below it, replacing only the functions
+	 * that it has its own version of.
+	 */
+	FAudio_INTERNAL_Convert_U8_To_F32 = FAudio_INTERNAL_Convert_U8_To_F32_Scalar;
+	FAudio_INTERNAL_Convert_S16_To_F32 = FAudio_INTERNAL_Convert_S16_To_F32_Scalar;
+	FAudio_INTERNAL_Convert_S24_To_F32 = FAudio_INTERNAL_Convert_S24_To_F32_Scalar;
+	FAudio_INTERNAL_Convert_F32_To_S16 = FAudio_INTERNAL_Convert_F32_To_S16_Scalar;
+	FAudio_INTERNAL_ResampleMono = FAudio_INTERNAL_ResampleMono_Scalar;
+	FAudio_INTERNAL_ResampleStereo = FAudio_INTERNAL_ResampleStereo_Scalar;
+	FAudio_INTERNAL_Resample4Channel = FAudio_INTERNAL_ResampleGeneric;
+	FAudio_INTERNAL_Resample6Channel = FAudio_INTERNAL_ResampleGeneric;
+	FAudio_INTERNAL_Resample8Channel = FAudio_INTERNAL_ResampleGeneric;
+	/* Without SIMD the ratio loops only pay off for the generic resamplers */
+	FAudio_INTERNAL_ResampleUpMono = FAudio_INTERNAL_ResampleMono_Scalar;
+	FAudio_INTERNAL_ResampleUpStereo = FAudio_INTERNAL_ResampleStereo_Scalar;
+	FAudio_INTERNAL_ResampleDownMono = FAudio_INTERNAL_ResampleMono_Scalar;
+	FAudio_INTERNAL_ResampleDownStereo = FAudio_INTERNAL_ResampleStereo_Scalar;
+	FAudio_INTERNAL_ResampleSincMono = FAudio_INTERNAL_ResampleSincMono_Scalar;
+	FAudio_INTERNAL_ResampleSincStereo = FAudio_INTERNAL_ResampleSincStereo_Scalar;
+	FAudio_INTERNAL_Amplify = FAudio_INTERNAL_Amplify_Scalar;
+	FAudio_INTERNAL_Mix_Generic = FAudio_INTERNAL_Mix_Generic_Scalar;
+	FAudio_INTERNAL_Mix_1in_1out = FAudio_INTERNAL_Mix_1in_1out_Scalar;
+	FAudio_INTERNAL_Mix_1in_2out = FAudio_INTERNAL_Mix_1in_2out_Scalar;
+	FAudio_INTERNAL_Mix_1in_6out = FAudio_INTERNAL_Mix_1in_6out_Scalar;
+	FAudio_INTERNAL_Mix_1in_8out = FAudio_INTERNAL_Mix_1in_8out_Scalar;
+	FAudio_INTERNAL_Mix_2in_1out = FAudio_INTERNAL_Mix_2in_1out_Scalar;
+	FAudio_INTERNAL_Mix_2in_2out = FAudio_INTERNAL_Mix_2in_2out_Scalar;
+	FAudio_INTERNAL_Mix_2in_6out = FAudio_INTERNAL_Mix_2in_6out_Scalar;
+	FAudio_INTERNAL_Mix_2in_8out = FAudio_INTERNAL_Mix_2in_8out_Scalar;
+	FAudio_INTERNAL_FilterVoice = FAudio_INTERNAL_FilterVoice_Scalar;
+	FAudio_INTERNAL_FilterMonoBatch = FAudio_INTERNAL_FilterMonoBatch_Scalar;
 #if HAVE_SSE2_INTRINSICS
 	if (hasSSE2)
 	{
 		FAudio_INTERNAL_Convert_U8_To_F32 = FAudio_INTERNAL_Convert_U8_To_F32_SSE2;
 		FAudio_INTERNAL_Convert_S16_To_F32 = FAudio_INTERNAL_Convert_S16_To_F32_SSE2;
+		FAudio_INTERNAL_Convert_S24_To_F32 = FAudio_INTERNAL_Convert_S24_To_F32_SSE2;
+		FAudio_INTERNAL_Convert_F32_To_S16 = FAudio_INTERNAL_Convert_F32_To_S16_SSE2;
 		FAudio_INTERNAL_ResampleMono = FAudio_INTERNAL_ResampleMono_SSE2;
 		FAudio_INTERNAL_ResampleStereo = FAudio_INTERNAL_ResampleStereo_SSE2;
+		FAudio_INTERNAL_Resample4Channel = FAudio_INTERNAL_Resample4Channel_SSE2;
+		FAudio_INTERNAL_Resample6Channel = FAudio_INTERNAL_Resample6Channel_SSE2;
+		FAudio_INTERNAL_Resample8Channel = FAudio_INTERNAL_Resample8Channel_SSE2;
+		FAudio_INTERNAL_ResampleUpMono = FAudio_INTERNAL_ResampleUpMono_SSE2;
+		FAudio_INTERNAL_ResampleUpStereo = FAudio_INTERNAL_ResampleUpStereo_SSE2;
+		FAudio_INTERNAL_ResampleDownMono = FAudio_INTERNAL_ResampleDownMono_SSE2;
+		FAudio_INTERNAL_ResampleDownStereo = FAudio_INTERNAL_ResampleDownStereo_SSE2;
+		FAudio_INTERNAL_ResampleSincMono = FAudio_INTERNAL_ResampleSincMono_SSE2;
+		FAudio_INTERNAL_ResampleSincStereo = FAudio_INTERNAL_ResampleSincStereo_SSE2;
 		FAudio_INTERNAL_Amplify = FAudio_INTERNAL_Amplify_SSE2;
+		FAudio_INTERNAL_Mix_Generic = FAudio_INTERNAL_Mix_Generic_SSE2;
+		FAudio_INTERNAL_Mix_1in_1out = FAudio_INTERNAL_Mix_1in_1out_SSE2;
+		FAudio_INTERNAL_Mix_1in_2out = FAudio_INTERNAL_Mix_1in_2out_SSE2;
+		FAudio_INTERNAL_Mix_1in_6out = FAudio_INTERNAL_Mix_1in_6out_SSE2;
+		FAudio_INTERNAL_Mix_1in_8out = FAudio_INTERNAL_Mix_1in_8out_SSE2;
+		FAudio_INTERNAL_Mix_2in_1out = FAudio_INTERNAL_Mix_2in_1out_SSE2;
+		FAudio_INTERNAL_Mix_2in_2out = FAudio_INTERNAL_Mix_2in_2out_SSE2;
+		FAudio_INTERNAL_Mix_2in_6out = FAudio_INTERNAL_Mix_2in_6out_SSE2;
+		FAudio_INTERNAL_Mix_2in_8out = FAudio_INTERNAL_Mix_2in_8out_SSE2;
+		FAudio_INTERNAL_FilterVoice = FAudio_INTERNAL_FilterVoice_SSE2;
+		FAudio_INTERNAL_FilterMonoBatch = FAudio_INTERNAL_FilterMonoBatch_SSE2;
+#if HAVE_AVX2_INTRINSICS
+		if (hasAVX2)
+		{
+			FAudio_INTERNAL_Convert_U8_To_F32 = FAudio_INTERNAL_Convert_U8_To_F32_AVX2;
+			FAudio_INTERNAL_Convert_S16_To_F32 = FAudio_INTERNAL_Convert_S16_To_F32_AVX2;
+			FAudio_INTERNAL_Convert_S24_To_F32 = FAudio_INTERNAL_Convert_S24_To_F32_AVX2;
+			FAudio_INTERNAL_Convert_F32_To_S16 = FAudio_INTERNAL_Convert_F32_To_S16_AVX2;
+			FAudio_INTERNAL_ResampleMono = FAudio_INTERNAL_ResampleMono_AVX2;
+			FAudio_INTERNAL_ResampleStereo = FAudio_INTERNAL_ResampleStereo_AVX2;
+			FAudio_INTERNAL_ResampleSincMono = FAudio_INTERNAL_ResampleSincMono_AVX2;
+			FAudio_INTERNAL_ResampleSincStereo = FAudio_INTERNAL_ResampleSincStereo_AVX2;
+			FAudio_INTERNAL_Amplify = FAudio_INTERNAL_Amplify_AVX2;
+			FAudio_INTERNAL_Mix_1in_1out = FAudio_INTERNAL_Mix_1in_1out_AVX2;
+			FAudio_INTERNAL_Mix_1in_2out = FAudio_INTERNAL_Mix_1in_2out_AVX2;
+			FAudio_INTERNAL_Mix_1in_8out = FAudio_INTERNAL_Mix_1in_8out_AVX2;
+			FAudio_INTERNAL_Mix_2in_2out = FAudio_INTERNAL_Mix_2in_2out_AVX2;
+			FAudio_INTERNAL_Mix_2in_8out = FAudio_INTERNAL_Mix_2in_8out_AVX2;
+		}
+#endif
+#if HAVE_AVX512F_INTRINSICS
+		if (hasAVX512F)
+		{
+			FAudio_INTERNAL_Convert_U8_To_F32 = FAudio_INTERNAL_Convert_U8_To_F32_AVX512F;
+			FAudio_INTERNAL_Convert_S16_To_F32 = FAudio_INTERNAL_Convert_S16_To_F32_AVX512F;
+			FAudio_INTERNAL_Amplify = FAudio_INTERNAL_Amplify_AVX512F;
+			FAudio_INTERNAL_Mix_1in_1out = FAudio_INTERNAL_Mix_1in_1out_AVX512F;
+		}
+#endif
 		return;
 	}
 #endif
@@ -1732,21 +6216,33 @@ void FAudio_INTERNAL_InitSIMDFunctions(uint8_t hasSSE2, uint8_t hasNEON)
 	{
 		FAudio_INTERNAL_Convert_U8_To_F32 = FAudio_INTERNAL_Convert_U8_To_F32_NEON;
 		FAudio_INTERNAL_Convert_S16_To_F32 = FAudio_INTERNAL_Convert_S16_To_F32_NEON;
+		FAudio_INTERNAL_Convert_S24_To_F32 = FAudio_INTERNAL_Convert_S24_To_F32_NEON;
+		FAudio_INTERNAL_Convert_F32_To_S16 = FAudio_INTERNAL_Convert_F32_To_S16_NEON;
 		FAudio_INTERNAL_ResampleMono = FAudio_INTERNAL_ResampleMono_NEON;
 		FAudio_INTERNAL_ResampleStereo = FAudio_INTERNAL_ResampleStereo_NEON;
+		FAudio_INTERNAL_Resample4Channel = FAudio_INTERNAL_Resample4Channel_NEON;
+		FAudio_INTERNAL_Resample6Channel = FAudio_INTERNAL_Resample6Channel_NEON;
+		FAudio_INTERNAL_Resample8Channel = FAudio_INTERNAL_Resample8Channel_NEON;
+		FAudio_INTERNAL_ResampleUpMono = FAudio_INTERNAL_ResampleUpMono_NEON;
+		FAudio_INTERNAL_ResampleUpStereo = FAudio_INTERNAL_ResampleUpStereo_NEON;
+		FAudio_INTERNAL_ResampleDownMono = FAudio_INTERNAL_ResampleDownMono_NEON;
+		FAudio_INTERNAL_ResampleDownStereo = FAudio_INTERNAL_ResampleDownStereo_NEON;
+		FAudio_INTERNAL_ResampleSincMono = FAudio_INTERNAL_ResampleSincMono_NEON;
+		FAudio_INTERNAL_ResampleSincStereo = FAudio_INTERNAL_ResampleSincStereo_NEON;
 		FAudio_INTERNAL_Amplify = FAudio_INTERNAL_Amplify_NEON;
-		return;
+		FAudio_INTERNAL_Mix_Generic = FAudio_INTERNAL_Mix_Generic_NEON;
+		FAudio_INTERNAL_Mix_1in_1out = FAudio_INTERNAL_Mix_1in_1out_NEON;
+		FAudio_INTERNAL_Mix_1in_2out = FAudio_INTERNAL_Mix_1in_2out_NEON;
+		FAudio_INTERNAL_Mix_1in_6out = FAudio_INTERNAL_Mix_1in_6out_NEON;
+		FAudio_INTERNAL_Mix_1in_8out = FAudio_INTERNAL_Mix_1in_8out_NEON;
+		FAudio_INTERNAL_Mix_2in_1out = FAudio_INTERNAL_Mix_2in_1out_NEON;
+		FAudio_INTERNAL_Mix_2in_2out = FAudio_INTERNAL_Mix_2in_2out_NEON;
+		FAudio_INTERNAL_Mix_2in_6out = FAudio_INTERNAL_Mix_2in_6out_NEON;
+		FAudio_INTERNAL_Mix_2in_8out = FAudio_INTERNAL_Mix_2in_8out_NEON;
+		FAudio_INTERNAL_FilterVoice = FAudio_INTERNAL_FilterVoice_NEON;
+		FAudio_INTERNAL_FilterMonoBatch = FAudio_INTERNAL_FilterMonoBatch_NEON;
 	}
 #endif
-#if NEED_SCALAR_CONVERTER_FALLBACKS
-	FAudio_INTERNAL_Convert_U8_To_F32 = FAudio_INTERNAL_Convert_U8_To_F32_Scalar;
-	FAudio_INTERNAL_Convert_S16_To_F32 = FAudio_INTERNAL_Convert_S16_To_F32_Scalar;
-	FAudio_INTERNAL_ResampleMono = FAudio_INTERNAL_ResampleMono_Scalar;
-	FAudio_INTERNAL_ResampleStereo = FAudio_INTERNAL_ResampleStereo_Scalar;
-	FAudio_INTERNAL_Amplify = FAudio_INTERNAL_Amplify_Scalar;
-#else
-	FAudio_assert(0 && "Need converter functions!");
-#endif
 }
 
 /* vim: set noexpandtab shiftwidth=8 tabstop=8: */
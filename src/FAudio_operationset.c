@@ -0,0 +1,754 @@
+/* FAudio - XAudio Reimplementation for FNA
+ *
+ * Copyright (c) 2011-2018 Ethan Lee, Luigi Auriemma, and the MonoGame Team
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from
+ * the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software in a
+ * product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ * Ethan "flibitijibibo" Lee <flibitijibibo@flibitijibibo.com>
+ *
+ */
+
+#include "FAudio_internal.h"
+
+/* Operation Sets
+ *
+ * Any voice call with an OperationSet other than FAUDIO_COMMIT_NOW is copied
+ * into an operation and pushed onto a lock-free stack owned by the engine.
+ * CommitChanges pushes a marker onto the same stack. At the start of each
+ * update the mixer takes the whole stack at once, appends it (in call order)
+ * to the operations still waiting for a commit, then applies every operation
+ * that a marker has committed. This way a committed batch always lands in a
+ * single update, and the client thread never waits on the mixer.
+ *
+ * The pending list only belongs to whoever holds operationLock, which is the
+ * mixer (once per update, only when there is something queued) and
+ * DestroyVoice (to drop the operations of the voice being destroyed).
+ */
+
+typedef enum FAudio_OPERATIONSET_Type
+{
+	FAUDIOOP_ENABLEEFFECT,
+	FAUDIOOP_DISABLEEFFECT,
+	FAUDIOOP_SETEFFECTPARAMETERS,
+	FAUDIOOP_SETFILTERPARAMETERS,
+	FAUDIOOP_SETOUTPUTFILTERPARAMETERS,
+	FAUDIOOP_SETVOLUME,
+	FAUDIOOP_SETCHANNELVOLUMES,
+	FAUDIOOP_SETOUTPUTMATRIX,
+	FAUDIOOP_START,
+	FAUDIOOP_STOP,
+	FAUDIOOP_EXITLOOP,
+	FAUDIOOP_SETFREQUENCYRATIO,
+	FAUDIOOP_COMMIT
+} FAudio_OPERATIONSET_Type;
+
+struct FAudio_OPERATIONSET_Operation
+{
+	FAudio_OPERATIONSET_Type Type;
+	uint32_t OperationSet;
+	FAudioVoice *Voice;
+
+	union
+	{
+		struct
+		{
+			uint32_t EffectIndex;
+		} EnableEffect;
+		struct
+		{
+			uint32_t EffectIndex;
+		} DisableEffect;
+		struct
+		{
+			uint32_t EffectIndex;
+			void *pParameters;
+			uint32_t ParametersByteSize;
+		} SetEffectParameters;
+		struct
+		{
+			FAudioFilterParameters Parameters;
+		} SetFilterParameters;
+		struct
+		{
+			FAudioVoice *pDestinationVoice;
+			FAudioFilterParameters Parameters;
+		} SetOutputFilterParameters;
+		struct
+		{
+			float Volume;
+		} SetVolume;
+		struct
+		{
+			uint32_t Channels;
+			float *pVolumes;
+		} SetChannelVolumes;
+		struct
+		{
+			FAudioVoice *pDestinationVoice;
+			uint32_t SourceChannels;
+			uint32_t DestinationChannels;
+			float *pLevelMatrix;
+		} SetOutputMatrix;
+		struct
+		{
+			uint32_t Flags;
+		} Start;
+		struct
+		{
+			uint32_t Flags;
+		} Stop;
+		struct
+		{
+			float Ratio;
+		} SetFrequencyRatio;
+	} Data;
+
+	FAudio_OPERATIONSET_Operation *next;
+};
+
+/* Queue Management */
+
+static FAudio_OPERATIONSET_Operation* FAudio_OPERATIONSET_Alloc(
+	FAudio *audio,
+	FAudio_OPERATIONSET_Type type,
+	FAudioVoice *voice,
+	uint32_t operationSet,
+	uint32_t extraBytes
+) {
+	FAudio_OPERATIONSET_Operation *op;
+
+	/* Variable-length data lives right after the operation, so each
+	 * operation is exactly one allocation.
+	 */
+	op = (FAudio_OPERATIONSET_Operation*) audio->pMalloc(
+		sizeof(FAudio_OPERATIONSET_Operation) + extraBytes
+	);
+	op->Type = type;
+	op->OperationSet = operationSet;
+	op->Voice = voice;
+	op->next = NULL;
+	return op;
+}
+
+static void FAudio_OPERATIONSET_Push(
+	FAudio *audio,
+	FAudio_OPERATIONSET_Operation *op
+) {
+	void *head;
+	do
+	{
+		head = FAudio_PlatformAtomicGetPtr(&audio->queuedOperations);
+		op->next = (FAudio_OPERATIONSET_Operation*) head;
+	} while (!FAudio_PlatformAtomicCASPtr(
+		&audio->queuedOperations,
+		head,
+		op
+	));
+}
+
+/* Requires operationLock! */
+static void FAudio_OPERATIONSET_Drain(FAudio *audio)
+{
+	FAudio_OPERATIONSET_Operation *op, *next, *reversed, *tail;
+
+	op = (FAudio_OPERATIONSET_Operation*) FAudio_PlatformAtomicSetPtr(
+		&audio->queuedOperations,
+		NULL
+	);
+	if (op == NULL)
+	{
+		return;
+	}
+
+	/* The stack is newest-first, flip it back to call order */
+	reversed = NULL;
+	while (op != NULL)
+	{
+		next = op->next;
+		op->next = reversed;
+		reversed = op;
+		op = next;
+	}
+
+	if (audio->pendingOperations == NULL)
+	{
+		audio->pendingOperations = reversed;
+	}
+	else
+	{
+		tail = audio->pendingOperations;
+		while (tail->next != NULL)
+		{
+			tail = tail->next;
+		}
+		tail->next = reversed;
+	}
+}
+
+static void FAudio_OPERATIONSET_ExecuteOperation(
+	FAudio_OPERATIONSET_Operation *op
+) {
+	switch (op->Type)
+	{
+	case FAUDIOOP_ENABLEEFFECT:
+		FAudioVoice_EnableEffect(
+			op->Voice,
+			op->Data.EnableEffect.EffectIndex,
+			FAUDIO_COMMIT_NOW
+		);
+		break;
+	case FAUDIOOP_DISABLEEFFECT:
+		FAudioVoice_DisableEffect(
+			op->Voice,
+			op->Data.DisableEffect.EffectIndex,
+			FAUDIO_COMMIT_NOW
+		);
+		break;
+	case FAUDIOOP_SETEFFECTPARAMETERS:
+		FAudioVoice_SetEffectParameters(
+			op->Voice,
+			op->Data.SetEffectParameters.EffectIndex,
+			op->Data.SetEffectParameters.pParameters,
+			op->Data.SetEffectParameters.ParametersByteSize,
+			FAUDIO_COMMIT_NOW
+		);
+		break;
+	case FAUDIOOP_SETFILTERPARAMETERS:
+		FAudioVoice_SetFilterParameters(
+			op->Voice,
+			&op->Data.SetFilterParameters.Parameters,
+			FAUDIO_COMMIT_NOW
+		);
+		break;
+	case FAUDIOOP_SETOUTPUTFILTERPARAMETERS:
+		FAudioVoice_SetOutputFilterParameters(
+			op->Voice,
+			op->Data.SetOutputFilterParameters.pDestinationVoice,
+			&op->Data.SetOutputFilterParameters.Parameters,
+			FAUDIO_COMMIT_NOW
+		);
+		break;
+	case FAUDIOOP_SETVOLUME:
+		FAudioVoice_SetVolume(
+			op->Voice,
+			op->Data.SetVolume.Volume,
+			FAUDIO_COMMIT_NOW
+		);
+		break;
+	case FAUDIOOP_SETCHANNELVOLUMES:
+		FAudioVoice_SetChannelVolumes(
+			op->Voice,
+			op->Data.SetChannelVolumes.Channels,
+			op->Data.SetChannelVolumes.pVolumes,
+			FAUDIO_COMMIT_NOW
+		);
+		break;
+	case FAUDIOOP_SETOUTPUTMATRIX:
+		FAudioVoice_SetOutputMatrix(
+			op->Voice,
+			op->Data.SetOutputMatrix.pDestinationVoice,
+			op->Data.SetOutputMatrix.SourceChannels,
+			op->Data.SetOutputMatrix.DestinationChannels,
+			op->Data.SetOutputMatrix.pLevelMatrix,
+			FAUDIO_COMMIT_NOW
+		);
+		break;
+	case FAUDIOOP_START:
+		FAudioSourceVoice_Start(
+			op->Voice,
+			op->Data.Start.Flags,
+			FAUDIO_COMMIT_NOW
+		);
+		break;
+	case FAUDIOOP_STOP:
+		FAudioSourceVoice_Stop(
+			op->Voice,
+			op->Data.Stop.Flags,
+			FAUDIO_COMMIT_NOW
+		);
+		break;
+	case FAUDIOOP_EXITLOOP:
+		FAudioSourceVoice_ExitLoop(
+			op->Voice,
+			FAUDIO_COMMIT_NOW
+		);
+		break;
+	case FAUDIOOP_SETFREQUENCYRATIO:
+		FAudioSourceVoice_SetFrequencyRatio(
+			op->Voice,
+			op->Data.SetFrequencyRatio.Ratio,
+			FAUDIO_COMMIT_NOW
+		);
+		break;
+	default:
+		FAudio_assert(0 && "Unrecognized operation type!");
+		break;
+	}
+}
+
+/* Public Functions */
+
+void FAudio_OPERATIONSET_Commit(FAudio *audio, uint32_t OperationSet)
+{
+	FAudio_OPERATIONSET_Operation *op;
+
+	LOG_FUNC_ENTER(audio)
+	op = FAudio_OPERATIONSET_Alloc(
+		audio,
+		FAUDIOOP_COMMIT,
+		NULL,
+		OperationSet,
+		0
+	);
+	FAudio_OPERATIONSET_Push(audio, op);
+	LOG_FUNC_EXIT(audio)
+}
+
+void FAudio_OPERATIONSET_Execute(FAudio *audio)
+{
+	FAudio_OPERATIONSET_Operation *op, *prev, *next, *commit;
+
+	/* Nearly every update has nothing to do, so don't even lock for it.
+	 * Only the mixer ever adds to pendingOperations, so a stale read here
+	 * can only cost us a pointless lock, never a missed commit.
+	 */
+	if (	audio->pendingOperations == NULL &&
+		FAudio_PlatformAtomicGetPtr(&audio->queuedOperations) == NULL	)
+	{
+		return;
+	}
+
+	LOG_FUNC_ENTER(audio)
+	FAudio_PlatformLockMutex(audio->operationLock);
+	LOG_MUTEX_LOCK(audio, audio->operationLock)
+
+	FAudio_OPERATIONSET_Drain(audio);
+
+	/* Markers are handled in call order; each one applies everything
+	 * before it with a matching set, anything queued later waits for
+	 * a later commit.
+	 */
+	while (1)
+	{
+		commit = audio->pendingOperations;
+		while (commit != NULL && commit->Type != FAUDIOOP_COMMIT)
+		{
+			commit = commit->next;
+		}
+		if (commit == NULL)
+		{
+			break;
+		}
+
+		prev = NULL;
+		op = audio->pendingOperations;
+		while (op != commit)
+		{
+			next = op->next;
+			if (	commit->OperationSet == FAUDIO_COMMIT_ALL ||
+				op->OperationSet == commit->OperationSet	)
+			{
+				FAudio_OPERATIONSET_ExecuteOperation(op);
+				if (prev == NULL)
+				{
+					audio->pendingOperations = next;
+				}
+				else
+				{
+					prev->next = next;
+				}
+				audio->pFree(op);
+			}
+			else
+			{
+				prev = op;
+			}
+			op = next;
+		}
+
+		/* Finally, unlink the marker itself */
+		if (prev == NULL)
+		{
+			audio->pendingOperations = commit->next;
+		}
+		else
+		{
+			prev->next = commit->next;
+		}
+		audio->pFree(commit);
+	}
+
+	FAudio_PlatformUnlockMutex(audio->operationLock);
+	LOG_MUTEX_UNLOCK(audio, audio->operationLock)
+	LOG_FUNC_EXIT(audio)
+}
+
+void FAudio_OPERATIONSET_ClearAll(FAudio *audio)
+{
+	FAudio_OPERATIONSET_Operation *op, *next;
+
+	LOG_FUNC_ENTER(audio)
+	FAudio_PlatformLockMutex(audio->operationLock);
+	LOG_MUTEX_LOCK(audio, audio->operationLock)
+
+	FAudio_OPERATIONSET_Drain(audio);
+	op = audio->pendingOperations;
+	while (op != NULL)
+	{
+		next = op->next;
+		audio->pFree(op);
+		op = next;
+	}
+	audio->pendingOperations = NULL;
+
+	FAudio_PlatformUnlockMutex(audio->operationLock);
+	LOG_MUTEX_UNLOCK(audio, audio->operationLock)
+	LOG_FUNC_EXIT(audio)
+}
+
+void FAudio_OPERATIONSET_ClearAllForVoice(FAudioVoice *voice)
+{
+	FAudio_OPERATIONSET_Operation *op, *prev, *next;
+	FAudio *audio = voice->audio;
+	uint8_t remove;
+
+	LOG_FUNC_ENTER(audio)
+	FAudio_PlatformLockMutex(audio->operationLock);
+	LOG_MUTEX_LOCK(audio, audio->operationLock)
+
+	FAudio_OPERATIONSET_Drain(audio);
+	prev = NULL;
+	op = audio->pendingOperations;
+	while (op != NULL)
+	{
+		next = op->next;
+
+		/* Sends to this voice are going away too */
+		remove = (op->Voice == voice);
+		if (op->Type == FAUDIOOP_SETOUTPUTFILTERPARAMETERS)
+		{
+			remove |= (op->Data.SetOutputFilterParameters.pDestinationVoice == voice);
+		}
+		else if (op->Type == FAUDIOOP_SETOUTPUTMATRIX)
+		{
+			remove |= (op->Data.SetOutputMatrix.pDestinationVoice == voice);
+		}
+
+		if (remove)
+		{
+			if (prev == NULL)
+			{
+				audio->pendingOperations = next;
+			}
+			else
+			{
+				prev->next = next;
+			}
+			audio->pFree(op);
+		}
+		else
+		{
+			prev = op;
+		}
+		op = next;
+	}
+
+	FAudio_PlatformUnlockMutex(audio->operationLock);
+	LOG_MUTEX_UNLOCK(audio, audio->operationLock)
+	LOG_FUNC_EXIT(audio)
+}
+
+/* Operation Queueing */
+
+void FAudio_OPERATIONSET_QueueEnableEffect(
+	FAudioVoice *voice,
+	uint32_t EffectIndex,
+	uint32_t OperationSet
+) {
+	FAudio_OPERATIONSET_Operation *op;
+
+	LOG_FUNC_ENTER(voice->audio)
+	op = FAudio_OPERATIONSET_Alloc(
+		voice->audio,
+		FAUDIOOP_ENABLEEFFECT,
+		voice,
+		OperationSet,
+		0
+	);
+	op->Data.EnableEffect.EffectIndex = EffectIndex;
+	FAudio_OPERATIONSET_Push(voice->audio, op);
+	LOG_FUNC_EXIT(voice->audio)
+}
+
+void FAudio_OPERATIONSET_QueueDisableEffect(
+	FAudioVoice *voice,
+	uint32_t EffectIndex,
+	uint32_t OperationSet
+) {
+	FAudio_OPERATIONSET_Operation *op;
+
+	LOG_FUNC_ENTER(voice->audio)
+	op = FAudio_OPERATIONSET_Alloc(
+		voice->audio,
+		FAUDIOOP_DISABLEEFFECT,
+		voice,
+		OperationSet,
+		0
+	);
+	op->Data.DisableEffect.EffectIndex = EffectIndex;
+	FAudio_OPERATIONSET_Push(voice->audio, op);
+	LOG_FUNC_EXIT(voice->audio)
+}
+
+void FAudio_OPERATIONSET_QueueSetEffectParameters(
+	FAudioVoice *voice,
+	uint32_t EffectIndex,
+	const void *pParameters,
+	uint32_t ParametersByteSize,
+	uint32_t OperationSet
+) {
+	FAudio_OPERATIONSET_Operation *op;
+
+	LOG_FUNC_ENTER(voice->audio)
+	op = FAudio_OPERATIONSET_Alloc(
+		voice->audio,
+		FAUDIOOP_SETEFFECTPARAMETERS,
+		voice,
+		OperationSet,
+		ParametersByteSize
+	);
+	op->Data.SetEffectParameters.EffectIndex = EffectIndex;
+	op->Data.SetEffectParameters.pParameters = op + 1;
+	op->Data.SetEffectParameters.ParametersByteSize = ParametersByteSize;
+	FAudio_memcpy(
+		op->Data.SetEffectParameters.pParameters,
+		pParameters,
+		ParametersByteSize
+	);
+	FAudio_OPERATIONSET_Push(voice->audio, op);
+	LOG_FUNC_EXIT(voice->audio)
+}
+
+void FAudio_OPERATIONSET_QueueSetFilterParameters(
+	FAudioVoice *voice,
+	const FAudioFilterParameters *pParameters,
+	uint32_t OperationSet
+) {
+	FAudio_OPERATIONSET_Operation *op;
+
+	LOG_FUNC_ENTER(voice->audio)
+	op = FAudio_OPERATIONSET_Alloc(
+		voice->audio,
+		FAUDIOOP_SETFILTERPARAMETERS,
+		voice,
+		OperationSet,
+		0
+	);
+	FAudio_memcpy(
+		&op->Data.SetFilterParameters.Parameters,
+		pParameters,
+		sizeof(FAudioFilterParameters)
+	);
+	FAudio_OPERATIONSET_Push(voice->audio, op);
+	LOG_FUNC_EXIT(voice->audio)
+}
+
+void FAudio_OPERATIONSET_QueueSetOutputFilterParameters(
+	FAudioVoice *voice,
+	FAudioVoice *pDestinationVoice,
+	const FAudioFilterParameters *pParameters,
+	uint32_t OperationSet
+) {
+	FAudio_OPERATIONSET_Operation *op;
+
+	LOG_FUNC_ENTER(voice->audio)
+	op = FAudio_OPERATIONSET_Alloc(
+		voice->audio,
+		FAUDIOOP_SETOUTPUTFILTERPARAMETERS,
+		voice,
+		OperationSet,
+		0
+	);
+	op->Data.SetOutputFilterParameters.pDestinationVoice = pDestinationVoice;
+	FAudio_memcpy(
+		&op->Data.SetOutputFilterParameters.Parameters,
+		pParameters,
+		sizeof(FAudioFilterParameters)
+	);
+	FAudio_OPERATIONSET_Push(voice->audio, op);
+	LOG_FUNC_EXIT(voice->audio)
+}
+
+void FAudio_OPERATIONSET_QueueSetVolume(
+	FAudioVoice *voice,
+	float Volume,
+	uint32_t OperationSet
+) {
+	FAudio_OPERATIONSET_Operation *op;
+
+	LOG_FUNC_ENTER(voice->audio)
+	op = FAudio_OPERATIONSET_Alloc(
+		voice->audio,
+		FAUDIOOP_SETVOLUME,
+		voice,
+		OperationSet,
+		0
+	);
+	op->Data.SetVolume.Volume = Volume;
+	FAudio_OPERATIONSET_Push(voice->audio, op);
+	LOG_FUNC_EXIT(voice->audio)
+}
+
+void FAudio_OPERATIONSET_QueueSetChannelVolumes(
+	FAudioVoice *voice,
+	uint32_t Channels,
+	const float *pVolumes,
+	uint32_t OperationSet
+) {
+	FAudio_OPERATIONSET_Operation *op;
+
+	LOG_FUNC_ENTER(voice->audio)
+	op = FAudio_OPERATIONSET_Alloc(
+		voice->audio,
+		FAUDIOOP_SETCHANNELVOLUMES,
+		voice,
+		OperationSet,
+		sizeof(float) * Channels
+	);
+	op->Data.SetChannelVolumes.Channels = Channels;
+	op->Data.SetChannelVolumes.pVolumes = (float*) (op + 1);
+	FAudio_memcpy(
+		op->Data.SetChannelVolumes.pVolumes,
+		pVolumes,
+		sizeof(float) * Channels
+	);
+	FAudio_OPERATIONSET_Push(voice->audio, op);
+	LOG_FUNC_EXIT(voice->audio)
+}
+
+void FAudio_OPERATIONSET_QueueSetOutputMatrix(
+	FAudioVoice *voice,
+	FAudioVoice *pDestinationVoice,
+	uint32_t SourceChannels,
+	uint32_t DestinationChannels,
+	const float *pLevelMatrix,
+	uint32_t OperationSet
+) {
+	FAudio_OPERATIONSET_Operation *op;
+
+	LOG_FUNC_ENTER(voice->audio)
+	op = FAudio_OPERATIONSET_Alloc(
+		voice->audio,
+		FAUDIOOP_SETOUTPUTMATRIX,
+		voice,
+		OperationSet,
+		sizeof(float) * SourceChannels * DestinationChannels
+	);
+	op->Data.SetOutputMatrix.pDestinationVoice = pDestinationVoice;
+	op->Data.SetOutputMatrix.SourceChannels = SourceChannels;
+	op->Data.SetOutputMatrix.DestinationChannels = DestinationChannels;
+	op->Data.SetOutputMatrix.pLevelMatrix = (float*) (op + 1);
+	FAudio_memcpy(
+		op->Data.SetOutputMatrix.pLevelMatrix,
+		pLevelMatrix,
+		sizeof(float) * SourceChannels * DestinationChannels
+	);
+	FAudio_OPERATIONSET_Push(voice->audio, op);
+	LOG_FUNC_EXIT(voice->audio)
+}
+
+void FAudio_OPERATIONSET_QueueStart(
+	FAudioSourceVoice *voice,
+	uint32_t Flags,
+	uint32_t OperationSet
+) {
+	FAudio_OPERATIONSET_Operation *op;
+
+	LOG_FUNC_ENTER(voice->audio)
+	op = FAudio_OPERATIONSET_Alloc(
+		voice->audio,
+		FAUDIOOP_START,
+		voice,
+		OperationSet,
+		0
+	);
+	op->Data.Start.Flags = Flags;
+	FAudio_OPERATIONSET_Push(voice->audio, op);
+	LOG_FUNC_EXIT(voice->audio)
+}
+
+void FAudio_OPERATIONSET_QueueStop(
+	FAudioSourceVoice *voice,
+	uint32_t Flags,
+	uint32_t OperationSet
+) {
+	FAudio_OPERATIONSET_Operation *op;
+
+	LOG_FUNC_ENTER(voice->audio)
+	op = FAudio_OPERATIONSET_Alloc(
+		voice->audio,
+		FAUDIOOP_STOP,
+		voice,
+		OperationSet,
+		0
+	);
+	op->Data.Stop.Flags = Flags;
+	FAudio_OPERATIONSET_Push(voice->audio, op);
+	LOG_FUNC_EXIT(voice->audio)
+}
+
+void FAudio_OPERATIONSET_QueueExitLoop(
+	FAudioSourceVoice *voice,
+	uint32_t OperationSet
+) {
+	FAudio_OPERATIONSET_Operation *op;
+
+	LOG_FUNC_ENTER(voice->audio)
+	op = FAudio_OPERATIONSET_Alloc(
+		voice->audio,
+		FAUDIOOP_EXITLOOP,
+		voice,
+		OperationSet,
+		0
+	);
+	FAudio_OPERATIONSET_Push(voice->audio, op);
+	LOG_FUNC_EXIT(voice->audio)
+}
+
+void FAudio_OPERATIONSET_QueueSetFrequencyRatio(
+	FAudioSourceVoice *voice,
+	float Ratio,
+	uint32_t OperationSet
+) {
+	FAudio_OPERATIONSET_Operation *op;
+
+	LOG_FUNC_ENTER(voice->audio)
+	op = FAudio_OPERATIONSET_Alloc(
+		voice->audio,
+		FAUDIOOP_SETFREQUENCYRATIO,
+		voice,
+		OperationSet,
+		0
+	);
+	op->Data.SetFrequencyRatio.Ratio = Ratio;
+	FAudio_OPERATIONSET_Push(voice->audio, op);
+	LOG_FUNC_EXIT(voice->audio)
+}
+
+/* vim: set noexpandtab shiftwidth=8 tabstop=8: */
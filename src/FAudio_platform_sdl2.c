@@ -35,6 +35,14 @@ typedef struct FAudioPlatformDevice
 	uint32_t bufferSize;
 	SDL_AudioDeviceID device;
 	FAudioWaveFormatExtensible format;
+
+	/* HeadlessEXT, used instead of the SDL device */
+	SDL_Thread *headlessThread;
+	SDL_atomic_t headlessRunning;
+	SDL_sem *headlessWake;
+	SDL_RWops *headlessFile;
+	float *headlessBuffer;
+	uint64_t headlessBytes;
 } FAudioPlatformDevice;
 
 /* WaveFormatExtensible Helpers */
@@ -75,22 +83,119 @@ static inline void WriteWaveFormatExtensible(
 	FAudio_memcpy(&fmt->SubFormat, &DATAFORMAT_SUBTYPE_IEEE_FLOAT, sizeof(FAudioGUID));
 }
 
+/* Headless Output Helpers */
+
+#define WAV_HEADER_SIZE 68
+
+static inline void WriteLE(uint8_t *dst, uint32_t value, uint8_t bytes)
+{
+	uint8_t i;
+	for (i = 0; i < bytes; i += 1)
+	{
+		dst[i] = (uint8_t) (value >> (i * 8));
+	}
+}
+
+static void WriteWAVHeader(
+	SDL_RWops *file,
+	FAudioWaveFormatExtensible *fmt,
+	uint32_t dataBytes
+) {
+	uint8_t header[WAV_HEADER_SIZE];
+
+	/* RIFF header, then a 40-byte WAVEFORMATEXTENSIBLE, then the data */
+	FAudio_memcpy(header + 0, "RIFF", 4);
+	WriteLE(header + 4, WAV_HEADER_SIZE - 8 + dataBytes, 4);
+	FAudio_memcpy(header + 8, "WAVE", 4);
+	FAudio_memcpy(header + 12, "fmt ", 4);
+	WriteLE(header + 16, 40, 4);
+	WriteLE(header + 20, fmt->Format.wFormatTag, 2);
+	WriteLE(header + 22, fmt->Format.nChannels, 2);
+	WriteLE(header + 24, fmt->Format.nSamplesPerSec, 4);
+	WriteLE(header + 28, fmt->Format.nAvgBytesPerSec, 4);
+	WriteLE(header + 32, fmt->Format.nBlockAlign, 2);
+	WriteLE(header + 34, fmt->Format.wBitsPerSample, 2);
+	WriteLE(header + 36, 22, 2);
+	WriteLE(header + 38, fmt->Samples.wValidBitsPerSample, 2);
+	WriteLE(header + 40, fmt->dwChannelMask, 4);
+	WriteLE(header + 44, fmt->SubFormat.Data1, 4);
+	WriteLE(header + 48, fmt->SubFormat.Data2, 2);
+	WriteLE(header + 50, fmt->SubFormat.Data3, 2);
+	FAudio_memcpy(header + 52, fmt->SubFormat.Data4, 8);
+	FAudio_memcpy(header + 60, "data", 4);
+	WriteLE(header + 64, dataBytes, 4);
+
+	SDL_RWseek(file, 0, RW_SEEK_SET);
+	SDL_RWwrite(file, header, sizeof(header), 1);
+}
+
 /* Mixer Thread */
 
 void FAudio_INTERNAL_MixCallback(void *userdata, Uint8 *stream, int len)
 {
 	FAudio *audio = (FAudio*) userdata;
+	FAudioPlatformDevice *device = (FAudioPlatformDevice*) audio->platform;
 
 	FAudio_zero(stream, len);
 	if (audio->active)
 	{
-		FAudio_INTERNAL_UpdateEngine(
+		FAudio_INTERNAL_RenderFrames(
 			audio,
-			(float*) stream
+			(float*) stream,
+			len / device->format.Format.nBlockAlign
 		);
 	}
 }
 
+static int FAudio_INTERNAL_HeadlessThread(void *userdata)
+{
+	FAudio *audio = (FAudio*) userdata;
+	FAudioPlatformDevice *device = (FAudioPlatformDevice*) audio->platform;
+	const uint32_t samples = (
+		audio->updateSize *
+		device->format.Format.nChannels
+	);
+	const size_t len = samples * sizeof(float);
+#if SDL_BYTEORDER == SDL_BIG_ENDIAN
+	uint32_t i;
+#endif
+
+	/* No device to wait on, so render as fast as we can. A stopped engine
+	 * doesn't produce any output at all, rather than writing silence, and
+	 * sleeps until FAudio_StartEngine or FAudio_PlatformQuit wakes it.
+	 */
+	while (SDL_AtomicGet(&device->headlessRunning))
+	{
+		if (!audio->active)
+		{
+			SDL_SemWait(device->headlessWake);
+			continue;
+		}
+
+		FAudio_zero(device->headlessBuffer, len);
+		FAudio_INTERNAL_RenderFrames(
+			audio,
+			device->headlessBuffer,
+			audio->updateSize
+		);
+
+		if (device->headlessFile != NULL)
+		{
+#if SDL_BYTEORDER == SDL_BIG_ENDIAN
+			for (i = 0; i < samples; i += 1)
+			{
+				device->headlessBuffer[i] = SDL_SwapFloatLE(
+					device->headlessBuffer[i]
+				);
+			}
+#endif
+			SDL_RWwrite(device->headlessFile, device->headlessBuffer, len, 1);
+			device->headlessBytes += len;
+		}
+	}
+	return 0;
+}
+
 /* Platform Functions */
 
 void FAudio_PlatformAddRef()
@@ -102,6 +207,12 @@ void FAudio_PlatformAddRef()
 	}
 	FAudio_INTERNAL_InitSIMDFunctions(
 		SDL_HasSSE2(),
+		SDL_HasAVX2(),
+#if SDL_VERSION_ATLEAST(2, 0, 9)
+		SDL_HasAVX512F(),
+#else
+		0,
+#endif
 		SDL_HasNEON()
 	);
 }
@@ -121,6 +232,7 @@ void FAudio_PlatformInit(FAudio *audio, uint32_t deviceIndex)
 	device = (FAudioPlatformDevice*) audio->pMalloc(
 		sizeof(FAudioPlatformDevice)
 	);
+	FAudio_zero(device, sizeof(FAudioPlatformDevice));
 
 	/* Build the device format.
 	 * The most unintuitive part of this is the use of outputChannels
@@ -133,59 +245,156 @@ void FAudio_PlatformInit(FAudio *audio, uint32_t deviceIndex)
 	want.format = AUDIO_F32;
 	want.channels = audio->master->outputChannels;
 	want.silence = 0;
-	want.samples = 1024;
+	want.samples = (audio->quantumSize > 0) ? audio->quantumSize : 1024;
 	want.callback = FAudio_INTERNAL_MixCallback;
 	want.userdata = audio;
 
-	/* Open the device, finally. */
-	device->device = SDL_OpenAudioDevice(
-		deviceIndex > 0 ? SDL_GetAudioDeviceName(deviceIndex - 1, 0) : NULL,
-		0,
-		&want,
-		&have,
+	if (audio->headlessMode == FAUDIO_HEADLESS_NONE_EXT)
+	{
+		/* Open the device, finally. */
+		device->device = SDL_OpenAudioDevice(
+			deviceIndex > 0 ? SDL_GetAudioDeviceName(deviceIndex - 1, 0) : NULL,
+			0,
+			&want,
+			&have,
 #if SDL_VERSION_ATLEAST(2, 0, 9)
-		SDL_AUDIO_ALLOW_SAMPLES_CHANGE
+			SDL_AUDIO_ALLOW_SAMPLES_CHANGE
 #else
 #warning Please update to SDL 2.0.9 ASAP!
-		0
+			0
 #endif
-	);
-	if (device->device == 0)
+		);
+		if (device->device == 0)
+		{
+			audio->pFree(device);
+			SDL_Log("OpenAudioDevice failed: %s\n", SDL_GetError());
+			FAudio_assert(0 && "Failed to open audio device!");
+			return;
+		}
+	}
+	else
 	{
-		audio->pFree(device);
-		SDL_Log("OpenAudioDevice failed: %s\n", SDL_GetError());
-		FAudio_assert(0 && "Failed to open audio device!");
-		return;
+		/* No device, so we get exactly what we asked for */
+		have = want;
 	}
 
 	/* Write up the format */
 	WriteWaveFormatExtensible(&device->format, have.channels, have.freq);
 	device->bufferSize = have.samples;
 
-	/* Give the output format to the engine */
-	audio->updateSize = device->bufferSize;
+	/* Give the output format to the engine. If the device didn't give us
+	 * the quantum we asked for, FAudio_INTERNAL_RenderFrames makes up the
+	 * difference.
+	 */
+	audio->updateSize = (audio->quantumSize > 0) ?
+		audio->quantumSize :
+		device->bufferSize;
 	audio->mixFormat = &device->format;
 
 	/* Also give some info to the master voice */
 	audio->master->outputChannels = have.channels;
 	audio->master->master.inputSampleRate = have.freq;
 
-	/* Start the thread! */
-	SDL_PauseAudioDevice(device->device, 0);
+	/* The engine needs a place to put partial updates */
+	audio->quantumCache = (float*) audio->pMalloc(
+		sizeof(float) * audio->updateSize * have.channels
+	);
+	audio->quantumOffset = audio->updateSize;
+
+	/* Only a real device holds on to what we give it */
+	audio->platformLatency = (audio->headlessMode == FAUDIO_HEADLESS_NONE_EXT) ?
+		device->bufferSize :
+		0;
 
+	/* Start the thread! */
 	audio->platform = device;
+	if (audio->headlessMode == FAUDIO_HEADLESS_NONE_EXT)
+	{
+		SDL_PauseAudioDevice(device->device, 0);
+		return;
+	}
+
+	/* FAudio_RenderEXT drives the engine from the client's thread */
+	if (audio->headlessMode == FAUDIO_HEADLESS_MANUAL_EXT)
+	{
+		return;
+	}
+
+	/* Headless output gets a file (maybe) and a thread of its own */
+	if (audio->headlessMode != FAUDIO_HEADLESS_NULL_EXT)
+	{
+		device->headlessFile = SDL_RWFromFile(audio->headlessPath, "wb");
+		if (device->headlessFile == NULL)
+		{
+			SDL_Log("Headless output failed: %s\n", SDL_GetError());
+		}
+		else if (audio->headlessMode == FAUDIO_HEADLESS_WAV_EXT)
+		{
+			WriteWAVHeader(device->headlessFile, &device->format, 0);
+		}
+	}
+	device->headlessBuffer = (float*) audio->pMalloc(
+		sizeof(float) * audio->updateSize * have.channels
+	);
+	device->headlessWake = SDL_CreateSemaphore(0);
+	SDL_AtomicSet(&device->headlessRunning, 1);
+	device->headlessThread = SDL_CreateThread(
+		FAudio_INTERNAL_HeadlessThread,
+		"FAudio_Headless",
+		audio
+	);
 }
 
 void FAudio_PlatformQuit(FAudio *audio)
 {
 	FAudioPlatformDevice *device = audio->platform;
-	SDL_CloseAudioDevice(
-		device->device
-	);
+	if (audio->headlessMode == FAUDIO_HEADLESS_NONE_EXT)
+	{
+		SDL_CloseAudioDevice(
+			device->device
+		);
+	}
+	else if (audio->headlessMode != FAUDIO_HEADLESS_MANUAL_EXT)
+	{
+		SDL_AtomicSet(&device->headlessRunning, 0);
+		SDL_SemPost(device->headlessWake);
+		SDL_WaitThread(device->headlessThread, NULL);
+		SDL_DestroySemaphore(device->headlessWake);
+		if (device->headlessFile != NULL)
+		{
+			if (audio->headlessMode == FAUDIO_HEADLESS_WAV_EXT)
+			{
+				/* The RIFF sizes are only 32 bits wide */
+				WriteWAVHeader(
+					device->headlessFile,
+					&device->format,
+					(uint32_t) FAudio_min(
+						device->headlessBytes,
+						0xFFFFFFFF - (WAV_HEADER_SIZE - 8)
+					)
+				);
+			}
+			SDL_RWclose(device->headlessFile);
+		}
+		audio->pFree(device->headlessBuffer);
+	}
 	audio->pFree(device);
+	audio->pFree(audio->quantumCache);
+	audio->quantumCache = NULL;
 	audio->platform = NULL;
 }
 
+void FAudio_PlatformStartEngine(FAudio *audio)
+{
+	FAudioPlatformDevice *device = audio->platform;
+
+	/* Only the headless thread sleeps while the engine is stopped */
+	if (device != NULL && device->headlessThread != NULL)
+	{
+		SDL_SemPost(device->headlessWake);
+	}
+}
+
 uint32_t FAudio_PlatformGetDeviceCount()
 {
 	return SDL_GetNumAudioDevices(0) + 1;
@@ -286,11 +495,68 @@ void FAudio_PlatformUnlockMutex(FAudioMutex mutex)
 	SDL_UnlockMutex((SDL_mutex*) mutex);
 }
 
+FAudioSemaphore FAudio_PlatformCreateSemaphore(uint32_t initialValue)
+{
+	return (FAudioSemaphore) SDL_CreateSemaphore(initialValue);
+}
+
+void FAudio_PlatformDestroySemaphore(FAudioSemaphore semaphore)
+{
+	SDL_DestroySemaphore((SDL_sem*) semaphore);
+}
+
+void FAudio_PlatformWaitSemaphore(FAudioSemaphore semaphore)
+{
+	SDL_SemWait((SDL_sem*) semaphore);
+}
+
+void FAudio_PlatformSignalSemaphore(FAudioSemaphore semaphore)
+{
+	SDL_SemPost((SDL_sem*) semaphore);
+}
+
 void FAudio_sleep(uint32_t ms)
 {
 	SDL_Delay(ms);
 }
 
+/* Atomics */
+
+int32_t FAudio_PlatformAtomicGet(int32_t *ptr)
+{
+	return SDL_AtomicGet((SDL_atomic_t*) ptr);
+}
+
+int32_t FAudio_PlatformAtomicSet(int32_t *ptr, int32_t value)
+{
+	return SDL_AtomicSet((SDL_atomic_t*) ptr, value);
+}
+
+int32_t FAudio_PlatformAtomicAdd(int32_t *ptr, int32_t value)
+{
+	return SDL_AtomicAdd((SDL_atomic_t*) ptr, value);
+}
+
+uint8_t FAudio_PlatformAtomicCAS(int32_t *ptr, int32_t oldValue, int32_t newValue)
+{
+	return SDL_AtomicCAS((SDL_atomic_t*) ptr, oldValue, newValue) == SDL_TRUE;
+}
+
+void* FAudio_PlatformAtomicGetPtr(void **ptr)
+{
+	return SDL_AtomicGetPtr(ptr);
+}
+
+void* FAudio_PlatformAtomicSetPtr(void **ptr, void *value)
+{
+	return SDL_AtomicSetPtr(ptr, value);
+}
+
+uint8_t FAudio_PlatformAtomicCASPtr(void **ptr, void *oldValue, void *newValue)
+{
+	return SDL_AtomicCASPtr(ptr, oldValue, newValue) == SDL_TRUE;
+}
+
 /* Time */
 
 uint32_t FAudio_timems()
@@ -298,6 +564,16 @@ uint32_t FAudio_timems()
 	return SDL_GetTicks();
 }
 
+uint64_t FAudio_timecounter()
+{
+	return SDL_GetPerformanceCounter();
+}
+
+uint64_t FAudio_timefrequency()
+{
+	return SDL_GetPerformanceFrequency();
+}
+
 /* FAudio I/O */
 
 FAudioIOStream* FAudio_fopen(const char *path)
@@ -0,0 +1,402 @@
+/* FAudio - XAudio Reimplementation for FNA
+ *
+ * Copyright (c) 2011-2018 Ethan Lee, Luigi Auriemma, and the MonoGame Team
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from
+ * the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software in a
+ * product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ * Ethan "flibitijibibo" Lee <flibitijibibo@flibitijibibo.com>
+ *
+ */
+
+#include "FAudio_internal.h"
+
+/* Source Voice Pools
+ *
+ * A pool holds source voices that were all created with the same format,
+ * flags and maximum frequency ratio. CreateSourceVoice checks the pools
+ * first; if an idle voice with a matching key exists, it is reset to the
+ * state a brand new voice would be in and handed out instead of building a
+ * new one. DestroyVoice puts pooled voices back instead of freeing them.
+ *
+ * Idle voices stay exactly as they were created: same format, no effects and
+ * a single default send to the mastering voice. Anything the client changed
+ * beyond that is undone when the voice comes back, which is the only time a
+ * pool may allocate (or free) anything, aside from growing on a miss.
+ *
+ * Idle voices are inactive members of audio->sources, so the mixer just skips
+ * them. They also keep their engine reference, which is only given back when
+ * the mastering voice is destroyed and the idle voices go with it.
+ */
+
+static FAudioSourceVoicePool* FAudio_VOICEPOOL_Find(
+	FAudio *audio,
+	const FAudioWaveFormatEx *pSourceFormat,
+	uint32_t Flags,
+	float MaxFrequencyRatio
+) {
+	FAudioSourceVoicePool *pool = audio->voicePools;
+	while (pool != NULL)
+	{
+		if (	pool->flags == Flags &&
+			pool->maxFreqRatio == MaxFrequencyRatio &&
+			pool->format->cbSize == pSourceFormat->cbSize &&
+			FAudio_memcmp(
+				pool->format,
+				pSourceFormat,
+				sizeof(FAudioWaveFormatEx) + pSourceFormat->cbSize
+			) == 0	)
+		{
+			return pool;
+		}
+		pool = pool->next;
+	}
+	return NULL;
+}
+
+static inline void FAudio_VOICEPOOL_CountUse(FAudioSourceVoicePool *pool)
+{
+	pool->stats.VoicesInUse += 1;
+	if (pool->stats.VoicesInUse > pool->stats.HighWaterMark)
+	{
+		pool->stats.HighWaterMark = pool->stats.VoicesInUse;
+	}
+}
+
+static inline uint8_t FAudio_VOICEPOOL_HasDefaultSends(FAudioVoice *voice)
+{
+	return (	voice->sends.SendCount == 1 &&
+			voice->sends.pSends[0].pOutputVoice == voice->audio->master &&
+			voice->sends.pSends[0].Flags == 0	);
+}
+
+static inline void FAudio_VOICEPOOL_Join(
+	FAudioSourceVoicePool *pool,
+	FAudioSourceVoice *voice
+) {
+	if (pool->stats.PoolSize == pool->idleCapacity)
+	{
+		pool->idleCapacity = (pool->idleCapacity == 0) ?
+			1 :
+			pool->idleCapacity * 2;
+		pool->idle = (FAudioSourceVoice**) voice->audio->pRealloc(
+			pool->idle,
+			sizeof(FAudioSourceVoice*) * pool->idleCapacity
+		);
+	}
+	pool->stats.PoolSize += 1;
+	voice->src.pool = pool;
+}
+
+uint32_t FAudio_VOICEPOOL_Create(
+	FAudio *audio,
+	const FAudioWaveFormatEx *pSourceFormat,
+	uint32_t Flags,
+	float MaxFrequencyRatio,
+	uint32_t VoiceCount
+) {
+	uint32_t i;
+	FAudioSourceVoicePool *pool;
+	FAudioSourceVoice *voice;
+
+	FAudio_PlatformLockMutex(audio->voicePoolLock);
+	LOG_MUTEX_LOCK(audio, audio->voicePoolLock)
+
+	if (	audio->master == NULL ||
+		FAudio_VOICEPOOL_Find(
+			audio,
+			pSourceFormat,
+			Flags,
+			MaxFrequencyRatio
+		) != NULL	)
+	{
+		FAudio_PlatformUnlockMutex(audio->voicePoolLock);
+		LOG_MUTEX_UNLOCK(audio, audio->voicePoolLock)
+		return FAUDIO_E_INVALID_CALL;
+	}
+
+	pool = (FAudioSourceVoicePool*) audio->pMalloc(sizeof(FAudioSourceVoicePool));
+	FAudio_zero(pool, sizeof(FAudioSourceVoicePool));
+	pool->format = (FAudioWaveFormatEx*) audio->pMalloc(
+		sizeof(FAudioWaveFormatEx) + pSourceFormat->cbSize
+	);
+	FAudio_memcpy(
+		pool->format,
+		pSourceFormat,
+		sizeof(FAudioWaveFormatEx) + pSourceFormat->cbSize
+	);
+	pool->flags = Flags;
+	pool->maxFreqRatio = MaxFrequencyRatio;
+
+	/* The pool isn't in the list yet, so these are built from scratch */
+	for (i = 0; i < VoiceCount; i += 1)
+	{
+		FAudio_CreateSourceVoice(
+			audio,
+			&voice,
+			pSourceFormat,
+			Flags,
+			MaxFrequencyRatio,
+			NULL,
+			NULL,
+			NULL
+		);
+		FAudio_VOICEPOOL_Join(pool, voice);
+		pool->idle[pool->idleCount++] = voice;
+	}
+
+	pool->next = audio->voicePools;
+	audio->voicePools = pool;
+
+	FAudio_PlatformUnlockMutex(audio->voicePoolLock);
+	LOG_MUTEX_UNLOCK(audio, audio->voicePoolLock)
+	return 0;
+}
+
+uint32_t FAudio_VOICEPOOL_GetStatistics(
+	FAudio *audio,
+	const FAudioWaveFormatEx *pSourceFormat,
+	uint32_t Flags,
+	float MaxFrequencyRatio,
+	FAudioSourceVoicePoolStatisticsEXT *pStatistics
+) {
+	FAudioSourceVoicePool *pool;
+
+	FAudio_PlatformLockMutex(audio->voicePoolLock);
+	LOG_MUTEX_LOCK(audio, audio->voicePoolLock)
+	pool = FAudio_VOICEPOOL_Find(
+		audio,
+		pSourceFormat,
+		Flags,
+		MaxFrequencyRatio
+	);
+	if (pool != NULL)
+	{
+		*pStatistics = pool->stats;
+	}
+	FAudio_PlatformUnlockMutex(audio->voicePoolLock);
+	LOG_MUTEX_UNLOCK(audio, audio->voicePoolLock)
+
+	return (pool != NULL) ? 0 : FAUDIO_E_INVALID_CALL;
+}
+
+uint8_t FAudio_VOICEPOOL_Acquire(
+	FAudio *audio,
+	FAudioSourceVoice **ppSourceVoice,
+	const FAudioWaveFormatEx *pSourceFormat,
+	uint32_t Flags,
+	float MaxFrequencyRatio,
+	FAudioVoiceCallback *pCallback,
+	const FAudioVoiceSends *pSendList,
+	FAudioSourceVoicePool **ppMissedPool
+) {
+	uint32_t i, outChannels;
+	FAudioSourceVoicePool *pool;
+	FAudioSourceVoice *voice;
+
+	*ppMissedPool = NULL;
+
+	FAudio_PlatformLockMutex(audio->voicePoolLock);
+	LOG_MUTEX_LOCK(audio, audio->voicePoolLock)
+	pool = FAudio_VOICEPOOL_Find(
+		audio,
+		pSourceFormat,
+		Flags,
+		MaxFrequencyRatio
+	);
+	if (pool == NULL)
+	{
+		FAudio_PlatformUnlockMutex(audio->voicePoolLock);
+		LOG_MUTEX_UNLOCK(audio, audio->voicePoolLock)
+		return 0;
+	}
+	FAudio_VOICEPOOL_CountUse(pool);
+	if (pool->idleCount == 0)
+	{
+		/* The new voice will join the pool, see Join */
+		pool->stats.Misses += 1;
+		*ppMissedPool = pool;
+		FAudio_PlatformUnlockMutex(audio->voicePoolLock);
+		LOG_MUTEX_UNLOCK(audio, audio->voicePoolLock)
+		return 0;
+	}
+	pool->stats.Hits += 1;
+	voice = pool->idle[--pool->idleCount];
+	FAudio_PlatformUnlockMutex(audio->voicePoolLock);
+	LOG_MUTEX_UNLOCK(audio, audio->voicePoolLock)
+
+	/* Nobody else can see this voice yet, and the mixer skips it since
+	 * it's inactive, so just put everything back the way
+	 * CreateSourceVoice would have.
+	 */
+	voice->src.callback = pCallback;
+	voice->src.freqRatio = 1.0f;
+	voice->src.resampleFreq = 0.0f;
+	voice->src.resampleOffset = 0;
+	voice->src.curBufferOffset = 0;
+	voice->src.curBufferOffsetDec = 0;
+	voice->src.totalSamples = 0;
+	FAudio_INTERNAL_SetResamplerQuality(voice, audio->resamplerQuality);
+#ifdef HAVE_FFMPEG
+	if (voice->src.ffmpeg != NULL)
+	{
+		FAudio_FFMPEG_reset(voice);
+	}
+#endif /* HAVE_FFMPEG */
+
+	voice->volume = 1.0f;
+	for (i = 0; i < voice->outputChannels; i += 1)
+	{
+		voice->channelVolume[i] = 1.0f;
+	}
+	voice->filter.Type = FAUDIO_DEFAULT_FILTER_TYPE;
+	voice->filter.Frequency = FAUDIO_DEFAULT_FILTER_FREQUENCY;
+	voice->filter.OneOverQ = FAUDIO_DEFAULT_FILTER_ONEOVERQ;
+	if (voice->filterState != NULL)
+	{
+		FAudio_zero(
+			voice->filterState,
+			sizeof(FAudioFilterState) * voice->src.format->nChannels
+		);
+	}
+
+	if (	pSendList == NULL ||
+		(	pSendList->SendCount == 1 &&
+			pSendList->pSends[0].pOutputVoice == audio->master &&
+			pSendList->pSends[0].Flags == 0	)	)
+	{
+		/* Same sends as the idle voice, only the matrix is reset */
+		outChannels = audio->master->master.inputChannels;
+		FAudio_memcpy(
+			voice->sendCoefficients[0],
+			FAUDIO_INTERNAL_MATRIX_DEFAULTS[voice->outputChannels - 1][outChannels - 1],
+			voice->outputChannels * outChannels * sizeof(float)
+		);
+		FAudio_INTERNAL_PublishParameters(voice);
+	}
+	else
+	{
+		/* This also publishes the levels we just reset */
+		FAudioVoice_SetOutputVoices(voice, pSendList);
+	}
+
+	*ppSourceVoice = voice;
+	return 1;
+}
+
+void FAudio_VOICEPOOL_AddVoice(
+	FAudioSourceVoicePool *pool,
+	FAudioSourceVoice *voice
+) {
+	FAudio_PlatformLockMutex(voice->audio->voicePoolLock);
+	LOG_MUTEX_LOCK(voice->audio, voice->audio->voicePoolLock)
+	FAudio_VOICEPOOL_Join(pool, voice);
+	FAudio_PlatformUnlockMutex(voice->audio->voicePoolLock);
+	LOG_MUTEX_UNLOCK(voice->audio, voice->audio->voicePoolLock)
+}
+
+void FAudio_VOICEPOOL_Recycle(FAudioSourceVoice *voice)
+{
+	FAudio *audio = voice->audio;
+	FAudioSourceVoicePool *pool = voice->src.pool;
+	FAudioBufferEntry entry;
+
+	/* Stop it right away and drop its buffers. Just like DestroyVoice,
+	 * this doesn't send any callbacks for the dropped buffers.
+	 */
+	FAudio_PlatformLockMutex(audio->sourceLock);
+	LOG_MUTEX_LOCK(audio, audio->sourceLock)
+	voice->src.active = 0;
+	FAudio_INTERNAL_InvalidateRenderPlan(audio, FAUDIO_VOICE_SOURCE);
+	voice->src.hasCurBuffer = 0;
+	FAudio_INTERNAL_ReleasePCMCacheEntry(voice);
+	while (FAudio_INTERNAL_DequeueBuffer(voice, &entry));
+	FAudio_PlatformAtomicSet(&voice->src.buffersQueued, 0);
+	FAudio_PlatformAtomicSetPtr(&voice->src.curBufferContext, NULL);
+	voice->src.newBuffer = 1;
+	voice->src.callback = NULL;
+	FAudio_PlatformUnlockMutex(audio->sourceLock);
+	LOG_MUTEX_UNLOCK(audio, audio->sourceLock)
+
+	/* Undo any changes to the shape of the voice */
+	if (voice->effects.count > 0)
+	{
+		FAudioVoice_SetEffectChain(voice, NULL);
+	}
+	if (!FAudio_VOICEPOOL_HasDefaultSends(voice))
+	{
+		FAudioVoice_SetOutputVoices(voice, NULL);
+	}
+	if (voice->src.format->nSamplesPerSec != pool->format->nSamplesPerSec)
+	{
+		FAudioSourceVoice_SetSourceSampleRate(
+			voice,
+			pool->format->nSamplesPerSec
+		);
+	}
+
+	FAudio_PlatformLockMutex(audio->voicePoolLock);
+	LOG_MUTEX_LOCK(audio, audio->voicePoolLock)
+	pool->idle[pool->idleCount++] = voice;
+	pool->stats.VoicesInUse -= 1;
+	FAudio_PlatformUnlockMutex(audio->voicePoolLock);
+	LOG_MUTEX_UNLOCK(audio, audio->voicePoolLock)
+}
+
+void FAudio_VOICEPOOL_FreeIdle(FAudio *audio)
+{
+	FAudioSourceVoicePool *pool;
+	FAudioSourceVoice *voice;
+
+	FAudio_PlatformLockMutex(audio->voicePoolLock);
+	LOG_MUTEX_LOCK(audio, audio->voicePoolLock)
+	for (pool = audio->voicePools; pool != NULL; pool = pool->next)
+	{
+		while (pool->idleCount > 0)
+		{
+			voice = pool->idle[--pool->idleCount];
+			pool->stats.PoolSize -= 1;
+			voice->src.pool = NULL;
+			FAudioVoice_DestroyVoice(voice);
+		}
+	}
+	FAudio_PlatformUnlockMutex(audio->voicePoolLock);
+	LOG_MUTEX_UNLOCK(audio, audio->voicePoolLock)
+}
+
+void FAudio_VOICEPOOL_DestroyAll(FAudio *audio)
+{
+	FAudioSourceVoicePool *pool, *next;
+
+	pool = audio->voicePools;
+	while (pool != NULL)
+	{
+		next = pool->next;
+		FAudio_assert(pool->idleCount == 0);
+		audio->pFree(pool->format);
+		if (pool->idle != NULL)
+		{
+			audio->pFree(pool->idle);
+		}
+		audio->pFree(pool);
+		pool = next;
+	}
+	audio->voicePools = NULL;
+}
+
+/* vim: set noexpandtab shiftwidth=8 tabstop=8: */
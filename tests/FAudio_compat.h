@@ -1,6 +1,7 @@
 /* map xaudio2 API to faudio API */
 typedef uint32_t HRESULT;
 typedef uint32_t UINT32;
+typedef uint64_t UINT64;
 typedef uint32_t DWORD;
 typedef uint8_t BOOL;
 
@@ -15,6 +16,7 @@ typedef uint8_t BOOL;
 #define XAUDIO2_ANY_PROCESSOR FAUDIO_DEFAULT_PROCESSOR
 #define XAUDIO2_COMMIT_NOW FAUDIO_COMMIT_NOW
 #define XAUDIO2_END_OF_STREAM FAUDIO_END_OF_STREAM
+#define XAUDIO2_LOOP_INFINITE FAUDIO_LOOP_INFINITE
 
 #define WAVE_FORMAT_IEEE_FLOAT FAUDIO_FORMAT_IEEE_FLOAT
 
@@ -32,6 +34,8 @@ typedef FAudioVoiceDetails XAUDIO27_VOICE_DETAILS;
 typedef FAudioVoiceState XAUDIO2_VOICE_STATE;
 typedef FAudioWaveFormatEx WAVEFORMATEX;
 typedef FAudioPerformanceData XAUDIO2_PERFORMANCE_DATA;
+typedef FAudioSendDescriptor XAUDIO2_SEND_DESCRIPTOR;
+typedef FAudioVoiceSends XAUDIO2_VOICE_SENDS;
 
 typedef FAudioEngineCallback IXAudio2EngineCallback;
 typedef FAudioVoiceCallback IXAudio2VoiceCallback;
@@ -39,6 +43,7 @@ typedef FAudioVoiceCallback IXAudio2VoiceCallback;
 typedef FAPO IXAPO;
 
 typedef FAudio IXAudio27;
+#define IXAudio27_CommitChanges FAudio_CommitOperationSet
 #define IXAudio27_CreateMasteringVoice FAudio_CreateMasteringVoice
 #define IXAudio27_CreateSourceVoice FAudio_CreateSourceVoice
 #define IXAudio27_CreateSubmixVoice FAudio_CreateSubmixVoice
@@ -53,6 +58,7 @@ typedef FAudio IXAudio27;
 #define IXAudio27_UnregisterForCallbacks FAudio_UnregisterForCallbacks
 
 typedef FAudio IXAudio2;
+#define IXAudio2_CommitChanges FAudio_CommitOperationSet
 #define IXAudio2_CreateMasteringVoice FAudio_CreateMasteringVoice
 #define IXAudio2_CreateSourceVoice FAudio_CreateSourceVoice
 #define IXAudio2_CreateSubmixVoice FAudio_CreateSubmixVoice
@@ -74,8 +80,10 @@ typedef FAudioSourceVoice IXAudio27SourceVoice;
 #define IXAudio27SourceVoice_FlushSourceBuffers FAudioSourceVoice_FlushSourceBuffers
 #define IXAudio27SourceVoice_GetState(a,b) FAudioSourceVoice_GetState(a,b,0)
 #define IXAudio27SourceVoice_GetVoiceDetails FAudioVoice_GetVoiceDetails
+#define IXAudio27SourceVoice_GetVolume FAudioVoice_GetVolume
 #define IXAudio27SourceVoice_SetChannelVolumes FAudioVoice_SetChannelVolumes
 #define IXAudio27SourceVoice_SetSourceSampleRate FAudioSourceVoice_SetSourceSampleRate
+#define IXAudio27SourceVoice_SetVolume FAudioVoice_SetVolume
 #define IXAudio27SourceVoice_Start FAudioSourceVoice_Start
 #define IXAudio27SourceVoice_Stop FAudioSourceVoice_Stop
 #define IXAudio27SourceVoice_SubmitSourceBuffer FAudioSourceVoice_SubmitSourceBuffer
@@ -86,8 +94,10 @@ typedef FAudioSourceVoice IXAudio2SourceVoice;
 #define IXAudio2SourceVoice_FlushSourceBuffers FAudioSourceVoice_FlushSourceBuffers
 #define IXAudio2SourceVoice_GetState FAudioSourceVoice_GetState
 #define IXAudio2SourceVoice_GetVoiceDetails FAudioVoice_GetVoiceDetails
+#define IXAudio2SourceVoice_GetVolume FAudioVoice_GetVolume
 #define IXAudio2SourceVoice_SetChannelVolumes FAudioVoice_SetChannelVolumes
 #define IXAudio2SourceVoice_SetSourceSampleRate FAudioSourceVoice_SetSourceSampleRate
+#define IXAudio2SourceVoice_SetVolume FAudioVoice_SetVolume
 #define IXAudio2SourceVoice_Start FAudioSourceVoice_Start
 #define IXAudio2SourceVoice_Stop FAudioSourceVoice_Stop
 #define IXAudio2SourceVoice_SubmitSourceBuffer FAudioSourceVoice_SubmitSourceBuffer
@@ -99,3 +109,6 @@ typedef FAudioSubmixVoice IXAudio27SubmixVoice;
 typedef FAudioSubmixVoice IXAudio2SubmixVoice;
 #define IXAudio2SubmixVoice_GetVoiceDetails FAudioVoice_GetVoiceDetails
 #define IXAudio2SubmixVoice_DestroyVoice FAudioVoice_DestroyVoice
+#define IXAudio2SubmixVoice_SetOutputVoices FAudioVoice_SetOutputVoices
+
+typedef FAudioVoice IXAudio2Voice;
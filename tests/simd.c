@@ -0,0 +1,887 @@
+/* FAudio SIMD tests
+ *
+ * This tests FAudio's SIMD functions against their scalar versions. Unlike
+ * xaudio2.c, this is built against FAudio's internals and only runs on the
+ * host.
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from
+ * the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software in a
+ * product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "FAudio_internal.h"
+
+#include <SDL.h>
+
+#include <stdarg.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+
+static int failure_count = 0;
+static int success_count = 0;
+
+static void ok_(const char *file, int line, int success, const char *fmt, ...) __attribute__((format(printf, 4, 5)));
+#define ok(success, fmt, ...) ok_(__FILE__, __LINE__, success, fmt, ##__VA_ARGS__)
+static void ok_(const char *file, int line, int success, const char *fmt, ...)
+{
+    if(!success){
+        va_list va;
+        va_start(va, fmt);
+        fprintf(stdout, "test failed (%s:%u): ", file, line);
+        vfprintf(stdout, fmt, va);
+        va_end(va);
+        ++failure_count;
+    }else
+        ++success_count;
+}
+
+/* Deterministic, so failures can be reproduced */
+static unsigned int rand_state = 1;
+static float rand_float(float min, float max)
+{
+    rand_state = rand_state * 1103515245 + 12345;
+    return min + (max - min) * ((rand_state >> 8) & 0xFFFF) / 65535.0f;
+}
+
+/* SIMD results may be off by a rounding step where the compiler fuses
+ * multiplies and adds differently than it did for the scalar version.
+ */
+static int float_close(float a, float b)
+{
+    float scale = FAudio_max(1.0f, FAudio_max(FAudio_fabsf(a), FAudio_fabsf(b)));
+    return FAudio_fabsf(a - b) <= 1e-5f * scale;
+}
+
+#define MAX_FRAMES 67
+#define MAX_CHANNELS 10
+
+/* Set by main() for each tier, so failures say which one broke */
+static const char *tier_name = "";
+
+/* Worst error seen for each kernel in the current tier. Every name in
+ * FAudio_INTERNAL_SIMDKernels has to end up here, or main() fails the tier.
+ */
+#define MAX_KERNELS 64
+static struct
+{
+    const char *name;
+    uint32_t checks;
+    double max_abs;
+    uint32_t max_ulp;
+    uint32_t benched;
+} kernels[MAX_KERNELS];
+static uint32_t kernel_count = 0;
+
+static uint32_t find_kernel(const char *name)
+{
+    uint32_t i;
+    for(i = 0; i < kernel_count; ++i)
+        if(FAudio_strcmp(kernels[i].name, name) == 0)
+            return i;
+    FAudio_assert(kernel_count < MAX_KERNELS);
+    FAudio_zero(&kernels[kernel_count], sizeof(kernels[0]));
+    kernels[kernel_count].name = name;
+    return kernel_count++;
+}
+
+/* Steps between two floats, with the negatives mirrored so that -0 and +0 are
+ * next to each other
+ */
+static uint32_t ulp_distance(float a, float b)
+{
+    int32_t ia, ib;
+    int64_t la, lb;
+    memcpy(&ia, &a, sizeof(ia));
+    memcpy(&ib, &b, sizeof(ib));
+    la = (ia < 0) ? (int64_t) INT32_MIN - ia : ia;
+    lb = (ib < 0) ? (int64_t) INT32_MIN - ib : ib;
+    return (uint32_t) FAudio_min((la > lb) ? la - lb : lb - la, (int64_t) UINT32_MAX);
+}
+
+/* Returns how many samples differ, while keeping track of the kernel's worst
+ * error. exact is for kernels that must match the scalar code bit for bit.
+ */
+static uint32_t compare_floats(const char *name, const float *simd,
+        const float *scalar, uint32_t len, int exact)
+{
+    uint32_t k = find_kernel(name);
+    uint32_t i, mismatches = 0;
+    kernels[k].checks += 1;
+    for(i = 0; i < len; ++i){
+        kernels[k].max_abs = FAudio_max(kernels[k].max_abs,
+                FAudio_fabsf(simd[i] - scalar[i]));
+        kernels[k].max_ulp = FAudio_max(kernels[k].max_ulp,
+                ulp_distance(simd[i], scalar[i]));
+        if(exact ? simd[i] != scalar[i] : !float_close(simd[i], scalar[i]))
+            ++mismatches;
+    }
+    return mismatches;
+}
+
+/* Same for int16 output, where both errors are in LSBs */
+static uint32_t compare_s16(const char *name, const int16_t *simd,
+        const int16_t *scalar, uint32_t len)
+{
+    uint32_t k = find_kernel(name);
+    uint32_t i, diff, mismatches = 0;
+    kernels[k].checks += 1;
+    for(i = 0; i < len; ++i){
+        diff = (uint32_t) FAudio_abs((int32_t) simd[i] - scalar[i]);
+        kernels[k].max_abs = FAudio_max(kernels[k].max_abs, (double) diff);
+        kernels[k].max_ulp = FAudio_max(kernels[k].max_ulp, diff);
+        if(diff != 0)
+            ++mismatches;
+    }
+    return mismatches;
+}
+
+/* Odd sizes and offsets, to cover both the vectors and the leftovers */
+static const uint32_t frame_counts[] = { 0, 1, 2, 3, 5, 8, 17, 64, 67 };
+static const uint32_t offsets[] = { 0, 1, 3 };
+
+static void test_converters(void)
+{
+    uint8_t src_u8[MAX_FRAMES + 4];
+    int16_t src_s16[MAX_FRAMES + 4];
+    uint8_t src_s24[(MAX_FRAMES + 4) * 3];
+    float src_f32[MAX_FRAMES + 4];
+    float dst_simd[MAX_FRAMES + 4];
+    float dst_scalar[MAX_FRAMES + 4];
+    int16_t dst_s16_simd[MAX_FRAMES + 4];
+    int16_t dst_s16_scalar[MAX_FRAMES + 4];
+    uint32_t i, f, o, mismatches;
+
+    for(f = 0; f < sizeof(frame_counts) / sizeof(frame_counts[0]); ++f){
+        for(o = 0; o < sizeof(offsets) / sizeof(offsets[0]); ++o){
+            for(i = 0; i < sizeof(src_u8) / sizeof(src_u8[0]); ++i){
+                src_u8[i] = (uint8_t) rand_float(0.0f, 255.0f);
+                src_s16[i] = (int16_t) rand_float(-32768.0f, 32767.0f);
+                src_f32[i] = rand_float(-1.25f, 1.25f);
+            }
+            for(i = 0; i < sizeof(src_s24); ++i)
+                src_s24[i] = (uint8_t) rand_float(0.0f, 255.0f);
+            /* The extremes are where a bad sign extension would show */
+            src_u8[offsets[o]] = 255;
+            src_s16[offsets[o]] = -32768;
+            src_s24[offsets[o] * 3 + 0] = 0x00;
+            src_s24[offsets[o] * 3 + 1] = 0x00;
+            src_s24[offsets[o] * 3 + 2] = 0x80;
+            src_s24[offsets[o] * 3 + 3] = 0xFF;
+            src_s24[offsets[o] * 3 + 4] = 0xFF;
+            src_s24[offsets[o] * 3 + 5] = 0x7F;
+
+            /* Both are exact, so the results must be identical */
+            memset(dst_simd, 0, sizeof(dst_simd));
+            memset(dst_scalar, 0, sizeof(dst_scalar));
+            FAudio_INTERNAL_Convert_U8_To_F32(src_u8 + offsets[o],
+                    dst_simd + offsets[o], frame_counts[f]);
+            FAudio_INTERNAL_Convert_U8_To_F32_Scalar(src_u8 + offsets[o],
+                    dst_scalar + offsets[o], frame_counts[f]);
+            mismatches = compare_floats("Convert_U8_To_F32", dst_simd, dst_scalar,
+                    sizeof(dst_simd) / sizeof(dst_simd[0]), 1);
+            ok(mismatches == 0, "%s Convert_U8_To_F32 (%u samples, offset %u): %u samples differ\n",
+                    tier_name, frame_counts[f], offsets[o], mismatches);
+
+            memset(dst_simd, 0, sizeof(dst_simd));
+            memset(dst_scalar, 0, sizeof(dst_scalar));
+            FAudio_INTERNAL_Convert_S16_To_F32(src_s16 + offsets[o],
+                    dst_simd + offsets[o], frame_counts[f]);
+            FAudio_INTERNAL_Convert_S16_To_F32_Scalar(src_s16 + offsets[o],
+                    dst_scalar + offsets[o], frame_counts[f]);
+            mismatches = compare_floats("Convert_S16_To_F32", dst_simd, dst_scalar,
+                    sizeof(dst_simd) / sizeof(dst_simd[0]), 1);
+            ok(mismatches == 0, "%s Convert_S16_To_F32 (%u samples, offset %u): %u samples differ\n",
+                    tier_name, frame_counts[f], offsets[o], mismatches);
+
+            memset(dst_simd, 0, sizeof(dst_simd));
+            memset(dst_scalar, 0, sizeof(dst_scalar));
+            FAudio_INTERNAL_Convert_S24_To_F32(src_s24 + offsets[o] * 3,
+                    dst_simd + offsets[o], frame_counts[f]);
+            FAudio_INTERNAL_Convert_S24_To_F32_Scalar(src_s24 + offsets[o] * 3,
+                    dst_scalar + offsets[o], frame_counts[f]);
+            mismatches = compare_floats("Convert_S24_To_F32", dst_simd, dst_scalar,
+                    sizeof(dst_simd) / sizeof(dst_simd[0]), 1);
+            ok(mismatches == 0, "%s Convert_S24_To_F32 (%u samples, offset %u): %u samples differ\n",
+                    tier_name, frame_counts[f], offsets[o], mismatches);
+            if(frame_counts[f] >= 2)
+                ok(dst_scalar[offsets[o]] < -1.0f && dst_scalar[offsets[o] + 1] == 1.0f,
+                        "%s Convert_S24_To_F32: extremes converted to %f and %f\n",
+                        tier_name, dst_scalar[offsets[o]], dst_scalar[offsets[o] + 1]);
+
+            /* Clipping and rounding ties are where the tiers could differ */
+            if(frame_counts[f] >= 4){
+                src_f32[offsets[o]] = -2.0f;
+                src_f32[offsets[o] + 1] = 2.0f;
+                src_f32[offsets[o] + 2] = 0.5f / 32768.0f;
+                src_f32[offsets[o] + 3] = -1.5f / 32768.0f;
+            }
+            memset(dst_s16_simd, 0, sizeof(dst_s16_simd));
+            memset(dst_s16_scalar, 0, sizeof(dst_s16_scalar));
+            FAudio_INTERNAL_Convert_F32_To_S16(src_f32 + offsets[o],
+                    dst_s16_simd + offsets[o], frame_counts[f]);
+            FAudio_INTERNAL_Convert_F32_To_S16_Scalar(src_f32 + offsets[o],
+                    dst_s16_scalar + offsets[o], frame_counts[f]);
+            mismatches = compare_s16("Convert_F32_To_S16", dst_s16_simd, dst_s16_scalar,
+                    sizeof(dst_s16_simd) / sizeof(dst_s16_simd[0]));
+            ok(mismatches == 0, "%s Convert_F32_To_S16 (%u samples, offset %u): %u samples differ\n",
+                    tier_name, frame_counts[f], offsets[o], mismatches);
+            if(frame_counts[f] >= 4)
+                ok(dst_s16_scalar[offsets[o]] == -32768 && dst_s16_scalar[offsets[o] + 1] == 32767 &&
+                        dst_s16_scalar[offsets[o] + 2] == 0 && dst_s16_scalar[offsets[o] + 3] == -2,
+                        "%s Convert_F32_To_S16: edge cases converted to %d %d %d %d\n",
+                        tier_name, dst_s16_scalar[offsets[o]], dst_s16_scalar[offsets[o] + 1],
+                        dst_s16_scalar[offsets[o] + 2], dst_s16_scalar[offsets[o] + 3]);
+        }
+    }
+}
+
+static void test_amplify(void)
+{
+    float out_simd[MAX_FRAMES + 4];
+    float out_scalar[MAX_FRAMES + 4];
+    float volume;
+    uint32_t i, f, o, mismatches;
+
+    for(f = 0; f < sizeof(frame_counts) / sizeof(frame_counts[0]); ++f){
+        for(o = 0; o < sizeof(offsets) / sizeof(offsets[0]); ++o){
+            for(i = 0; i < sizeof(out_simd) / sizeof(out_simd[0]); ++i)
+                out_simd[i] = out_scalar[i] = rand_float(-2.0f, 2.0f);
+            /* Loud enough to hit the clamp some of the time */
+            volume = rand_float(0.0f, FAUDIO_MAX_VOLUME_LEVEL);
+
+            FAudio_INTERNAL_Amplify(out_simd + offsets[o], frame_counts[f], volume);
+            FAudio_INTERNAL_Amplify_Scalar(out_scalar + offsets[o], frame_counts[f], volume);
+
+            mismatches = compare_floats("Amplify", out_simd, out_scalar,
+                    sizeof(out_simd) / sizeof(out_simd[0]), 0);
+            ok(mismatches == 0, "%s Amplify (%u samples, offset %u): %u samples differ\n",
+                    tier_name, frame_counts[f], offsets[o], mismatches);
+        }
+    }
+}
+
+static void test_resample(const char *name, FAudioResampleCallback simd,
+        FAudioResampleCallback scalar, uint8_t channels)
+{
+    /* Slower and faster than 1:1, including common rate conversions, plus a
+     * few arbitrary steps that no fixed list would think of
+     */
+    const double ratios[] = {
+        0.5, 1.0, 44100.0 / 48000.0, 48000.0 / 44100.0, 2.0, 3.7,
+        rand_float(0.1f, 3.9f), rand_float(0.1f, 3.9f), rand_float(0.1f, 3.9f)
+    };
+    float src[(MAX_FRAMES * 4 + 2) * 8];
+    float dst_simd[MAX_FRAMES * 8 + 8];
+    float dst_scalar[MAX_FRAMES * 8 + 8];
+    uint64_t step, start, offset_simd, offset_scalar;
+    uint32_t i, f, r, mismatches;
+
+    for(i = 0; i < sizeof(src) / sizeof(src[0]); ++i)
+        src[i] = rand_float(-1.0f, 1.0f);
+
+    for(r = 0; r < sizeof(ratios) / sizeof(ratios[0]); ++r){
+        step = DOUBLE_TO_FIXED(ratios[r]);
+        for(f = 0; f < sizeof(frame_counts) / sizeof(frame_counts[0]); ++f){
+            /* Start somewhere between two samples */
+            start = DOUBLE_TO_FIXED(rand_float(0.0f, 0.999f));
+            offset_simd = offset_scalar = start;
+            memset(dst_simd, 0, sizeof(dst_simd));
+            memset(dst_scalar, 0, sizeof(dst_scalar));
+
+            simd(src, dst_simd, &offset_simd, step, frame_counts[f], channels);
+            scalar(src, dst_scalar, &offset_scalar, step, frame_counts[f], channels);
+
+            mismatches = compare_floats(name, dst_simd, dst_scalar,
+                    sizeof(dst_simd) / sizeof(dst_simd[0]), 0);
+            ok(mismatches == 0, "%s %s (ratio %f, %u frames): %u samples differ\n",
+                    tier_name, name, ratios[r], frame_counts[f], mismatches);
+            ok(offset_simd == offset_scalar, "%s %s (ratio %f, %u frames): offset %llu, expected %llu\n",
+                    tier_name, name, ratios[r], frame_counts[f],
+                    (unsigned long long) offset_simd,
+                    (unsigned long long) offset_scalar);
+        }
+    }
+}
+
+/* The integer ratio resamplers must match ResampleGeneric; the scalar ones
+ * exactly, since they do the same math with the fractions computed up front.
+ */
+static void test_ratio_resample(const char *name, FAudioResampleCallback simd,
+        const double *ratios, uint8_t channels, int exact)
+{
+    /* Including a start where the fractions need to wrap around first */
+    const double starts[] = { 0.0, 0.75, rand_float(0.0f, 0.999f) };
+    float src[(MAX_FRAMES * 4 + 2) * 6];
+    float dst_simd[MAX_FRAMES * 6 + 8];
+    float dst_generic[MAX_FRAMES * 6 + 8];
+    uint64_t step, offset_simd, offset_generic;
+    uint32_t i, f, r, s, mismatches;
+
+    for(i = 0; i < sizeof(src) / sizeof(src[0]); ++i)
+        src[i] = rand_float(-1.0f, 1.0f);
+
+    for(r = 0; r < 2; ++r){
+        step = DOUBLE_TO_FIXED(ratios[r]);
+        for(f = 0; f < sizeof(frame_counts) / sizeof(frame_counts[0]); ++f){
+            for(s = 0; s < sizeof(starts) / sizeof(starts[0]); ++s){
+                /* Offsets carry whole frames too, those must be left alone */
+                offset_simd = offset_generic = (5ull << FIXED_PRECISION) + DOUBLE_TO_FIXED(starts[s]);
+                memset(dst_simd, 0, sizeof(dst_simd));
+                memset(dst_generic, 0, sizeof(dst_generic));
+
+                simd(src, dst_simd, &offset_simd, step, frame_counts[f], channels);
+                FAudio_INTERNAL_ResampleGeneric(src, dst_generic, &offset_generic, step,
+                        frame_counts[f], channels);
+
+                mismatches = compare_floats(name, dst_simd, dst_generic,
+                        sizeof(dst_simd) / sizeof(dst_simd[0]), exact);
+                ok(mismatches == 0, "%s %s (ratio %f, %u frames, start %f): %u samples differ\n",
+                        tier_name, name, ratios[r], frame_counts[f], starts[s], mismatches);
+                ok(offset_simd == offset_generic, "%s %s (ratio %f, %u frames, start %f): offset %llu, expected %llu\n",
+                        tier_name, name, ratios[r], frame_counts[f], starts[s],
+                        (unsigned long long) offset_simd,
+                        (unsigned long long) offset_generic);
+            }
+        }
+    }
+}
+
+static void test_resamplers(void)
+{
+    static const double up[] = { 0.5, 0.25 };
+    static const double down[] = { 2.0, 4.0 };
+
+    test_resample("ResampleMono", FAudio_INTERNAL_ResampleMono,
+            FAudio_INTERNAL_ResampleMono_Scalar, 1);
+    test_resample("ResampleStereo", FAudio_INTERNAL_ResampleStereo,
+            FAudio_INTERNAL_ResampleStereo_Scalar, 2);
+    test_resample("Resample4Channel", FAudio_INTERNAL_Resample4Channel,
+            FAudio_INTERNAL_ResampleGeneric, 4);
+    test_resample("Resample6Channel", FAudio_INTERNAL_Resample6Channel,
+            FAudio_INTERNAL_ResampleGeneric, 6);
+    test_resample("Resample8Channel", FAudio_INTERNAL_Resample8Channel,
+            FAudio_INTERNAL_ResampleGeneric, 8);
+
+    test_ratio_resample("ResampleUpMono", FAudio_INTERNAL_ResampleUpMono, up, 1, 0);
+    test_ratio_resample("ResampleUpStereo", FAudio_INTERNAL_ResampleUpStereo, up, 2, 0);
+    test_ratio_resample("ResampleDownMono", FAudio_INTERNAL_ResampleDownMono, down, 1, 0);
+    test_ratio_resample("ResampleDownStereo", FAudio_INTERNAL_ResampleDownStereo, down, 2, 0);
+    test_ratio_resample("ResampleUpGeneric", FAudio_INTERNAL_ResampleUpGeneric, up, 6, 1);
+    test_ratio_resample("ResampleDownGeneric", FAudio_INTERNAL_ResampleDownGeneric, down, 6, 1);
+}
+
+/* Shared by the sinc tests and the benchmark, built once by main() */
+static float sinc_table[SINC_TABLE_SIZE];
+
+static const float *get_sinc_table(double ratio)
+{
+    uint32_t i = 0;
+    while(i < SINC_CUTOFFS - 1 && ratio > FAUDIO_INTERNAL_SINC_STEPS[i])
+        ++i;
+    return sinc_table + i * SINC_PHASES * SINC_ROW;
+}
+
+static void test_sinc_resample(const char *name, FAudioSincResampleCallback simd,
+        FAudioSincResampleCallback scalar, uint8_t channels)
+{
+    const double ratios[] = {
+        0.5, 44100.0 / 48000.0, 48000.0 / 44100.0, 1.5, 2.0, 3.7, 6.0,
+        rand_float(0.1f, 5.9f), rand_float(0.1f, 5.9f)
+    };
+    /* The resamplers read SINC_HISTORY frames before src */
+    float src_buf[(SINC_HISTORY + MAX_FRAMES * 6 + 2) * 2];
+    float *src = src_buf + SINC_HISTORY * channels;
+    float dst_simd[MAX_FRAMES * 2 + 8];
+    float dst_scalar[MAX_FRAMES * 2 + 8];
+    uint64_t step, start, offset_simd, offset_scalar;
+    uint32_t i, f, r, mismatches;
+
+    for(i = 0; i < sizeof(src_buf) / sizeof(src_buf[0]); ++i)
+        src_buf[i] = rand_float(-1.0f, 1.0f);
+
+    for(r = 0; r < sizeof(ratios) / sizeof(ratios[0]); ++r){
+        step = DOUBLE_TO_FIXED(ratios[r]);
+        for(f = 0; f < sizeof(frame_counts) / sizeof(frame_counts[0]); ++f){
+            start = DOUBLE_TO_FIXED(rand_float(0.0f, 0.999f));
+            offset_simd = offset_scalar = start;
+            memset(dst_simd, 0, sizeof(dst_simd));
+            memset(dst_scalar, 0, sizeof(dst_scalar));
+
+            simd(src, dst_simd, &offset_simd, step, frame_counts[f], channels,
+                    get_sinc_table(ratios[r]));
+            scalar(src, dst_scalar, &offset_scalar, step, frame_counts[f], channels,
+                    get_sinc_table(ratios[r]));
+
+            mismatches = compare_floats(name, dst_simd, dst_scalar,
+                    sizeof(dst_simd) / sizeof(dst_simd[0]), 0);
+            ok(mismatches == 0, "%s %s (ratio %f, %u frames): %u samples differ\n",
+                    tier_name, name, ratios[r], frame_counts[f], mismatches);
+            ok(offset_simd == offset_scalar, "%s %s (ratio %f, %u frames): offset %llu, expected %llu\n",
+                    tier_name, name, ratios[r], frame_counts[f],
+                    (unsigned long long) offset_simd,
+                    (unsigned long long) offset_scalar);
+        }
+    }
+}
+
+/* Checks the table itself: DC stays DC, and a sine comes out as the same sine,
+ * SINC_DELAY frames late
+ */
+static void test_sinc_response(void)
+{
+    const double pi = FAudio_acos(-1.0);
+    const double ratio = 44100.0 / 48000.0;
+    const double freq = 0.05; /* Cycles per input frame, about 2.2kHz at 44.1kHz */
+    float src_buf[SINC_HISTORY + MAX_FRAMES * 2 + 2];
+    float *src = src_buf + SINC_HISTORY;
+    float dst[MAX_FRAMES];
+    double expected, worst_dc = 0.0, worst_sine = 0.0;
+    uint64_t offset;
+    uint32_t i;
+
+    for(i = 0; i < sizeof(src_buf) / sizeof(src_buf[0]); ++i)
+        src_buf[i] = 0.5f;
+    offset = 0;
+    FAudio_INTERNAL_ResampleSincMono_Scalar(src, dst, &offset,
+            DOUBLE_TO_FIXED(ratio), MAX_FRAMES, 1, get_sinc_table(ratio));
+    for(i = 0; i < MAX_FRAMES; ++i)
+        worst_dc = FAudio_max(worst_dc, FAudio_fabsf(dst[i] - 0.5f));
+    ok(worst_dc < 1e-5, "%s sinc DC error %g\n", tier_name, worst_dc);
+
+    for(i = 0; i < sizeof(src_buf) / sizeof(src_buf[0]); ++i)
+        src_buf[i] = (float) FAudio_sin(2.0 * pi * freq * ((double) i - SINC_HISTORY));
+    offset = 0;
+    FAudio_INTERNAL_ResampleSincMono(src, dst, &offset,
+            DOUBLE_TO_FIXED(ratio), MAX_FRAMES, 1, get_sinc_table(ratio));
+    for(i = 0; i < MAX_FRAMES; ++i){
+        expected = FAudio_sin(2.0 * pi * freq * (i * ratio - SINC_DELAY));
+        worst_sine = FAudio_max(worst_sine, FAudio_fabsf((float) (dst[i] - expected)));
+    }
+    /* -80dB, roughly what the window is designed for */
+    ok(worst_sine < 1e-4, "%s sinc sine error %g\n", tier_name, worst_sine);
+}
+
+static void test_sinc_resamplers(void)
+{
+    test_sinc_resample("ResampleSincMono", FAudio_INTERNAL_ResampleSincMono,
+            FAudio_INTERNAL_ResampleSincMono_Scalar, 1);
+    test_sinc_resample("ResampleSincStereo", FAudio_INTERNAL_ResampleSincStereo,
+            FAudio_INTERNAL_ResampleSincStereo_Scalar, 2);
+    test_sinc_resample("ResampleSincGeneric (mono)", FAudio_INTERNAL_ResampleSincGeneric,
+            FAudio_INTERNAL_ResampleSincMono_Scalar, 1);
+    test_sinc_resample("ResampleSincGeneric (stereo)", FAudio_INTERNAL_ResampleSincGeneric,
+            FAudio_INTERNAL_ResampleSincStereo_Scalar, 2);
+    test_sinc_response();
+}
+
+static void random_filter(FAudioFilterParameters *filter, FAudioFilterState *state,
+        uint32_t channels)
+{
+    uint32_t i, k;
+    filter->Type = (FAudioFilterType) (rand_state % 4);
+    filter->Frequency = rand_float(0.01f, FAUDIO_MAX_FILTER_FREQUENCY);
+    filter->OneOverQ = rand_float(0.1f, FAUDIO_MAX_FILTER_ONEOVERQ);
+    for(i = 0; i < channels; ++i)
+        for(k = 0; k < 4; ++k)
+            state[i][k] = rand_float(-1.0f, 1.0f);
+}
+
+static uint32_t count_state_mismatches(const char *name, FAudioFilterState *a,
+        FAudioFilterState *b, uint32_t channels)
+{
+    return compare_floats(name, a[0], b[0], channels * 4, 0);
+}
+
+static void test_filters(void)
+{
+    static const uint16_t channel_counts[] = { 1, 2, 3, 4, 6, 8 };
+    float samples_simd[FILTER_MONO_BATCH][MAX_FRAMES * 8];
+    float samples_scalar[FILTER_MONO_BATCH][MAX_FRAMES * 8];
+    FAudioFilterParameters filters[FILTER_MONO_BATCH];
+    FAudioFilterState state_simd[FILTER_MONO_BATCH][8];
+    FAudioFilterState state_scalar[FILTER_MONO_BATCH][8];
+    const FAudioFilterParameters *batch_filters[FILTER_MONO_BATCH];
+    FAudioFilterState *batch_states[FILTER_MONO_BATCH];
+    float *batch_samples[FILTER_MONO_BATCH];
+    uint32_t batch_counts[FILTER_MONO_BATCH];
+    uint32_t c, f, i, n, mismatches;
+
+    /* One voice, a channel per lane */
+    for(c = 0; c < sizeof(channel_counts) / sizeof(channel_counts[0]); ++c){
+        for(f = 0; f < sizeof(frame_counts) / sizeof(frame_counts[0]); ++f){
+            random_filter(&filters[0], state_scalar[0], channel_counts[c]);
+            memcpy(state_simd[0], state_scalar[0], sizeof(state_simd[0]));
+            for(i = 0; i < MAX_FRAMES * 8; ++i)
+                samples_simd[0][i] = samples_scalar[0][i] = rand_float(-1.0f, 1.0f);
+
+            FAudio_INTERNAL_FilterVoice(&filters[0], state_simd[0],
+                    samples_simd[0], frame_counts[f], channel_counts[c]);
+            FAudio_INTERNAL_FilterVoice_Scalar(&filters[0], state_scalar[0],
+                    samples_scalar[0], frame_counts[f], channel_counts[c]);
+
+            mismatches = count_state_mismatches("FilterVoice", state_simd[0],
+                    state_scalar[0], channel_counts[c]);
+            mismatches += compare_floats("FilterVoice", samples_simd[0],
+                    samples_scalar[0], MAX_FRAMES * 8, 0);
+            ok(mismatches == 0, "%s FilterVoice (%u ch, %u frames, type %u): %u values differ\n",
+                    tier_name, channel_counts[c], frame_counts[f],
+                    filters[0].Type, mismatches);
+        }
+    }
+
+    /* Several mono voices, a voice per lane, not all the same length */
+    for(n = 1; n <= FILTER_MONO_BATCH; ++n){
+        for(f = 0; f < sizeof(frame_counts) / sizeof(frame_counts[0]); ++f){
+            for(i = 0; i < n; ++i){
+                random_filter(&filters[i], state_scalar[i], 1);
+                memcpy(state_simd[i], state_scalar[i], sizeof(state_simd[i]));
+                batch_filters[i] = &filters[i];
+                batch_states[i] = state_simd[i];
+                batch_samples[i] = samples_simd[i];
+                batch_counts[i] = (frame_counts[f] + i * 5) % (MAX_FRAMES + 1);
+                for(c = 0; c < MAX_FRAMES * 8; ++c)
+                    samples_simd[i][c] = samples_scalar[i][c] = rand_float(-1.0f, 1.0f);
+            }
+
+            FAudio_INTERNAL_FilterMonoBatch(batch_filters, batch_states,
+                    batch_samples, batch_counts, n);
+
+            mismatches = 0;
+            for(i = 0; i < n; ++i){
+                FAudio_INTERNAL_FilterVoice_Scalar(&filters[i], state_scalar[i],
+                        samples_scalar[i], batch_counts[i], 1);
+                mismatches += count_state_mismatches("FilterMonoBatch",
+                        state_simd[i], state_scalar[i], 1);
+                mismatches += compare_floats("FilterMonoBatch", samples_simd[i],
+                        samples_scalar[i], MAX_FRAMES * 8, 0);
+            }
+            ok(mismatches == 0, "%s FilterMonoBatch (%u voices, %u frames): %u values differ\n",
+                    tier_name, n, frame_counts[f], mismatches);
+        }
+    }
+}
+
+static void test_mix(const char *name, FAudioMixCallback simd,
+        FAudioMixCallback scalar, uint32_t srcChans, uint32_t dstChans)
+{
+    float src[MAX_FRAMES * MAX_CHANNELS + 4];
+    float dst_simd[MAX_FRAMES * MAX_CHANNELS + 4];
+    float dst_scalar[MAX_FRAMES * MAX_CHANNELS + 4];
+    float channelVolume[MAX_CHANNELS];
+    float coefficients[MAX_CHANNELS * MAX_CHANNELS];
+    float baseVolume, range;
+    uint32_t i, f, o, loud, mismatches;
+
+    for(loud = 0; loud < 2; ++loud){
+        /* The loud pass pushes the output past FAUDIO_MAX_VOLUME_LEVEL */
+        range = loud ? FAUDIO_MAX_VOLUME_LEVEL : 1.0f;
+
+        for(f = 0; f < sizeof(frame_counts) / sizeof(frame_counts[0]); ++f){
+            for(o = 0; o < sizeof(offsets) / sizeof(offsets[0]); ++o){
+                for(i = 0; i < sizeof(src) / sizeof(src[0]); ++i)
+                    src[i] = rand_float(-range, range);
+                for(i = 0; i < sizeof(dst_simd) / sizeof(dst_simd[0]); ++i)
+                    dst_simd[i] = dst_scalar[i] = rand_float(-range, range);
+                for(i = 0; i < srcChans; ++i)
+                    channelVolume[i] = rand_float(0.0f, 2.0f);
+                for(i = 0; i < srcChans * dstChans; ++i)
+                    coefficients[i] = rand_float(-1.0f, 1.0f);
+                baseVolume = rand_float(0.0f, 4.0f);
+
+                simd(frame_counts[f], srcChans, dstChans, baseVolume,
+                        src + offsets[o], dst_simd + offsets[o],
+                        channelVolume, coefficients);
+                scalar(frame_counts[f], srcChans, dstChans, baseVolume,
+                        src + offsets[o], dst_scalar + offsets[o],
+                        channelVolume, coefficients);
+
+                /* Everything past the mixed frames must be untouched too */
+                mismatches = compare_floats(name, dst_simd, dst_scalar,
+                        sizeof(dst_simd) / sizeof(dst_simd[0]), 0);
+                ok(mismatches == 0, "%s %s (%u -> %u ch, %u frames, offset %u, %s): %u samples differ\n",
+                        tier_name, name, srcChans, dstChans, frame_counts[f], offsets[o],
+                        loud ? "loud" : "quiet", mismatches);
+            }
+        }
+    }
+}
+
+static void test_mixers(void)
+{
+    static const uint32_t generic_layouts[][2] = {
+        { 1, 1 }, { 1, 3 }, { 1, 4 }, { 2, 3 }, { 2, 4 }, { 3, 2 },
+        { 4, 2 }, { 6, 1 }, { 6, 2 }, { 6, 6 }, { 6, 8 }, { 8, 2 },
+        { 8, 6 }, { 8, 8 }, { 10, 2 }, { 2, 10 }
+    };
+    uint32_t i, srcChans, dstChans;
+
+#define TEST_MIX(type, srcChans, dstChans) \
+    test_mix("Mix_" #type, FAudio_INTERNAL_Mix_##type, \
+            FAudio_INTERNAL_Mix_##type##_Scalar, srcChans, dstChans)
+    TEST_MIX(1in_1out, 1, 1);
+    TEST_MIX(1in_2out, 1, 2);
+    TEST_MIX(1in_6out, 1, 6);
+    TEST_MIX(1in_8out, 1, 8);
+    TEST_MIX(2in_1out, 2, 1);
+    TEST_MIX(2in_2out, 2, 2);
+    TEST_MIX(2in_6out, 2, 6);
+    TEST_MIX(2in_8out, 2, 8);
+    for(i = 0; i < sizeof(generic_layouts) / sizeof(generic_layouts[0]); ++i)
+        TEST_MIX(Generic, generic_layouts[i][0], generic_layouts[i][1]);
+    for(i = 0; i < 4; ++i){
+        srcChans = 1 + (uint32_t) rand_float(0.0f, MAX_CHANNELS - 0.01f);
+        dstChans = 1 + (uint32_t) rand_float(0.0f, MAX_CHANNELS - 0.01f);
+        TEST_MIX(Generic, srcChans, dstChans);
+    }
+#undef TEST_MIX
+}
+
+/* "simd --bench": throughput of every kernel in FAudio_INTERNAL_SIMDKernels, in
+ * output samples per nanosecond. This is not a test, it only prints numbers for
+ * comparing tiers, though main() still fails if a kernel is missing.
+ */
+#define BENCH_FRAMES 1024
+#define BENCH_RUNS 2000
+
+static float bench_src_buf[(SINC_HISTORY + BENCH_FRAMES * 4 + 2) * MAX_CHANNELS];
+static float *const bench_src = bench_src_buf + SINC_HISTORY * MAX_CHANNELS;
+static float bench_dst[BENCH_FRAMES * MAX_CHANNELS * FILTER_MONO_BATCH];
+
+static void bench_report(const char *name, uint64_t ticks, uint32_t samples)
+{
+    double ns = ticks * 1e9 / (double) SDL_GetPerformanceFrequency();
+    kernels[find_kernel(name)].benched += 1;
+    fprintf(stdout, "%-8s %-20s %8.3f samples/ns\n", tier_name, name,
+            (double) BENCH_RUNS * samples / FAudio_max(ns, 1.0));
+}
+
+#define BENCH(name, samples, call) \
+    do { \
+        uint64_t bench_start = SDL_GetPerformanceCounter(); \
+        uint32_t run; \
+        for(run = 0; run < BENCH_RUNS; ++run){ \
+            call; \
+        } \
+        bench_report(name, SDL_GetPerformanceCounter() - bench_start, samples); \
+    } while(0)
+
+static void bench_resample(const char *name, FAudioResampleCallback resample,
+        double step, uint8_t channels)
+{
+    uint64_t offset;
+    BENCH(name, BENCH_FRAMES * channels,
+            offset = 0;
+            resample(bench_src, bench_dst, &offset, DOUBLE_TO_FIXED(step),
+                    BENCH_FRAMES, channels));
+}
+
+static void bench_sinc(const char *name, FAudioSincResampleCallback resample,
+        double step, uint8_t channels)
+{
+    uint64_t offset;
+    BENCH(name, BENCH_FRAMES * channels,
+            offset = 0;
+            resample(bench_src, bench_dst, &offset, DOUBLE_TO_FIXED(step),
+                    BENCH_FRAMES, channels, get_sinc_table(step)));
+}
+
+static void bench_mix(const char *name, FAudioMixCallback mix,
+        uint32_t srcChans, uint32_t dstChans)
+{
+    float channelVolume[MAX_CHANNELS];
+    float coefficients[MAX_CHANNELS * MAX_CHANNELS];
+    uint32_t i;
+
+    for(i = 0; i < srcChans; ++i)
+        channelVolume[i] = 1.0f;
+    for(i = 0; i < srcChans * dstChans; ++i)
+        coefficients[i] = rand_float(0.0f, 1.0f);
+    /* The output is clamped, so mixing into it over and over is harmless */
+    BENCH(name, BENCH_FRAMES * dstChans,
+            mix(BENCH_FRAMES, srcChans, dstChans, 0.5f, bench_src, bench_dst,
+                    channelVolume, coefficients));
+}
+
+static void bench_kernels(void)
+{
+    const double ratio = 44100.0 / 48000.0;
+    static uint8_t src_u8[BENCH_FRAMES];
+    static int16_t src_s16[BENCH_FRAMES];
+    static uint8_t src_s24[BENCH_FRAMES * 3];
+    static int16_t dst_s16[BENCH_FRAMES];
+    FAudioFilterParameters filter;
+    FAudioFilterState states[FILTER_MONO_BATCH][8];
+    const FAudioFilterParameters *batch_filters[FILTER_MONO_BATCH];
+    FAudioFilterState *batch_states[FILTER_MONO_BATCH];
+    float *batch_samples[FILTER_MONO_BATCH];
+    uint32_t batch_counts[FILTER_MONO_BATCH];
+    uint32_t i;
+
+    for(i = 0; i < sizeof(bench_src_buf) / sizeof(bench_src_buf[0]); ++i)
+        bench_src_buf[i] = rand_float(-1.0f, 1.0f);
+    for(i = 0; i < BENCH_FRAMES; ++i){
+        src_u8[i] = (uint8_t) rand_float(0.0f, 255.0f);
+        src_s16[i] = (int16_t) rand_float(-32768.0f, 32767.0f);
+    }
+    for(i = 0; i < sizeof(src_s24); ++i)
+        src_s24[i] = (uint8_t) rand_float(0.0f, 255.0f);
+
+    BENCH("Convert_U8_To_F32", BENCH_FRAMES,
+            FAudio_INTERNAL_Convert_U8_To_F32(src_u8, bench_dst, BENCH_FRAMES));
+    BENCH("Convert_S16_To_F32", BENCH_FRAMES,
+            FAudio_INTERNAL_Convert_S16_To_F32(src_s16, bench_dst, BENCH_FRAMES));
+    BENCH("Convert_S24_To_F32", BENCH_FRAMES,
+            FAudio_INTERNAL_Convert_S24_To_F32(src_s24, bench_dst, BENCH_FRAMES));
+    BENCH("Convert_F32_To_S16", BENCH_FRAMES,
+            FAudio_INTERNAL_Convert_F32_To_S16(bench_src, dst_s16, BENCH_FRAMES));
+
+    bench_resample("ResampleMono", FAudio_INTERNAL_ResampleMono, ratio, 1);
+    bench_resample("ResampleStereo", FAudio_INTERNAL_ResampleStereo, ratio, 2);
+    bench_resample("Resample4Channel", FAudio_INTERNAL_Resample4Channel, ratio, 4);
+    bench_resample("Resample6Channel", FAudio_INTERNAL_Resample6Channel, ratio, 6);
+    bench_resample("Resample8Channel", FAudio_INTERNAL_Resample8Channel, ratio, 8);
+    bench_resample("ResampleUpMono", FAudio_INTERNAL_ResampleUpMono, 0.5, 1);
+    bench_resample("ResampleUpStereo", FAudio_INTERNAL_ResampleUpStereo, 0.5, 2);
+    bench_resample("ResampleDownMono", FAudio_INTERNAL_ResampleDownMono, 2.0, 1);
+    bench_resample("ResampleDownStereo", FAudio_INTERNAL_ResampleDownStereo, 2.0, 2);
+    bench_sinc("ResampleSincMono", FAudio_INTERNAL_ResampleSincMono, ratio, 1);
+    bench_sinc("ResampleSincStereo", FAudio_INTERNAL_ResampleSincStereo, ratio, 2);
+
+    for(i = 0; i < BENCH_FRAMES; ++i)
+        bench_dst[i] = bench_src[i];
+    BENCH("Amplify", BENCH_FRAMES,
+            FAudio_INTERNAL_Amplify(bench_dst, BENCH_FRAMES, 1.0f));
+
+    bench_mix("Mix_Generic", FAudio_INTERNAL_Mix_Generic, 6, 2);
+    bench_mix("Mix_1in_1out", FAudio_INTERNAL_Mix_1in_1out, 1, 1);
+    bench_mix("Mix_1in_2out", FAudio_INTERNAL_Mix_1in_2out, 1, 2);
+    bench_mix("Mix_1in_6out", FAudio_INTERNAL_Mix_1in_6out, 1, 6);
+    bench_mix("Mix_1in_8out", FAudio_INTERNAL_Mix_1in_8out, 1, 8);
+    bench_mix("Mix_2in_1out", FAudio_INTERNAL_Mix_2in_1out, 2, 1);
+    bench_mix("Mix_2in_2out", FAudio_INTERNAL_Mix_2in_2out, 2, 2);
+    bench_mix("Mix_2in_6out", FAudio_INTERNAL_Mix_2in_6out, 2, 6);
+    bench_mix("Mix_2in_8out", FAudio_INTERNAL_Mix_2in_8out, 2, 8);
+
+    /* A gentle low pass keeps the state from blowing up over the runs */
+    filter.Type = FAudioLowPassFilter;
+    filter.Frequency = 0.5f;
+    filter.OneOverQ = 1.0f;
+    FAudio_zero(states, sizeof(states));
+    for(i = 0; i < BENCH_FRAMES * 2; ++i)
+        bench_dst[i] = bench_src[i];
+    BENCH("FilterVoice", BENCH_FRAMES * 2,
+            FAudio_INTERNAL_FilterVoice(&filter, states[0], bench_dst,
+                    BENCH_FRAMES, 2));
+
+    for(i = 0; i < FILTER_MONO_BATCH; ++i){
+        batch_filters[i] = &filter;
+        batch_states[i] = states[i];
+        batch_samples[i] = bench_dst + i * BENCH_FRAMES;
+        batch_counts[i] = BENCH_FRAMES;
+    }
+    for(i = 0; i < BENCH_FRAMES * FILTER_MONO_BATCH; ++i)
+        bench_dst[i] = bench_src[i % (BENCH_FRAMES * 4)];
+    BENCH("FilterMonoBatch", BENCH_FRAMES * FILTER_MONO_BATCH,
+            FAudio_INTERNAL_FilterMonoBatch(batch_filters, batch_states,
+                    batch_samples, batch_counts, FILTER_MONO_BATCH));
+}
+
+#undef BENCH
+
+int main(int argc, char **argv)
+{
+    /* Every tier the host can run, each checked against the scalar code */
+    const struct
+    {
+        const char *name;
+        uint8_t hasSSE2, hasAVX2, hasAVX512F, hasNEON;
+        int supported;
+    } tiers[] = {
+        { "scalar", 0, 0, 0, 0, 1 },
+        { "SSE2", 1, 0, 0, 0, SDL_HasSSE2() },
+        { "AVX2", 1, 1, 0, 0, SDL_HasSSE2() && SDL_HasAVX2() },
+#if SDL_VERSION_ATLEAST(2, 0, 9)
+        { "AVX-512F", 1, 1, 1, 0, SDL_HasSSE2() && SDL_HasAVX2() && SDL_HasAVX512F() },
+#endif
+        { "NEON", 0, 0, 0, 1, SDL_HasNEON() }
+    };
+    int bench = 0, report = 0;
+    uint32_t i, k;
+
+    /* --bench only times the kernels, --report also prints their worst errors */
+    for(i = 1; i < (uint32_t) argc; ++i){
+        if(FAudio_strcmp(argv[i], "--bench") == 0)
+            bench = 1;
+        else if(FAudio_strcmp(argv[i], "--report") == 0)
+            report = 1;
+    }
+
+    FAudio_INTERNAL_BuildSincTable(sinc_table);
+
+    /* FAUDIO_SIMD would hide the tier being tested */
+    if(FAudio_getenv("FAUDIO_SIMD") != NULL)
+        fprintf(stdout, "FAUDIO_SIMD is set, some tiers may not be tested\n");
+
+    for(i = 0; i < sizeof(tiers) / sizeof(tiers[0]); ++i){
+        if(!tiers[i].supported){
+            fprintf(stdout, "Skipping %s, not supported by this CPU\n", tiers[i].name);
+            continue;
+        }
+        tier_name = tiers[i].name;
+        FAudio_INTERNAL_InitSIMDFunctions(tiers[i].hasSSE2, tiers[i].hasAVX2,
+                tiers[i].hasAVX512F, tiers[i].hasNEON);
+        kernel_count = 0;
+
+        if(bench){
+            bench_kernels();
+            for(k = 0; FAudio_INTERNAL_SIMDKernels[k] != NULL; ++k)
+                ok(kernels[find_kernel(FAudio_INTERNAL_SIMDKernels[k])].benched > 0,
+                        "%s %s is never benchmarked\n",
+                        tier_name, FAudio_INTERNAL_SIMDKernels[k]);
+            continue;
+        }
+
+        test_converters();
+        test_amplify();
+        test_resamplers();
+        test_sinc_resamplers();
+        test_filters();
+        test_mixers();
+
+        /* A kernel nothing compares is a kernel nothing tests */
+        for(k = 0; FAudio_INTERNAL_SIMDKernels[k] != NULL; ++k)
+            ok(kernels[find_kernel(FAudio_INTERNAL_SIMDKernels[k])].checks > 0,
+                    "%s %s is never checked against scalar\n",
+                    tier_name, FAudio_INTERNAL_SIMDKernels[k]);
+
+        if(report){
+            for(k = 0; k < kernel_count; ++k)
+                fprintf(stdout, "%-8s %-28s %6u checks, max error %g (%u ulp)\n",
+                        tier_name, kernels[k].name, kernels[k].checks,
+                        kernels[k].max_abs, kernels[k].max_ulp);
+        }
+    }
+
+    if(bench)
+        return failure_count > 0;
+
+    fprintf(stdout, "Finished with %u successful tests and %u failed tests.\n",
+            success_count, failure_count);
+
+    return failure_count > 0;
+}
@@ -42,6 +42,7 @@
 
 #include "FAudio_compat.h"
 
+#include <math.h>
 #include <stdarg.h>
 #include <stdlib.h>
 #include <string.h>
@@ -484,6 +485,15 @@ static void test_simple_streaming(IXAudio2 *xa)
     ok(perfdata.TotalSourceVoiceCount == 2, "Got wrong TotalSourceVoiceCount: %u\n",
             perfdata.TotalSourceVoiceCount);
     ok(perfdata.CurrentLatencyInSamples > 0, "Got zero latency?\n");
+    ok(perfdata.AudioCyclesSinceLastQuery > 0, "Got no audio cycles?\n");
+    ok(perfdata.AudioCyclesSinceLastQuery <= perfdata.TotalCyclesSinceLastQuery,
+            "Got more audio cycles than total cycles: %u > %u\n",
+            (UINT32)perfdata.AudioCyclesSinceLastQuery,
+            (UINT32)perfdata.TotalCyclesSinceLastQuery);
+    ok(perfdata.MinimumCyclesPerQuantum <= perfdata.MaximumCyclesPerQuantum,
+            "Got minimum cycles above maximum: %u > %u\n",
+            perfdata.MinimumCyclesPerQuantum, perfdata.MaximumCyclesPerQuantum);
+    ok(perfdata.MemoryUsageInBytes > 0, "Got zero memory usage?\n");
 
     FAtest_free((void*)buf.pAudioData);
     FAtest_free((void*)buf2.pAudioData);
@@ -1030,7 +1040,9 @@ static void test_submix(IXAudio2 *xa)
 {
     HRESULT hr;
     IXAudio2MasteringVoice *master;
-    IXAudio2SubmixVoice *sub;
+    IXAudio2SubmixVoice *sub, *late, *bad;
+    XAUDIO2_SEND_DESCRIPTOR send;
+    XAUDIO2_VOICE_SENDS sends;
 
     XA2CALL_0V(StopEngine);
 
@@ -1063,7 +1075,30 @@ static void test_submix(IXAudio2 *xa)
         ok(details.InputSampleRate == 44100, "Got wrong sample rate: 0x%x\n", details.InputSampleRate);
     }
 
+    /* Submixes may only send to submixes of a later processing stage */
+    XA2CALL(CreateSubmixVoice, &late, 2, 44100, 0, 1, NULL, NULL);
+    ok(hr == S_OK, "CreateSubmixVoice failed: %08x\n", hr);
+
+    send.Flags = 0;
+    send.pOutputVoice = (IXAudio2Voice*)sub;
+    sends.SendCount = 1;
+    sends.pSends = &send;
+    XA2CALL(CreateSubmixVoice, &bad, 2, 44100, 0, 0, &sends, NULL);
+    ok(hr == XAUDIO2_E_INVALID_CALL, "CreateSubmixVoice to the same stage should have failed: %08x\n", hr);
+    XA2CALL(CreateSubmixVoice, &bad, 2, 44100, 0, 1, &sends, NULL);
+    ok(hr == XAUDIO2_E_INVALID_CALL, "CreateSubmixVoice to an earlier stage should have failed: %08x\n", hr);
+
+    if(!xaudio27){
+        hr = IXAudio2SubmixVoice_SetOutputVoices(late, &sends);
+        ok(hr == XAUDIO2_E_INVALID_CALL, "SetOutputVoices to an earlier stage should have failed: %08x\n", hr);
+
+        send.pOutputVoice = (IXAudio2Voice*)late;
+        hr = IXAudio2SubmixVoice_SetOutputVoices(sub, &sends);
+        ok(hr == S_OK, "SetOutputVoices to a later stage failed: %08x\n", hr);
+    }
+
     IXAudio2SubmixVoice_DestroyVoice(sub);
+    IXAudio2SubmixVoice_DestroyVoice(late);
     IXAudio2MasteringVoice_DestroyVoice(master);
 }
 
@@ -1148,6 +1183,141 @@ static void test_flush(IXAudio2 *xa)
     FAtest_free((void*)buf.pAudioData);
 }
 
+static UINT64 get_samples_played(IXAudio2SourceVoice *src)
+{
+    XAUDIO2_VOICE_STATE state;
+
+    if(xaudio27)
+        IXAudio27SourceVoice_GetState((IXAudio27SourceVoice*)src, &state);
+    else
+        IXAudio2SourceVoice_GetState(src, &state, 0);
+    return state.SamplesPlayed;
+}
+
+/* waits until the engine has run at least one full update */
+static void wait_for_update(IXAudio2SourceVoice *src)
+{
+    UINT64 played = get_samples_played(src);
+    int i;
+
+    /* the first change may come from an update that was already running */
+    for(i = 0; i < 2; ++i){
+        while(get_samples_played(src) == played)
+            FAtest_sleep(1);
+        played = get_samples_played(src);
+    }
+}
+
+static float get_volume(IXAudio2SourceVoice *src)
+{
+    float volume;
+
+    if(xaudio27)
+        IXAudio27SourceVoice_GetVolume((IXAudio27SourceVoice*)src, &volume);
+    else
+        IXAudio2SourceVoice_GetVolume(src, &volume);
+    return volume;
+}
+
+static void test_operationsets(IXAudio2 *xa)
+{
+    HRESULT hr;
+    IXAudio2MasteringVoice *master;
+    IXAudio2SourceVoice *src;
+    WAVEFORMATEX fmt;
+    XAUDIO2_BUFFER buf;
+
+    XA2CALL_0V(StopEngine);
+
+    if(xaudio27)
+        hr = IXAudio27_CreateMasteringVoice((IXAudio27*)xa, &master, 2, 44100, 0, 0, NULL);
+    else
+        hr = IXAudio2_CreateMasteringVoice(xa, &master, 2, 44100, 0,
+#ifdef _WIN32
+                NULL /*WCHAR *deviceID*/, NULL, AudioCategory_GameEffects);
+#else
+                0 /*int deviceIndex*/, NULL);
+#endif
+    ok(hr == S_OK, "CreateMasteringVoice failed: %08x\n", hr);
+
+    fmt.wFormatTag = WAVE_FORMAT_IEEE_FLOAT;
+    fmt.nChannels = 2;
+    fmt.nSamplesPerSec = 44100;
+    fmt.wBitsPerSample = 32;
+    fmt.nBlockAlign = fmt.nChannels * fmt.wBitsPerSample / 8;
+    fmt.nAvgBytesPerSec = fmt.nSamplesPerSec * fmt.nBlockAlign;
+    fmt.cbSize = 0;
+
+    XA2CALL(CreateSourceVoice, &src, &fmt, 0, 1.f, NULL, NULL, NULL);
+    ok(hr == S_OK, "CreateSourceVoice failed: %08x\n", hr);
+
+    memset(&buf, 0, sizeof(buf));
+    buf.AudioBytes = 22050 * fmt.nBlockAlign;
+    buf.pAudioData = FAtest_malloc(buf.AudioBytes);
+    buf.LoopCount = XAUDIO2_LOOP_INFINITE;
+    fill_buf((float*)buf.pAudioData, &fmt, 440, 22050);
+
+    hr = IXAudio2SourceVoice_SubmitSourceBuffer(src, &buf, NULL);
+    ok(hr == S_OK, "SubmitSourceBuffer failed: %08x\n", hr);
+
+    hr = IXAudio2SourceVoice_Start(src, 0, XAUDIO2_COMMIT_NOW);
+    ok(hr == S_OK, "Start failed: %08x\n", hr);
+
+    XA2CALL_0(StartEngine);
+    ok(hr == S_OK, "StartEngine failed: %08x\n", hr);
+
+    wait_for_update(src);
+
+    /* deferred operations wait for their own operation set to be committed */
+    if(xaudio27)
+        hr = IXAudio27SourceVoice_SetVolume((IXAudio27SourceVoice*)src, 0.5f, 1);
+    else
+        hr = IXAudio2SourceVoice_SetVolume(src, 0.5f, 1);
+    ok(hr == S_OK, "SetVolume failed: %08x\n", hr);
+
+    wait_for_update(src);
+    ok(get_volume(src) == 1.f, "Uncommitted volume was applied: %f\n", get_volume(src));
+
+    XA2CALL(CommitChanges, 2);
+    ok(hr == S_OK, "CommitChanges failed: %08x\n", hr);
+
+    wait_for_update(src);
+    ok(get_volume(src) == 1.f, "Volume was applied by another operation set: %f\n", get_volume(src));
+
+    if(xaudio27)
+        hr = IXAudio27SourceVoice_SetVolume((IXAudio27SourceVoice*)src, 0.25f, 2);
+    else
+        hr = IXAudio2SourceVoice_SetVolume(src, 0.25f, 2);
+    ok(hr == S_OK, "SetVolume failed: %08x\n", hr);
+
+    XA2CALL(CommitChanges, 1);
+    ok(hr == S_OK, "CommitChanges failed: %08x\n", hr);
+
+    wait_for_update(src);
+    ok(get_volume(src) == 0.5f, "Committed volume wasn't applied: %f\n", get_volume(src));
+
+    /* committing one set leaves the others pending */
+    wait_for_update(src);
+    ok(get_volume(src) == 0.5f, "Uncommitted volume was applied: %f\n", get_volume(src));
+
+    XA2CALL(CommitChanges, 2);
+    ok(hr == S_OK, "CommitChanges failed: %08x\n", hr);
+
+    wait_for_update(src);
+    ok(get_volume(src) == 0.25f, "Committed volume wasn't applied: %f\n", get_volume(src));
+
+    XA2CALL_0V(StopEngine);
+
+    if(xaudio27){
+        IXAudio27SourceVoice_DestroyVoice((IXAudio27SourceVoice*)src);
+    }else{
+        IXAudio2SourceVoice_DestroyVoice(src);
+    }
+    IXAudio2MasteringVoice_DestroyVoice(master);
+
+    FAtest_free((void*)buf.pAudioData);
+}
+
 static void test_setchannelvolumes(IXAudio2 *xa)
 {
     HRESULT hr;
@@ -1223,6 +1393,1363 @@ static void test_setchannelvolumes(IXAudio2 *xa)
     IXAudio2MasteringVoice_DestroyVoice(master);
 }
 
+#ifndef _WIN32
+/* FAudio extensions have no XAudio2 equivalent, so these tests are written to
+ * the FAudio API directly and are only run against FAudio.
+ */
+
+static void init_float_format(FAudioWaveFormatEx *fmt, uint16_t channels, uint32_t rate)
+{
+    fmt->wFormatTag = FAUDIO_FORMAT_IEEE_FLOAT;
+    fmt->nChannels = channels;
+    fmt->nSamplesPerSec = rate;
+    fmt->wBitsPerSample = 32;
+    fmt->nBlockAlign = fmt->nChannels * fmt->wBitsPerSample / 8;
+    fmt->nAvgBytesPerSec = fmt->nSamplesPerSec * fmt->nBlockAlign;
+    fmt->cbSize = 0;
+}
+
+static uint32_t read_le(const uint8_t *src, uint8_t bytes)
+{
+    uint32_t value = 0;
+    uint8_t i;
+    for(i = 0; i < bytes; ++i)
+        value |= (uint32_t)src[i] << (i * 8);
+    return value;
+}
+
+/* An engine that only renders when FAudio_RenderEXT is called, so that the
+ * output can be compared sample for sample
+ */
+static FAudio *create_manual_engine(FAudioMasteringVoice **master, uint32_t channels, uint32_t rate,
+        uint32_t quantum)
+{
+    FAudio *audio;
+    uint32_t hr;
+
+    hr = FAudioCreate(&audio, 0, FAUDIO_DEFAULT_PROCESSOR);
+    ok(hr == S_OK, "FAudioCreate failed: %08x\n", hr);
+    hr = FAudio_SetHeadlessModeEXT(audio, FAUDIO_HEADLESS_MANUAL_EXT, NULL);
+    ok(hr == S_OK, "SetHeadlessModeEXT failed: %08x\n", hr);
+    hr = FAudio_SetQuantumSizeEXT(audio, quantum);
+    ok(hr == S_OK, "SetQuantumSizeEXT failed: %08x\n", hr);
+    hr = FAudio_CreateMasteringVoice(audio, master, channels, rate, 0, 0, NULL);
+    ok(hr == S_OK, "CreateMasteringVoice failed: %08x\n", hr);
+    return audio;
+}
+
+#pragma pack(push, 1)
+struct msadpcm_format {
+    FAudioWaveFormatEx wfx;
+    uint16_t wSamplesPerBlock;
+    uint16_t wNumCoef;
+    int16_t aCoef[14];
+};
+#pragma pack(pop)
+
+static void init_msadpcm_format(struct msadpcm_format *fmt, uint16_t channels, uint32_t rate, uint16_t align)
+{
+    static const int16_t coefs[14] = {256, 0, 512, -256, 0, 0, 192, 64, 240, 0, 460, -208, 392, -232};
+
+    fmt->wfx.wFormatTag = FAUDIO_FORMAT_MSADPCM;
+    fmt->wfx.nChannels = channels;
+    fmt->wfx.nSamplesPerSec = rate;
+    fmt->wfx.wBitsPerSample = 4;
+    fmt->wfx.nBlockAlign = align;
+    fmt->wSamplesPerBlock = ((align / channels) - 6) * 2;
+    fmt->wfx.nAvgBytesPerSec = rate / fmt->wSamplesPerBlock * align;
+    fmt->wfx.cbSize = sizeof(*fmt) - sizeof(FAudioWaveFormatEx);
+    fmt->wNumCoef = 7;
+    memcpy(fmt->aCoef, coefs, sizeof(coefs));
+}
+
+/* Noisy, but valid, MSADPCM blocks */
+static void fill_msadpcm(uint8_t *data, uint32_t blocks, uint16_t channels, uint16_t align, uint32_t seed)
+{
+    uint32_t i, c;
+    uint8_t *block;
+
+    for(i = 0; i < blocks * align; ++i){
+        seed = seed * 1664525 + 1013904223;
+        data[i] = seed >> 24;
+    }
+    for(i = 0; i < blocks; ++i){
+        block = data + i * align;
+        for(c = 0; c < channels; ++c){
+            /* predictor, then a small starting delta */
+            block[c] %= 7;
+            block[channels + c * 2] = 16;
+            block[channels + c * 2 + 1] = 0;
+        }
+    }
+}
+
+static void get_decode_stats(FAudio *audio, FAudioDecodeStatisticsEXT *stats)
+{
+    memset(stats, 0xcc, sizeof(*stats));
+    FAudio_GetDecodeStatisticsEXT(audio, stats);
+}
+
+static void test_headless_wav(void)
+{
+    static const char path[] = "faudio_tests_headless.wav";
+    FAudio *audio;
+    FAudioMasteringVoice *master;
+    FAudioSourceVoice *src;
+    FAudioWaveFormatEx fmt;
+    FAudioBuffer buf;
+    FAudioVoiceState state;
+    uint32_t hr, mode, i, dataBytes, frames, wrong;
+    float *samples;
+    uint8_t *file;
+    long fileBytes;
+    FILE *fp;
+
+    hr = FAudioCreate(&audio, 0, FAUDIO_DEFAULT_PROCESSOR);
+    ok(hr == S_OK, "FAudioCreate failed: %08x\n", hr);
+    FAudio_StopEngine(audio);
+
+    hr = FAudio_SetHeadlessModeEXT(audio, FAUDIO_HEADLESS_WAV_EXT, path);
+    ok(hr == S_OK, "SetHeadlessModeEXT failed: %08x\n", hr);
+    FAudio_GetHeadlessModeEXT(audio, &mode);
+    ok(mode == FAUDIO_HEADLESS_WAV_EXT, "Got wrong headless mode: %u\n", mode);
+
+    hr = FAudio_CreateMasteringVoice(audio, &master, 2, 48000, 0, 0, NULL);
+    ok(hr == S_OK, "CreateMasteringVoice failed: %08x\n", hr);
+
+    hr = FAudio_SetHeadlessModeEXT(audio, FAUDIO_HEADLESS_NULL_EXT, NULL);
+    ok(hr == XAUDIO2_E_INVALID_CALL, "SetHeadlessModeEXT should have failed: %08x\n", hr);
+
+    /* a known signal, so that the file's contents can be checked */
+    init_float_format(&fmt, 2, 48000);
+    hr = FAudio_CreateSourceVoice(audio, &src, &fmt, 0, 1.f, NULL, NULL, NULL);
+    ok(hr == S_OK, "CreateSourceVoice failed: %08x\n", hr);
+
+    memset(&buf, 0, sizeof(buf));
+    buf.AudioBytes = 4800 * fmt.nBlockAlign;
+    buf.pAudioData = FAtest_malloc(buf.AudioBytes);
+    buf.Flags = XAUDIO2_END_OF_STREAM;
+    samples = (float*)buf.pAudioData;
+    for(i = 0; i < 4800 * 2; ++i)
+        samples[i] = 0.5f;
+
+    hr = FAudioSourceVoice_SubmitSourceBuffer(src, &buf, NULL);
+    ok(hr == S_OK, "SubmitSourceBuffer failed: %08x\n", hr);
+    hr = FAudioSourceVoice_Start(src, 0, XAUDIO2_COMMIT_NOW);
+    ok(hr == S_OK, "Start failed: %08x\n", hr);
+
+    /* nothing is written until the engine is started */
+    FAtest_sleep(20);
+    hr = FAudio_StartEngine(audio);
+    ok(hr == S_OK, "StartEngine failed: %08x\n", hr);
+
+    do{
+        FAtest_sleep(1);
+        FAudioSourceVoice_GetState(src, &state, 0);
+    }while(state.BuffersQueued > 0);
+    FAudio_StopEngine(audio);
+
+    FAudioVoice_DestroyVoice(src);
+    FAudioVoice_DestroyVoice(master);
+    FAudio_Release(audio);
+    FAtest_free((void*)buf.pAudioData);
+
+    fp = fopen(path, "rb");
+    ok(fp != NULL, "Headless output wasn't written\n");
+    if(!fp)
+        return;
+    fseek(fp, 0, SEEK_END);
+    fileBytes = ftell(fp);
+    fseek(fp, 0, SEEK_SET);
+    file = FAtest_malloc(fileBytes);
+    ok(fread(file, 1, fileBytes, fp) == (size_t)fileBytes, "Couldn't read headless output\n");
+    fclose(fp);
+    remove(path);
+
+    ok(fileBytes > 68, "Headless output is too short: %ld\n", fileBytes);
+    if(fileBytes > 68){
+        ok(memcmp(file, "RIFF", 4) == 0, "Missing RIFF header\n");
+        ok(read_le(file + 4, 4) == fileBytes - 8, "Got wrong RIFF size: %u\n", read_le(file + 4, 4));
+        ok(memcmp(file + 8, "WAVEfmt ", 8) == 0, "Missing WAVE format chunk\n");
+        ok(read_le(file + 16, 4) == 40, "Got wrong format size: %u\n", read_le(file + 16, 4));
+        ok(read_le(file + 20, 2) == FAUDIO_FORMAT_EXTENSIBLE, "Got wrong format tag: %x\n", read_le(file + 20, 2));
+        ok(read_le(file + 22, 2) == 2, "Got wrong channel count: %u\n", read_le(file + 22, 2));
+        ok(read_le(file + 24, 4) == 48000, "Got wrong sample rate: %u\n", read_le(file + 24, 4));
+        ok(read_le(file + 28, 4) == 48000 * 8, "Got wrong byte rate: %u\n", read_le(file + 28, 4));
+        ok(read_le(file + 32, 2) == 8, "Got wrong block align: %u\n", read_le(file + 32, 2));
+        ok(read_le(file + 34, 2) == 32, "Got wrong sample size: %u\n", read_le(file + 34, 2));
+        ok(memcmp(file + 60, "data", 4) == 0, "Missing data chunk\n");
+
+        /* the sizes are only filled in when the mastering voice goes away */
+        dataBytes = read_le(file + 64, 4);
+        ok(dataBytes == fileBytes - 68, "Got wrong data size: %u, expected %ld\n", dataBytes, fileBytes - 68);
+
+        /* the engine only ever writes whole updates */
+        frames = dataBytes / 8;
+        ok(frames >= 4800, "Got too few frames: %u\n", frames);
+        ok(frames % 1024 == 0, "Got a partial update: %u frames\n", frames);
+
+        samples = (float*)(file + 68);
+        wrong = 0;
+        for(i = 0; i < frames * 2 && i < 4800 * 2; ++i)
+            wrong += (samples[i] != 0.5f);
+        for(; i < frames * 2; ++i)
+            wrong += (samples[i] != 0.f);
+        ok(wrong == 0, "Got %u wrong samples\n", wrong);
+    }
+
+    FAtest_free(file);
+
+    /* a stopped engine sleeps until it's started, or until it goes away */
+    hr = FAudioCreate(&audio, 0, FAUDIO_DEFAULT_PROCESSOR);
+    ok(hr == S_OK, "FAudioCreate failed: %08x\n", hr);
+    FAudio_StopEngine(audio);
+    FAudio_SetHeadlessModeEXT(audio, FAUDIO_HEADLESS_WAV_EXT, path);
+    hr = FAudio_CreateMasteringVoice(audio, &master, 2, 48000, 0, 0, NULL);
+    ok(hr == S_OK, "CreateMasteringVoice failed: %08x\n", hr);
+    FAtest_sleep(20);
+    FAudioVoice_DestroyVoice(master);
+    FAudio_Release(audio);
+
+    fp = fopen(path, "rb");
+    ok(fp != NULL, "Headless output wasn't written\n");
+    if(!fp)
+        return;
+    fseek(fp, 0, SEEK_END);
+    fileBytes = ftell(fp);
+    fclose(fp);
+    remove(path);
+    ok(fileBytes == 68, "Stopped engine wrote %ld bytes\n", fileBytes - 68);
+}
+
+#define PCM_BLOCKS 16
+#define PCM_FRAMES (PCM_BLOCKS * 128)
+#define PCM_ENTRY_BYTES (PCM_FRAMES * sizeof(float))
+
+static void submit_pcm(FAudioSourceVoice *voice, const uint8_t *data, uint32_t flags)
+{
+    FAudioBuffer buf;
+    uint32_t hr;
+
+    memset(&buf, 0, sizeof(buf));
+    buf.Flags = flags;
+    buf.AudioBytes = PCM_BLOCKS * 70;
+    buf.pAudioData = data;
+    hr = FAudioSourceVoice_SubmitSourceBuffer(voice, &buf, NULL);
+    ok(hr == S_OK, "SubmitSourceBuffer failed: %08x\n", hr);
+}
+
+static void test_pcm_cache(void)
+{
+    FAudio *audio;
+    FAudioMasteringVoice *master;
+    FAudioSourceVoice *player, *idle;
+    struct msadpcm_format fmt;
+    FAudioDecodeStatisticsEXT stats;
+    uint8_t *data[6];
+    float *reference, *output;
+    uint32_t hr, budget, i;
+
+    audio = create_manual_engine(&master, 1, 48000, 0);
+    init_msadpcm_format(&fmt, 1, 48000, 70);
+    for(i = 0; i < 6; ++i){
+        data[i] = FAtest_malloc(PCM_BLOCKS * 70);
+        fill_msadpcm(data[i], PCM_BLOCKS, 1, 70, i + 1);
+    }
+    reference = FAtest_malloc(2 * PCM_FRAMES * sizeof(float));
+    output = FAtest_malloc(PCM_FRAMES * sizeof(float));
+
+    FAudio_GetPCMCacheBudgetEXT(audio, &budget);
+    ok(budget == 0, "The cache should be disabled by default: %u\n", budget);
+
+    hr = FAudio_CreateSourceVoice(audio, &idle, &fmt.wfx, 0, 1.f, NULL, NULL, NULL);
+    ok(hr == S_OK, "CreateSourceVoice failed: %08x\n", hr);
+
+    /* what the voice decodes by itself */
+    hr = FAudio_CreateSourceVoice(audio, &player, &fmt.wfx, 0, 1.f, NULL, NULL, NULL);
+    ok(hr == S_OK, "CreateSourceVoice failed: %08x\n", hr);
+    submit_pcm(player, data[0], FAUDIO_BUFFER_CACHEABLE_EXT);
+    FAudioSourceVoice_Start(player, 0, FAUDIO_COMMIT_NOW);
+    FAudio_RenderEXT(audio, reference, PCM_FRAMES, FAUDIO_RENDER_FLOAT32_EXT);
+    FAudioVoice_DestroyVoice(player);
+
+    hr = FAudio_CreateSourceVoice(audio, &player, &fmt.wfx, 0, 1.f, NULL, NULL, NULL);
+    ok(hr == S_OK, "CreateSourceVoice failed: %08x\n", hr);
+    submit_pcm(player, data[3], FAUDIO_BUFFER_CACHEABLE_EXT);
+    FAudioSourceVoice_Start(player, 0, FAUDIO_COMMIT_NOW);
+    FAudio_RenderEXT(audio, reference + PCM_FRAMES, PCM_FRAMES, FAUDIO_RENDER_FLOAT32_EXT);
+    FAudioVoice_DestroyVoice(player);
+
+    get_decode_stats(audio, &stats);
+    ok(stats.PCMCacheHits == 0 && stats.PCMCacheMisses == 0 && stats.PCMCacheEntries == 0,
+            "Disabled cache was used: %u hits, %u misses, %u entries\n",
+            stats.PCMCacheHits, stats.PCMCacheMisses, stats.PCMCacheEntries);
+
+    /* room for exactly four of our buffers, the most a buffer may take is a quarter */
+    FAudio_SetPCMCacheBudgetEXT(audio, 4 * PCM_ENTRY_BYTES);
+    FAudio_GetPCMCacheBudgetEXT(audio, &budget);
+    ok(budget == 4 * PCM_ENTRY_BYTES, "Got wrong budget: %u\n", budget);
+
+    /* miss, decoded when it's submitted... */
+    submit_pcm(idle, data[0], FAUDIO_BUFFER_CACHEABLE_EXT);
+    get_decode_stats(audio, &stats);
+    ok(stats.PCMCacheMisses == 1, "Got %u misses\n", stats.PCMCacheMisses);
+    ok(stats.PCMCacheHits == 0, "Got %u hits\n", stats.PCMCacheHits);
+    ok(stats.PCMCacheEntries == 1, "Got %u entries\n", stats.PCMCacheEntries);
+    ok(stats.PCMCacheBytes == PCM_ENTRY_BYTES, "Got %u bytes\n", stats.PCMCacheBytes);
+
+    /* ... then a hit, which plays back exactly what the voice would have decoded */
+    hr = FAudio_CreateSourceVoice(audio, &player, &fmt.wfx, 0, 1.f, NULL, NULL, NULL);
+    ok(hr == S_OK, "CreateSourceVoice failed: %08x\n", hr);
+    submit_pcm(player, data[0], FAUDIO_BUFFER_CACHEABLE_EXT);
+    get_decode_stats(audio, &stats);
+    ok(stats.PCMCacheHits == 1, "Got %u hits\n", stats.PCMCacheHits);
+    ok(stats.PCMCacheMisses == 1, "Got %u misses\n", stats.PCMCacheMisses);
+    ok(stats.PCMCacheEntries == 1, "Got %u entries\n", stats.PCMCacheEntries);
+
+    FAudioSourceVoice_Start(player, 0, FAUDIO_COMMIT_NOW);
+    FAudio_RenderEXT(audio, output, PCM_FRAMES, FAUDIO_RENDER_FLOAT32_EXT);
+    get_decode_stats(audio, &stats);
+    ok(stats.MSADPCMBlocksDecoded == 0, "Cached buffer was decoded again: %u blocks\n", stats.MSADPCMBlocksDecoded);
+    ok(!memcmp(reference, output, PCM_FRAMES * sizeof(float)), "Cached output differs\n");
+    FAudioVoice_DestroyVoice(player);
+
+    /* uncacheable buffers are neither looked up nor decoded up front */
+    submit_pcm(idle, data[1], 0);
+    get_decode_stats(audio, &stats);
+    ok(stats.PCMCacheHits == 1 && stats.PCMCacheMisses == 1 && stats.PCMCacheEntries == 1,
+            "Uncacheable buffer was cached: %u hits, %u misses, %u entries\n",
+            stats.PCMCacheHits, stats.PCMCacheMisses, stats.PCMCacheEntries);
+
+    /* a full cache evicts the least recently used buffer */
+    for(i = 1; i < 4; ++i)
+        submit_pcm(idle, data[i], FAUDIO_BUFFER_CACHEABLE_EXT);
+    get_decode_stats(audio, &stats);
+    ok(stats.PCMCacheEntries == 4, "Got %u entries\n", stats.PCMCacheEntries);
+    ok(stats.PCMCacheBytes == 4 * PCM_ENTRY_BYTES, "Got %u bytes\n", stats.PCMCacheBytes);
+    ok(stats.PCMCacheEvictions == 0, "Got %u evictions\n", stats.PCMCacheEvictions);
+
+    submit_pcm(idle, data[4], FAUDIO_BUFFER_CACHEABLE_EXT);
+    get_decode_stats(audio, &stats);
+    ok(stats.PCMCacheEntries == 4, "Got %u entries\n", stats.PCMCacheEntries);
+    ok(stats.PCMCacheBytes == 4 * PCM_ENTRY_BYTES, "Got %u bytes\n", stats.PCMCacheBytes);
+    ok(stats.PCMCacheEvictions == 1, "Got %u evictions\n", stats.PCMCacheEvictions);
+    ok(stats.PCMCacheMisses == 5, "Got %u misses\n", stats.PCMCacheMisses);
+
+    /* data[0] was the oldest, data[1] is the oldest now */
+    submit_pcm(idle, data[2], FAUDIO_BUFFER_CACHEABLE_EXT);
+    get_decode_stats(audio, &stats);
+    ok(stats.PCMCacheHits == 2, "Got %u hits\n", stats.PCMCacheHits);
+    submit_pcm(idle, data[0], FAUDIO_BUFFER_CACHEABLE_EXT);
+    get_decode_stats(audio, &stats);
+    ok(stats.PCMCacheMisses == 6, "Evicted buffer was found: %u misses\n", stats.PCMCacheMisses);
+    ok(stats.PCMCacheEvictions == 2, "Got %u evictions\n", stats.PCMCacheEvictions);
+
+    /* entries that voices are reading from are skipped; data[3] ends up the
+     * oldest, but it's playing, so data[2] goes instead
+     */
+    hr = FAudio_CreateSourceVoice(audio, &player, &fmt.wfx, 0, 1.f, NULL, NULL, NULL);
+    ok(hr == S_OK, "CreateSourceVoice failed: %08x\n", hr);
+    submit_pcm(player, data[3], FAUDIO_BUFFER_CACHEABLE_EXT);
+    FAudioSourceVoice_Start(player, 0, FAUDIO_COMMIT_NOW);
+    FAudio_RenderEXT(audio, output, 256, FAUDIO_RENDER_FLOAT32_EXT);
+    submit_pcm(idle, data[2], FAUDIO_BUFFER_CACHEABLE_EXT);
+    submit_pcm(idle, data[0], FAUDIO_BUFFER_CACHEABLE_EXT);
+    submit_pcm(idle, data[4], FAUDIO_BUFFER_CACHEABLE_EXT);
+    submit_pcm(idle, data[5], FAUDIO_BUFFER_CACHEABLE_EXT);
+    get_decode_stats(audio, &stats);
+    ok(stats.PCMCacheEvictions == 3, "Got %u evictions\n", stats.PCMCacheEvictions);
+    ok(stats.PCMCacheEntries == 4, "Got %u entries\n", stats.PCMCacheEntries);
+    submit_pcm(idle, data[3], FAUDIO_BUFFER_CACHEABLE_EXT);
+    get_decode_stats(audio, &stats);
+    ok(stats.PCMCacheHits == 7, "Playing buffer was evicted: %u hits\n", stats.PCMCacheHits);
+
+    /* invalidating leaves other memory alone... */
+    FAudio_InvalidatePCMCacheEXT(audio, data[1], PCM_BLOCKS * 70);
+    get_decode_stats(audio, &stats);
+    ok(stats.PCMCacheEntries == 4, "Got %u entries\n", stats.PCMCacheEntries);
+
+    /* ... and drops the buffers it overlaps, even while they're playing. The
+     * voice keeps reading its samples until it's done with them.
+     */
+    FAudio_InvalidatePCMCacheEXT(audio, data[3] + 70, 1);
+    get_decode_stats(audio, &stats);
+    ok(stats.PCMCacheEntries == 3, "Got %u entries\n", stats.PCMCacheEntries);
+    ok(stats.PCMCacheBytes == 3 * PCM_ENTRY_BYTES, "Got %u bytes\n", stats.PCMCacheBytes);
+    FAudio_RenderEXT(audio, output + 256, PCM_FRAMES - 256, FAUDIO_RENDER_FLOAT32_EXT);
+    ok(!memcmp(reference + PCM_FRAMES, output, PCM_FRAMES * sizeof(float)),
+            "Invalidated buffer played back wrong\n");
+    FAudioVoice_DestroyVoice(player);
+
+    submit_pcm(idle, data[3], FAUDIO_BUFFER_CACHEABLE_EXT);
+    get_decode_stats(audio, &stats);
+    ok(stats.PCMCacheMisses == 8, "Invalidated buffer was found: %u misses\n", stats.PCMCacheMisses);
+    ok(stats.PCMCacheEntries == 4, "Got %u entries\n", stats.PCMCacheEntries);
+
+    /* lowering the budget evicts right away, and a buffer over a quarter of
+     * it isn't cached
+     */
+    FAudio_SetPCMCacheBudgetEXT(audio, 2 * PCM_ENTRY_BYTES);
+    get_decode_stats(audio, &stats);
+    ok(stats.PCMCacheEntries == 2, "Got %u entries\n", stats.PCMCacheEntries);
+    ok(stats.PCMCacheBytes == 2 * PCM_ENTRY_BYTES, "Got %u bytes\n", stats.PCMCacheBytes);
+    ok(stats.PCMCacheEvictions == 5, "Got %u evictions\n", stats.PCMCacheEvictions);
+    submit_pcm(idle, data[0], FAUDIO_BUFFER_CACHEABLE_EXT);
+    get_decode_stats(audio, &stats);
+    ok(stats.PCMCacheMisses == 9, "Got %u misses\n", stats.PCMCacheMisses);
+    ok(stats.PCMCacheEntries == 2, "Oversized buffer was cached\n");
+
+    FAudioVoice_DestroyVoice(idle);
+    FAudioVoice_DestroyVoice(master);
+    FAudio_Release(audio);
+
+    for(i = 0; i < 6; ++i)
+        FAtest_free(data[i]);
+    FAtest_free(reference);
+    FAtest_free(output);
+}
+
+struct counting_callback {
+    FAudioVoiceCallback iface;
+    uint32_t passes, buffer_starts, buffer_ends;
+    void *last_context;
+};
+
+static void FAUDIOCALL CCB_OnBufferEnd(FAudioVoiceCallback *iface, void *context)
+{
+    struct counting_callback *This = (struct counting_callback *)iface;
+    ++This->buffer_ends;
+    This->last_context = context;
+}
+
+static void FAUDIOCALL CCB_OnBufferStart(FAudioVoiceCallback *iface, void *context)
+{
+    struct counting_callback *This = (struct counting_callback *)iface;
+    ++This->buffer_starts;
+    This->last_context = context;
+}
+
+static void FAUDIOCALL CCB_OnVoiceProcessingPassStart(FAudioVoiceCallback *iface, uint32_t bytes)
+{
+    struct counting_callback *This = (struct counting_callback *)iface;
+    ++This->passes;
+}
+
+static void init_counting_callback(struct counting_callback *cb)
+{
+    memset(cb, 0, sizeof(*cb));
+    cb->iface.OnBufferEnd = CCB_OnBufferEnd;
+    cb->iface.OnBufferStart = CCB_OnBufferStart;
+    cb->iface.OnVoiceProcessingPassStart = CCB_OnVoiceProcessingPassStart;
+}
+
+static void check_pool_stats(unsigned line, FAudio *audio, const FAudioWaveFormatEx *fmt,
+        uint32_t flags, float ratio, uint32_t size, uint32_t in_use, uint32_t high,
+        uint32_t hits, uint32_t misses)
+{
+    FAudioSourceVoicePoolStatisticsEXT stats;
+    uint32_t hr;
+
+    memset(&stats, 0xcc, sizeof(stats));
+    hr = FAudio_GetSourceVoicePoolStatisticsEXT(audio, fmt, flags, ratio, &stats);
+    ok_(__FILE__, line, hr == S_OK, "GetSourceVoicePoolStatisticsEXT failed: %08x\n", hr);
+    ok_(__FILE__, line, stats.PoolSize == size && stats.VoicesInUse == in_use &&
+            stats.HighWaterMark == high && stats.Hits == hits && stats.Misses == misses,
+            "Got size %u, in use %u, high water mark %u, %u hits, %u misses\n",
+            stats.PoolSize, stats.VoicesInUse, stats.HighWaterMark, stats.Hits, stats.Misses);
+}
+
+static void test_voice_pools(void)
+{
+    FAudio *audio;
+    FAudioMasteringVoice *master;
+    FAudioSubmixVoice *sub;
+    FAudioSourceVoice *voices[3], *src;
+    FAudioWaveFormatEx fmt;
+    FAudioSourceVoicePoolStatisticsEXT stats;
+    FAudioFilterParameters filter;
+    FAudioSendDescriptor send;
+    FAudioVoiceSends sends;
+    FAudioVoiceState state;
+    FAudioBuffer buf;
+    struct counting_callback cb1, cb2;
+    float samples[256], output[256], reference[128], volume, ratio;
+    uint32_t hr, i, wrong;
+    const uint32_t flags = FAUDIO_VOICE_USEFILTER;
+
+    init_float_format(&fmt, 1, 48000);
+    init_counting_callback(&cb1);
+    init_counting_callback(&cb2);
+    for(i = 0; i < 256; ++i)
+        samples[i] = 1.f;
+    memset(&buf, 0, sizeof(buf));
+    buf.AudioBytes = sizeof(samples);
+    buf.pAudioData = (uint8_t*)samples;
+
+    /* pools need a mastering voice */
+    hr = FAudioCreate(&audio, 0, FAUDIO_DEFAULT_PROCESSOR);
+    ok(hr == S_OK, "FAudioCreate failed: %08x\n", hr);
+    hr = FAudio_CreateSourceVoicePoolEXT(audio, &fmt, flags, 2.f, 2);
+    ok(hr == XAUDIO2_E_INVALID_CALL, "CreateSourceVoicePoolEXT without a master should have failed: %08x\n", hr);
+    FAudio_Release(audio);
+
+    /* small updates, so that each render only plays a little */
+    audio = create_manual_engine(&master, 1, 48000, 128);
+    hr = FAudio_GetSourceVoicePoolStatisticsEXT(audio, &fmt, flags, 2.f, &stats);
+    ok(hr == XAUDIO2_E_INVALID_CALL, "GetSourceVoicePoolStatisticsEXT without a pool should have failed: %08x\n", hr);
+
+    hr = FAudio_CreateSourceVoicePoolEXT(audio, &fmt, flags, 2.f, 2);
+    ok(hr == S_OK, "CreateSourceVoicePoolEXT failed: %08x\n", hr);
+    hr = FAudio_CreateSourceVoicePoolEXT(audio, &fmt, flags, 2.f, 2);
+    ok(hr == XAUDIO2_E_INVALID_CALL, "CreateSourceVoicePoolEXT with a duplicate key should have failed: %08x\n", hr);
+    check_pool_stats(__LINE__, audio, &fmt, flags, 2.f, 2, 0, 0, 0, 0);
+
+    /* two idle voices, then the pool has to grow */
+    for(i = 0; i < 3; ++i){
+        hr = FAudio_CreateSourceVoice(audio, &voices[i], &fmt, flags, 2.f, &cb1.iface, NULL, NULL);
+        ok(hr == S_OK, "CreateSourceVoice failed: %08x\n", hr);
+    }
+    check_pool_stats(__LINE__, audio, &fmt, flags, 2.f, 3, 3, 3, 2, 1);
+
+    /* voices with another key don't come from the pool */
+    hr = FAudio_CreateSourceVoice(audio, &src, &fmt, flags, 4.f, NULL, NULL, NULL);
+    ok(hr == S_OK, "CreateSourceVoice failed: %08x\n", hr);
+    FAudioVoice_DestroyVoice(src);
+    check_pool_stats(__LINE__, audio, &fmt, flags, 2.f, 3, 3, 3, 2, 1);
+
+    FAudioVoice_DestroyVoice(voices[2]);
+    FAudioVoice_DestroyVoice(voices[1]);
+    check_pool_stats(__LINE__, audio, &fmt, flags, 2.f, 3, 1, 3, 2, 1);
+
+    /* change everything a recycled voice has to forget... */
+    src = voices[0];
+    filter.Type = FAudioHighPassFilter;
+    filter.Frequency = 0.25f;
+    filter.OneOverQ = 0.5f;
+    hr = FAudioVoice_SetFilterParameters(src, &filter, FAUDIO_COMMIT_NOW);
+    ok(hr == S_OK, "SetFilterParameters failed: %08x\n", hr);
+    FAudioVoice_SetVolume(src, 0.25f, FAUDIO_COMMIT_NOW);
+    FAudioSourceVoice_SetFrequencyRatio(src, 1.5f, FAUDIO_COMMIT_NOW);
+    for(i = 0; i < 4; ++i){
+        buf.pContext = &cb1;
+        hr = FAudioSourceVoice_SubmitSourceBuffer(src, &buf, NULL);
+        ok(hr == S_OK, "SubmitSourceBuffer failed: %08x\n", hr);
+    }
+    FAudioSourceVoice_Start(src, 0, FAUDIO_COMMIT_NOW);
+    FAudio_RenderEXT(audio, output, 128, FAUDIO_RENDER_FLOAT32_EXT);
+    ok(cb1.buffer_starts == 1, "Got %u buffer starts\n", cb1.buffer_starts);
+
+    /* ... and its queued buffers never call back once it's destroyed */
+    FAudioVoice_DestroyVoice(src);
+    check_pool_stats(__LINE__, audio, &fmt, flags, 2.f, 3, 0, 3, 2, 1);
+    init_counting_callback(&cb1);
+    FAudio_RenderEXT(audio, output, 256, FAUDIO_RENDER_FLOAT32_EXT);
+    ok(cb1.passes == 0 && cb1.buffer_starts == 0 && cb1.buffer_ends == 0,
+            "Destroyed voice called back: %u passes, %u starts, %u ends\n",
+            cb1.passes, cb1.buffer_starts, cb1.buffer_ends);
+
+    /* a recycled voice is indistinguishable from a new one */
+    hr = FAudio_CreateSubmixVoice(audio, &sub, 1, 48000, 0, 0, NULL, NULL);
+    ok(hr == S_OK, "CreateSubmixVoice failed: %08x\n", hr);
+    FAudioVoice_SetVolume(sub, 0.5f, FAUDIO_COMMIT_NOW);
+    send.Flags = 0;
+    send.pOutputVoice = sub;
+    sends.SendCount = 1;
+    sends.pSends = &send;
+
+    /* what a brand new voice plays, the key differs so it's not pooled */
+    hr = FAudio_CreateSourceVoice(audio, &src, &fmt, flags, 4.f, NULL, &sends, NULL);
+    ok(hr == S_OK, "CreateSourceVoice failed: %08x\n", hr);
+    hr = FAudioSourceVoice_SubmitSourceBuffer(src, &buf, NULL);
+    ok(hr == S_OK, "SubmitSourceBuffer failed: %08x\n", hr);
+    FAudioSourceVoice_Start(src, 0, FAUDIO_COMMIT_NOW);
+    FAudio_RenderEXT(audio, reference, 128, FAUDIO_RENDER_FLOAT32_EXT);
+    FAudioVoice_DestroyVoice(src);
+
+    hr = FAudio_CreateSourceVoice(audio, &src, &fmt, flags, 2.f, &cb2.iface, &sends, NULL);
+    ok(hr == S_OK, "CreateSourceVoice failed: %08x\n", hr);
+    check_pool_stats(__LINE__, audio, &fmt, flags, 2.f, 3, 1, 3, 3, 1);
+
+    FAudioSourceVoice_GetState(src, &state, 0);
+    ok(state.BuffersQueued == 0, "Recycled voice has %u buffers queued\n", state.BuffersQueued);
+    ok(state.SamplesPlayed == 0, "Recycled voice has played %"PRIu64" samples\n", state.SamplesPlayed);
+    FAudioVoice_GetVolume(src, &volume);
+    ok(volume == 1.f, "Recycled voice has volume %f\n", volume);
+    FAudioSourceVoice_GetFrequencyRatio(src, &ratio);
+    ok(ratio == 1.f, "Recycled voice has frequency ratio %f\n", ratio);
+    FAudioVoice_GetFilterParameters(src, &filter);
+    ok(filter.Type == FAUDIO_DEFAULT_FILTER_TYPE &&
+            filter.Frequency == FAUDIO_DEFAULT_FILTER_FREQUENCY &&
+            filter.OneOverQ == FAUDIO_DEFAULT_FILTER_ONEOVERQ,
+            "Recycled voice has filter %u, %f, %f\n", filter.Type, filter.Frequency, filter.OneOverQ);
+
+    /* it's stopped... */
+    buf.pContext = &cb2;
+    hr = FAudioSourceVoice_SubmitSourceBuffer(src, &buf, NULL);
+    ok(hr == S_OK, "SubmitSourceBuffer failed: %08x\n", hr);
+    FAudio_RenderEXT(audio, output, 128, FAUDIO_RENDER_FLOAT32_EXT);
+    FAudioSourceVoice_GetState(src, &state, 0);
+    ok(state.SamplesPlayed == 0, "Recycled voice isn't stopped: %"PRIu64" samples\n", state.SamplesPlayed);
+
+    /* ... calls the new callback, and only sends where it was asked to */
+    FAudioSourceVoice_Start(src, 0, FAUDIO_COMMIT_NOW);
+    FAudio_RenderEXT(audio, output, 128, FAUDIO_RENDER_FLOAT32_EXT);
+    ok(cb2.buffer_starts == 1 && cb2.last_context == &cb2, "Got %u buffer starts, context %p\n",
+            cb2.buffer_starts, cb2.last_context);
+    ok(cb1.passes == 0 && cb1.buffer_starts == 0, "Old callback was called\n");
+    ok(!memcmp(output, reference, sizeof(reference)), "Recycled voice doesn't play like a new one\n");
+    wrong = 0;
+    for(i = 8; i < 128; ++i)
+        wrong += (output[i] != 0.5f);
+    ok(wrong == 0, "Recycled voice didn't send to the submix: %f\n", output[64]);
+
+    FAudioVoice_DestroyVoice(src);
+    FAudioVoice_DestroyVoice(sub);
+    check_pool_stats(__LINE__, audio, &fmt, flags, 2.f, 3, 0, 3, 3, 1);
+
+    /* idle voices go away with the master, the pool and its statistics stay */
+    FAudioVoice_DestroyVoice(master);
+    check_pool_stats(__LINE__, audio, &fmt, flags, 2.f, 0, 0, 3, 3, 1);
+    FAudio_Release(audio);
+}
+
+#define SCENE_FRAMES (8 * 1024)
+
+/* A bit of everything: a resampled, looping mono voice and a native rate
+ * stereo voice that runs out partway through an update
+ */
+static void render_scene(void *output, uint32_t format, const uint32_t *chunks, uint32_t chunk_count)
+{
+    FAudio *audio;
+    FAudioMasteringVoice *master;
+    FAudioSourceVoice *mono, *stereo;
+    FAudioWaveFormatEx fmt;
+    FAudioBuffer buf;
+    float *mono_data, *stereo_data;
+    uint8_t *dst = output;
+    uint32_t hr, i, frames, chunk, failed;
+    const uint32_t sample_bytes = (format == FAUDIO_RENDER_FLOAT32_EXT) ? sizeof(float) : sizeof(int16_t);
+
+    mono_data = FAtest_malloc(4410 * sizeof(float));
+    for(i = 0; i < 4410; ++i)
+        mono_data[i] = (float)((i * 37) % 200) / 200.f - 0.5f;
+    stereo_data = FAtest_malloc(3000 * 2 * sizeof(float));
+    for(i = 0; i < 3000 * 2; ++i)
+        stereo_data[i] = (i & 1) ? 0.25f : -(float)(i % 64) / 128.f;
+
+    audio = create_manual_engine(&master, 2, 48000, 0);
+
+    init_float_format(&fmt, 1, 44100);
+    hr = FAudio_CreateSourceVoice(audio, &mono, &fmt, 0, 2.f, NULL, NULL, NULL);
+    ok(hr == S_OK, "CreateSourceVoice failed: %08x\n", hr);
+    memset(&buf, 0, sizeof(buf));
+    buf.AudioBytes = 4410 * sizeof(float);
+    buf.pAudioData = (uint8_t*)mono_data;
+    buf.LoopCount = 2;
+    hr = FAudioSourceVoice_SubmitSourceBuffer(mono, &buf, NULL);
+    ok(hr == S_OK, "SubmitSourceBuffer failed: %08x\n", hr);
+    FAudioSourceVoice_SetFrequencyRatio(mono, 1.1f, FAUDIO_COMMIT_NOW);
+
+    init_float_format(&fmt, 2, 48000);
+    hr = FAudio_CreateSourceVoice(audio, &stereo, &fmt, 0, 1.f, NULL, NULL, NULL);
+    ok(hr == S_OK, "CreateSourceVoice failed: %08x\n", hr);
+    memset(&buf, 0, sizeof(buf));
+    buf.AudioBytes = 3000 * 2 * sizeof(float);
+    buf.pAudioData = (uint8_t*)stereo_data;
+    hr = FAudioSourceVoice_SubmitSourceBuffer(stereo, &buf, NULL);
+    ok(hr == S_OK, "SubmitSourceBuffer failed: %08x\n", hr);
+    FAudioVoice_SetVolume(stereo, 0.75f, FAUDIO_COMMIT_NOW);
+
+    FAudioSourceVoice_Start(mono, 0, FAUDIO_COMMIT_NOW);
+    FAudioSourceVoice_Start(stereo, 0, FAUDIO_COMMIT_NOW);
+
+    for(frames = 0, i = 0, failed = 0; frames < SCENE_FRAMES; frames += chunk, ++i){
+        chunk = chunks[i % chunk_count];
+        if(chunk > SCENE_FRAMES - frames)
+            chunk = SCENE_FRAMES - frames;
+        failed += (FAudio_RenderEXT(audio, dst + frames * 2 * sample_bytes, chunk, format) != S_OK);
+    }
+    ok(failed == 0, "RenderEXT failed %u times\n", failed);
+
+    FAudioVoice_DestroyVoice(mono);
+    FAudioVoice_DestroyVoice(stereo);
+    FAudioVoice_DestroyVoice(master);
+    FAudio_Release(audio);
+    FAtest_free(mono_data);
+    FAtest_free(stereo_data);
+}
+
+static void test_render_ext(void)
+{
+    static const uint32_t whole[] = { 1024 };
+    static const uint32_t odd[] = { 1, 100, 777 };
+    FAudio *audio;
+    FAudioMasteringVoice *master;
+    FAudioSourceVoice *src;
+    FAudioWaveFormatEx fmt;
+    FAudioBuffer buf;
+    FAudioVoiceState state;
+    float *reference, *output, samples[4] = { 2.f, -2.f, 0.5f, -0.25f }, floats[256];
+    int16_t *reference16, *output16, ints[256];
+    uint32_t hr, i, wrong, noisy;
+
+    reference = FAtest_malloc(SCENE_FRAMES * 2 * sizeof(float));
+    output = FAtest_malloc(SCENE_FRAMES * 2 * sizeof(float));
+    reference16 = FAtest_malloc(SCENE_FRAMES * 2 * sizeof(int16_t));
+    output16 = FAtest_malloc(SCENE_FRAMES * 2 * sizeof(int16_t));
+
+    /* where a call stops inside an update makes no difference to the output */
+    render_scene(reference, FAUDIO_RENDER_FLOAT32_EXT, whole, 1);
+    render_scene(output, FAUDIO_RENDER_FLOAT32_EXT, odd, 3);
+    ok(!memcmp(reference, output, SCENE_FRAMES * 2 * sizeof(float)), "Partial updates changed the output\n");
+    wrong = 0;
+    for(i = 0; i < SCENE_FRAMES * 2; ++i)
+        wrong += (reference[i] == 0.f);
+    ok(wrong < SCENE_FRAMES, "Scene is mostly silent: %u zero samples\n", wrong);
+
+    render_scene(reference16, FAUDIO_RENDER_INT16_EXT, whole, 1);
+    render_scene(output16, FAUDIO_RENDER_INT16_EXT, odd, 3);
+    ok(!memcmp(reference16, output16, SCENE_FRAMES * 2 * sizeof(int16_t)), "Partial updates changed the int16 output\n");
+
+    /* dither is at most one step either way, and the same every time */
+    render_scene(output16, FAUDIO_RENDER_INT16_DITHER_EXT, whole, 1);
+    wrong = noisy = 0;
+    for(i = 0; i < SCENE_FRAMES * 2; ++i){
+        wrong += (output16[i] - reference16[i] > 1 || output16[i] - reference16[i] < -1);
+        noisy += (output16[i] != reference16[i]);
+    }
+    ok(wrong == 0, "Got %u samples dithered by more than one step\n", wrong);
+    ok(noisy != 0, "Dither didn't change anything\n");
+    memcpy(reference16, output16, SCENE_FRAMES * 2 * sizeof(int16_t));
+    render_scene(output16, FAUDIO_RENDER_INT16_DITHER_EXT, odd, 3);
+    ok(!memcmp(reference16, output16, SCENE_FRAMES * 2 * sizeof(int16_t)), "Dither isn't reproducible\n");
+
+    FAtest_free(reference);
+    FAtest_free(output);
+    FAtest_free(reference16);
+    FAtest_free(output16);
+
+    /* int16 output rounds and clips, the float output doesn't */
+    audio = create_manual_engine(&master, 1, 48000, 128);
+    init_float_format(&fmt, 1, 48000);
+    hr = FAudio_CreateSourceVoice(audio, &src, &fmt, 0, 1.f, NULL, NULL, NULL);
+    ok(hr == S_OK, "CreateSourceVoice failed: %08x\n", hr);
+    memset(&buf, 0, sizeof(buf));
+    buf.AudioBytes = sizeof(samples);
+    buf.pAudioData = (uint8_t*)samples;
+    buf.LoopCount = FAUDIO_LOOP_INFINITE;
+    hr = FAudioSourceVoice_SubmitSourceBuffer(src, &buf, NULL);
+    ok(hr == S_OK, "SubmitSourceBuffer failed: %08x\n", hr);
+    FAudioSourceVoice_Start(src, 0, FAUDIO_COMMIT_NOW);
+
+    FAudio_RenderEXT(audio, floats, 128, FAUDIO_RENDER_FLOAT32_EXT);
+    ok(floats[0] == 2.f && floats[1] == -2.f, "Float output was clipped: %f %f\n", floats[0], floats[1]);
+    FAudio_RenderEXT(audio, ints, 128, FAUDIO_RENDER_INT16_EXT);
+    ok(ints[0] == 32767 && ints[1] == -32768, "Got %d %d, expected 32767 -32768\n", ints[0], ints[1]);
+    ok(ints[2] == 16384 && ints[3] == -8192, "Got %d %d, expected 16384 -8192\n", ints[2], ints[3]);
+    FAudio_RenderEXT(audio, ints, 128, FAUDIO_RENDER_INT16_DITHER_EXT);
+    ok(ints[0] >= 32766 && ints[1] <= -32767, "Dither wrapped around: %d %d\n", ints[0], ints[1]);
+    ok(ints[2] >= 16383 && ints[2] <= 16385, "Got %d, expected 16384 +/- 1\n", ints[2]);
+
+    /* a stopped engine writes silence and leaves the voices alone */
+    FAudio_StopEngine(audio);
+    FAudioSourceVoice_GetState(src, &state, 0);
+    for(i = 0; i < 256; ++i)
+        floats[i] = 1.f;
+    hr = FAudio_RenderEXT(audio, floats, 256, FAUDIO_RENDER_FLOAT32_EXT);
+    ok(hr == S_OK, "RenderEXT failed: %08x\n", hr);
+    wrong = 0;
+    for(i = 0; i < 256; ++i)
+        wrong += (floats[i] != 0.f);
+    ok(wrong == 0, "Stopped engine rendered %u samples\n", wrong);
+    for(i = 0; i < 256; ++i)
+        ints[i] = 1;
+    hr = FAudio_RenderEXT(audio, ints, 256, FAUDIO_RENDER_INT16_DITHER_EXT);
+    ok(hr == S_OK, "RenderEXT failed: %08x\n", hr);
+    wrong = 0;
+    for(i = 0; i < 256; ++i)
+        wrong += (ints[i] != 0);
+    ok(wrong == 0, "Stopped engine rendered %u int16 samples\n", wrong);
+    i = (uint32_t)state.SamplesPlayed;
+    FAudioSourceVoice_GetState(src, &state, 0);
+    ok(state.SamplesPlayed == i, "Voice advanced while stopped: %u -> %u\n", i, (uint32_t)state.SamplesPlayed);
+
+    hr = FAudio_RenderEXT(audio, floats, 128, FAUDIO_RENDER_INT16_DITHER_EXT + 1);
+    ok(hr == FAUDIO_E_INVALID_CALL, "RenderEXT with a bad format returned %08x\n", hr);
+
+    FAudioVoice_DestroyVoice(src);
+    FAudioVoice_DestroyVoice(master);
+    hr = FAudio_RenderEXT(audio, floats, 128, FAUDIO_RENDER_FLOAT32_EXT);
+    ok(hr == FAUDIO_E_INVALID_CALL, "RenderEXT without a master returned %08x\n", hr);
+    FAudio_Release(audio);
+
+    /* only MANUAL masters can be rendered from the client */
+    hr = FAudioCreate(&audio, 0, FAUDIO_DEFAULT_PROCESSOR);
+    ok(hr == S_OK, "FAudioCreate failed: %08x\n", hr);
+    FAudio_StopEngine(audio);
+    FAudio_SetHeadlessModeEXT(audio, FAUDIO_HEADLESS_NULL_EXT, NULL);
+    hr = FAudio_CreateMasteringVoice(audio, &master, 1, 48000, 0, 0, NULL);
+    ok(hr == S_OK, "CreateMasteringVoice failed: %08x\n", hr);
+    hr = FAudio_RenderEXT(audio, floats, 128, FAUDIO_RENDER_FLOAT32_EXT);
+    ok(hr == FAUDIO_E_INVALID_CALL, "RenderEXT on a NULL master returned %08x\n", hr);
+    FAudioVoice_DestroyVoice(master);
+    FAudio_Release(audio);
+}
+
+/* Plays the buffers on a new voice and renders `frames` frames of it. A voice
+ * with an effect chain is mixed a whole update at a time, which makes it a
+ * reference for the block mixer (and everything it skips) to be checked against.
+ */
+static void render_voice(FAudio *audio, const FAudioWaveFormatEx *fmt, uint32_t flags, float ratio,
+        const FAudioBuffer *bufs, uint32_t count, BOOL whole_updates, float *output, uint32_t frames)
+{
+    FAudioSourceVoice *src;
+    FAudioEffectDescriptor effect;
+    FAudioEffectChain chain;
+    FAudioFilterParameters filter;
+    FAPO *vumeter = NULL;
+    uint32_t hr, i;
+
+    if(whole_updates){
+        hr = FAudioCreateVolumeMeter(&vumeter, 0);
+        ok(hr == S_OK, "FAudioCreateVolumeMeter failed: %08x\n", hr);
+        effect.InitialState = TRUE;
+        effect.OutputChannels = fmt->nChannels;
+        effect.pEffect = vumeter;
+        chain.EffectCount = 1;
+        chain.pEffectDescriptors = &effect;
+    }
+    hr = FAudio_CreateSourceVoice(audio, &src, fmt, flags, 4.f, NULL, NULL, whole_updates ? &chain : NULL);
+    ok(hr == S_OK, "CreateSourceVoice failed: %08x\n", hr);
+    if(vumeter)
+        vumeter->Release(vumeter);
+
+    if(flags & FAUDIO_VOICE_USEFILTER){
+        filter.Type = FAudioLowPassFilter;
+        filter.Frequency = 0.3f;
+        filter.OneOverQ = 1.f;
+        FAudioVoice_SetFilterParameters(src, &filter, FAUDIO_COMMIT_NOW);
+    }
+    FAudioSourceVoice_SetFrequencyRatio(src, ratio, FAUDIO_COMMIT_NOW);
+    for(i = 0; i < count; ++i){
+        hr = FAudioSourceVoice_SubmitSourceBuffer(src, &bufs[i], NULL);
+        ok(hr == S_OK, "SubmitSourceBuffer failed: %08x\n", hr);
+    }
+    FAudioSourceVoice_Start(src, 0, FAUDIO_COMMIT_NOW);
+    FAudio_RenderEXT(audio, output, frames, FAUDIO_RENDER_FLOAT32_EXT);
+    FAudioVoice_DestroyVoice(src);
+}
+
+static uint32_t count_differences(const float *a, const float *b, uint32_t len, uint32_t *first)
+{
+    uint32_t i, wrong = 0;
+
+    *first = len;
+    for(i = 0; i < len; ++i){
+        if(a[i] != b[i]){
+            if(!wrong)
+                *first = i;
+            ++wrong;
+        }
+    }
+    return wrong;
+}
+
+#define MIX_FRAMES (4 * 1024)
+
+static void check_voice_blocks(unsigned line, FAudio *audio, const FAudioWaveFormatEx *fmt, uint32_t flags,
+        float ratio, const FAudioBuffer *bufs, uint32_t count, float *reference, float *output)
+{
+    uint32_t wrong, first, silent = 0, i;
+
+    render_voice(audio, fmt, flags, ratio, bufs, count, TRUE, reference, MIX_FRAMES);
+    render_voice(audio, fmt, flags, ratio, bufs, count, FALSE, output, MIX_FRAMES);
+    wrong = count_differences(reference, output, MIX_FRAMES * 2, &first);
+    ok_(__FILE__, line, wrong == 0, "Got %u wrong samples, first at %u\n", wrong, first);
+    for(i = 0; i < MIX_FRAMES * 2; ++i)
+        silent += (reference[i] == 0.f);
+    ok_(__FILE__, line, silent < MIX_FRAMES, "Voice was mostly silent: %u zero samples\n", silent);
+}
+
+static void test_mix_blocks(void)
+{
+    FAudio *audio;
+    FAudioMasteringVoice *master;
+    FAudioWaveFormatEx fmt;
+    FAudioBuffer bufs[2];
+    float *floats, *reference, *output;
+    int16_t *ints;
+    uint32_t i;
+
+    floats = FAtest_malloc(3000 * 2 * sizeof(float));
+    ints = FAtest_malloc(3000 * 2 * sizeof(int16_t));
+    for(i = 0; i < 3000 * 2; ++i){
+        floats[i] = (float)((i * 53) % 251) / 251.f - 0.5f;
+        ints[i] = (int16_t)((i * 977) % 65536 - 32768) / 4;
+    }
+    reference = FAtest_malloc(MIX_FRAMES * 2 * sizeof(float));
+    output = FAtest_malloc(MIX_FRAMES * 2 * sizeof(float));
+
+    /* none of these lengths or loop points line up with the 128 frame blocks */
+    memset(bufs, 0, sizeof(bufs));
+    bufs[0].PlayBegin = 7;
+    bufs[0].PlayLength = 1000;
+    bufs[0].LoopBegin = 100;
+    bufs[0].LoopLength = 333;
+    bufs[0].LoopCount = 2;
+    bufs[1].PlayLength = 1900;
+
+    audio = create_manual_engine(&master, 2, 48000, 0);
+
+    init_float_format(&fmt, 1, 44100);
+    bufs[0].AudioBytes = bufs[1].AudioBytes = 3000 * sizeof(float);
+    bufs[0].pAudioData = bufs[1].pAudioData = (uint8_t*)floats;
+    check_voice_blocks(__LINE__, audio, &fmt, 0, 1.f, bufs, 2, reference, output);
+    check_voice_blocks(__LINE__, audio, &fmt, 0, 0.7f, bufs, 2, reference, output);
+
+    init_float_format(&fmt, 2, 22050);
+    bufs[0].AudioBytes = bufs[1].AudioBytes = 3000 * 2 * sizeof(float);
+    check_voice_blocks(__LINE__, audio, &fmt, FAUDIO_VOICE_USEFILTER, 1.3f, bufs, 2, reference, output);
+
+    fmt.wFormatTag = FAUDIO_FORMAT_PCM;
+    fmt.nSamplesPerSec = 32000;
+    fmt.wBitsPerSample = 16;
+    fmt.nBlockAlign = 4;
+    fmt.nAvgBytesPerSec = 32000 * 4;
+    bufs[0].AudioBytes = bufs[1].AudioBytes = 3000 * 2 * sizeof(int16_t);
+    bufs[0].pAudioData = bufs[1].pAudioData = (uint8_t*)ints;
+    check_voice_blocks(__LINE__, audio, &fmt, 0, 1.1f, bufs, 2, reference, output);
+
+    FAudioVoice_DestroyVoice(master);
+    FAudio_Release(audio);
+    FAtest_free(floats);
+    FAtest_free(ints);
+    FAtest_free(reference);
+    FAtest_free(output);
+}
+
+#define RESAMPLE_UPDATES 4
+#define RESAMPLE_SOURCE_FRAMES 20000
+
+/* Plays `rate` Hz audio into a 48000Hz master and checks the output against
+ * a plain linear interpolation. The source's frequency ratio is set to
+ * ratios[i] for update i. With a submix, the source plays at the submix's
+ * rate and it's the submix that resamples.
+ */
+static void check_resampler(unsigned line, uint16_t channels, uint32_t rate, const float *ratios,
+        BOOL submix, float tolerance)
+{
+    FAudio *audio;
+    FAudioMasteringVoice *master;
+    FAudioSubmixVoice *sub = NULL;
+    FAudioSourceVoice *src;
+    FAudioWaveFormatEx fmt;
+    FAudioSendDescriptor send;
+    FAudioVoiceSends sends;
+    FAudioBuffer buf;
+    float *samples, *output, expected;
+    uint64_t offset = 0, step;
+    uint32_t hr, i, c, frame, base = 0, wrong = 0, first = 0;
+    BOOL last;
+
+    samples = FAtest_malloc(RESAMPLE_SOURCE_FRAMES * channels * sizeof(float));
+    output = FAtest_malloc(RESAMPLE_UPDATES * 1024 * channels * sizeof(float));
+    /* multiples of 1/64, so the 1/2 and 1/4 step lerps are exact */
+    for(i = 0; i < RESAMPLE_SOURCE_FRAMES * channels; ++i)
+        samples[i] = (float)((i * 7 + i / channels * 13) % 64) / 64.f - 0.5f;
+
+    audio = create_manual_engine(&master, channels, 48000, 0);
+    init_float_format(&fmt, channels, rate);
+    if(submix){
+        hr = FAudio_CreateSubmixVoice(audio, &sub, channels, rate, 0, 0, NULL, NULL);
+        ok_(__FILE__, line, hr == S_OK, "CreateSubmixVoice failed: %08x\n", hr);
+        send.Flags = 0;
+        send.pOutputVoice = sub;
+        sends.SendCount = 1;
+        sends.pSends = &send;
+    }
+    hr = FAudio_CreateSourceVoice(audio, &src, &fmt, 0, 2.f, NULL, submix ? &sends : NULL, NULL);
+    ok_(__FILE__, line, hr == S_OK, "CreateSourceVoice failed: %08x\n", hr);
+    memset(&buf, 0, sizeof(buf));
+    buf.AudioBytes = RESAMPLE_SOURCE_FRAMES * channels * sizeof(float);
+    buf.pAudioData = (uint8_t*)samples;
+    FAudioSourceVoice_SubmitSourceBuffer(src, &buf, NULL);
+    FAudioSourceVoice_Start(src, 0, FAUDIO_COMMIT_NOW);
+
+    for(i = 0; i < RESAMPLE_UPDATES; ++i){
+        FAudioSourceVoice_SetFrequencyRatio(src, ratios[i], FAUDIO_COMMIT_NOW);
+        FAudio_RenderEXT(audio, output + i * 1024 * channels, 1024, FAUDIO_RENDER_FLOAT32_EXT);
+    }
+
+    for(frame = 0; frame < RESAMPLE_UPDATES * 1024; ++frame){
+        step = (uint64_t)(ratios[frame / 1024] * (double)rate / 48000.0 * 4294967296.0 + 0.5);
+        /* submixes resample each update's input by itself, so the end of
+         * an upsampled update interpolates towards silence
+         */
+        if(submix && frame % 1024 == 0){
+            base = frame / 1024 * ((1024 * rate + 47999) / 48000);
+            offset = 0;
+        }
+        last = submix && (offset >> 32) + 1 >= (1024 * rate + 47999) / 48000;
+        for(c = 0; c < channels; ++c){
+            i = (base + (uint32_t)(offset >> 32)) * channels + c;
+            expected = (float)(samples[i] + ((last ? 0.f : samples[i + channels]) - samples[i]) *
+                    ((offset & 0xffffffff) / 4294967296.0));
+            if(fabsf(output[frame * channels + c] - expected) > tolerance){
+                if(!wrong)
+                    first = frame * channels + c;
+                ++wrong;
+            }
+        }
+        offset += step;
+    }
+    ok_(__FILE__, line, wrong == 0, "Got %u wrong samples, first at %u: %f\n", wrong, first, output[first]);
+
+    FAudioVoice_DestroyVoice(src);
+    if(sub)
+        FAudioVoice_DestroyVoice(sub);
+    FAudioVoice_DestroyVoice(master);
+    FAudio_Release(audio);
+    FAtest_free(samples);
+    FAtest_free(output);
+}
+
+static const float fixed_ratios[RESAMPLE_UPDATES] = { 1.f, 1.f, 1.f, 1.f };
+/* 2:1 for a 24000Hz source, then a step the ratio resamplers can't do, then 2:1 again */
+static const float changing_ratios[RESAMPLE_UPDATES] = { 1.f, 1.5f, 1.5f, 1.f };
+
+static void test_ratio_resamplers(void)
+{
+    uint16_t channels;
+
+    for(channels = 1; channels <= 3; ++channels){
+        check_resampler(__LINE__, channels, 24000, fixed_ratios, FALSE, 0.f);
+        check_resampler(__LINE__, channels, 12000, fixed_ratios, FALSE, 0.f);
+        check_resampler(__LINE__, channels, 96000, fixed_ratios, FALSE, 0.f);
+        check_resampler(__LINE__, channels, 192000, fixed_ratios, FALSE, 0.f);
+        check_resampler(__LINE__, channels, 24000, changing_ratios, FALSE, 0.f);
+        check_resampler(__LINE__, channels, 24000, fixed_ratios, TRUE, 0.f);
+        check_resampler(__LINE__, channels, 96000, fixed_ratios, TRUE, 0.f);
+    }
+}
+
+static void test_multichannel_resamplers(void)
+{
+    uint16_t channels;
+
+    for(channels = 4; channels <= 8; channels += 2){
+        check_resampler(__LINE__, channels, 24000, fixed_ratios, FALSE, 0.f);
+        check_resampler(__LINE__, channels, 12000, fixed_ratios, FALSE, 0.f);
+        check_resampler(__LINE__, channels, 96000, fixed_ratios, FALSE, 0.f);
+        check_resampler(__LINE__, channels, 24000, changing_ratios, FALSE, 0.f);
+        check_resampler(__LINE__, channels, 24000, fixed_ratios, TRUE, 0.f);
+
+        /* these lerp in single precision, unlike the reference */
+        check_resampler(__LINE__, channels, 44100, fixed_ratios, FALSE, 1e-6f);
+        check_resampler(__LINE__, channels, 44100, changing_ratios, FALSE, 1e-6f);
+        check_resampler(__LINE__, channels, 44100, fixed_ratios, TRUE, 1e-6f);
+        check_resampler(__LINE__, channels, 32000, fixed_ratios, TRUE, 1e-6f);
+    }
+}
+
+#define ADPCM_BLOCKS 40
+#define ADPCM_UPDATES 8
+
+/* Plays the blocks on a new voice, update by update, and returns how many
+ * blocks were decoded in total and in the busiest update
+ */
+static void play_msadpcm(FAudio *audio, const struct msadpcm_format *fmt, const uint8_t *data,
+        const FAudioBuffer *layout, float ratio, float *output, uint32_t *decoded, uint32_t *busiest)
+{
+    FAudioSourceVoice *src;
+    FAudioDecodeStatisticsEXT stats;
+    FAudioBuffer buf = *layout;
+    uint64_t total;
+    uint32_t hr, i;
+
+    hr = FAudio_CreateSourceVoice(audio, &src, &fmt->wfx, 0, 2.f, NULL, NULL, NULL);
+    ok(hr == S_OK, "CreateSourceVoice failed: %08x\n", hr);
+    buf.AudioBytes = ADPCM_BLOCKS * fmt->wfx.nBlockAlign;
+    buf.pAudioData = data;
+    hr = FAudioSourceVoice_SubmitSourceBuffer(src, &buf, NULL);
+    ok(hr == S_OK, "SubmitSourceBuffer failed: %08x\n", hr);
+    FAudioSourceVoice_SetFrequencyRatio(src, ratio, FAUDIO_COMMIT_NOW);
+    FAudioSourceVoice_Start(src, 0, FAUDIO_COMMIT_NOW);
+
+    get_decode_stats(audio, &stats);
+    total = stats.TotalMSADPCMBlocksDecoded;
+    *busiest = 0;
+    for(i = 0; i < ADPCM_UPDATES; ++i){
+        FAudio_RenderEXT(audio, output + i * 1024 * fmt->wfx.nChannels, 1024, FAUDIO_RENDER_FLOAT32_EXT);
+        get_decode_stats(audio, &stats);
+        if(stats.MSADPCMBlocksDecoded > *busiest)
+            *busiest = stats.MSADPCMBlocksDecoded;
+    }
+    *decoded = (uint32_t)(stats.TotalMSADPCMBlocksDecoded - total);
+    FAudioVoice_DestroyVoice(src);
+}
+
+static void check_msadpcm(unsigned line, uint16_t channels, float ratio, const FAudioBuffer *layout,
+        uint32_t expected_blocks)
+{
+    FAudio *audio;
+    FAudioMasteringVoice *master;
+    struct msadpcm_format fmt;
+    FAudioBuffer cached = *layout;
+    uint8_t *data;
+    float *reference, *output;
+    uint32_t decoded, busiest, reference_decoded, wrong, first;
+    const uint32_t samples = ADPCM_UPDATES * 1024 * channels;
+
+    data = FAtest_malloc(ADPCM_BLOCKS * 70 * channels);
+    fill_msadpcm(data, ADPCM_BLOCKS, channels, 70 * channels, 42);
+    reference = FAtest_malloc(samples * sizeof(float));
+    output = FAtest_malloc(samples * sizeof(float));
+    audio = create_manual_engine(&master, channels, 48000, 0);
+    init_msadpcm_format(&fmt, channels, 48000, 70 * channels);
+
+    /* the PCM cache decodes the whole buffer up front, without the voice's block cache */
+    FAudio_SetPCMCacheBudgetEXT(audio, 4 * ADPCM_BLOCKS * 128 * channels * sizeof(float));
+    cached.Flags |= FAUDIO_BUFFER_CACHEABLE_EXT;
+    play_msadpcm(audio, &fmt, data, &cached, ratio, reference, &reference_decoded, &busiest);
+    ok_(__FILE__, line, reference_decoded == ADPCM_BLOCKS, "PCM cache decoded %u blocks\n", reference_decoded);
+    FAudio_SetPCMCacheBudgetEXT(audio, 0);
+
+    play_msadpcm(audio, &fmt, data, layout, ratio, output, &decoded, &busiest);
+    wrong = count_differences(reference, output, samples, &first);
+    ok_(__FILE__, line, wrong == 0, "Got %u wrong samples, first at %u\n", wrong, first);
+    ok_(__FILE__, line, decoded == expected_blocks, "Decoded %u blocks, expected %u\n", decoded, expected_blocks);
+    /* an update covers 1024 * ratio frames, plus the block it left off in */
+    ok_(__FILE__, line, busiest <= (uint32_t)(1024 * ratio / 128) + 2, "Decoded %u blocks in one update\n", busiest);
+
+    FAudioVoice_DestroyVoice(master);
+    FAudio_Release(audio);
+    FAtest_free(data);
+    FAtest_free(reference);
+    FAtest_free(output);
+}
+
+static void test_msadpcm_blocks(void)
+{
+    FAudioBuffer whole, looped;
+    uint16_t channels;
+
+    memset(&whole, 0, sizeof(whole));
+    /* MSADPCM loops are whole blocks, here blocks 7 to 21, which are decoded again */
+    looped = whole;
+    looped.LoopBegin = 7 * 128;
+    looped.LoopLength = 15 * 128;
+    looped.LoopCount = 1;
+
+    for(channels = 1; channels <= 2; ++channels){
+        check_msadpcm(__LINE__, channels, 1.f, &whole, ADPCM_BLOCKS);
+        check_msadpcm(__LINE__, channels, 0.9f, &whole, ADPCM_BLOCKS);
+        check_msadpcm(__LINE__, channels, 1.3f, &whole, ADPCM_BLOCKS);
+        check_msadpcm(__LINE__, channels, 1.f, &looped, ADPCM_BLOCKS + 15);
+        check_msadpcm(__LINE__, channels, 0.9f, &looped, ADPCM_BLOCKS + 15);
+    }
+}
+
+#define DIRECT_FRAMES (3 * 1024)
+
+/* Appends what a buffer plays to expected, in frames */
+static uint32_t append_buffer(float *expected, const float *samples, uint16_t channels, const FAudioBuffer *buf)
+{
+    uint32_t frames = 0, loop, end = buf->LoopCount ? buf->LoopBegin + buf->LoopLength : 0;
+    uint32_t play_end = buf->PlayBegin + buf->PlayLength;
+
+    if(!end){
+        memcpy(expected, samples + buf->PlayBegin * channels, buf->PlayLength * channels * sizeof(float));
+        return buf->PlayLength;
+    }
+    memcpy(expected, samples + buf->PlayBegin * channels, (end - buf->PlayBegin) * channels * sizeof(float));
+    frames += end - buf->PlayBegin;
+    for(loop = 0; loop < buf->LoopCount; ++loop){
+        memcpy(expected + frames * channels, samples + buf->LoopBegin * channels,
+                buf->LoopLength * channels * sizeof(float));
+        frames += buf->LoopLength;
+    }
+    memcpy(expected + frames * channels, samples + end * channels, (play_end - end) * channels * sizeof(float));
+    return frames + play_end - end;
+}
+
+static void check_direct_source(unsigned line, const FAudioWaveFormatEx *fmt, const void *data, const float *samples)
+{
+    FAudio *audio;
+    FAudioMasteringVoice *master;
+    FAudioBuffer bufs[3];
+    float *expected, *reference, *output;
+    uint32_t i, frames = 0, wrong, first;
+    const uint32_t count = DIRECT_FRAMES * fmt->nChannels;
+
+    /* a loop, and buffer ends that land in the middle of updates */
+    memset(bufs, 0, sizeof(bufs));
+    bufs[0].PlayBegin = 10;
+    bufs[0].PlayLength = 500;
+    bufs[0].LoopBegin = 100;
+    bufs[0].LoopLength = 77;
+    bufs[0].LoopCount = 3;
+    bufs[1].PlayLength = 1000;
+    bufs[2].PlayBegin = 600;
+    bufs[2].PlayLength = 333;
+    for(i = 0; i < 3; ++i){
+        bufs[i].AudioBytes = 1000 * fmt->nBlockAlign;
+        bufs[i].pAudioData = data;
+    }
+
+    expected = FAtest_malloc(count * sizeof(float));
+    reference = FAtest_malloc(count * sizeof(float));
+    output = FAtest_malloc(count * sizeof(float));
+    memset(expected, 0, count * sizeof(float));
+    for(i = 0; i < 3; ++i)
+        frames += append_buffer(expected + frames * fmt->nChannels, samples, fmt->nChannels, &bufs[i]);
+
+    audio = create_manual_engine(&master, fmt->nChannels, 48000, 0);
+    render_voice(audio, fmt, 0, 1.f, bufs, 3, TRUE, reference, DIRECT_FRAMES);
+    render_voice(audio, fmt, 0, 1.f, bufs, 3, FALSE, output, DIRECT_FRAMES);
+    wrong = count_differences(expected, reference, count, &first);
+    ok_(__FILE__, line, wrong == 0, "Got %u wrong samples from the decode cache, first at %u\n", wrong, first);
+    wrong = count_differences(expected, output, count, &first);
+    ok_(__FILE__, line, wrong == 0, "Got %u wrong samples, first at %u\n", wrong, first);
+
+    FAudioVoice_DestroyVoice(master);
+    FAudio_Release(audio);
+    FAtest_free(expected);
+    FAtest_free(reference);
+    FAtest_free(output);
+}
+
+static void test_direct_sources(void)
+{
+    FAudioWaveFormatEx fmt;
+    float floats[1000 * 2], samples[1000 * 2];
+    int16_t ints[1000 * 2];
+    uint16_t channels;
+    uint32_t i;
+
+    for(i = 0; i < 1000 * 2; ++i){
+        floats[i] = (float)((i * 53) % 251) / 251.f - 0.5f;
+        ints[i] = (int16_t)((i * 977) % 65536 - 32768);
+        samples[i] = ints[i] / 32768.f;
+    }
+
+    for(channels = 1; channels <= 2; ++channels){
+        init_float_format(&fmt, channels, 48000);
+        check_direct_source(__LINE__, &fmt, floats, floats);
+
+        fmt.wFormatTag = FAUDIO_FORMAT_PCM;
+        fmt.wBitsPerSample = 16;
+        fmt.nBlockAlign = channels * 2;
+        fmt.nAvgBytesPerSec = 48000 * fmt.nBlockAlign;
+        check_direct_source(__LINE__, &fmt, ints, samples);
+    }
+}
+
+/* Renders a single frame, which runs one whole update, and returns how many
+ * frames that update played
+ */
+static uint32_t get_update_frames(FAudio *audio)
+{
+    FAudioSourceVoice *src;
+    FAudioWaveFormatEx fmt;
+    FAudioVoiceState state;
+    FAudioBuffer buf;
+    float output[2];
+    uint32_t hr;
+
+    init_float_format(&fmt, 1, 48000);
+    hr = FAudio_CreateSourceVoice(audio, &src, &fmt, 0, 1.f, NULL, NULL, NULL);
+    ok(hr == S_OK, "CreateSourceVoice failed: %08x\n", hr);
+    memset(&buf, 0, sizeof(buf));
+    buf.AudioBytes = sizeof(output);
+    buf.pAudioData = (uint8_t*)output;
+    buf.LoopCount = FAUDIO_LOOP_INFINITE;
+    FAudioSourceVoice_SubmitSourceBuffer(src, &buf, NULL);
+    FAudioSourceVoice_Start(src, 0, FAUDIO_COMMIT_NOW);
+    FAudio_RenderEXT(audio, output, 1, FAUDIO_RENDER_FLOAT32_EXT);
+    FAudioSourceVoice_GetState(src, &state, 0);
+    FAudioVoice_DestroyVoice(src);
+    return (uint32_t)state.SamplesPlayed;
+}
+
+static void test_quantum_size(void)
+{
+    FAudio *audio;
+    FAudioMasteringVoice *master;
+    uint32_t hr, quantum, frames;
+
+    unsetenv("FAUDIO_QUANTUM_FRAMES");
+    hr = FAudioCreate(&audio, 0, FAUDIO_DEFAULT_PROCESSOR);
+    ok(hr == S_OK, "FAudioCreate failed: %08x\n", hr);
+    FAudio_GetQuantumSizeEXT(audio, &quantum);
+    ok(quantum == 0, "Got quantum %u, expected the device default\n", quantum);
+
+    hr = FAudio_SetQuantumSizeEXT(audio, FAUDIO_MIN_QUANTUM_FRAMES - 1);
+    ok(hr == FAUDIO_E_INVALID_CALL, "SetQuantumSizeEXT(15) returned %08x\n", hr);
+    hr = FAudio_SetQuantumSizeEXT(audio, FAUDIO_MAX_QUANTUM_FRAMES + 1);
+    ok(hr == FAUDIO_E_INVALID_CALL, "SetQuantumSizeEXT(32769) returned %08x\n", hr);
+    FAudio_GetQuantumSizeEXT(audio, &quantum);
+    ok(quantum == 0, "Rejected quantum was kept: %u\n", quantum);
+
+    hr = FAudio_SetQuantumSizeEXT(audio, FAUDIO_MIN_QUANTUM_FRAMES);
+    ok(hr == S_OK, "SetQuantumSizeEXT(16) failed: %08x\n", hr);
+    FAudio_GetQuantumSizeEXT(audio, &quantum);
+    ok(quantum == 16, "Got quantum %u\n", quantum);
+    hr = FAudio_SetQuantumSizeEXT(audio, FAUDIO_MAX_QUANTUM_FRAMES);
+    ok(hr == S_OK, "SetQuantumSizeEXT(32768) failed: %08x\n", hr);
+    FAudio_GetQuantumSizeEXT(audio, &quantum);
+    ok(quantum == 32768, "Got quantum %u\n", quantum);
+    hr = FAudio_SetQuantumSizeEXT(audio, 0);
+    ok(hr == S_OK, "SetQuantumSizeEXT(0) failed: %08x\n", hr);
+    FAudio_GetQuantumSizeEXT(audio, &quantum);
+    ok(quantum == 0, "Got quantum %u\n", quantum);
+
+    /* the quantum is fixed once the mastering voice exists */
+    hr = FAudio_SetQuantumSizeEXT(audio, 100);
+    ok(hr == S_OK, "SetQuantumSizeEXT(100) failed: %08x\n", hr);
+    FAudio_SetHeadlessModeEXT(audio, FAUDIO_HEADLESS_MANUAL_EXT, NULL);
+    hr = FAudio_CreateMasteringVoice(audio, &master, 1, 48000, 0, 0, NULL);
+    ok(hr == S_OK, "CreateMasteringVoice failed: %08x\n", hr);
+    hr = FAudio_SetQuantumSizeEXT(audio, 256);
+    ok(hr == FAUDIO_E_INVALID_CALL, "SetQuantumSizeEXT with a master returned %08x\n", hr);
+    hr = FAudio_SetQuantumSizeEXT(audio, 0);
+    ok(hr == FAUDIO_E_INVALID_CALL, "SetQuantumSizeEXT with a master returned %08x\n", hr);
+    FAudio_GetQuantumSizeEXT(audio, &quantum);
+    ok(quantum == 100, "Got quantum %u\n", quantum);
+    frames = get_update_frames(audio);
+    ok(frames == 100, "Update played %u frames\n", frames);
+    FAudioVoice_DestroyVoice(master);
+
+    /* without a quantum, Get returns what the engine picked */
+    hr = FAudio_SetQuantumSizeEXT(audio, 0);
+    ok(hr == S_OK, "SetQuantumSizeEXT(0) failed: %08x\n", hr);
+    hr = FAudio_CreateMasteringVoice(audio, &master, 1, 48000, 0, 0, NULL);
+    ok(hr == S_OK, "CreateMasteringVoice failed: %08x\n", hr);
+    FAudio_GetQuantumSizeEXT(audio, &quantum);
+    ok(quantum != 0, "Got no quantum for the master\n");
+    frames = get_update_frames(audio);
+    ok(frames == quantum, "Update played %u frames, expected %u\n", frames, quantum);
+    FAudioVoice_DestroyVoice(master);
+    FAudio_Release(audio);
+
+    /* the environment variable sets the initial quantum, if it's in range */
+    setenv("FAUDIO_QUANTUM_FRAMES", "256", 1);
+    hr = FAudioCreate(&audio, 0, FAUDIO_DEFAULT_PROCESSOR);
+    ok(hr == S_OK, "FAudioCreate failed: %08x\n", hr);
+    FAudio_GetQuantumSizeEXT(audio, &quantum);
+    ok(quantum == 256, "Got quantum %u from the environment\n", quantum);
+    FAudio_Release(audio);
+
+    setenv("FAUDIO_QUANTUM_FRAMES", "8", 1);
+    hr = FAudioCreate(&audio, 0, FAUDIO_DEFAULT_PROCESSOR);
+    ok(hr == S_OK, "FAudioCreate failed: %08x\n", hr);
+    FAudio_GetQuantumSizeEXT(audio, &quantum);
+    ok(quantum == 0, "Out of range quantum %u was used\n", quantum);
+    FAudio_Release(audio);
+    unsetenv("FAUDIO_QUANTUM_FRAMES");
+}
+#endif
+
 int main(int argc, char **argv)
 {
     HRESULT hr;
@@ -1255,6 +2782,7 @@ int main(int argc, char **argv)
             test_looping((IXAudio2*)xa27);
             test_submix((IXAudio2*)xa27);
             test_flush((IXAudio2*)xa27);
+            test_operationsets((IXAudio2*)xa27);
             test_setchannelvolumes((IXAudio2*)xa27);
         }else
             fprintf(stdout, "No audio devices available\n");
@@ -1289,6 +2817,7 @@ int main(int argc, char **argv)
             test_looping(xa);
             test_submix(xa);
             test_flush(xa);
+            test_operationsets(xa);
             test_setchannelvolumes(xa);
         }else
             fprintf(stdout, "No audio devices available\n");
@@ -1297,6 +2826,19 @@ int main(int argc, char **argv)
     }else
         fprintf(stdout, "XAudio2.8 not available, tests skipped\n");
 
+#ifndef _WIN32
+    test_headless_wav();
+    test_pcm_cache();
+    test_voice_pools();
+    test_render_ext();
+    test_mix_blocks();
+    test_ratio_resamplers();
+    test_multichannel_resamplers();
+    test_msadpcm_blocks();
+    test_direct_sources();
+    test_quantum_size();
+#endif
+
     fprintf(stdout, "Finished with %u successful tests and %u failed tests.\n",
             success_count, failure_count);
 